@@ -438,6 +438,14 @@ function(hpx_check_for_cxx17_std_variant)
   )
 endfunction()
 
+# ##############################################################################
+function(hpx_check_for_cxx17_std_to_chars)
+  add_hpx_config_test(
+    HPX_WITH_CXX17_STD_TO_CHARS SOURCE cmake/tests/cxx17_std_to_chars.cpp FILE
+                                       ${ARGN}
+  )
+endfunction()
+
 # ##############################################################################
 function(hpx_check_for_cxx20_coroutines)
   add_hpx_config_test(
@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <charconv>
+#include <system_error>
+
+int main()
+{
+    char buffer[32];
+    std::to_chars_result r = std::to_chars(buffer, buffer + 32, 42ull, 16);
+
+    return r.ec == std::errc() ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/functional/function.hpp>
+
+#include <hpx/components/iostreams/export_definitions.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    class interval_timer;
+}}
+
+namespace hpx { namespace iostreams { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns the interval (in milliseconds) in which the output collected in
+    // buffered mode is sent to the console locality, returns zero if buffered
+    // output is disabled (see hpx.iostreams.buffered).
+    HPX_IOSTREAMS_EXPORT std::int64_t get_buffered_output_interval();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // In buffered mode each worker thread formats its output into a buffer of
+    // its own. Each piece of output an HPX thread writes to a buffer is
+    // numbered when it is started, and it is considered complete once it is
+    // terminated by hpx::endl and friends (or once the buffer is used by
+    // another thread, or the thread writes to another buffer).
+    // Completed output is periodically collected from all buffers and sent
+    // to the console locality as one batch, ordered by those numbers. The
+    // output of each HPX thread therefore stays in order, even if the thread
+    // continues on a different worker thread. A line is kept together unless
+    // its thread is suspended before finishing it, or leaves it unfinished
+    // for longer than one flush interval.
+    struct output_segment
+    {
+        std::uint64_t sequence_;
+        std::vector<char> data_;
+    };
+
+    class HPX_IOSTREAMS_EXPORT local_buffers
+    {
+    public:
+        // the amount of completed output of a thread which triggers sending
+        // it to the console before the flush interval has elapsed
+        static constexpr std::size_t flush_threshold = 64 * 1024;
+
+        // flush is invoked every flush_interval milliseconds
+        local_buffers(util::function_nonser<bool()> const& flush,
+            std::int64_t flush_interval);
+        ~local_buffers();
+
+        // Append the completed output of all threads to the given vector,
+        // returns false if no output was collected. If all is true, output
+        // which has not been completed yet is collected as well. Output
+        // started after output which can't be collected yet is held back
+        // until the next call. Calls to this function have to be serialized
+        // by the caller.
+        bool collect(std::vector<char>& data, bool all);
+
+        // stop the periodic flushing
+        void stop();
+
+    private:
+        friend class local_stream;
+
+        struct local_buffer;
+        local_buffer& get_local_buffer();
+
+        void begin_write(local_buffer& buffer);
+        void end_write(local_buffer& buffer);
+        void open(local_buffer& buffer);
+
+        std::size_t num_buffers_;
+        std::unique_ptr<local_buffer[]> buffers_;
+        std::unique_ptr<util::interval_timer> timer_;
+
+        // the number given to the next piece of output
+        std::atomic<std::uint64_t> next_sequence_;
+
+        // completed output which has to wait for earlier, not yet completed
+        // output to be sent
+        std::vector<output_segment> held_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Provides exclusive access to the stream of the calling thread for the
+    // lifetime of this object. The same thread may create nested instances
+    // (for instance from an operator<< writing to hpx::cout itself).
+    class HPX_IOSTREAMS_EXPORT local_stream
+    {
+    public:
+        explicit local_stream(local_buffers& buffers);
+        ~local_stream();
+
+        local_stream(local_stream const&) = delete;
+        local_stream& operator=(local_stream const&) = delete;
+
+        std::ostream& get();
+
+        // mark the output written so far as complete, returns the amount of
+        // completed output in the buffer of the calling thread
+        std::size_t complete();
+
+    private:
+        local_buffers& buffers_;
+        local_buffers::local_buffer& buffer_;
+    };
+}}}
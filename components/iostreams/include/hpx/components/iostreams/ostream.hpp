@@ -12,6 +12,7 @@
 #include <hpx/async_distributed/apply.hpp>
 #include <hpx/modules/async_distributed.hpp>
 #include <hpx/execution_base/register_locks.hpp>
+#include <hpx/components/iostreams/local_buffers.hpp>
 #include <hpx/components/iostreams/manipulators.hpp>
 #include <hpx/components/iostreams/server/output_stream.hpp>
 #include <hpx/runtime/components/client_base.hpp>
@@ -23,6 +24,7 @@
 #include <ios>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -121,6 +123,22 @@ namespace hpx { namespace iostreams
             return "/locality#console/output_stream#consolestream";
         }
 
+        // buffered output is never used for hpx::cerr
+        inline std::int64_t get_buffered_output_interval(cout_tag)
+        {
+            return get_buffered_output_interval();
+        }
+
+        inline std::int64_t get_buffered_output_interval(cerr_tag)
+        {
+            return 0;
+        }
+
+        inline std::int64_t get_buffered_output_interval(consolestream_tag)
+        {
+            return get_buffered_output_interval();
+        }
+
         ///////////////////////////////////////////////////////////////////////
         hpx::future<naming::id_type>
         create_ostream(char const* name, std::ostream& strm);
@@ -171,6 +189,20 @@ namespace hpx { namespace iostreams
         using detail::buffer::mtx_;
         std::atomic<std::uint64_t> generational_count_;
 
+        // per-thread buffers, non-null if buffered output is enabled. This
+        // is accessed only through the atomic shared_ptr functions, as it is
+        // reset during shutdown while other threads might still write.
+        std::shared_ptr<detail::local_buffers> local_buffers_;
+
+        std::shared_ptr<detail::local_buffers> get_local_buffers() const
+        {
+            return std::atomic_load(&local_buffers_);
+        }
+
+        // the buffers are kept alive after shutdown, the interval timer might
+        // still be executing a flush
+        std::shared_ptr<detail::local_buffers> stopped_local_buffers_;
+
         // Performs a lazy streaming operation.
         template <typename T>
         ostream& streaming_operator_lazy(T const& subject)
@@ -231,6 +263,76 @@ namespace hpx { namespace iostreams
             return *this;
         } // }}}
 
+        ///////////////////////////////////////////////////////////////////////
+        // Buffered mode: the output is formatted into the buffer of the
+        // calling worker thread.
+        template <typename T>
+        ostream& streaming_operator_buffered(
+            detail::local_buffers& buffers, T const& subject)
+        { // {{{
+            detail::local_stream s(buffers);
+            s.get() << subject;
+            return *this;
+        } // }}}
+
+        // Buffered mode: complete the output of the calling worker thread,
+        // it will be sent with the next batch.
+        template <typename T>
+        ostream& streaming_operator_buffered_complete(
+            detail::local_buffers& buffers, T const& subject)
+        { // {{{
+            std::size_t completed = 0;
+            {
+                detail::local_stream s(buffers);
+                s.get() << subject;
+                completed = s.complete();
+            }
+
+            // don't wait for the flush interval if a lot of output is pending
+            if (completed >= detail::local_buffers::flush_threshold)
+                flush_buffered(false);
+
+            return *this;
+        } // }}}
+
+        // Send the completed output of all worker threads as one batch.
+        bool flush_buffered(bool sync)
+        { // {{{
+            std::shared_ptr<detail::local_buffers> buffers =
+                get_local_buffers();
+            if (!buffers)
+                return true;
+
+            std::unique_lock<mutex_type> l(*mtx_);
+
+            std::vector<char> data;
+            if (!buffers->collect(data, sync) && !sync)
+            {
+                return true;
+            }
+
+            // assign the sequence number while holding the lock to preserve
+            // the order of the batches
+            std::uint64_t const count = generational_count_++;
+            buffer next(std::move(data));
+
+            l.unlock();
+
+            if (sync)
+            {
+                typedef server::output_stream::write_sync_action action_type;
+                hpx::async<action_type>(this->get_id(),
+                    hpx::get_locality_id(), count, next).get();
+            }
+            else
+            {
+                typedef server::output_stream::write_async_action action_type;
+                hpx::apply<action_type>(this->get_id(),
+                    hpx::get_locality_id(), count, next);
+            }
+            return true;
+        } // }}}
+
         ///////////////////////////////////////////////////////////////////////
         friend struct detail::buffer_sink<char>;
 
@@ -269,15 +371,43 @@ namespace hpx { namespace iostreams
         void initialize(Tag tag)
         {
             *static_cast<base_type*>(this) = detail::create_ostream(tag);
+
+            std::int64_t const interval =
+                detail::get_buffered_output_interval(tag);
+            if (interval != 0)
+            {
+                std::atomic_store(&local_buffers_,
+                    std::make_shared<detail::local_buffers>(
+                        [this]() { return flush_buffered(false); }, interval));
+            }
         }
 
         // reset this object during runtime system shutdown
         template <typename Tag>
         void uninitialize(Tag tag)
         {
+            // Writers which still hold on to the buffers may finish their
+            // output, it is not sent anymore.
+            std::shared_ptr<detail::local_buffers> buffers =
+                std::atomic_exchange(&local_buffers_,
+                    std::shared_ptr<detail::local_buffers>());
+            if (buffers)
+            {
+                buffers->stop();
+                stopped_local_buffers_ = buffers;
+            }
+
             std::unique_lock<mutex_type> l(*mtx_, std::try_to_lock);
             if (l)
             {
+                // send the pending output of all threads with the final flush
+                std::vector<char> data;
+                if (buffers && buffers->collect(data, true))
+                {
+                    this->detail::buffer::write(
+                        data.data(), std::streamsize(data.size()));
+                }
+
                 streaming_operator_sync(hpx::async_flush, l);   // unlocks
             }
 
@@ -297,6 +427,15 @@ namespace hpx { namespace iostreams
         // hpx::flush manipulator
         ostream& operator<<(hpx::iostreams::flush_type const& m)
         {
+            if (std::shared_ptr<detail::local_buffers> buffers =
+                    get_local_buffers())
+            {
+                // send the output of all threads right away
+                streaming_operator_buffered_complete(*buffers, m);
+                flush_buffered(true);
+                return *this;
+            }
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_sync(m, l);
         }
@@ -304,6 +443,12 @@ namespace hpx { namespace iostreams
         // hpx::endl manipulator
         ostream& operator<<(hpx::iostreams::endl_type const& m)
         {
+            if (std::shared_ptr<detail::local_buffers> buffers =
+                    get_local_buffers())
+            {
+                return streaming_operator_buffered_complete(*buffers, m);
+            }
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_sync(m, l);
         }
@@ -311,6 +456,12 @@ namespace hpx { namespace iostreams
         // hpx::async_flush manipulator
         ostream& operator<<(hpx::iostreams::async_flush_type const& m)
         {
+            if (std::shared_ptr<detail::local_buffers> buffers =
+                    get_local_buffers())
+            {
+                return streaming_operator_buffered_complete(*buffers, m);
+            }
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_async(m, l);
         }
@@ -318,6 +469,12 @@ namespace hpx { namespace iostreams
         // hpx::async_endl manipulator
         ostream& operator<<(hpx::iostreams::async_endl_type const& m)
         {
+            if (std::shared_ptr<detail::local_buffers> buffers =
+                    get_local_buffers())
+            {
+                return streaming_operator_buffered_complete(*buffers, m);
+            }
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_async(m, l);
         }
@@ -326,6 +483,12 @@ namespace hpx { namespace iostreams
         template <typename T>
         ostream& operator<<(T const& subject)
         {
+            if (std::shared_ptr<detail::local_buffers> buffers =
+                    get_local_buffers())
+            {
+                return streaming_operator_buffered(*buffers, subject);
+            }
+
             std::lock_guard<mutex_type> l(*mtx_);
             return streaming_operator_lazy(subject);
         }
@@ -333,6 +496,12 @@ namespace hpx { namespace iostreams
         ///////////////////////////////////////////////////////////////////////
         ostream& operator<<(std_stream_type& (*manip_fun)(std_stream_type&))
         {
+            if (std::shared_ptr<detail::local_buffers> buffers =
+                    get_local_buffers())
+            {
+                return streaming_operator_buffered(*buffers, manip_fun);
+            }
+
             std::unique_lock<mutex_type> l(*mtx_);
             util::ignore_while_checking<std::unique_lock<mutex_type> > ignore(&l);
             return streaming_operator_lazy(manip_fun);
@@ -32,6 +32,11 @@ namespace hpx { namespace iostreams { namespace detail
             mtx_(new mutex_type)
         {}
 
+        explicit buffer(std::vector<char>&& data)
+          : data_(std::make_shared<std::vector<char> >(std::move(data))),
+            mtx_(new mutex_type)
+        {}
+
         buffer(buffer const& rhs)
           : data_(rhs.data_)
           , mtx_(rhs.mtx_)
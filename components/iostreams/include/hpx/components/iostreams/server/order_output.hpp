@@ -12,65 +12,90 @@
 
 #include <hpx/components/iostreams/server/buffer.hpp>
 
+#include <algorithm>
 #include <cstdint>
-#include <map>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace iostreams { namespace detail
 {
     struct order_output
     {
-        typedef std::map<std::uint64_t, buffer> output_data_type;
-        typedef std::pair<std::uint64_t, output_data_type> data_type;
-        typedef std::map<std::uint32_t, data_type> output_data_map_type;
+        // buffers received out of order, sorted by their sequence number
+        typedef std::vector<std::pair<std::uint64_t, buffer> >
+            output_data_type;
+
+        struct data_type
+        {
+            // sequence number of the next buffer to write
+            std::uint64_t next_ = 0;
+            output_data_type pending_;
+        };
+
+        typedef std::unordered_map<std::uint32_t, data_type>
+            output_data_map_type;
 
         template <typename F, typename Mutex>
         void output(std::uint32_t locality_id, std::uint64_t count,
             detail::buffer const& buf_in, F const& write_f, Mutex& mtx)
         {
-            detail::buffer in(buf_in);
             std::unique_lock<Mutex> l(mtx);
             data_type& data = output_data_map_[locality_id]; //-V108
 
-            if (count == data.first)
+            if (count != data.next_)
+            {
+                // buffers arrive mostly in order, so this is usually an
+                // append
+                HPX_ASSERT(count > data.next_);
+                auto it = std::upper_bound(data.pending_.begin(),
+                    data.pending_.end(), count,
+                    [](std::uint64_t c,
+                        output_data_type::value_type const& p) {
+                        return c < p.first;
+                    });
+                data.pending_.emplace(it, count, buf_in);
+                return;
+            }
+
+            // this is the next expected buffer, output it together with all
+            // consecutive pending buffers
+            std::vector<buffer> ready;
+            ready.push_back(buf_in);
+            ++count;
+
+            while (true)
             {
-                // this is the next expected output line
+                auto it = data.pending_.begin();
+                for (/**/; it != data.pending_.end() && it->first == count;
+                     ++it, ++count)
                 {
-                    // output the line as requested
-                    util::unlock_guard<std::unique_lock<Mutex> > ul(l);
-                    in.write(write_f, mtx);
+                    ready.push_back(std::move(it->second));
                 }
-                ++data.first;
+                data.pending_.erase(data.pending_.begin(), it);
 
-                // print all consecutive pending buffers
-                output_data_type::iterator next = data.second.find(++count);
-                while (next != data.second.end())
                 {
-                    buffer next_in = (*next).second;
+                    // buffers arriving in the meantime are queued as
+                    // data.next_ has not been updated yet
+                    util::unlock_guard<std::unique_lock<Mutex> > ul(l);
+                    for (buffer& b : ready)
                     {
-                        // output the next line
-                        util::unlock_guard<std::unique_lock<Mutex> > ul(l);
-                        next_in.write(write_f, mtx);
+                        b.write(write_f, mtx);
                     }
-                    data.second.erase(next);
+                }
+                ready.clear();
+                data.next_ = count;
 
-                    // find next entry in map
-                    ++data.first;
-                    next = data.second.find(++count);
+                if (data.pending_.empty() ||
+                    data.pending_.front().first != count)
+                {
+                    break;
                 }
             }
-            else
-            {
-                HPX_ASSERT(count > data.first);
-                data.second.insert(output_data_type::value_type(count, in));
-            }
         }
 
     private:
         output_data_map_type output_data_map_;
     };
 }}}
-
-
-
@@ -0,0 +1,313 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/functional/function.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/runtime_local/get_os_thread_count.hpp>
+#include <hpx/runtime_local/interval_timer.hpp>
+#include <hpx/synchronization/recursive_mutex.hpp>
+#include <hpx/threading_base/thread_data.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
+
+#include <hpx/components/iostreams/local_buffers.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace iostreams { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t get_buffered_output_interval()
+    {
+        if (get_config_entry("hpx.iostreams.buffered", "0") != "1")
+            return 0;
+
+        std::int64_t interval = std::stoll(
+            get_config_entry("hpx.iostreams.flush_interval", "10"));
+        return interval > 0 ? interval : 1;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // stream buffer appending all output to a vector
+        class vector_streambuf : public std::streambuf
+        {
+        public:
+            explicit vector_streambuf(std::vector<char>& data)
+              : data_(data)
+            {}
+
+        protected:
+            int_type overflow(int_type ch) override
+            {
+                if (!traits_type::eq_int_type(ch, traits_type::eof()))
+                {
+                    data_.push_back(traits_type::to_char_type(ch));
+                }
+                return traits_type::not_eof(ch);
+            }
+
+            std::streamsize xsputn(char const* s, std::streamsize n) override
+            {
+                data_.insert(data_.end(), s, s + n);
+                return n;
+            }
+
+        private:
+            std::vector<char>& data_;
+        };
+
+        struct local_buffer_data
+        {
+            local_buffer_data()
+              : open_(false)
+              , seen_(false)
+              , sequence_(0)
+              , owner_(nullptr)
+              , completed_size_(0)
+              , lowest_((std::numeric_limits<std::uint64_t>::max)())
+              , buf_(data_)
+              , stream_(&buf_)
+            {}
+
+            // protects all members, the thread owning the lock may write to
+            // the stream again (e.g. from inside a user defined operator<<)
+            lcos::local::recursive_mutex mtx_;
+
+            // the output which has not been completed yet, it was written by
+            // owner_ (nullptr if that is not an HPX thread)
+            std::vector<char> data_;
+            bool open_;
+            bool seen_;    // set once collect found the output incomplete
+            std::uint64_t sequence_;
+            std::atomic<threads::thread_data*> owner_;
+
+            // completed output which is ready to be sent
+            std::vector<output_segment> completed_;
+            std::size_t completed_size_;
+
+            // the number of the earliest output which has not been collected
+            // yet, readable without holding the lock
+            std::atomic<std::uint64_t> lowest_;
+
+            vector_streambuf buf_;
+            std::ostream stream_;
+
+            void complete()
+            {
+                if (!data_.empty())
+                {
+                    completed_size_ += data_.size();
+                    completed_.push_back(output_segment{sequence_, data_});
+                    data_.clear();
+                }
+                open_ = false;
+                owner_ = nullptr;
+            }
+        };
+    }
+
+    struct local_buffers::local_buffer
+      : util::cache_aligned_data_derived<local_buffer_data>
+    {
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    local_buffers::local_buffers(util::function_nonser<bool()> const& flush,
+            std::int64_t flush_interval)
+        // one buffer for each worker thread and one shared by all other
+        // threads
+      : num_buffers_(get_os_thread_count() + 1)
+      , buffers_(new local_buffer[num_buffers_])
+      , timer_(new util::interval_timer(flush, flush_interval * 1000,
+            "hpx::iostreams::detail::local_buffers", true))
+      , next_sequence_(0)
+    {
+        timer_->start(false);
+    }
+
+    local_buffers::~local_buffers()
+    {
+        stop();
+    }
+
+    void local_buffers::stop()
+    {
+        timer_->stop();
+    }
+
+    local_buffers::local_buffer& local_buffers::get_local_buffer()
+    {
+        std::size_t num_thread = get_worker_thread_num();
+        if (num_thread >= num_buffers_ - 1)
+            num_thread = num_buffers_ - 1;
+        return buffers_[num_thread];
+    }
+
+    void local_buffers::open(local_buffer& buffer)
+    {
+        buffer.open_ = true;
+        buffer.seen_ = false;
+        buffer.sequence_ = next_sequence_++;
+        buffer.owner_ = threads::get_self_id_data();
+        if (buffer.completed_.empty())
+            buffer.lowest_ = buffer.sequence_;
+    }
+
+    // The buffer is locked by the calling thread. Every HPX thread has at
+    // most one piece of incomplete output, so it is continued only if it is
+    // found in the buffer being written to. Otherwise the incomplete output
+    // of this buffer and the one this thread may have left in another buffer
+    // (before it was moved to a different worker thread) are completed.
+    //
+    // The other buffer is locked while this one is held. This can't
+    // deadlock: the thread holding the other buffer has completed the
+    // incomplete output of the calling thread before looking at any other
+    // buffer, so it can't be waiting for this one.
+    void local_buffers::begin_write(local_buffer& buffer)
+    {
+        threads::thread_data* self = threads::get_self_id_data();
+        if (buffer.open_ && self != nullptr && buffer.owner_ == self)
+            return;
+
+        buffer.complete();
+
+        if (self != nullptr)
+        {
+            for (std::size_t i = 0; i != num_buffers_; ++i)
+            {
+                local_buffer& other = buffers_[i];
+                if (&other == &buffer || other.owner_ != self)
+                    continue;
+
+                std::lock_guard<lcos::local::recursive_mutex> l(other.mtx_);
+                if (other.owner_ == self)
+                    other.complete();
+            }
+        }
+
+        open(buffer);
+    }
+
+    void local_buffers::end_write(local_buffer& buffer)
+    {
+        if (buffer.data_.empty())
+        {
+            buffer.complete();
+        }
+        else if (!buffer.open_)
+        {
+            // a nested write has completed the output while the current
+            // operator<< was still writing, the remainder is new output
+            open(buffer);
+        }
+    }
+
+    bool local_buffers::collect(std::vector<char>& data, bool all)
+    {
+        // output started later than this may have been completed while the
+        // buffers are visited and is not necessarily collected yet, it is
+        // held back together with all output started after incomplete output
+        std::uint64_t limit = next_sequence_.load();
+
+        std::vector<output_segment> segments = std::move(held_);
+        held_.clear();
+
+        for (std::size_t i = 0; i != num_buffers_; ++i)
+        {
+            local_buffer& buffer = buffers_[i];
+
+            // the thread holding the lock may wait for the caller (e.g. when
+            // flushing from inside an operator<<), skip its buffer this time
+            std::unique_lock<lcos::local::recursive_mutex> l(
+                buffer.mtx_, std::try_to_lock);
+            if (!l.owns_lock())
+            {
+                limit = (std::min)(limit, buffer.lowest_.load());
+                continue;
+            }
+
+            // incomplete output is sent on request or if it has stayed
+            // incomplete for a full flush interval, otherwise it holds back
+            // all output started after it
+            if (buffer.open_)
+            {
+                if (all || buffer.seen_)
+                {
+                    buffer.complete();
+                }
+                else
+                {
+                    buffer.seen_ = true;
+                    limit = (std::min)(limit, buffer.sequence_);
+                }
+            }
+
+            std::move(buffer.completed_.begin(), buffer.completed_.end(),
+                std::back_inserter(segments));
+            buffer.completed_.clear();
+            buffer.completed_size_ = 0;
+            buffer.lowest_ = buffer.open_ ? buffer.sequence_ :
+                (std::numeric_limits<std::uint64_t>::max)();
+        }
+
+        std::sort(segments.begin(), segments.end(),
+            [](output_segment const& lhs, output_segment const& rhs) {
+                return lhs.sequence_ < rhs.sequence_;
+            });
+
+        std::size_t const size = data.size();
+        for (output_segment& segment : segments)
+        {
+            if (segment.sequence_ >= limit)
+            {
+                held_.push_back(std::move(segment));
+                continue;
+            }
+            data.insert(data.end(), segment.data_.begin(), segment.data_.end());
+        }
+        return data.size() != size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    local_stream::local_stream(local_buffers& buffers)
+      : buffers_(buffers)
+      , buffer_(buffers.get_local_buffer())
+    {
+        buffer_.mtx_.lock();
+        buffers_.begin_write(buffer_);
+    }
+
+    local_stream::~local_stream()
+    {
+        buffers_.end_write(buffer_);
+        buffer_.mtx_.unlock();
+    }
+
+    std::ostream& local_stream::get()
+    {
+        return buffer_.stream_;
+    }
+
+    std::size_t local_stream::complete()
+    {
+        buffer_.complete();
+        return buffer_.completed_size_;
+    }
+}}}
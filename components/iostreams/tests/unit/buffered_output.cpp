@@ -0,0 +1,126 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the output of hpx::consolestream is complete and ordered per
+// task if buffered output is enabled, even if the tasks are moved between
+// worker threads and if output is generated while formatting other output.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 100;
+std::size_t const num_lines = 100;
+
+// writes a line of its own to hpx::consolestream while being formatted
+struct nested_output
+{
+    std::size_t task;
+    std::size_t line;
+};
+
+std::ostream& operator<<(std::ostream& os, nested_output const& n)
+{
+    hpx::consolestream << "nested " << n.task << " " << n.line << hpx::endl;
+    return os;
+}
+
+void generate_output(std::size_t task)
+{
+    for (std::size_t line = 0; line != num_lines; ++line)
+    {
+        if (line % 10 == 0)
+        {
+            hpx::consolestream << nested_output{task, line} << task << " "
+                               << line << hpx::endl;
+        }
+        else
+        {
+            hpx::consolestream << task << " " << line << hpx::endl;
+        }
+
+        // give the task a chance to continue on another worker thread
+        hpx::this_thread::yield();
+    }
+}
+
+int hpx_main()
+{
+    std::vector<hpx::future<void>> tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t task = 0; task != num_tasks; ++task)
+    {
+        tasks.push_back(hpx::async(&generate_output, task));
+    }
+    hpx::wait_all(tasks);
+
+    // hpx::flush sends all pending output right away, batches sent earlier
+    // may still be in flight though
+    hpx::consolestream << hpx::flush;
+
+    std::string str;
+    for (int i = 0; i != 100; ++i)
+    {
+        str = hpx::get_consolestream().str();
+        if (std::count(str.begin(), str.end(), '\n') ==
+            std::ptrdiff_t(num_tasks * (num_lines + num_lines / 10)))
+        {
+            break;
+        }
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::istringstream output(str);
+
+    std::vector<std::size_t> next_line(num_tasks, 0);
+    std::size_t count = 0, nested_count = 0;
+    std::string text;
+    while (std::getline(output, text))
+    {
+        std::istringstream fields(text);
+
+        // the nested output precedes the line it was generated for
+        bool const nested = text.compare(0, 7, "nested ") == 0;
+        if (nested)
+            fields.ignore(7);
+
+        std::size_t task = 0, line = 0;
+        HPX_TEST(static_cast<bool>(fields >> task >> line));
+        HPX_TEST_LT(task, num_tasks);
+        if (task < num_tasks)
+        {
+            // the output of each task is in order
+            HPX_TEST_EQ(line, next_line[task]);
+            if (!nested)
+                next_line[task] = line + 1;
+        }
+        ++(nested ? nested_count : count);
+    }
+    HPX_TEST_EQ(count, num_tasks * num_lines);
+    HPX_TEST_EQ(nested_count, num_tasks * num_lines / 10);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.iostreams.buffered=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -8,7 +8,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/modules/errors.hpp>
 #include <hpx/lcos/promise.hpp>
@@ -268,7 +268,8 @@ namespace hpx { namespace lcos {
         // use this instance its member function \a apply needs to be directly
         // called.
         packaged_action()
-          : base_type(std::allocator_arg, hpx::util::internal_allocator<>{})
+          : base_type(std::allocator_arg,
+                hpx::util::thread_local_caching_allocator<>{})
         {
         }
 
@@ -410,7 +411,7 @@ namespace hpx { namespace lcos {
         /// called.
         packaged_action()
           : packaged_action<Action, Result, false>(
-              std::allocator_arg, hpx::util::internal_allocator<>{})
+              std::allocator_arg, hpx::util::thread_local_caching_allocator<>{})
         {
         }
 
@@ -135,6 +135,8 @@ namespace hpx { namespace actions
         naming::id_type&& target, naming::address::address_type lva,
         naming::address::component_type comptype)
     {
+        // the arguments are moved into the argument tuple of the thread
+        // function, which invokes the action with them (no bind involved)
         return base_type::derived_type::construct_thread_function(
             std::move(target), lva, comptype,
             util::get<Is>(std::move(this->arguments_))...);
@@ -15,14 +15,15 @@
 #if defined(HPX_HAVE_NETWORKING)
 #include <hpx/runtime/actions_fwd.hpp>
 
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/runtime/actions/action_support.hpp>
 #include <hpx/runtime/actions/base_action.hpp>
 #include <hpx/runtime/actions/detail/invocation_count_registry.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
+#include <hpx/serialization/detail/non_default_constructible.hpp>
 #include <hpx/serialization/input_archive.hpp>
 #include <hpx/serialization/output_archive.hpp>
-#include <hpx/serialization/unique_ptr.hpp>
 #include <hpx/traits/action_does_termination_detection.hpp>
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_priority.hpp>
@@ -41,6 +42,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -48,54 +50,103 @@ namespace hpx { namespace actions
 {
     ///////////////////////////////////////////////////////////////////////////
     // If one or more arguments of the action are non-default-constructible,
-    // the transfer_action does not store the argument tuple directly but a
-    // unique_ptr to the tuple instead.
+    // the transfer_action can't store the argument tuple directly. The
+    // argument_holder provides (uninitialized) inline storage for the tuple
+    // instead, which avoids a separate allocation for the arguments.
     namespace detail
     {
         template <typename Args>
         struct argument_holder
         {
-            argument_holder() = default;
+            argument_holder() noexcept
+              : constructed_(false)
+            {}
 
             explicit argument_holder(Args && args)
-              : data_(new Args(std::move(args)))
-            {}
+              : constructed_(false)
+            {
+                ::new (&storage_) Args(std::move(args));
+                constructed_ = true;
+            }
 
             template <typename ... Ts>
             argument_holder(Ts && ... ts)
-              : data_(new Args(std::forward<Ts>(ts)...))
-            {}
+              : constructed_(false)
+            {
+                ::new (&storage_) Args(std::forward<Ts>(ts)...);
+                constructed_ = true;
+            }
+
+            argument_holder(argument_holder const&) = delete;
+            argument_holder& operator=(argument_holder const&) = delete;
 
-            template <typename Archive>
-            void serialize(Archive& ar, unsigned int const)
+            ~argument_holder()
             {
-                ar & data_;
+                reset();
             }
 
-            HPX_HOST_DEVICE HPX_FORCEINLINE
-            Args& data()
+            // The wire format is the same as for a std::unique_ptr<Args>,
+            // which was used before
+            void load(serialization::input_archive& ar, unsigned int const)
             {
-                HPX_ASSERT(!!data_);
-                return *data_;
+                reset();
+
+                bool valid = false;
+                ar >> valid;
+                if (valid)
+                {
+                    using serialization::detail::load_construct_data;
+
+                    Args* args = reinterpret_cast<Args*>(&storage_);
+                    load_construct_data(ar, args, 0);
+                    constructed_ = true;
+
+                    ar >> *args;
+                }
             }
 
-#if defined(HPX_DISABLE_ASSERTS) || defined(BOOST_DISABLE_ASSERTS) || defined(NDEBUG)
-            constexpr HPX_HOST_DEVICE HPX_FORCEINLINE
-            Args const& data() const
+            void save(serialization::output_archive& ar,
+                unsigned int const) const
             {
-                return *data_;
+                ar << constructed_;
+                if (constructed_)
+                {
+                    using serialization::detail::save_construct_data;
+
+                    save_construct_data(ar, &data(), 0);
+                    ar << data();
+                }
             }
-#else
+
+            HPX_SERIALIZATION_SPLIT_MEMBER();
+
+            HPX_HOST_DEVICE HPX_FORCEINLINE
+            Args& data()
+            {
+                HPX_ASSERT(constructed_);
+                return *reinterpret_cast<Args*>(&storage_);
+            }
+
             HPX_HOST_DEVICE HPX_FORCEINLINE
             Args const& data() const
             {
-                HPX_ASSERT(!!data_);
-                return *data_;
+                HPX_ASSERT(constructed_);
+                return *reinterpret_cast<Args const*>(&storage_);
             }
-#endif
 
         private:
-            std::unique_ptr<Args> data_;
+            void reset()
+            {
+                if (constructed_)
+                {
+                    reinterpret_cast<Args*>(&storage_)->~Args();
+                    constructed_ = false;
+                }
+            }
+
+            typename std::aligned_storage<sizeof(Args), alignof(Args)>::type
+                storage_;
+            bool constructed_;
         };
     }
 }}
@@ -196,6 +247,21 @@ namespace hpx { namespace actions
             detail::register_action<derived_type>::instance.instantiate();
         }
 
+        // An action object is created for every parcel sent or received.
+        // These objects are allocated from the per-thread allocator caches
+        // (the dynamic size of the derived action is passed to the sized
+        // operator delete as the destructor is virtual).
+        static void* operator new(std::size_t size)
+        {
+            return util::thread_local_caching_allocator<char>{}.allocate(size);
+        }
+
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            util::thread_local_caching_allocator<char>{}.deallocate(
+                static_cast<char*>(p), size);
+        }
+
     public:
         /// retrieve component type
         static int get_static_component_type()
@@ -148,22 +148,18 @@ HPX_EXPORT bool is_local_address_cached(
   , error_code& ec = throws
     );
 
-inline bool is_local_address_cached(
-    naming::id_type const& gid
+// The local address of managed ids referring to non-migratable objects is
+// cached in the id itself, subsequent invocations don't need to consult AGAS.
+HPX_EXPORT bool is_local_address_cached(
+    naming::id_type const& id
+  , naming::address& addr
   , error_code& ec = throws
-    )
-{
-    return is_local_address_cached(gid.get_gid(), ec);
-}
+    );
 
-inline bool is_local_address_cached(
-    naming::id_type const& gid
-  , naming::address& addr
+HPX_EXPORT bool is_local_address_cached(
+    naming::id_type const& id
   , error_code& ec = throws
-    )
-{
-    return is_local_address_cached(gid.get_gid(), addr, ec);
-}
+    );
 
 ///////////////////////////////////////////////////////////////////////////////
 HPX_EXPORT bool is_local_lva_encoded_address(
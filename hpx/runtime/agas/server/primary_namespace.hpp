@@ -22,9 +22,12 @@
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_serialization_filter.hpp>
 #include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/datastructures/tuple.hpp>
 
+#include <array>
 #include <atomic>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <list>
@@ -128,21 +131,61 @@ struct HPX_EXPORT primary_namespace
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
-    mutex_type mutex_;
+    // The GVA table is split into stripes, each protected by its own mutex.
+    // The gid space is divided into blocks of 2^gva_block_bits consecutive
+    // ids, a range is registered in the stripes of all blocks it covers.
+    // Looking up an id therefore needs to consult the stripe of its block
+    // only, while binding or unbinding a range locks all of its stripes (in
+    // ascending order).
+    static constexpr std::size_t gva_block_bits = 4;
+    static constexpr std::size_t num_gva_stripes = 128;
+
+    // The reference counts and the migration bookkeeping are striped
+    // independently by gid.
+    static constexpr std::size_t num_refcnt_stripes = 128;
+    static constexpr std::size_t num_migration_stripes = 128;
 
-    gva_table_type gvas_;
-    refcnt_table_type refcnts_;
     typedef std::map<
             naming::gid_type,
             hpx::util::tuple<bool, std::size_t, lcos::local::detail::condition_variable>
         > migration_table_type;
 
+    struct gva_table_stripe
+    {
+        mutex_type mutex_;
+        gva_table_type gvas_;
+    };
+
+    struct refcnt_table_stripe
+    {
+        mutex_type mutex_;
+        refcnt_table_type refcnts_;
+    };
+
+    struct migration_table_stripe
+    {
+        mutex_type mutex_;
+        migration_table_type migrating_objects_;
+    };
+
+    typedef std::bitset<num_gva_stripes> gva_stripe_set;
+
+    // holds the locks of all stripes a range is registered in
+    class gva_stripes_lock;
+
+    std::array<util::cache_line_data<gva_table_stripe>, num_gva_stripes>
+        gva_stripes_;
+
+    std::array<util::cache_line_data<refcnt_table_stripe>, num_refcnt_stripes>
+        refcnt_stripes_;
+
+    std::array<util::cache_line_data<migration_table_stripe>,
+        num_migration_stripes>
+        migration_stripes_;
+
     std::string instance_name_;
     naming::gid_type next_id_;      // next available gid
     naming::gid_type locality_;     // our locality id
-    migration_table_type migrating_objects_;
 
     struct update_time_on_exit;
 
@@ -221,26 +264,55 @@ struct HPX_EXPORT primary_namespace
     counter_data counter_data_;
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all entries in [lower, upper).
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         );
 #endif
 
-    // helper function
+    // helper function, expects that \p l holds the mutex of \p stripe
     void wait_for_migration_locked(std::unique_lock<mutex_type>& l,
-        naming::gid_type const& id, error_code& ec);
+        migration_table_stripe& stripe, naming::gid_type const& id,
+        error_code& ec);
+
+    static std::uint64_t hash_gid(naming::gid_type const& id)
+    {
+        return id.get_lsb() ^ (id.get_msb() * 0x9e3779b97f4a7c15ull);
+    }
+
+    // access the stripes responsible for the given (stripped) gid
+    static std::size_t get_gva_stripe_index(naming::gid_type const& id)
+    {
+        std::uint64_t const block = (id.get_lsb() >> gva_block_bits) ^
+            (id.get_msb() * 0x9e3779b97f4a7c15ull);
+        return block % num_gva_stripes;
+    }
+
+    gva_table_stripe& get_gva_stripe(naming::gid_type const& id)
+    {
+        return gva_stripes_[get_gva_stripe_index(id)].data_;
+    }
+
+    refcnt_table_stripe& get_refcnt_stripe(naming::gid_type const& id)
+    {
+        return refcnt_stripes_[hash_gid(id) % num_refcnt_stripes].data_;
+    }
+
+    migration_table_stripe& get_migration_stripe(naming::gid_type id)
+    {
+        naming::detail::strip_internal_bits_from_gid(id);
+        return migration_stripes_[hash_gid(id) % num_migration_stripes].data_;
+    }
+
+    // return the stripes of all blocks covered by the range [id, id + count)
+    static gva_stripe_set get_gva_stripes(
+        naming::gid_type const& id, std::uint64_t count);
 
 public:
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
-      , mutex_()
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
@@ -254,6 +326,10 @@ public:
         next_id_ = naming::gid_type(g.get_msb() + 1, 0x1000);
     }
 
+    /// Returns how often existing bindings were changed on this locality,
+    /// used to invalidate local addresses cached in ids.
+    static std::uint64_t get_rebind_count() noexcept;
+
     /// Register all performance counter types exposed by this component.
     static void register_counter_types(
         error_code& ec = throws
@@ -304,9 +380,21 @@ public:
     naming::gid_type statistics_counter(std::string const& name);
 
   private:
-    resolved_type resolve_gid_locked(
-        std::unique_lock<mutex_type>& l
-      , naming::gid_type const& gid
+    // look up the range containing the given (stripped) gid
+    bool find_gva_range(
+        naming::gid_type const& id
+      , naming::gid_type& base
+      , gva_table_data_type& data
+        );
+
+    resolved_type resolve_gid_impl(
+        naming::gid_type const& gid
+      , error_code& ec
+        );
+
+    // wait for any pending migration of the object before resolving it
+    resolved_type wait_and_resolve_gid(
+        naming::gid_type const& gid
       , error_code& ec
         );
 
@@ -335,8 +423,7 @@ public:
         std::list<free_entry, free_entry_allocator_type>;
 
     void resolve_free_list(
-        std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+        std::list<naming::gid_type> const& free_list
       , free_entry_list_type& free_entry_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
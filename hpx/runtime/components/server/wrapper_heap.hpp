@@ -17,6 +17,7 @@
 #include <hpx/util/generate_unique_ids.hpp>
 #include <hpx/util/wrapper_heap_base.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -111,17 +112,25 @@ namespace hpx { namespace components { namespace detail
         void set_gid(naming::gid_type const& g);
 
     protected:
-        bool test_release(scoped_lock& lk);
-        bool ensure_pool(std::size_t count);
+        bool test_release(std::size_t freed);
+        bool ensure_pool(char* first_free, std::size_t count) const;
+        std::size_t allocated_size() const;
 
         bool init_pool();
         void tidy();
 
     protected:
-        char* pool_;
-        char* first_free_;
+        // Slots are handed out by atomically bumping first_free_ and are
+        // never reused (the index of a slot determines the global id of the
+        // object living there). The heap is released once all slots have
+        // been handed out and num_freed_ has caught up with them. This allows
+        // for alloc() and free() to proceed without acquiring mtx_.
+        std::atomic<char*> pool_;
+        std::atomic<char*> first_free_;
+        char* begin_;
+        char* end_;
         heap_parameters const parameters_;
-        std::size_t free_size_;
+        std::atomic<std::size_t> num_freed_;
 
         // these values are used for AGAS registration of all elements of this
         // managed_component heap
@@ -132,8 +141,8 @@ namespace hpx { namespace components { namespace detail
     public:
         std::string const class_name_;
 #if defined(HPX_DEBUG)
-        std::size_t alloc_count_;
-        std::size_t free_count_;
+        std::atomic<std::size_t> alloc_count_;
+        std::atomic<std::size_t> free_count_;
         std::size_t heap_count_;
 #endif
 
@@ -52,6 +52,12 @@ namespace hpx { namespace components { namespace detail
         ///
         naming::gid_type get_gid(void* p)
         {
+            // the object was most likely allocated by the current worker
+            if (util::wrapper_heap_base* heap = this->get_cached_heap(p))
+            {
+                return heap->get_gid(id_range_, p, type_);
+            }
+
             typename base_type::unique_lock_type guard(this->mtx_);
 
             typedef typename base_type::const_iterator iterator;
@@ -58,11 +58,13 @@ namespace hpx { namespace naming
 
     inline id_type& id_type::operator++()       // pre-increment
     {
+        gid_->reset_cached_address();
         ++(*gid_);
         return *this;
     }
     inline id_type id_type::operator++(int)     // post-increment
     {
+        gid_->reset_cached_address();
         return id_type((*gid_)++, unmanaged);
     }
 
@@ -124,6 +126,7 @@ namespace hpx { namespace naming
     }
     inline void id_type::set_msb(std::uint64_t msb)
     {
+        gid_->reset_cached_address();
         gid_->set_msb(msb);
     }
 
@@ -133,15 +136,18 @@ namespace hpx { namespace naming
     }
     inline void id_type::set_lsb(std::uint64_t lsb)
     {
+        gid_->reset_cached_address();
         gid_->set_lsb(lsb);
     }
     inline void id_type::set_lsb(void* lsb)
     {
+        gid_->reset_cached_address();
         gid_->set_lsb(lsb);
     }
 
     inline void id_type::make_unmanaged() const
     {
+        gid_->reset_cached_address();
         gid_->set_management_type(detail::unmanaged);
     }
 }}
@@ -23,6 +23,7 @@
 #include <hpx/serialization/traits/is_bitwise_serializable.hpp>
 #include <hpx/thread_support/atomic_count.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -823,6 +824,8 @@ namespace hpx { namespace naming
             // count of zero
             id_type_impl() noexcept
               : count_(0), type_(unknown_deleter)
+              , address_sequence_(0)
+              , component_type_(0), lva_(0), rebind_count_(0)
             {}
 
             explicit id_type_impl(init_no_addref,
@@ -830,6 +833,8 @@ namespace hpx { namespace naming
               : gid_type(0, lsb_id)
               , count_(1)
               , type_(t)
+              , address_sequence_(0)
+              , component_type_(0), lva_(0), rebind_count_(0)
             {}
 
             explicit id_type_impl(init_no_addref, std::uint64_t msb_id,
@@ -837,6 +842,8 @@ namespace hpx { namespace naming
               : gid_type(msb_id, lsb_id)
               , count_(1)
               , type_(t)
+              , address_sequence_(0)
+              , component_type_(0), lva_(0), rebind_count_(0)
             {}
 
             explicit id_type_impl(init_no_addref, gid_type const& gid,
@@ -844,6 +851,8 @@ namespace hpx { namespace naming
               : gid_type(gid)
               , count_(1)
               , type_(t)
+              , address_sequence_(0)
+              , component_type_(0), lva_(0), rebind_count_(0)
             {}
 
             id_type_management get_management_type() const noexcept
@@ -855,6 +864,81 @@ namespace hpx { namespace naming
                 type_ = type;
             }
 
+            // The local address of the referenced object, cached after it has
+            // been resolved once. This is used for managed ids referring to
+            // local, non-migratable objects only, as those can neither go
+            // away nor move while the id is alive. The cached address is
+            // valid only as long as no existing binding was changed in the
+            // meantime (see primary_namespace::get_rebind_count).
+            //
+            // The cached address is protected by a sequence lock: updates
+            // make address_sequence_ odd while they are in progress and
+            // advance it afterwards, readers discard what they have read if
+            // address_sequence_ has changed in the meantime.
+            bool get_cached_address(std::uint64_t rebind_count,
+                std::uint64_t& lva, std::int32_t& component_type) const noexcept
+            {
+                std::uint32_t const sequence =
+                    address_sequence_.load(std::memory_order_acquire);
+                if ((sequence & (address_updating | address_cached)) !=
+                    address_cached)
+                {
+                    return false;
+                }
+
+                std::uint64_t const cached_rebind_count =
+                    rebind_count_.load(std::memory_order_relaxed);
+                std::uint64_t const cached_lva =
+                    lva_.load(std::memory_order_relaxed);
+                std::int32_t const cached_component_type =
+                    component_type_.load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (address_sequence_.load(std::memory_order_relaxed) !=
+                        sequence ||
+                    cached_rebind_count != rebind_count)
+                {
+                    return false;
+                }
+
+                lva = cached_lva;
+                component_type = cached_component_type;
+                return true;
+            }
+
+            // concurrent updates are dropped, only one of them is needed
+            void set_cached_address(std::uint64_t rebind_count,
+                std::uint64_t lva, std::int32_t component_type) noexcept
+            {
+                std::uint32_t sequence =
+                    address_sequence_.load(std::memory_order_relaxed);
+                if ((sequence & address_updating) != 0 ||
+                    !address_sequence_.compare_exchange_strong(sequence,
+                        sequence | address_updating, std::memory_order_relaxed))
+                {
+                    return;
+                }
+                std::atomic_thread_fence(std::memory_order_release);
+
+                rebind_count_.store(rebind_count, std::memory_order_relaxed);
+                lva_.store(lva, std::memory_order_relaxed);
+                component_type_.store(
+                    component_type, std::memory_order_relaxed);
+
+                address_sequence_.store(
+                    (sequence & ~address_state_mask) + address_sequence_step +
+                        address_cached,
+                    std::memory_order_release);
+            }
+
+            // used when the id itself is modified, which can't happen
+            // concurrently with resolving it
+            void reset_cached_address() noexcept
+            {
+                address_sequence_.fetch_and(
+                    ~std::uint32_t(address_cached), std::memory_order_release);
+            }
+
             // serialization
             void save(serialization::output_archive& ar, unsigned) const;
 
@@ -899,6 +983,21 @@ namespace hpx { namespace naming
             util::atomic_count count_;
             id_type_management type_;
 
+            // the two lowest bits of address_sequence_ describe the state of
+            // the cached address, the remaining bits count the updates
+            enum address_state : std::uint32_t
+            {
+                address_updating = 1,
+                address_cached = 2,
+                address_state_mask = 3,
+                address_sequence_step = 4
+            };
+
+            std::atomic<std::uint32_t> address_sequence_;
+            std::atomic<std::int32_t> component_type_;
+            std::atomic<std::uint64_t> lva_;
+            std::atomic<std::uint64_t> rebind_count_;
+
             static util::internal_allocator<id_type_impl> alloc_;
         };
     }
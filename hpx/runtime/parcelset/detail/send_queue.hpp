@@ -0,0 +1,429 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The queue of parcels waiting to be sent to a single destination.
+    //
+    // Any number of threads may enqueue parcels without acquiring a lock
+    // (the pending parcels form an intrusive lock-free stack). At most one
+    // thread at a time (the drainer) takes the parcels out of the queue and
+    // sends them using the connection it owns. All parcels which have been
+    // enqueued while a write operation was in flight are sent by the drainer
+    // as a single batch afterwards.
+    class send_queue
+    {
+    public:
+        using write_handler_type = parcelport::write_handler_type;
+
+    private:
+        struct node
+        {
+            node(parcel&& p, write_handler_type&& f)
+              : parcel_(std::move(p))
+              , handler_(std::move(f))
+              , next_(nullptr)
+            {
+            }
+
+            parcel parcel_;
+            write_handler_type handler_;
+            node* next_;
+        };
+
+    public:
+        explicit send_queue(locality const& dest)
+          : destination_(dest)
+          , head_(nullptr)
+          , count_(0)
+          , draining_(false)
+          , stalled_(false)
+        {
+        }
+
+        HPX_NON_COPYABLE(send_queue);
+
+        ~send_queue()
+        {
+            delete_nodes(head_.load(std::memory_order_acquire));
+        }
+
+        locality const& destination() const noexcept
+        {
+            return destination_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void enqueue(parcel&& p, write_handler_type&& f)
+        {
+            node* n = new node(std::move(p), std::move(f));
+
+            // make the parcel visible to the pending count before it can be
+            // taken out of the queue
+            count_.fetch_add(1, std::memory_order_seq_cst);
+            push(n, n);
+        }
+
+        void enqueue(std::vector<parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
+            if (parcels.empty())
+                return;
+
+            // link the nodes such that the first parcel ends up at the bottom
+            // of the stack, this preserves the order of the parcels
+            node* last = nullptr;
+            node* first = nullptr;
+            for (std::size_t i = 0; i != parcels.size(); ++i)
+            {
+                node* n = new node(
+                    std::move(parcels[i]), std::move(handlers[i]));
+                n->next_ = first;
+                first = n;
+                if (last == nullptr)
+                    last = n;
+            }
+
+            count_.fetch_add(parcels.size(), std::memory_order_seq_cst);
+            push(first, last);
+        }
+
+        // return the number of parcels which have not been handed to a
+        // connection yet
+        std::size_t size() const noexcept
+        {
+            return count_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        // return whether there are parcels which have not been taken out of
+        // the queue by a drainer yet
+        bool has_queued() const noexcept
+        {
+            return head_.load(std::memory_order_seq_cst) != nullptr;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Try to become the (only) thread sending the parcels of this queue.
+        //
+        // A sender which fails to become the drainer after enqueueing a
+        // parcel relies on the drainer to see that parcel after releasing
+        // the queue (see has_queued()), which requires sequential
+        // consistency between enqueueing, acquiring and releasing.
+        bool try_acquire_drainer() noexcept
+        {
+            return !draining_.load(std::memory_order_seq_cst) &&
+                !draining_.exchange(true, std::memory_order_seq_cst);
+        }
+
+        void release_drainer() noexcept
+        {
+            HPX_ASSERT(draining_.load(std::memory_order_relaxed));
+            draining_.store(false, std::memory_order_seq_cst);
+        }
+
+        bool is_draining() const noexcept
+        {
+            return draining_.load(std::memory_order_acquire);
+        }
+
+        // Remember that no connection was available for sending the parcels
+        // of this queue. Returns true if the queue was not marked as stalled
+        // before.
+        bool mark_stalled() noexcept
+        {
+            return !stalled_.exchange(true, std::memory_order_acq_rel);
+        }
+
+        bool clear_stalled() noexcept
+        {
+            return stalled_.load(std::memory_order_relaxed) &&
+                stalled_.exchange(false, std::memory_order_acq_rel);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The following functions may be called by the drainer only.
+
+        // Move all parcels enqueued so far into the buffers owned by the
+        // drainer. Returns whether there are parcels to send. If this throws,
+        // the parcels stay in the queue.
+        bool dequeue()
+        {
+            HPX_ASSERT(draining_.load(std::memory_order_relaxed));
+
+            node* head = head_.exchange(nullptr, std::memory_order_seq_cst);
+            if (head != nullptr)
+            {
+                // the stack holds the parcels in reverse order
+                node* prev = nullptr;
+                std::size_t count = 0;
+                while (head != nullptr)
+                {
+                    node* next = head->next_;
+                    head->next_ = prev;
+                    prev = head;
+                    head = next;
+                    ++count;
+                }
+
+                try
+                {
+                    parcels_.reserve(parcels_.size() + count);
+                    handlers_.reserve(handlers_.size() + count);
+                }
+                catch (...)
+                {
+                    // give the parcels back to the queue, they may end up
+                    // behind parcels enqueued in the meantime
+                    node* first = nullptr;
+                    node* last = prev;
+                    while (prev != nullptr)
+                    {
+                        node* next = prev->next_;
+                        prev->next_ = first;
+                        first = prev;
+                        prev = next;
+                    }
+                    push(first, last);
+                    throw;
+                }
+
+                while (prev != nullptr)
+                {
+                    node* next = prev->next_;
+                    parcels_.push_back(std::move(prev->parcel_));
+                    handlers_.push_back(std::move(prev->handler_));
+                    delete prev;
+                    prev = next;
+                }
+            }
+
+            HPX_ASSERT(parcels_.size() == handlers_.size());
+            return !parcels_.empty();
+        }
+
+        std::vector<parcel>& parcels() noexcept
+        {
+            HPX_ASSERT(draining_.load(std::memory_order_relaxed));
+            return parcels_;
+        }
+
+        std::vector<write_handler_type>& handlers() noexcept
+        {
+            HPX_ASSERT(draining_.load(std::memory_order_relaxed));
+            return handlers_;
+        }
+
+        // The given number of parcels has been handed to a connection.
+        void sent(std::size_t count) noexcept
+        {
+            HPX_ASSERT(count_.load(std::memory_order_relaxed) >= count);
+            count_.fetch_sub(count, std::memory_order_acq_rel);
+        }
+
+    private:
+        void push(node* first, node* last) noexcept
+        {
+            node* head = head_.load(std::memory_order_relaxed);
+            do
+            {
+                last->next_ = head;
+            } while (!head_.compare_exchange_weak(head, first,
+                std::memory_order_seq_cst, std::memory_order_relaxed));
+        }
+
+        static void delete_nodes(node* n) noexcept
+        {
+            while (n != nullptr)
+            {
+                node* next = n->next_;
+                delete n;
+                n = next;
+            }
+        }
+
+    private:
+        locality const destination_;
+
+        // parcels enqueued by the senders
+        std::atomic<node*> head_;
+        std::atomic<std::size_t> count_;
+
+        std::atomic<bool> draining_;
+        std::atomic<bool> stalled_;
+
+        // parcels owned by the drainer
+        std::vector<parcel> parcels_;
+        std::vector<write_handler_type> handlers_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The table mapping destinations to their send queues.
+    //
+    // Destinations are never removed from the table, which allows to look
+    // up the queue for a destination without acquiring a lock: readers
+    // binary-search an immutable, sorted snapshot of all queues. Adding a
+    // destination publishes a new snapshot. Replaced snapshots are deleted
+    // once no reader is active anymore (readers announce themselves using
+    // per-thread counters).
+    class send_queue_table
+    {
+        using mutex_type = hpx::lcos::local::spinlock;
+        using snapshot_type = std::vector<send_queue*>;
+
+        static constexpr std::size_t num_reader_slots = 64;
+
+        struct reader_guard
+        {
+            explicit reader_guard(send_queue_table& table) noexcept
+              : counter_(table.readers_[get_worker_thread_num() %
+                    num_reader_slots].data_)
+            {
+                counter_.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            ~reader_guard()
+            {
+                counter_.fetch_sub(1, std::memory_order_release);
+            }
+
+            std::atomic<std::size_t>& counter_;
+        };
+
+        static bool less(send_queue const* q, locality const& dest)
+        {
+            return q->destination() < dest;
+        }
+
+        static send_queue* find(snapshot_type const& s, locality const& dest)
+        {
+            auto it = std::lower_bound(s.begin(), s.end(), dest, &less);
+            if (it != s.end() && (*it)->destination() == dest)
+                return *it;
+            return nullptr;
+        }
+
+    public:
+        send_queue_table()
+          : current_(new snapshot_type)
+        {
+            for (auto& reader : readers_)
+                reader.data_.store(0, std::memory_order_relaxed);
+        }
+
+        HPX_NON_COPYABLE(send_queue_table);
+
+        ~send_queue_table()
+        {
+            delete current_.load(std::memory_order_acquire);
+        }
+
+        // return the queue for the given destination, if any
+        send_queue* get(locality const& dest)
+        {
+            reader_guard g(*this);
+            return find(*current_.load(std::memory_order_seq_cst), dest);
+        }
+
+        // return the queue for the given destination, create a new one if
+        // needed
+        send_queue* get_or_create(locality const& dest)
+        {
+            send_queue* q = get(dest);
+            if (q != nullptr)
+                return q;
+
+            std::lock_guard<mutex_type> l(mtx_);
+
+            snapshot_type* current = current_.load(std::memory_order_relaxed);
+            q = find(*current, dest);
+            if (q != nullptr)
+                return q;
+
+            queues_.emplace_back(new send_queue(dest));
+            q = queues_.back().get();
+
+            std::unique_ptr<snapshot_type> s(new snapshot_type);
+            s->reserve(current->size() + 1);
+            auto it =
+                std::lower_bound(current->begin(), current->end(), dest, &less);
+            s->insert(s->end(), current->begin(), it);
+            s->push_back(q);
+            s->insert(s->end(), it, current->end());
+
+            current_.store(s.release(), std::memory_order_seq_cst);
+            retired_.emplace_back(current);
+
+            reclaim();
+            return q;
+        }
+
+        // invoke the given function for all known queues
+        template <typename F>
+        void for_each(F&& f)
+        {
+            reader_guard g(*this);
+            for (send_queue* q : *current_.load(std::memory_order_seq_cst))
+            {
+                f(*q);
+            }
+        }
+
+    private:
+        // delete replaced snapshots if there are no active readers
+        void reclaim()
+        {
+            for (auto const& reader : readers_)
+            {
+                if (reader.data_.load(std::memory_order_seq_cst) != 0)
+                    return;
+            }
+            retired_.clear();
+        }
+
+    private:
+        std::atomic<snapshot_type*> current_;
+        std::array<util::cache_line_data<std::atomic<std::size_t>>,
+            num_reader_slots>
+            readers_;
+
+        mutex_type mtx_;
+        std::vector<std::unique_ptr<send_queue>> queues_;
+        std::vector<std::unique_ptr<snapshot_type>> retired_;
+    };
+}}}
+
+#endif
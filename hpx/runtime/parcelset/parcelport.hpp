@@ -245,7 +245,8 @@ namespace hpx { namespace parcelset
         std::int64_t get_buffer_allocate_time_sent(bool reset);
         std::int64_t get_buffer_allocate_time_received(bool reset);
 
-        std::int64_t get_pending_parcels_count(bool /*reset*/);
+        /// Return the number of parcels which are waiting to be sent
+        virtual std::int64_t get_pending_parcels_count(bool reset) = 0;
 
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
         // same as above, just separated data for each action
@@ -335,18 +336,6 @@ namespace hpx { namespace parcelset
 
         hpx::applier::applier *applier_;
 
-        /// The cache for pending parcels
-        typedef util::tuple<
-            std::vector<parcel>
-          , std::vector<write_handler_type>
-        > map_second_type;
-        typedef std::map<locality, map_second_type> pending_parcels_map;
-        pending_parcels_map pending_parcels_;
-
-        typedef std::set<locality> pending_parcels_destinations;
-        pending_parcels_destinations parcel_destinations_;
-        std::atomic<std::uint32_t> num_parcel_destinations_;
-
         /// The local locality
         locality here_;
 
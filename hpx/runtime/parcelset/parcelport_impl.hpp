@@ -20,6 +20,7 @@
 #include <hpx/runtime_local/config_entry.hpp>
 #include <hpx/runtime/parcelset/detail/call_for_each.hpp>
 #include <hpx/runtime/parcelset/detail/parcel_await.hpp>
+#include <hpx/runtime/parcelset/detail/send_queue.hpp>
 #include <hpx/runtime/parcelset/encode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/modules/threading.hpp>
@@ -121,6 +122,7 @@ namespace hpx { namespace parcelset
           , max_background_thread_(hpx::util::from_string<std::size_t>(
                 hpx::get_config_entry("hpx.max_background_threads",
                     (std::numeric_limits<std::size_t>::max)())))
+          , num_stalled_destinations_(0)
         {
 #if BOOST_ENDIAN_BIG_BYTE
             std::string endian_out = get_config_entry("hpx.parcel.endian_out", "big");
@@ -186,6 +188,17 @@ namespace hpx { namespace parcelset
                 "parcelport_impl::flush_parcels");
         }
 
+        std::int64_t get_pending_parcels_count(bool /*reset*/) override
+        {
+            std::int64_t count = 0;
+            send_queues_.for_each(
+                [&count](detail::send_queue const& q)
+                {
+                    count += static_cast<std::int64_t>(q.size());
+                });
+            return count;
+        }
+
         void stop(bool blocking = true) override
         {
             flush_parcels();
@@ -228,9 +241,8 @@ namespace hpx { namespace parcelset
                     else
                     {
                         // enqueue the outgoing parcel ...
-                        enqueue_parcel(dest, std::move(p), std::move(f));
-
-                        get_connection_and_send_parcels(dest);
+                        get_connection_and_send_parcels(enqueue_parcel(
+                            dest, std::move(p), std::move(f)));
                     }
                 });
         }
@@ -273,10 +285,8 @@ namespace hpx { namespace parcelset
                     }
                     else
                     {
-                        enqueue_parcels(
-                            dest, std::move(parcels), std::move(handlers));
-
-                        get_connection_and_send_parcels(dest);
+                        get_connection_and_send_parcels(enqueue_parcels(
+                            dest, std::move(parcels), std::move(handlers)));
                     }
                 });
         }
@@ -558,8 +568,9 @@ namespace hpx { namespace parcelset
                 std::vector<write_handler_type> overflow_handlers(
                     std::make_move_iterator(fs + encoded_parcels),
                     std::make_move_iterator(fs + num_parcels));
-                enqueue_parcels(dest_, std::move(overflow_parcels),
-                    std::move(overflow_handlers));
+                this_.mark_stalled(this_.enqueue_parcels(dest_,
+                    std::move(overflow_parcels),
+                    std::move(overflow_handlers)));
             }
         }
 
@@ -614,229 +625,191 @@ namespace hpx { namespace parcelset
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void enqueue_parcel(locality const& locality_id,
+        detail::send_queue& enqueue_parcel(locality const& locality_id,
             parcel&& p, write_handler_type&& f)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking<
-                std::unique_lock<lcos::local::spinlock>
-            > il(&l);
-
-            mapped_type& e = pending_parcels_[locality_id];
-            util::get<0>(e).push_back(std::move(p));
-            util::get<1>(e).push_back(std::move(f));
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            detail::send_queue& q = *send_queues_.get_or_create(locality_id);
+            q.enqueue(std::move(p), std::move(f));
+            return q;
         }
 
-        void enqueue_parcels(locality const& locality_id,
+        detail::send_queue& enqueue_parcels(locality const& locality_id,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
         {
-            using mapped_type = pending_parcels_map::mapped_type;
-
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking<
-                std::unique_lock<lcos::local::spinlock>
-            > il(&l);
-
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
-            if (util::get<0>(e).empty())
-            {
-                HPX_ASSERT(util::get<1>(e).empty());
-                std::swap(util::get<0>(e), parcels);
-                std::swap(util::get<1>(e), handlers);
-            }
-            else
-            {
-                HPX_ASSERT(util::get<0>(e).size() == util::get<1>(e).size());
-                std::size_t new_size = util::get<0>(e).size() + parcels.size();
-                util::get<0>(e).reserve(new_size);
-
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(util::get<0>(e)));
-                util::get<1>(e).reserve(new_size);
-                std::move(handlers.begin(), handlers.end(),
-                    std::back_inserter(util::get<1>(e)));
-            }
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            detail::send_queue& q = *send_queues_.get_or_create(locality_id);
+            q.enqueue(std::move(parcels), std::move(handlers));
+            return q;
         }
 
         bool dequeue_parcels(locality const& locality_id,
             std::vector<parcel>& parcels,
             std::vector<write_handler_type>& handlers)
         {
-            using iterator = pending_parcels_map::iterator;
-
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
+            HPX_ASSERT(parcels.empty() && handlers.empty());
 
-                if (!l) return false;
+            detail::send_queue* q = send_queues_.get(locality_id);
 
-                iterator it = pending_parcels_.find(locality_id);
+            // do nothing if parcels are being picked up by another thread
+            if (q == nullptr || !q->try_acquire_drainer())
+                return false;
 
-                // do nothing if parcels have already been picked up by
-                // another thread
-                if (it != pending_parcels_.end() && !util::get<0>(it->second).empty())
-                {
-                    HPX_ASSERT(it->first == locality_id);
-                    HPX_ASSERT(handlers.size() == 0);
-                    HPX_ASSERT(handlers.size() == parcels.size());
-                    std::swap(parcels, util::get<0>(it->second));
-                    HPX_ASSERT(util::get<0>(it->second).size() == 0);
-                    std::swap(handlers, util::get<1>(it->second));
-                    HPX_ASSERT(handlers.size() == parcels.size());
-
-                    HPX_ASSERT(!handlers.empty());
-                }
-                else
+            try
+            {
+                if (q->dequeue())
                 {
-                    HPX_ASSERT(util::get<1>(it->second).empty());
-                    return false;
+                    std::swap(parcels, q->parcels());
+                    std::swap(handlers, q->handlers());
+                    q->sent(parcels.size());
                 }
+            }
+            catch (...)
+            {
+                q->release_drainer();
+                throw;
+            }
+            q->release_drainer();
 
-                parcel_destinations_.erase(locality_id);
-
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
+            HPX_ASSERT(handlers.size() == parcels.size());
+            return !parcels.empty();
+        }
 
-                return true;
-            }
+        // remember to retry sending the parcels of the given queue from
+        // the background work
+        void mark_stalled(detail::send_queue& q)
+        {
+            if (q.mark_stalled())
+                ++num_stalled_destinations_;
         }
 
     protected:
         bool dequeue_parcel(locality& dest, parcel& p, write_handler_type& handler)
         {
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
-
-                if (!l) return false;
-
-                for (auto &pending: pending_parcels_)
+            bool result = false;
+            send_queues_.for_each(
+                [&](detail::send_queue& q)
                 {
-                    auto &parcels = util::get<0>(pending.second);
-                    if (!parcels.empty())
+                    if (result || q.empty() || !q.try_acquire_drainer())
+                        return;
+
+                    try
                     {
-                        auto& handlers = util::get<1>(pending.second);
-                        dest = pending.first;
-                        p = std::move(parcels.back());
-                        parcels.pop_back();
-                        handler = std::move(handlers.back());
-                        handlers.pop_back();
-
-                        if (parcels.empty())
+                        if (q.dequeue())
                         {
-                            pending_parcels_.erase(dest);
+                            dest = q.destination();
+                            p = std::move(q.parcels().back());
+                            q.parcels().pop_back();
+                            handler = std::move(q.handlers().back());
+                            q.handlers().pop_back();
+                            q.sent(1);
+                            result = true;
                         }
-                        return true;
                     }
-                }
-            }
-            return false;
+                    catch (...)
+                    {
+                        q.release_drainer();
+                        throw;
+                    }
+                    q.release_drainer();
+                });
+            return result;
         }
 
         bool trigger_pending_work()
         {
-            if (0 == num_parcel_destinations_.load(std::memory_order_relaxed))
+            if (0 == num_stalled_destinations_.load(std::memory_order_relaxed))
                 return true;
 
-            std::vector<locality> destinations;
-
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
-                if(l.owns_lock())
+            // Create new HPX threads which send the parcels that are still
+            // pending.
+            send_queues_.for_each(
+                [this](detail::send_queue& q)
                 {
-                    if (parcel_destinations_.empty())
-                        return true;
-
-                    destinations.reserve(parcel_destinations_.size());
-                    for (locality const& loc : parcel_destinations_)
+                    if (q.clear_stalled())
                     {
-                        destinations.push_back(loc);
-                    }
-                }
-            }
+                        HPX_ASSERT(0 != num_stalled_destinations_.load());
+                        --num_stalled_destinations_;
 
-            // Create new HPX threads which send the parcels that are still
-            // pending.
-            for (locality const& loc : destinations)
-            {
-                get_connection_and_send_parcels(loc);
-            }
+                        get_connection_and_send_parcels(q);
+                    }
+                });
 
             return true;
         }
 
     private:
         ///////////////////////////////////////////////////////////////////////
-        void get_connection_and_send_parcels(
-            locality const& locality_id, bool background = false)
+        void get_connection_and_send_parcels(detail::send_queue& q)
         {
-
             if (connection_handler_traits<ConnectionHandler>::
                     send_immediate_parcels::value)
             {
                 this->send_immediate_impl<ConnectionHandler>(
-                    *this, locality_id, nullptr, nullptr, 0);
-                return;
-            }
+                    *this, q.destination(), nullptr, nullptr, 0);
 
-            // If one of the sending threads are in suspended state, we
-            // need to force a new connection to avoid deadlocks.
-            bool force_connection = true;
-
-            error_code ec;
-            std::shared_ptr<connection> sender_connection =
-                get_connection(locality_id, force_connection, ec);
-
-            if (!sender_connection)
-            {
-                // We can safely return if no connection is available
-                // at this point. As soon as a connection becomes
-                // available it checks for pending parcels and sends
-                // those out.
+                if (!q.empty())
+                    mark_stalled(q);
                 return;
             }
 
-            // repeat until no more parcels are to be sent
-            std::vector<parcel> parcels;
-            std::vector<write_handler_type> handlers;
-
-            if(!dequeue_parcels(locality_id, parcels, handlers))
+            // Only one thread at a time sends the parcels of a destination.
+            // If another thread is already sending, it will pick up all
+            // parcels enqueued in the meantime.
+            while (q.try_acquire_drainer())
             {
-                // Give this connection back to the cache as we couldn't dequeue
-                // parcels.
-                connection_cache_.reclaim(locality_id, sender_connection);
+                bool has_parcels = false;
+                std::shared_ptr<connection> sender_connection;
+                try
+                {
+                    has_parcels = q.dequeue();
+                    if (has_parcels)
+                    {
+                        // If one of the sending threads are in suspended
+                        // state, we need to force a new connection to avoid
+                        // deadlocks.
+                        bool force_connection = true;
+
+                        error_code ec;
+                        sender_connection = get_connection(
+                            q.destination(), force_connection, ec);
+                    }
+                }
+                catch (...)
+                {
+                    // parcels left in the queue are retried from the
+                    // background work
+                    fail_pending_parcels(q, std::current_exception());
+                    mark_stalled(q);
+                    return;
+                }
 
-                return;
-            }
+                if (has_parcels)
+                {
+                    if (!sender_connection)
+                    {
+                        // The parcels are sent from the background work as
+                        // soon as a connection becomes available.
+                        q.release_drainer();
+                        mark_stalled(q);
+                        return;
+                    }
 
-            // send parcels if they didn't get sent by another connection
-            send_pending_parcels(
-                locality_id,
-                sender_connection, std::move(parcels),
-                std::move(handlers));
+                    // the drainer owns the connection until all parcels
+                    // have been sent
+                    send_pending_parcels(q, std::move(sender_connection));
+                    return;
+                }
 
-            // We yield here for a short amount of time to give another
-            // HPX thread the chance to put a subsequent parcel which
-            // leads to a more effective parcel buffering
-            //             hpx::execution_base::this_thread::yield();
+                // Parcels may have been enqueued while we were checking the
+                // queue. Their senders could not take over.
+                q.release_drainer();
+                if (!q.has_queued())
+                    return;
+            }
         }
 
-
         void send_pending_parcels_trampoline(
             boost::system::error_code const& ec,
             locality const& locality_id,
@@ -848,36 +821,39 @@ namespace hpx { namespace parcelset
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             sender_connection->set_state(connection::state_scheduled_thread);
 #endif
-            if (!ec)
-            {
-                // Give this connection back to the cache as it's not
-                // needed anymore.
-                connection_cache_.reclaim(locality_id, sender_connection);
-            }
-            else
+            detail::send_queue* q = send_queues_.get(locality_id);
+            HPX_ASSERT(q != nullptr && q->is_draining());
+
+            if (ec)
             {
                 // remove this connection from cache
                 connection_cache_.clear(locality_id, sender_connection);
+
+                q->release_drainer();
+                if (!q->empty())
+                    get_connection_and_send_parcels(*q);
+                return;
             }
-            {
-                std::lock_guard<lcos::local::spinlock> l(mtx_);
 
-//                HPX_ASSERT(locality_id == sender_connection->destination());
-                pending_parcels_map::iterator it = pending_parcels_.find(locality_id);
-                if (it == pending_parcels_.end() || util::get<0>(it->second).empty())
-                    return;
+            // Send all parcels enqueued while the previous write operation
+            // was in flight using the same connection.
+            if (q->dequeue())
+            {
+                send_pending_parcels(*q, std::move(sender_connection));
+                return;
             }
 
-            // Create a new HPX thread which sends parcels that are still
-            // pending.
-            get_connection_and_send_parcels(locality_id);
+            // Give this connection back to the cache as it's not needed
+            // anymore.
+            connection_cache_.reclaim(locality_id, sender_connection);
+
+            q->release_drainer();
+            if (q->has_queued())
+                get_connection_and_send_parcels(*q);
         }
 
-        void send_pending_parcels(
-            parcelset::locality const & parcel_locality_id,
-            std::shared_ptr<connection> sender_connection,
-            std::vector<parcel>&& parcels,
-            std::vector<write_handler_type>&& handlers)
+        void send_pending_parcels(detail::send_queue& q,
+            std::shared_ptr<connection> sender_connection)
         {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             sender_connection->set_state(connection::state_send_pending);
@@ -885,61 +861,119 @@ namespace hpx { namespace parcelset
 
 #if defined(HPX_DEBUG)
             // verify the connection points to the right destination
-//            HPX_ASSERT(parcel_locality_id == sender_connection->destination());
-            sender_connection->verify_(parcel_locality_id);
+            sender_connection->verify_(q.destination());
 #endif
+            std::vector<parcel>& parcels = q.parcels();
+            std::vector<write_handler_type>& handlers = q.handlers();
+
             // encode the parcels
-            std::size_t num_parcels = encode_parcels(*this, &parcels[0],
+            std::size_t num_parcels = 0;
+            try
+            {
+                num_parcels = encode_parcels(*this, &parcels[0],
                     parcels.size(), sender_connection->buffer_,
                     archive_flags_,
                     this->get_max_outbound_message_size());
+                if (num_parcels == 0)
+                {
+                    HPX_THROW_EXCEPTION(serialization_error,
+                        "parcelport_impl::send_pending_parcels",
+                        "could not encode the parcels to send");
+                }
+            }
+            catch (...)
+            {
+                send_pending_parcels_failed(q, std::move(sender_connection),
+                    std::current_exception());
+                return;
+            }
+
+            std::vector<parcel> handled_parcels;
+            std::vector<write_handler_type> handled_handlers;
 
-            using hpx::parcelset::detail::call_for_each;
             if (num_parcels == parcels.size())
             {
-                ++operations_in_flight_;
                 // send all of the parcels
-                sender_connection->async_write(
-                    call_for_each(std::move(handlers), std::move(parcels)),
-                    util::bind_front(&parcelport_impl::send_pending_parcels_trampoline,
-                        this));
+                std::swap(handled_parcels, parcels);
+                std::swap(handled_handlers, handlers);
             }
             else
             {
-                ++operations_in_flight_;
-                // NOLINTNEXTLINE(bugprone-use-after-move)
                 HPX_ASSERT(num_parcels < parcels.size());
 
-                std::vector<write_handler_type> handled_handlers;
+                // send only part of the parcels, the remaining parcels stay
+                // with the drainer and are sent with the next batch
                 handled_handlers.reserve(num_parcels);
-
                 std::move(handlers.begin(), handlers.begin()+num_parcels,
                     std::back_inserter(handled_handlers));
 
-                std::vector<parcel> handled_parcels;
                 handled_parcels.reserve(num_parcels);
-
                 std::move(parcels.begin(), parcels.begin()+num_parcels,
                     std::back_inserter(handled_parcels));
 
-                // send only part of the parcels
-                sender_connection->async_write(
-                    call_for_each(
-                        std::move(handled_handlers), std::move(handled_parcels)),
-                    util::bind_front(&parcelport_impl::send_pending_parcels_trampoline,
-                        this));
-
-                // give back unhandled parcels
                 parcels.erase(parcels.begin(), parcels.begin()+num_parcels);
                 handlers.erase(handlers.begin(), handlers.begin()+num_parcels);
+            }
 
-                enqueue_parcels(parcel_locality_id, std::move(parcels),
-                    std::move(handlers));
+            // the queue may not be touched anymore once the write operation
+            // was started
+            ++operations_in_flight_;
+            q.sent(num_parcels);
+
+            detail::call_for_each handled(
+                std::move(handled_handlers), std::move(handled_parcels));
+            try
+            {
+                sender_connection->async_write(std::move(handled),
+                    util::bind_front(
+                        &parcelport_impl::send_pending_parcels_trampoline,
+                        this));
+            }
+            catch (...)
+            {
+                // the write operation was not started, the parcels of this
+                // batch are reported as failed unless the connection has
+                // taken them over already
+                --operations_in_flight_;
+
+                std::exception_ptr e = std::current_exception();
+                handled(hpx::make_error_code(e));
+                send_pending_parcels_failed(
+                    q, std::move(sender_connection), e);
+                return;
             }
 
             hpx::execution_base::this_thread::yield();
         }
 
+        // Report the error to the senders of all parcels owned by the drainer
+        // of the given queue and release the queue.
+        void fail_pending_parcels(
+            detail::send_queue& q, std::exception_ptr const& e)
+        {
+            std::vector<parcel> parcels;
+            std::vector<write_handler_type> handlers;
+            std::swap(parcels, q.parcels());
+            std::swap(handlers, q.handlers());
+            q.sent(parcels.size());
+            q.release_drainer();
+
+            detail::call_for_each(std::move(handlers), std::move(parcels))(
+                hpx::make_error_code(e));
+        }
+
+        void send_pending_parcels_failed(detail::send_queue& q,
+            std::shared_ptr<connection> sender_connection,
+            std::exception_ptr const& e)
+        {
+            // the state of the connection is unknown, don't reuse it
+            connection_cache_.clear(q.destination(), sender_connection);
+
+            fail_pending_parcels(q, e);
+            if (q.has_queued())
+                get_connection_and_send_parcels(q);
+        }
+
     public:
         std::size_t get_next_num_thread()
         {
@@ -960,6 +994,10 @@ namespace hpx { namespace parcelset
 
         std::atomic<std::size_t> num_thread_;
         std::size_t const max_background_thread_;
+
+        /// The queues of the parcels waiting to be sent, one per destination
+        detail::send_queue_table send_queues_;
+        std::atomic<std::size_t> num_stalled_destinations_;
     };
 }}
 
@@ -0,0 +1,149 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/threading_base/thread_pool_base.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads {
+    /// Limits for the number of processing units a pool managed by an
+    /// \a elastic_pool_policy may run on at any point in time.
+    struct elastic_pool_parameters
+    {
+        std::size_t min_cores = 1;
+        std::size_t max_cores = std::size_t(-1);
+    };
+
+    /// The elastic_pool_policy automatically lends processing units between
+    /// thread pools which share them.
+    ///
+    /// Processing units are shared between pools by adding them to several
+    /// pools using resource::partitioner::add_resource(pu, pool, false) (which
+    /// requires the partitioner to be created with
+    /// resource::mode_allow_dynamic_pools). Each shared processing unit is
+    /// owned by the first pool (in the order of add_pool) it has been
+    /// assigned to, it is suspended in all other pools when the policy is
+    /// started. Shared processing units are lent to pools which would
+    /// otherwise start with less than their \a min_cores processing units.
+    /// All managed pools have to be created with
+    /// threads::policies::enable_elasticity set.
+    ///
+    /// A monitor running on a dedicated OS-thread samples the pending-queue
+    /// length and the number of idle cores of every managed pool. A
+    /// processing unit is lent from an idle pool to an overloaded pool if
+    /// both have been in their respective state for at least \a hysteresis
+    /// consecutive samples. Lent processing units are reclaimed at the first
+    /// sample at which the owning pool has pending work, as long as this
+    /// does not leave the borrowing pool with less than its \a min_cores
+    /// processing units.
+    ///
+    /// \note Moving a processing unit, including reclaiming it, is not
+    ///       immediate. The monitor thread suspends the processing unit in
+    ///       the pool currently holding it and waits for it to stop running
+    ///       that pool's work before resuming it in the other pool.
+    ///
+    /// \note stop() has to be called (or the policy has to be destroyed)
+    ///       before the runtime is shut down.
+    class HPX_EXPORT elastic_pool_policy
+    {
+    public:
+        HPX_NON_COPYABLE(elastic_pool_policy);
+
+    public:
+        explicit elastic_pool_policy(
+            std::chrono::microseconds interval = std::chrono::microseconds(
+                1000),
+            std::size_t hysteresis = 3);
+        ~elastic_pool_policy();
+
+        /// Add the pool with the given name to the set of pools managed by
+        /// this policy. Can be called only before start().
+        void add_pool(std::string const& pool_name,
+            elastic_pool_parameters const& params = elastic_pool_parameters());
+
+        /// Start monitoring the managed pools. The initial assignment of the
+        /// shared processing units is performed asynchronously by the
+        /// monitor thread.
+        void start();
+
+        /// Stop monitoring, returns all lent processing units to their
+        /// owners.
+        void stop();
+
+        bool is_running() const
+        {
+            return monitor_thread_.joinable();
+        }
+
+        /// Return the number of processing units the given pool currently
+        /// runs on, as seen by this policy.
+        std::size_t get_num_cores(std::string const& pool_name) const;
+
+        /// Return the number of processing units moved between pools by this
+        /// policy.
+        std::int64_t get_move_count(bool reset = false);
+
+    private:
+        struct pool_data
+        {
+            thread_pool_base* pool_;
+            elastic_pool_parameters params_;
+            std::size_t active_cores_;
+            std::size_t overloaded_samples_;
+            std::size_t idle_samples_;
+            std::int64_t pending_;
+        };
+
+        struct pu_data
+        {
+            std::size_t pu_num_;
+            std::size_t owner_;
+            std::size_t holder_;
+            // (pool index, virtual core in that pool)
+            std::vector<std::pair<std::size_t, std::size_t>> members_;
+
+            std::size_t virt_core(std::size_t pool) const;
+            bool is_member(std::size_t pool) const;
+        };
+
+        void monitor();
+        void initialize_assignment();
+        void restore_assignment();
+        void sample();
+        void evaluate();
+        bool move_pu(pu_data& pu, std::size_t to);
+
+        std::chrono::microseconds interval_;
+        std::size_t hysteresis_;
+
+        std::vector<pool_data> pools_;
+        std::vector<pu_data> pus_;
+        std::vector<std::atomic<std::size_t>> num_cores_;
+
+        std::thread monitor_thread_;
+        std::mutex mtx_;
+        std::condition_variable cond_;
+        bool stop_requested_;
+
+        std::atomic<std::int64_t> move_count_;
+    };
+
+    /// Return the number of processing units moved between pools by all
+    /// elastic pool policies in this locality.
+    HPX_EXPORT std::int64_t get_elastic_core_move_count(bool reset);
+}}    // namespace hpx::threads
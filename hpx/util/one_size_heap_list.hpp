@@ -1,4 +1,4 @@
-//  Copyright (c) 1998-2017 Hartmut Kaiser
+//  Copyright (c) 1998-2020 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -9,10 +9,13 @@
 
 #include <hpx/config.hpp>
 #include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/util/wrapper_heap_base.hpp>
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -36,6 +39,68 @@ namespace hpx { namespace util
 
         typedef wrapper_heap_base::heap_parameters heap_parameters;
 
+        // Statistics gathered across all heap lists of this locality, these
+        // are exposed as performance counters
+        struct statistics
+        {
+            std::int64_t alloc_count;      // number of allocated objects
+            std::int64_t free_count;       // number of freed objects
+            std::int64_t cache_hits;       // allocations served w/o locking
+            std::int64_t contention_count;    // contended list lock attempts
+        };
+
+        static statistics get_statistics(bool reset);
+
+        // install the performance counters exposing the statistics above
+        static void register_counter_types();
+
+    private:
+        // Every worker thread allocates from the heap it last used. Heaps are
+        // never removed from heap_list_ before the list itself is destroyed,
+        // which allows to keep raw pointers here. The worker's NUMA domain is
+        // cached as well, it is used to prefer heaps whose memory was touched
+        // first by workers on the same NUMA domain.
+        struct worker_data
+        {
+            worker_data()
+              : heap_(nullptr)
+              , numa_domain_(std::size_t(-1))
+              , alloc_count_(0)
+              , free_count_(0)
+              , cache_hits_(0)
+              , contention_count_(0)
+            {
+            }
+
+            std::atomic<util::wrapper_heap_base*> heap_;
+            std::atomic<std::size_t> numa_domain_;
+
+            std::atomic<std::int64_t> alloc_count_;
+            std::atomic<std::int64_t> free_count_;
+            std::atomic<std::int64_t> cache_hits_;
+            std::atomic<std::int64_t> contention_count_;
+        };
+
+        typedef util::cache_aligned_data_derived<worker_data>
+            cached_worker_data;
+
+        cached_worker_data* get_worker_data() const;
+        static std::size_t get_numa_domain(cached_worker_data& data);
+
+        void* try_alloc_cached(cached_worker_data& data, std::size_t count);
+        bool try_free_cached(
+            cached_worker_data& data, void* p, std::size_t count);
+
+        // allocate per-worker data and register this list for statistics
+        void initialize();
+
+        void accumulate_statistics(statistics& stats, bool reset) const;
+
+    protected:
+        // Return the heap cached for the current worker if it owns the given
+        // pointer
+        util::wrapper_heap_base* get_cached_heap(void* p) const;
+
     private:
         template <typename Heap>
         static std::shared_ptr<util::wrapper_heap_base> create_heap(
@@ -53,13 +118,11 @@ namespace hpx { namespace util
         one_size_heap_list()
             : class_name_()
 #if defined(HPX_DEBUG)
-            , alloc_count_(0)
-            , free_count_(0)
             , heap_count_(0)
-            , max_alloc_count_(0)
 #endif
             , create_heap_(nullptr)
             , parameters_({0, 0, 0})
+            , num_workers_(0)
         {
             HPX_ASSERT(false); // shouldn't ever be called
         }
@@ -69,28 +132,28 @@ namespace hpx { namespace util
                 heap_parameters parameters, Heap* = nullptr)
             : class_name_(class_name)
 #if defined(HPX_DEBUG)
-            , alloc_count_(0L)
-            , free_count_(0L)
             , heap_count_(0L)
-            , max_alloc_count_(0L)
 #endif
             , create_heap_(&one_size_heap_list::create_heap<Heap>)
             , parameters_(parameters)
-        {}
+            , num_workers_(0)
+        {
+            initialize();
+        }
 
         template <typename Heap>
         explicit one_size_heap_list(std::string const& class_name,
                 heap_parameters parameters, Heap* = nullptr)
             : class_name_(class_name)
 #if defined(HPX_DEBUG)
-            , alloc_count_(0L)
-            , free_count_(0L)
             , heap_count_(0L)
-            , max_alloc_count_(0L)
 #endif
             , create_heap_(&one_size_heap_list::create_heap<Heap>)
             , parameters_(parameters)
-        {}
+            , num_workers_(0)
+        {
+            initialize();
+        }
 
         ~one_size_heap_list() noexcept;
 
@@ -115,15 +178,16 @@ namespace hpx { namespace util
 
     public:
 #if defined(HPX_DEBUG)
-        std::size_t alloc_count_;
-        std::size_t free_count_;
         std::size_t heap_count_;
-        std::size_t max_alloc_count_;
 #endif
         std::shared_ptr<util::wrapper_heap_base> (*create_heap_)(
             char const*, std::size_t, heap_parameters);
 
         heap_parameters const parameters_;
+
+    private:
+        std::size_t num_workers_;
+        std::unique_ptr<cached_worker_data[]> worker_data_;
     };
 }}
 
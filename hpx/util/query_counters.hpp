@@ -100,6 +100,17 @@ namespace hpx { namespace util {
         template <typename Stream>
         void print_name_csv_short(Stream& out, std::string const& name);
 
+        // support for the OpenMetrics text format: the counter values are
+        // sampled into a compact buffer which is written in batches
+        bool sample_openmetrics_counters(bool destination_is_cout, bool reset,
+            bool no_output, bool flush,
+            std::vector<performance_counters::counter_info> const& infos,
+            error_code& ec);
+        void print_openmetrics(bool destination_is_cout,
+            std::vector<performance_counters::counter_info> const& infos,
+            error_code& ec);
+        void flush_openmetrics(error_code& ec = throws);
+
     private:
         typedef lcos::local::mutex mutex_type;
         mutex_type mtx_;
@@ -117,6 +128,14 @@ namespace hpx { namespace util {
 
         interval_timer timer_;
 
+        // samples collected in OpenMetrics mode which were not written yet,
+        // one row of scalar values and one set of array values per sample
+        std::size_t batch_size_;
+        std::vector<double> sample_times_;
+        std::vector<double> sample_values_;
+        std::vector<std::int64_t> sample_arrays_;
+        std::vector<std::size_t> sample_array_offsets_;
+
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         std::map<std::string, util::itt::counter> itt_counters_;
 #endif
@@ -21,7 +21,7 @@
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
+#include <hpx/parallel/util/scan_lookback_partitioner.hpp>
 #include <hpx/type_support/unused.hpp>
 
 #include <algorithm>
@@ -110,61 +110,43 @@ namespace hpx { namespace parallel { inline namespace v1 {
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 3
-                // steps. The first calculates the scan results for each
-                // partition. The second accumulates the result from left to
-                // right to be used by the third step--which operates on the
-                // same partitions the first step operated on.
+                // The overall scan algorithm is performed in a single pass
+                // over the partitions. Each partition is either scanned
+                // directly if the prefix of all preceding partitions is
+                // known, or it is reduced first and its prefix is determined
+                // by looking back at the results of the preceding partitions.
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
 
-                auto f3 = [op, policy](zip_iterator part_begin,
-                              std::size_t part_size, hpx::shared_future<T> curr,
-                              hpx::shared_future<T> next) {
-                    HPX_UNUSED(policy);
-
-                    next.get();    // rethrow exceptions
-
-                    T val = curr.get();
-                    FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
-
-                    // MSVC 2015 fails if op is captured by reference
-                    util::loop_n<ExPolicy>(
-                        dst, part_size, [=, &val](FwdIter2 it) {
-                            *it = hpx::util::invoke(op, val, *it);
-                        });
-                };
-
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
-                    std::forward<ExPolicy>(policy),
+                return util::scan_lookback_partitioner<ExPolicy,
+                    FwdIter2>::call(std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
-                    // step 1 performs first part of scan algorithm
-                    [op, last, conv = std::forward<Conv>(conv)](
+                    // step 1 reduces a partition without writing any output
+                    [op, conv](
                         zip_iterator part_begin, std::size_t part_size) -> T {
-                        T part_init =
-                            hpx::util::invoke(conv, get<0>(*part_begin));
-                        get<1>(*part_begin++) = part_init;
-
-                        auto iters = part_begin.get_iterator_tuple();
-                        if (get<0>(iters) != last)
+                        FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
+                        T val = hpx::util::invoke(conv, *it);
+                        for (++it; --part_size != 0; ++it)
                         {
-                            return sequential_inclusive_scan_n(get<0>(iters),
-                                part_size - 1, get<1>(iters), part_init, op,
-                                conv);
+                            val = hpx::util::invoke(
+                                op, val, hpx::util::invoke(conv, *it));
                         }
-                        return part_init;
+                        return val;
+                    },
+                    // step 2 combines the partition results from left to
+                    // right
+                    op,
+                    // step 3 scans a partition using the prefix of all
+                    // preceding partitions
+                    [op, conv](zip_iterator part_begin, std::size_t part_size,
+                        T const& prefix) -> T {
+                        auto iters = part_begin.get_iterator_tuple();
+                        return sequential_inclusive_scan_n(get<0>(iters),
+                            part_size, get<1>(iters), prefix, op, conv);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final accumulation on each partition
-                    std::move(f3),
                     // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T>>&&,
-                        std::vector<hpx::future<void>>&&) {
-                        return final_dest;
-                    });
+                    [final_dest]() -> FwdIter2 { return final_dest; });
             }
         };
 
@@ -21,7 +21,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
+#include <hpx/parallel/util/scan_lookback_partitioner.hpp>
 #include <hpx/type_support/unused.hpp>
 
 #include <algorithm>
@@ -111,53 +111,44 @@ namespace hpx { namespace parallel { inline namespace v1 {
                 FwdIter2 final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 2
-                // subsequent parallel steps. The first calculates the scan
-                // results for each partition and the second produces the
-                // overall result
+                // The overall scan algorithm is performed in a single pass
+                // over the partitions. Each partition is either scanned
+                // directly if the prefix of all preceding partitions is
+                // known, or it is reduced first and its prefix is determined
+                // by looking back at the results of the preceding partitions.
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
 
-                auto f3 = [op](zip_iterator part_begin, std::size_t part_size,
-                              hpx::shared_future<T> curr,
-                              hpx::shared_future<T> next) -> void {
-                    next.get();    // rethrow exceptions
-
-                    T val = curr.get();
-                    FwdIter2 dst = get<1>(part_begin.get_iterator_tuple());
-
-                    util::loop_n<ExPolicy>(
-                        dst, part_size, [&op, &val](FwdIter2 it) -> void {
-                            *it = hpx::util::invoke(op, *it, val);
-                        });
-                };
-
-                return util::scan_partitioner<ExPolicy, FwdIter2, T>::call(
-                    std::forward<ExPolicy>(policy),
+                return util::scan_lookback_partitioner<ExPolicy,
+                    FwdIter2>::call(std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, dest), count, init,
-                    // step 1 performs first part of scan algorithm
+                    // step 1 reduces a partition without writing any output
                     [op, conv](
                         zip_iterator part_begin, std::size_t part_size) -> T {
-                        T part_init =
-                            hpx::util::invoke(conv, get<0>(*part_begin));
-                        get<1>(*part_begin++) = part_init;
-
+                        FwdIter1 it = get<0>(part_begin.get_iterator_tuple());
+                        T val = hpx::util::invoke(conv, *it);
+                        for (++it; --part_size != 0; ++it)
+                        {
+                            val = hpx::util::invoke(
+                                op, val, hpx::util::invoke(conv, *it));
+                        }
+                        return val;
+                    },
+                    // step 2 combines the partition results from left to
+                    // right
+                    op,
+                    // step 3 scans a partition using the prefix of all
+                    // preceding partitions
+                    [op, conv](zip_iterator part_begin, std::size_t part_size,
+                        T const& prefix) -> T {
                         auto iters = part_begin.get_iterator_tuple();
                         return sequential_transform_inclusive_scan_n(
-                            get<0>(iters), part_size - 1, get<1>(iters), conv,
-                            part_init, op);
+                            get<0>(iters), part_size, get<1>(iters), conv,
+                            prefix, op);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapping(op),
-                    // step 3 runs final accumulation on each partition
-                    std::move(f3),
                     // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T>>&&,
-                        std::vector<hpx::future<void>> &&) -> FwdIter2 {
-                        return final_dest;
-                    });
+                    [final_dest]() -> FwdIter2 { return final_dest; });
             }
         };
 
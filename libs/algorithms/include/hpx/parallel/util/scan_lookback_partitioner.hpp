@@ -0,0 +1,475 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/datastructures/tuple.hpp>
+#include <hpx/execution_base/this_thread.hpp>
+#include <hpx/functional/invoke.hpp>
+#include <hpx/iterator_support/range.hpp>
+#include <hpx/modules/errors.hpp>
+#if !defined(HPX_COMPUTE_DEVICE_CODE)
+#include <hpx/async_combinators/wait_all.hpp>
+#endif
+
+#include <hpx/execution/executors/execution.hpp>
+#include <hpx/execution/executors/execution_parameters.hpp>
+#include <hpx/executors/execution_policy.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/chunk_size.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
+#include <hpx/parallel/util/detail/select_partitioner.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace util {
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // The values a chunk publishes to its successors. The status is
+        // written only by the worker owning the chunk, the values are written
+        // before the status is released and are never changed afterwards.
+        template <typename T>
+        struct scan_lookback_chunk
+        {
+            enum status_type
+            {
+                invalid = 0,
+                aggregate_available = 1,
+                prefix_available = 2,
+                failed = 3
+            };
+
+            scan_lookback_chunk()
+              : status_(invalid)
+            {
+            }
+
+            std::atomic<int> status_;
+            hpx::util::optional<T> aggregate_;    // reduction of this chunk
+            hpx::util::optional<T> prefix_;       // inclusive prefix
+            std::exception_ptr error_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Shared state of all workers of a single-pass scan. Every worker
+        // owns a contiguous range of chunks, the ranges are assigned in
+        // order. A chunk a worker looks back at is owned either by the same
+        // worker or by one of its predecessors, all of which eventually
+        // publish their values.
+        template <typename FwdIter, typename T, typename F1, typename Op,
+            typename F3>
+        struct scan_lookback_state
+        {
+            using chunk_type = scan_lookback_chunk<T>;
+            using padded_chunk_type =
+                hpx::util::cache_aligned_data_derived<chunk_type>;
+
+            scan_lookback_state(T const& init, F1& f1, Op& op, F3& f3)
+              : init_(init)
+              , f1_(f1)
+              , op_(op)
+              , f3_(f3)
+              , num_workers_(0)
+              , stop_(false)
+            {
+            }
+
+            void allocate_chunks(std::size_t num_workers)
+            {
+                chunks_.reset(new padded_chunk_type[shape_.size()]);
+                num_workers_ = num_workers;
+            }
+
+            // index of the first chunk owned by the given worker
+            std::size_t first_chunk(std::size_t worker) const
+            {
+                return worker * shape_.size() / num_workers_;
+            }
+
+            // executed by every worker, processes the chunks owned by it
+            void work(std::size_t worker)
+            {
+                std::size_t const first = first_chunk(worker);
+                std::size_t const last = first_chunk(worker + 1);
+
+                std::size_t i = first;
+                try
+                {
+                    // If the inclusive prefix preceding the range is already
+                    // known, the chunks are scanned right away and their
+                    // elements are read only once.
+                    if (first == 0 ||
+                        chunks_[first - 1].status_.load(
+                            std::memory_order_acquire) ==
+                            chunk_type::prefix_available)
+                    {
+                        T const* prefix = (first == 0) ?
+                            &init_ :
+                            &*chunks_[first - 1].prefix_;
+                        for (/**/; i != last; ++i)
+                        {
+                            if (stop_.load(std::memory_order_relaxed))
+                            {
+                                fail(i, last);
+                                return;
+                            }
+
+                            chunk_type& chunk = chunks_[i];
+                            chunk.prefix_.emplace(f3_(
+                                hpx::util::get<0>(shape_[i]),
+                                hpx::util::get<1>(shape_[i]), *prefix));
+                            publish(chunk, chunk_type::prefix_available);
+                            prefix = &*chunk.prefix_;
+                        }
+                        return;
+                    }
+
+                    // Otherwise publish the aggregates of all chunks, which
+                    // allows for the successors to make progress, and look
+                    // back for the exclusive prefix of the range.
+                    for (/**/; i != last; ++i)
+                    {
+                        if (stop_.load(std::memory_order_relaxed))
+                        {
+                            fail(i, last);
+                            return;
+                        }
+
+                        chunk_type& chunk = chunks_[i];
+                        chunk.aggregate_.emplace(f1_(
+                            hpx::util::get<0>(shape_[i]),
+                            hpx::util::get<1>(shape_[i])));
+                        publish(chunk, chunk_type::aggregate_available);
+                    }
+
+                    i = first;
+                    hpx::util::optional<T> const prefix = lookback(first);
+                    if (!prefix)
+                    {
+                        // one of the preceding chunks failed
+                        fail(first, last);
+                        stop_.store(true);
+                        return;
+                    }
+
+                    // publish all inclusive prefixes before scanning
+                    T const* value = &*prefix;
+                    for (/**/; i != last; ++i)
+                    {
+                        chunk_type& chunk = chunks_[i];
+                        chunk.prefix_.emplace(
+                            hpx::util::invoke(op_, *value, *chunk.aggregate_));
+                        publish(chunk, chunk_type::prefix_available);
+                        value = &*chunk.prefix_;
+                    }
+
+                    value = &*prefix;
+                    for (i = first; i != last; ++i)
+                    {
+                        if (stop_.load(std::memory_order_relaxed))
+                            return;
+
+                        f3_(hpx::util::get<0>(shape_[i]),
+                            hpx::util::get<1>(shape_[i]), *value);
+                        value = &*chunks_[i].prefix_;
+                    }
+                }
+                catch (...)
+                {
+                    chunks_[i].error_ = std::current_exception();
+                    fail(i, last);
+                    stop_.store(true);
+                }
+            }
+
+            // Mark the chunks of all workers starting with the given one as
+            // failed, this is used if those could not be launched.
+            void fail_workers(std::size_t worker)
+            {
+                if (!chunks_ || worker >= num_workers_)
+                    return;
+
+                fail(first_chunk(worker), shape_.size());
+                stop_.store(true);
+            }
+
+            template <typename ExPolicy>
+            void collect_errors(std::list<std::exception_ptr>& errors) const
+            {
+                if (!chunks_)
+                    return;
+
+                for (std::size_t i = 0; i != shape_.size(); ++i)
+                {
+                    if (chunks_[i].error_)
+                    {
+                        handle_local_exceptions<ExPolicy>::call(
+                            chunks_[i].error_, errors);
+                    }
+                }
+            }
+
+        private:
+            void publish(chunk_type& chunk, int status)
+            {
+                chunk.status_.store(status, std::memory_order_release);
+            }
+
+            // Every chunk has to publish some status as successors might be
+            // waiting for it. Chunks which already published their prefix
+            // are left alone.
+            void fail(std::size_t first, std::size_t last)
+            {
+                for (/**/; first != last; ++first)
+                {
+                    chunk_type& chunk = chunks_[first];
+                    if (chunk.status_.load(std::memory_order_relaxed) !=
+                        chunk_type::prefix_available)
+                    {
+                        publish(chunk, chunk_type::failed);
+                    }
+                }
+            }
+
+            // Combine the values published by the preceding chunks from right
+            // to left until a chunk with a known inclusive prefix is found.
+            // Returns an empty optional if one of those chunks failed.
+            hpx::util::optional<T> lookback(std::size_t i)
+            {
+                hpx::util::optional<T> prefix;
+                for (std::size_t k = i; k-- != 0; /**/)
+                {
+                    chunk_type& pred = chunks_[k];
+
+                    int status = chunk_type::invalid;
+                    hpx::util::yield_while(
+                        [&]() {
+                            status =
+                                pred.status_.load(std::memory_order_acquire);
+                            return status == chunk_type::invalid;
+                        },
+                        "scan_lookback_partitioner::lookback");
+
+                    if (status == chunk_type::failed)
+                        return hpx::util::optional<T>();
+
+                    T const& value = (status == chunk_type::prefix_available) ?
+                        *pred.prefix_ :
+                        *pred.aggregate_;
+
+                    if (prefix)
+                        prefix.emplace(hpx::util::invoke(op_, value, *prefix));
+                    else
+                        prefix.emplace(value);
+
+                    if (status == chunk_type::prefix_available)
+                        return prefix;
+                }
+
+                // the first chunk always publishes its inclusive prefix
+                HPX_ASSERT(false);
+                return hpx::util::optional<T>();
+            }
+
+        public:
+            std::vector<hpx::util::tuple<FwdIter, std::size_t>> shape_;
+            std::unique_ptr<padded_chunk_type[]> chunks_;
+            T init_;
+
+        private:
+            F1& f1_;
+            Op& op_;
+            F3& f3_;
+
+            std::size_t num_workers_;
+            std::atomic<bool> stop_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The single-pass scan splits the input into chunks, each of the
+        // workers (one per core) processes a contiguous range of those. A
+        // range whose predecessor already knows its inclusive prefix is
+        // scanned directly, all others publish the aggregates of their chunks
+        // first and find their prefix by looking back at the values published
+        // by the preceding chunks (decoupled look-back). Every worker is
+        // passed the iterator of its first chunk, which allows for the
+        // executor to place it close to the data.
+        template <typename ExPolicy, typename R>
+        struct scan_lookback_static_partitioner
+        {
+            using parameters_type = typename ExPolicy::executor_parameters_type;
+            using executor_type = typename ExPolicy::executor_type;
+
+            using scoped_executor_parameters =
+                detail::scoped_executor_parameters_ref<parameters_type,
+                    executor_type>;
+
+            using handle_local_exceptions =
+                detail::handle_local_exceptions<ExPolicy>;
+
+            template <typename ExPolicy_, typename FwdIter, typename T,
+                typename F1, typename Op, typename F3, typename F4>
+            static R call(ExPolicy_ policy, FwdIter first, std::size_t count,
+                T const& init, F1&& f1, Op&& op, F3&& f3, F4&& f4)
+            {
+#if defined(HPX_COMPUTE_DEVICE_CODE)
+                HPX_ASSERT(false);
+                return R();
+#else
+                using state_type = scan_lookback_state<FwdIter, T,
+                    typename std::decay<F1>::type,
+                    typename std::decay<Op>::type,
+                    typename std::decay<F3>::type>;
+
+                // inform parameter traits
+                scoped_executor_parameters scoped_params(
+                    policy.parameters(), policy.executor());
+
+                state_type state(init, f1, op, f3);
+
+                std::vector<hpx::future<void>> workers;
+                std::list<std::exception_ptr> errors;
+                try
+                {
+                    HPX_ASSERT(count > 0);
+
+                    // the chunk used for measuring the chunk size is scanned
+                    // sequentially and becomes part of the initial value
+                    auto test_function = [&](FwdIter it, std::size_t size) {
+                        state.init_ = f3(it, size, state.init_);
+                    };
+
+                    // estimate a chunk size based on number of cores used
+                    typedef typename execution::extract_has_variable_chunk_size<
+                        parameters_type>::type has_variable_chunk_size;
+
+                    std::vector<hpx::future<void>> tested;
+                    auto shape = detail::get_bulk_iteration_shape(
+                        has_variable_chunk_size(), policy, tested,
+                        test_function, first, count, 1);
+
+                    state.shape_.reserve(hpx::util::size(shape));
+                    for (auto const& elem : shape)
+                    {
+                        state.shape_.emplace_back(
+                            hpx::util::get<0>(elem), hpx::util::get<1>(elem));
+                    }
+
+                    std::size_t const cores = execution::processing_units_count(
+                        policy.parameters(), policy.executor());
+                    std::size_t const num_workers =
+                        (std::min)(cores, state.shape_.size());
+
+                    state.allocate_chunks(num_workers);
+
+                    workers.reserve(num_workers);
+                    for (std::size_t i = 0; i != num_workers; ++i)
+                    {
+                        workers.push_back(execution::async_execute(
+                            policy.executor(),
+                            [&state, i](FwdIter) { state.work(i); },
+                            hpx::util::get<0>(
+                                state.shape_[state.first_chunk(i)])));
+                    }
+
+                    scoped_params.mark_end_of_scheduling();
+                }
+                catch (...)
+                {
+                    // the workers which were launched might wait for the
+                    // chunks of the others
+                    state.fail_workers(workers.size());
+
+                    handle_local_exceptions::call(
+                        std::current_exception(), errors);
+                }
+
+                // wait for all workers to finish, they refer to 'state'
+                hpx::wait_all(workers);
+
+                // always rethrow if 'errors' is not empty, if one of the
+                // chunks failed, or if 'workers' has an exceptional future
+                state.template collect_errors<ExPolicy>(errors);
+                handle_local_exceptions::call(workers, errors);
+
+                try
+                {
+                    return f4();
+                }
+                catch (...)
+                {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions::call(std::current_exception());
+                }
+#endif
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename R>
+        struct scan_lookback_task_partitioner
+        {
+            template <typename ExPolicy_, typename FwdIter, typename T,
+                typename F1, typename Op, typename F3, typename F4>
+            static hpx::future<R> call(ExPolicy_&& policy, FwdIter first,
+                std::size_t count, T const& init, F1&& f1, Op&& op, F3&& f3,
+                F4&& f4)
+            {
+                return execution::async_execute(policy.executor(),
+                    [first, count, policy = std::forward<ExPolicy_>(policy),
+                        init, f1 = std::forward<F1>(f1),
+                        op = std::forward<Op>(op), f3 = std::forward<F3>(f3),
+                        f4 = std::forward<F4>(f4)]() mutable -> R {
+                        using partitioner_type =
+                            scan_lookback_static_partitioner<ExPolicy, R>;
+                        return partitioner_type::call(
+                            std::forward<ExPolicy_>(policy), first, count,
+                            init, f1, op, f3, f4);
+                    });
+            }
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Single-pass scan partitioner using decoupled look-back.
+    //
+    // ExPolicy:    execution policy
+    // R:           overall result type
+    //
+    // The partitioner is invoked as
+    //
+    //      call(policy, first, count, init, f1, op, f3, f4)
+    //
+    // f1(it, size) -> T:           reduces the given chunk without writing
+    //                              any output
+    // op(T, T) -> T:               the associative scan operation
+    // f3(it, size, prefix) -> T:   scans the given chunk starting with
+    //                              'prefix', writes the output, and returns
+    //                              the inclusive prefix of the chunk
+    // f4() -> R:                   produces the overall result
+    template <typename ExPolicy, typename R = void>
+    struct scan_lookback_partitioner
+      : detail::select_partitioner<typename std::decay<ExPolicy>::type,
+            detail::scan_lookback_static_partitioner,
+            detail::scan_lookback_task_partitioner>::template apply<R>
+    {
+    };
+}}}    // namespace hpx::parallel::util
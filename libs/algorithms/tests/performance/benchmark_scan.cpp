@@ -0,0 +1,223 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the scan algorithms (inclusive_scan, exclusive_scan,
+// transform_inclusive_scan, and transform_exclusive_scan). Run it with an
+// increasing number of cores (--hpx:threads) to measure their scaling.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_generate.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_transform_scan.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <hpx/modules/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+unsigned int seed = std::random_device{}();
+
+///////////////////////////////////////////////////////////////////////////////
+struct random_fill
+{
+    random_fill()
+      : gen(seed)
+      , dist(0, 100)
+    {
+    }
+
+    std::uint64_t operator()()
+    {
+        return dist(gen);
+    }
+
+    std::mt19937 gen;
+    std::uniform_int_distribution<std::uint64_t> dist;
+};
+
+struct square
+{
+    std::uint64_t operator()(std::uint64_t v) const
+    {
+        return v * v;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+double run_scan_benchmark(int test_count, F&& f)
+{
+    // warm up caches and the thread pool
+    f();
+
+    std::uint64_t time = std::uint64_t(0);
+    for (int i = 0; i < test_count; ++i)
+    {
+        std::uint64_t elapsed = hpx::util::high_resolution_clock::now();
+        f();
+        time += hpx::util::high_resolution_clock::now() - elapsed;
+    }
+
+    return (time * 1e-9) / test_count;
+}
+
+template <typename ExPolicy>
+void run_benchmark(std::string const& name, ExPolicy policy,
+    std::vector<std::uint64_t> const& data, std::vector<std::uint64_t>& dest,
+    int test_count, bool csvoutput)
+{
+    using namespace hpx::parallel;
+
+    auto first = std::begin(data);
+    auto last = std::end(data);
+    auto out = std::begin(dest);
+
+    double time_inclusive = run_scan_benchmark(test_count, [&]() {
+        inclusive_scan(policy, first, last, out, std::plus<std::uint64_t>(),
+            std::uint64_t(0));
+    });
+
+    double time_exclusive = run_scan_benchmark(test_count, [&]() {
+        exclusive_scan(policy, first, last, out, std::uint64_t(0),
+            std::plus<std::uint64_t>());
+    });
+
+    double time_transform_inclusive = run_scan_benchmark(test_count, [&]() {
+        transform_inclusive_scan(policy, first, last, out,
+            std::plus<std::uint64_t>(), square(), std::uint64_t(0));
+    });
+
+    double time_transform_exclusive = run_scan_benchmark(test_count, [&]() {
+        transform_exclusive_scan(policy, first, last, out, std::uint64_t(0),
+            std::plus<std::uint64_t>(), square());
+    });
+
+    std::size_t const os_threads = hpx::get_os_thread_count();
+    if (csvoutput)
+    {
+        hpx::util::format_to(std::cout, "{1},{2},{3},{4},{5},{6},{7}\n", name,
+            os_threads, data.size(), time_inclusive, time_exclusive,
+            time_transform_inclusive, time_transform_exclusive);
+    }
+    else
+    {
+        auto fmt = "{1} ({2}) : {3}(sec)\n";
+        hpx::util::format_to(std::cout, fmt, "inclusive_scan", name,
+            time_inclusive);
+        hpx::util::format_to(std::cout, fmt, "exclusive_scan", name,
+            time_exclusive);
+        hpx::util::format_to(std::cout, fmt, "transform_inclusive_scan", name,
+            time_transform_inclusive);
+        hpx::util::format_to(std::cout, fmt, "transform_exclusive_scan", name,
+            time_transform_exclusive);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::size_t const vector_size = vm["vector_size"].as<std::size_t>();
+    int const test_count = vm["test_count"].as<int>();
+    bool const csvoutput = vm.count("csv_output") != 0;
+
+    if (test_count <= 0)
+    {
+        std::cout << "test_count must be greater than zero...\n";
+        return hpx::finalize();
+    }
+
+    std::vector<std::uint64_t> data(vector_size);
+    std::vector<std::uint64_t> dest(vector_size);
+    std::vector<std::uint64_t> expected(vector_size);
+
+    hpx::parallel::generate(hpx::parallel::execution::par, std::begin(data),
+        std::end(data), random_fill());
+
+    if (!csvoutput)
+    {
+        std::cout << "-------------- Benchmark Config --------------\n";
+        std::cout << "seed        : " << seed << "\n";
+        std::cout << "vector_size : " << vector_size << "\n";
+        std::cout << "test_count  : " << test_count << "\n";
+        std::cout << "os threads  : " << hpx::get_os_thread_count() << "\n";
+        std::cout << "----------------------------------------------\n";
+    }
+
+    // make sure the parallel scan produces the correct results
+    std::partial_sum(std::begin(data), std::end(data), std::begin(expected));
+    hpx::parallel::inclusive_scan(hpx::parallel::execution::par,
+        std::begin(data), std::end(data), std::begin(dest),
+        std::plus<std::uint64_t>(), std::uint64_t(0));
+    HPX_TEST(dest == expected);
+
+    double const time_std = run_scan_benchmark(test_count, [&]() {
+        std::partial_sum(std::begin(data), std::end(data), std::begin(dest));
+    });
+
+    if (csvoutput)
+    {
+        hpx::util::format_to(
+            std::cout, "std,1,{1},{2},,,\n", vector_size, time_std);
+    }
+    else
+    {
+        hpx::util::format_to(
+            std::cout, "partial_sum (std) : {1}(sec)\n", time_std);
+    }
+
+    run_benchmark("seq", hpx::parallel::execution::seq, data, dest,
+        test_count, csvoutput);
+    run_benchmark("par", hpx::parallel::execution::par, data, dest,
+        test_count, csvoutput);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    desc_commandline.add_options()
+        ("vector_size",
+         hpx::program_options::value<std::size_t>()->default_value(10000000),
+         "size of vector (default: 10000000)")
+        ("test_count",
+         hpx::program_options::value<int>()->default_value(10),
+         "number of tests to be averaged (default: 10)")
+        ("csv_output",
+         "print results in csv format (format: policy,os-threads,size,"
+         "inclusive,exclusive,transform_inclusive,transform_exclusive)")
+        ("seed,s", hpx::program_options::value<unsigned int>(),
+         "the random number generator seed to use for this run")
+        ;
+    // clang-format on
+
+    // initialize program
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,239 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/parallel/util/scan_lookback_partitioner.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using base_iterator = std::vector<std::size_t>::iterator;
+
+///////////////////////////////////////////////////////////////////////////////
+// Runs the worker owning the given chunk delayed, which forces all workers
+// owning later chunks to take the look-back path. The number of processing
+// units reported decides about the number of workers.
+struct delaying_executor : hpx::parallel::execution::parallel_executor
+{
+    delaying_executor(base_iterator delayed, std::size_t num_workers)
+      : delayed_(delayed)
+      , num_workers_(num_workers)
+    {
+    }
+
+    template <typename F>
+    hpx::future<void> async_execute(F&& f, base_iterator it)
+    {
+        bool const delay = (it == delayed_);
+        return hpx::parallel::execution::parallel_executor::async_execute(
+            [delay, it, f = std::forward<F>(f)]() mutable {
+                if (delay)
+                {
+                    hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+                f(it);
+            });
+    }
+
+    std::size_t processing_units_count() const
+    {
+        return num_workers_;
+    }
+
+    base_iterator delayed_;
+    std::size_t num_workers_;
+};
+
+namespace hpx { namespace parallel { namespace execution {
+    template <>
+    struct is_two_way_executor<delaying_executor> : std::true_type
+    {
+    };
+}}}    // namespace hpx::parallel::execution
+
+///////////////////////////////////////////////////////////////////////////////
+// The operations counting how often a chunk was reduced separately, which
+// happens only on the look-back path. The chunk starting at the element
+// 'fail_at' throws in the given operation.
+struct scan_operations
+{
+    enum fail_mode
+    {
+        fail_none,
+        fail_reduce,
+        fail_scan
+    };
+
+    scan_operations(std::vector<std::size_t>& c, std::vector<std::size_t>& d,
+        fail_mode mode = fail_none, std::size_t fail_at = 0)
+      : c_(c)
+      , d_(d)
+      , mode_(mode)
+      , fail_at_(fail_at)
+      , reduced_(0)
+    {
+    }
+
+    void check_failure(base_iterator it, fail_mode mode) const
+    {
+        if (mode_ == mode &&
+            std::size_t(std::distance(c_.begin(), it)) == fail_at_)
+        {
+            throw std::runtime_error("test");
+        }
+    }
+
+    std::size_t reduce(base_iterator it, std::size_t size)
+    {
+        ++reduced_;
+        check_failure(it, fail_reduce);
+
+        std::size_t sum = 0;
+        for (/**/; size != 0; --size, ++it)
+            sum += *it;
+        return sum;
+    }
+
+    std::size_t scan(base_iterator it, std::size_t size, std::size_t prefix)
+    {
+        check_failure(it, fail_scan);
+
+        auto dest = d_.begin() + std::distance(c_.begin(), it);
+        for (/**/; size != 0; --size, ++it, ++dest)
+        {
+            prefix += *it;
+            *dest = prefix;
+        }
+        return prefix;
+    }
+
+    std::size_t run(delaying_executor const& exec, std::size_t chunk_size)
+    {
+        auto policy = hpx::parallel::execution::par.on(exec).with(
+            hpx::parallel::execution::static_chunk_size(chunk_size));
+
+        using partitioner_type =
+            hpx::parallel::util::scan_lookback_partitioner<decltype(policy),
+                std::size_t>;
+
+        return partitioner_type::call(
+            policy, c_.begin(), c_.size(), std::size_t(0),
+            [this](base_iterator it, std::size_t size) {
+                return reduce(it, size);
+            },
+            std::plus<std::size_t>(),
+            [this](base_iterator it, std::size_t size, std::size_t prefix) {
+                return scan(it, size, prefix);
+            },
+            [this]() { return d_.back(); });
+    }
+
+    std::vector<std::size_t>& c_;
+    std::vector<std::size_t>& d_;
+    fail_mode mode_;
+    std::size_t fail_at_;
+    std::atomic<std::size_t> reduced_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_lookback(std::size_t num_workers, std::size_t chunk_size)
+{
+    std::vector<std::size_t> c(10007, std::size_t(1));
+    std::vector<std::size_t> d(c.size());
+
+    scan_operations ops(c, d);
+    delaying_executor exec(c.begin(), num_workers);
+
+    HPX_TEST_EQ(ops.run(exec, chunk_size), c.size());
+    for (std::size_t i = 0; i != d.size(); ++i)
+    {
+        HPX_TEST_EQ(d[i], i + 1);
+    }
+
+    // the first worker was delayed, all others had to look back
+    if (num_workers > 1)
+    {
+        HPX_TEST_NEQ(ops.reduced_.load(), std::size_t(0));
+    }
+}
+
+void test_lookback_exception(scan_operations::fail_mode mode,
+    std::size_t num_workers, std::size_t fail_at)
+{
+    std::vector<std::size_t> c(10007, std::size_t(1));
+    std::vector<std::size_t> d(c.size());
+
+    scan_operations ops(c, d, mode, fail_at);
+    delaying_executor exec(c.begin(), num_workers);
+
+    bool caught_exception = false;
+    try
+    {
+        ops.run(exec, 100);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e)
+    {
+        caught_exception = true;
+        HPX_TEST_EQ(e.size(), std::size_t(1));
+    }
+    catch (...)
+    {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map&)
+{
+    std::size_t const cores = hpx::get_os_thread_count();
+
+    // one worker per core, more chunks than workers
+    test_lookback(cores, 100);
+
+    // oversubscription, many more workers than cores
+    test_lookback(4 * cores, 100);
+    test_lookback(4 * cores, 1);
+
+    // a single worker and a single chunk per worker
+    test_lookback(1, 100);
+    test_lookback(101, 100);
+
+    // the last chunk fails while being processed on the look-back path
+    std::size_t const last = 10000;
+    test_lookback_exception(scan_operations::fail_scan, 4 * cores, last);
+    test_lookback_exception(scan_operations::fail_reduce, 4 * cores, last);
+
+    // the first chunk fails while all others are looking back
+    test_lookback_exception(scan_operations::fail_scan, cores, 0);
+    test_lookback_exception(scan_operations::fail_scan, 4 * cores, 0);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,148 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/internal_allocator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util {
+
+    namespace detail {
+        // Allocations are grouped into size classes which are multiples of
+        // the granularity below. Larger allocations are not cached.
+        constexpr std::size_t allocator_cache_granularity = 32;
+        constexpr std::size_t allocator_cache_max_size = 1024;
+        constexpr std::size_t allocator_cache_num_size_classes =
+            allocator_cache_max_size / allocator_cache_granularity;
+
+        HPX_EXPORT void* allocator_cache_allocate(std::size_t size);
+        HPX_EXPORT void allocator_cache_deallocate(
+            void* p, std::size_t size) noexcept;
+
+        // account for an allocation forwarded to the internal allocator
+        HPX_EXPORT void allocator_cache_count_uncached() noexcept;
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Statistics gathered across all threads, these are exposed as
+    // performance counters
+    struct allocator_cache_statistics
+    {
+        std::int64_t allocations;    // number of cacheable allocations
+        std::int64_t cache_hits;     // allocations served from the caches
+        std::int64_t uncached;       // allocations bypassing the caches
+    };
+
+    HPX_EXPORT allocator_cache_statistics get_allocator_cache_statistics(
+        bool reset);
+
+    // The caches can be switched off at runtime (see hpx.allocator_cache),
+    // all allocations are then forwarded to the internal allocator
+    HPX_EXPORT void set_allocator_cache_enabled(bool enabled);
+    HPX_EXPORT bool get_allocator_cache_enabled();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Allocator for frequently created short-lived objects (shared states,
+    /// task objects, dataflow frames). Every thread keeps a list of freed
+    /// blocks per size class and serves allocations from there. Blocks freed
+    /// on a thread different from the allocating one are cached by the
+    /// freeing thread; once its cache overflows, blocks are handed back to a
+    /// global depot in batches from where they are picked up (again in
+    /// batches) by threads whose cache has run empty.
+    template <typename T = char>
+    struct thread_local_caching_allocator
+    {
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using reference = T&;
+        using const_reference = T const&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = thread_local_caching_allocator<U>;
+        };
+
+        using is_always_equal = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+
+        thread_local_caching_allocator() = default;
+
+        template <typename U>
+        explicit thread_local_caching_allocator(
+            thread_local_caching_allocator<U> const&)
+        {
+        }
+
+        pointer allocate(size_type n, void const* = nullptr)
+        {
+            // over-aligned types can't be cached
+            if (alignof(T) > alignof(std::max_align_t))
+            {
+                detail::allocator_cache_count_uncached();
+                return internal_allocator<T>{}.allocate(n);
+            }
+            return static_cast<pointer>(
+                detail::allocator_cache_allocate(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type n) noexcept
+        {
+            if (alignof(T) > alignof(std::max_align_t))
+            {
+                internal_allocator<T>{}.deallocate(p, n);
+                return;
+            }
+            detail::allocator_cache_deallocate(p, n * sizeof(T));
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<size_type>::max)() / sizeof(T);
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args)
+        {
+            ::new ((void*) p) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+    };
+
+    template <typename T, typename U>
+    constexpr bool operator==(thread_local_caching_allocator<T> const&,
+        thread_local_caching_allocator<U> const&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    constexpr bool operator!=(thread_local_caching_allocator<T> const&,
+        thread_local_caching_allocator<U> const&)
+    {
+        return false;
+    }
+}}    // namespace hpx::util
+
+#include <hpx/config/warnings_suffix.hpp>
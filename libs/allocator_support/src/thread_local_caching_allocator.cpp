@@ -0,0 +1,446 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace util {
+
+    namespace detail {
+
+        // number of blocks moved between a thread cache and the depot at once
+        constexpr std::size_t allocator_cache_batch_size = 32;
+
+        // maximum number of blocks cached per thread and size class
+        constexpr std::size_t allocator_cache_max_blocks =
+            2 * allocator_cache_batch_size;
+
+        // maximum number of batches kept in the depot per size class, any
+        // surplus is released to the internal allocator
+        constexpr std::size_t allocator_cache_max_batches = 256;
+
+        static std::atomic<bool> allocator_cache_enabled(true);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Freed blocks are linked through their first bytes. The first block
+        // of each batch in the depot additionally links the next batch (the
+        // smallest size class leaves enough room for both pointers).
+        struct free_block
+        {
+            free_block* next;
+            free_block* next_batch;
+        };
+
+        static_assert(sizeof(free_block) <= allocator_cache_granularity,
+            "the smallest size class must be able to hold a free_block");
+
+        static std::size_t get_size_class(std::size_t size) noexcept
+        {
+            return size == 0 ? 0 : (size - 1) / allocator_cache_granularity;
+        }
+
+        static std::size_t get_block_size(std::size_t size_class) noexcept
+        {
+            return (size_class + 1) * allocator_cache_granularity;
+        }
+
+        static void* allocate_block(std::size_t size_class)
+        {
+            return internal_allocator<char>{}.allocate(
+                get_block_size(size_class));
+        }
+
+        static void deallocate_block(void* p, std::size_t size_class) noexcept
+        {
+            internal_allocator<char>{}.deallocate(
+                static_cast<char*>(p), get_block_size(size_class));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Global pool of batches of free blocks, per size class
+        struct depot
+        {
+            std::mutex mtx_;
+            free_block* batches_ = nullptr;
+            std::size_t num_batches_ = 0;
+        };
+
+        // The depots are never destroyed as threads may exit (and flush their
+        // caches) after static objects have been destroyed.
+        static depot* get_depots()
+        {
+            static depot* depots = new depot[allocator_cache_num_size_classes];
+            return depots;
+        }
+
+        // take all blocks of one batch, return nullptr if the depot is empty
+        static free_block* take_batch(std::size_t size_class)
+        {
+            depot& d = get_depots()[size_class];
+
+            std::lock_guard<std::mutex> l(d.mtx_);
+            free_block* batch = d.batches_;
+            if (batch != nullptr)
+            {
+                d.batches_ = batch->next_batch;
+                --d.num_batches_;
+            }
+            return batch;
+        }
+
+        static void release_batch(
+            free_block* batch, std::size_t size_class) noexcept
+        {
+            {
+                depot& d = get_depots()[size_class];
+
+                std::lock_guard<std::mutex> l(d.mtx_);
+                if (d.num_batches_ < allocator_cache_max_batches)
+                {
+                    batch->next_batch = d.batches_;
+                    d.batches_ = batch;
+                    ++d.num_batches_;
+                    return;
+                }
+            }
+
+            // the depot is full, release the memory
+            while (batch != nullptr)
+            {
+                free_block* next = batch->next;
+                deallocate_block(batch, size_class);
+                batch = next;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct thread_cache;
+
+        // all live thread caches, used for gathering statistics only
+        struct thread_cache_registry
+        {
+            std::mutex mtx_;
+            std::vector<thread_cache const*> caches_;
+
+            // statistics of caches of exited threads
+            allocator_cache_statistics retired_ = {0, 0, 0};
+
+            // values reported by the last reset
+            allocator_cache_statistics base_ = {0, 0, 0};
+        };
+
+        static thread_cache_registry& get_thread_cache_registry()
+        {
+            static thread_cache_registry* registry = new thread_cache_registry;
+            return *registry;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct thread_cache
+        {
+            struct size_class_data
+            {
+                free_block* head_ = nullptr;
+                std::size_t count_ = 0;
+            };
+
+            thread_cache()
+            {
+                auto& registry = get_thread_cache_registry();
+
+                std::lock_guard<std::mutex> l(registry.mtx_);
+                registry.caches_.push_back(this);
+            }
+
+            ~thread_cache()
+            {
+                for (std::size_t i = 0; i != allocator_cache_num_size_classes;
+                     ++i)
+                {
+                    flush(i);
+                }
+
+                auto& registry = get_thread_cache_registry();
+
+                std::lock_guard<std::mutex> l(registry.mtx_);
+                registry.retired_.allocations +=
+                    allocations_.load(std::memory_order_relaxed);
+                registry.retired_.cache_hits +=
+                    cache_hits_.load(std::memory_order_relaxed);
+                registry.retired_.uncached +=
+                    uncached_.load(std::memory_order_relaxed);
+
+                auto it = std::find(
+                    registry.caches_.begin(), registry.caches_.end(), this);
+                if (it != registry.caches_.end())
+                {
+                    registry.caches_.erase(it);
+                }
+            }
+
+            thread_cache(thread_cache const&) = delete;
+            thread_cache& operator=(thread_cache const&) = delete;
+
+            void* allocate(std::size_t size_class)
+            {
+                // the counters are written by the owning thread only
+                allocations_.store(
+                    allocations_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+
+                size_class_data& data = classes_[size_class];
+                if (data.head_ == nullptr)
+                {
+                    // refill from the depot
+                    data.head_ = take_batch(size_class);
+                    if (data.head_ == nullptr)
+                    {
+                        return allocate_block(size_class);
+                    }
+                    data.count_ = allocator_cache_batch_size;
+                }
+
+                cache_hits_.store(
+                    cache_hits_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+
+                free_block* block = data.head_;
+                data.head_ = block->next;
+                --data.count_;
+                return block;
+            }
+
+            void deallocate(void* p, std::size_t size_class) noexcept
+            {
+                size_class_data& data = classes_[size_class];
+
+                free_block* block = static_cast<free_block*>(p);
+                block->next = data.head_;
+                data.head_ = block;
+
+                if (++data.count_ > allocator_cache_max_blocks)
+                {
+                    // hand one batch of blocks back to the depot
+                    free_block* batch = data.head_;
+                    free_block* last = batch;
+                    for (std::size_t i = 1; i != allocator_cache_batch_size;
+                         ++i)
+                    {
+                        last = last->next;
+                    }
+
+                    data.head_ = last->next;
+                    data.count_ -= allocator_cache_batch_size;
+
+                    last->next = nullptr;
+                    release_batch(batch, size_class);
+                }
+            }
+
+            // return all cached blocks of the given size class, partial
+            // batches are released to the internal allocator
+            void flush(std::size_t size_class) noexcept
+            {
+                size_class_data& data = classes_[size_class];
+                while (data.count_ >= allocator_cache_batch_size)
+                {
+                    free_block* batch = data.head_;
+                    free_block* last = batch;
+                    for (std::size_t i = 1; i != allocator_cache_batch_size;
+                         ++i)
+                    {
+                        last = last->next;
+                    }
+
+                    data.head_ = last->next;
+                    data.count_ -= allocator_cache_batch_size;
+
+                    last->next = nullptr;
+                    release_batch(batch, size_class);
+                }
+
+                while (data.head_ != nullptr)
+                {
+                    free_block* next = data.head_->next;
+                    deallocate_block(data.head_, size_class);
+                    data.head_ = next;
+                }
+                data.count_ = 0;
+            }
+
+            void accumulate_statistics(allocator_cache_statistics& stats) const
+            {
+                stats.allocations +=
+                    allocations_.load(std::memory_order_relaxed);
+                stats.cache_hits += cache_hits_.load(std::memory_order_relaxed);
+                stats.uncached += uncached_.load(std::memory_order_relaxed);
+            }
+
+            void count_uncached() noexcept
+            {
+                uncached_.store(uncached_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+            }
+
+            size_class_data classes_[allocator_cache_num_size_classes];
+
+            std::atomic<std::int64_t> allocations_{0};
+            std::atomic<std::int64_t> cache_hits_{0};
+            std::atomic<std::int64_t> uncached_{0};
+        };
+
+        // Return the cache of the calling thread, or nullptr if it has
+        // already been destroyed (objects may be released by destructors of
+        // other thread-local objects while the thread exits).
+        static thread_cache* get_thread_cache()
+        {
+            enum cache_state : char
+            {
+                uninitialized,
+                alive,
+                destroyed
+            };
+
+            struct thread_cache_holder
+            {
+                explicit thread_cache_holder(cache_state& state)
+                  : state_(state)
+                {
+                    state_ = alive;
+                }
+                ~thread_cache_holder()
+                {
+                    state_ = destroyed;
+                }
+
+                cache_state& state_;
+                thread_cache cache_;
+            };
+
+            static thread_local cache_state state = uninitialized;
+            if (state == destroyed)
+            {
+                return nullptr;
+            }
+
+            static thread_local thread_cache_holder holder(state);
+            return &holder.cache_;
+        }
+
+        // uncached allocations of threads which don't have a cache (anymore)
+        static std::atomic<std::int64_t> allocator_cache_uncached(0);
+
+        static void count_uncached(thread_cache* cache) noexcept
+        {
+            if (cache != nullptr)
+            {
+                cache->count_uncached();
+            }
+            else
+            {
+                allocator_cache_uncached.fetch_add(
+                    1, std::memory_order_relaxed);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void* allocator_cache_allocate(std::size_t size)
+        {
+            thread_cache* cache = get_thread_cache();
+            if (size > allocator_cache_max_size)
+            {
+                count_uncached(cache);
+                return internal_allocator<char>{}.allocate(size);
+            }
+
+            // Blocks are always allocated with the full size of their size
+            // class, which allows to switch the caches on and off at any
+            // time.
+            std::size_t const size_class = get_size_class(size);
+            if (cache != nullptr &&
+                allocator_cache_enabled.load(std::memory_order_relaxed))
+            {
+                return cache->allocate(size_class);
+            }
+
+            count_uncached(cache);
+            return allocate_block(size_class);
+        }
+
+        void allocator_cache_count_uncached() noexcept
+        {
+            count_uncached(get_thread_cache());
+        }
+
+        void allocator_cache_deallocate(void* p, std::size_t size) noexcept
+        {
+            if (size > allocator_cache_max_size)
+            {
+                internal_allocator<char>{}.deallocate(
+                    static_cast<char*>(p), size);
+                return;
+            }
+
+            std::size_t const size_class = get_size_class(size);
+            if (allocator_cache_enabled.load(std::memory_order_relaxed))
+            {
+                thread_cache* cache = get_thread_cache();
+                if (cache != nullptr)
+                {
+                    cache->deallocate(p, size_class);
+                    return;
+                }
+            }
+            deallocate_block(p, size_class);
+        }
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    allocator_cache_statistics get_allocator_cache_statistics(bool reset)
+    {
+        auto& registry = detail::get_thread_cache_registry();
+
+        std::lock_guard<std::mutex> l(registry.mtx_);
+
+        allocator_cache_statistics total = registry.retired_;
+        total.uncached += detail::allocator_cache_uncached.load(
+            std::memory_order_relaxed);
+        for (detail::thread_cache const* cache : registry.caches_)
+        {
+            cache->accumulate_statistics(total);
+        }
+
+        allocator_cache_statistics result = {
+            total.allocations - registry.base_.allocations,
+            total.cache_hits - registry.base_.cache_hits,
+            total.uncached - registry.base_.uncached};
+
+        if (reset)
+        {
+            registry.base_ = total;
+        }
+        return result;
+    }
+
+    void set_allocator_cache_enabled(bool enabled)
+    {
+        detail::allocator_cache_enabled.store(
+            enabled, std::memory_order_relaxed);
+    }
+
+    bool get_allocator_cache_enabled()
+    {
+        return detail::allocator_cache_enabled.load(std::memory_order_relaxed);
+    }
+}}    // namespace hpx::util
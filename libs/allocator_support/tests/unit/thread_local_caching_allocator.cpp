@@ -0,0 +1,196 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+template <std::size_t N>
+struct object
+{
+    char data[N];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void test_reuse()
+{
+    hpx::util::thread_local_caching_allocator<T> alloc;
+
+    // a freed block is handed out again by the next allocation of the same
+    // size class
+    T* p1 = alloc.allocate(1);
+    alloc.deallocate(p1, 1);
+    T* p2 = alloc.allocate(1);
+    HPX_TEST_EQ(p1, p2);
+    alloc.deallocate(p2, 1);
+
+    // all outstanding blocks are distinct
+    std::vector<T*> blocks;
+    std::set<T*> unique;
+    for (std::size_t i = 0; i != 1000; ++i)
+    {
+        blocks.push_back(alloc.allocate(1));
+        unique.insert(blocks.back());
+    }
+    HPX_TEST_EQ(unique.size(), blocks.size());
+
+    for (T* p : blocks)
+        alloc.deallocate(p, 1);
+}
+
+void test_statistics()
+{
+    using allocator_type = hpx::util::thread_local_caching_allocator<object<64>>;
+    allocator_type alloc;
+
+    // warm up the cache of this thread
+    alloc.deallocate(alloc.allocate(1), 1);
+
+    hpx::util::get_allocator_cache_statistics(true);
+
+    for (std::size_t i = 0; i != 100; ++i)
+        alloc.deallocate(alloc.allocate(1), 1);
+
+    hpx::util::allocator_cache_statistics stats =
+        hpx::util::get_allocator_cache_statistics(true);
+    HPX_TEST_EQ(stats.allocations, std::int64_t(100));
+    HPX_TEST_EQ(stats.cache_hits, std::int64_t(100));
+    HPX_TEST_EQ(stats.uncached, std::int64_t(0));
+
+    // large allocations are not cached, they are counted separately
+    hpx::util::thread_local_caching_allocator<object<4096>> large_alloc;
+    large_alloc.deallocate(large_alloc.allocate(1), 1);
+
+    stats = hpx::util::get_allocator_cache_statistics(false);
+    HPX_TEST_EQ(stats.allocations, std::int64_t(0));
+    HPX_TEST_EQ(stats.uncached, std::int64_t(1));
+}
+
+void test_disabled()
+{
+    using allocator_type = hpx::util::thread_local_caching_allocator<object<64>>;
+    allocator_type alloc;
+
+    // blocks allocated while the caches are switched off can be freed after
+    // they have been switched on again (and vice versa)
+    object<64>* p1 = alloc.allocate(1);
+
+    hpx::util::set_allocator_cache_enabled(false);
+    HPX_TEST(!hpx::util::get_allocator_cache_enabled());
+
+    object<64>* p2 = alloc.allocate(1);
+    alloc.deallocate(p1, 1);
+
+    hpx::util::get_allocator_cache_statistics(true);
+    alloc.deallocate(alloc.allocate(1), 1);
+
+    hpx::util::allocator_cache_statistics stats =
+        hpx::util::get_allocator_cache_statistics(true);
+    HPX_TEST_EQ(stats.allocations, std::int64_t(0));
+    HPX_TEST_EQ(stats.uncached, std::int64_t(1));
+
+    hpx::util::set_allocator_cache_enabled(true);
+    HPX_TEST(hpx::util::get_allocator_cache_enabled());
+
+    alloc.deallocate(p2, 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// blocks allocated on one thread and freed on another find their way back
+// through the global depot
+void test_cross_thread()
+{
+    using allocator_type =
+        hpx::util::thread_local_caching_allocator<object<128>>;
+
+    std::size_t const count = 10000;
+    std::vector<object<128>*> blocks(count);
+
+    std::thread producer([&]() {
+        allocator_type alloc;
+        for (std::size_t i = 0; i != count; ++i)
+            blocks[i] = alloc.allocate(1);
+    });
+    producer.join();
+
+    std::thread consumer([&]() {
+        allocator_type alloc;
+        for (object<128>* p : blocks)
+            alloc.deallocate(p, 1);
+    });
+    consumer.join();
+
+    hpx::util::get_allocator_cache_statistics(true);
+
+    allocator_type alloc;
+    for (std::size_t i = 0; i != count; ++i)
+        blocks[i] = alloc.allocate(1);
+
+    // most of the blocks are picked up from the depot
+    hpx::util::allocator_cache_statistics stats =
+        hpx::util::get_allocator_cache_statistics(true);
+    HPX_TEST_EQ(stats.allocations, std::int64_t(count));
+    HPX_TEST_LT(std::int64_t(0), stats.cache_hits);
+
+    for (object<128>* p : blocks)
+        alloc.deallocate(p, 1);
+}
+
+void test_concurrent()
+{
+    using allocator_type = hpx::util::thread_local_caching_allocator<object<96>>;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t != 4; ++t)
+    {
+        threads.emplace_back([]() {
+            allocator_type alloc;
+            std::vector<object<96>*> blocks;
+            for (std::size_t j = 0; j != 100; ++j)
+            {
+                for (std::size_t i = 0; i != 100; ++i)
+                {
+                    object<96>* p = alloc.allocate(1);
+                    p->data[0] = char(i);
+                    blocks.push_back(p);
+                }
+                for (std::size_t i = 0; i != 100; ++i)
+                {
+                    HPX_TEST_EQ(blocks[i]->data[0], char(i));
+                    alloc.deallocate(blocks[i], 1);
+                }
+                blocks.clear();
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+}
+
+int main()
+{
+    test_reuse<object<1>>();
+    test_reuse<object<32>>();
+    test_reuse<object<200>>();
+    test_reuse<object<1024>>();
+    test_reuse<std::uint64_t>();
+
+    test_statistics();
+    test_disabled();
+    test_cross_thread();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
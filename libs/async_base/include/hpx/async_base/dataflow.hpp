@@ -7,7 +7,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/type_support/decay.hpp>
 
 #include <utility>
@@ -23,12 +23,12 @@ namespace hpx {
     template <typename F, typename... Ts>
     HPX_FORCEINLINE auto dataflow(F&& f, Ts&&... ts) -> decltype(
         lcos::detail::dataflow_dispatch<typename util::decay<F>::type>::call(
-            hpx::util::internal_allocator<>{}, std::forward<F>(f),
+            hpx::util::thread_local_caching_allocator<>{}, std::forward<F>(f),
             std::forward<Ts>(ts)...))
     {
         return lcos::detail::dataflow_dispatch<typename util::decay<F>::type>::
-            call(hpx::util::internal_allocator<>{}, std::forward<F>(f),
-                std::forward<Ts>(ts)...);
+            call(hpx::util::thread_local_caching_allocator<>{},
+                std::forward<F>(f), std::forward<Ts>(ts)...);
     }
 
     template <typename Allocator, typename F, typename... Ts>
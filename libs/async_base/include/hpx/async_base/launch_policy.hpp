@@ -26,11 +26,13 @@ namespace hpx {
             sync = 0x08,
             fork = 0x10,    // same as async, but forces continuation stealing
             apply = 0x20,
+            lazy = 0x40,    // same as async, but runs inline when awaited
+                            // before being stolen (child stealing)
 
             sync_policies = 0x0a,     // sync | deferred
-            async_policies = 0x15,    // async | task | fork
-            all = 0x3f                // async | deferred | task | sync |
-                                      // fork | apply
+            async_policies = 0x55,    // async | task | fork | lazy
+            all = 0x7f                // async | deferred | task | sync |
+                                      // fork | apply | lazy
         };
 
         struct policy_holder_base
@@ -180,6 +182,22 @@ namespace hpx {
             }
         };
 
+        struct lazy_policy : policy_holder<lazy_policy>
+        {
+            constexpr explicit lazy_policy(
+                threads::thread_priority priority =
+                    threads::thread_priority_default) noexcept
+              : policy_holder<lazy_policy>(launch_policy::lazy, priority)
+            {
+            }
+
+            constexpr lazy_policy operator()(
+                threads::thread_priority priority) const noexcept
+            {
+                return lazy_policy(priority);
+            }
+        };
+
         struct sync_policy : policy_holder<sync_policy>
         {
             constexpr sync_policy() noexcept
@@ -370,6 +388,14 @@ namespace hpx {
         {
         }
 
+        /// Create a launch policy representing asynchronous execution. The
+        /// new task is run inline by the first thread waiting for its result
+        /// unless an idle worker has stolen it before
+        constexpr launch(detail::lazy_policy) noexcept
+          : detail::policy_holder<>{detail::launch_policy::lazy}
+        {
+        }
+
         /// Create a launch policy representing synchronous execution
         constexpr launch(detail::sync_policy) noexcept
           : detail::policy_holder<>{detail::launch_policy::sync}
@@ -399,6 +425,7 @@ namespace hpx {
         /// \cond NOINTERNAL
         using async_policy = detail::async_policy;
         using fork_policy = detail::fork_policy;
+        using lazy_policy = detail::lazy_policy;
         using sync_policy = detail::sync_policy;
         using deferred_policy = detail::deferred_policy;
         using apply_policy = detail::apply_policy;
@@ -414,6 +441,11 @@ namespace hpx {
         /// new thread is executed in a preferred way
         HPX_EXPORT static const detail::fork_policy fork;
 
+        /// Predefined launch policy representing asynchronous execution. The
+        /// new task is run inline by the first thread waiting for its result
+        /// unless an idle worker has stolen it before (lazy task creation)
+        HPX_EXPORT static const detail::lazy_policy lazy;
+
         /// Predefined launch policy representing synchronous execution
         HPX_EXPORT static const detail::sync_policy sync;
 
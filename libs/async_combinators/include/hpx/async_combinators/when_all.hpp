@@ -133,7 +133,7 @@ namespace hpx {
 #else    // DOXYGEN
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/datastructures/tuple.hpp>
 #include <hpx/futures/detail/future_data.hpp>
 #include <hpx/futures/detail/future_transforms.hpp>
@@ -232,7 +232,7 @@ namespace hpx { namespace lcos {
             typename frame_type::base_type::init_no_addref no_addref;
 
             auto frame = util::traverse_pack_async_allocator(
-                util::internal_allocator<>{},
+                util::thread_local_caching_allocator<>{},
                 util::async_traverse_in_place_tag<frame_type>{}, no_addref,
                 func(std::forward<T>(args))...);
 
@@ -0,0 +1,419 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file batched_async.hpp
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/async_base/launch_policy.hpp>
+#include <hpx/async_distributed/apply.hpp>
+#include <hpx/async_distributed/async.hpp>
+#include <hpx/async_distributed/sync.hpp>
+#include <hpx/datastructures/tuple.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/futures/traits/get_remote_result.hpp>
+#include <hpx/futures/traits/is_future.hpp>
+#include <hpx/lcos_local/promise.hpp>
+#include <hpx/preprocessor/cat.hpp>
+#include <hpx/runtime/actions/basic_action.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/get_colocation_id.hpp>
+#include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/serialization/tuple.hpp>
+#include <hpx/serialization/vector.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/threading/thread.hpp>
+#include <hpx/timing/steady_clock.hpp>
+#include <hpx/traits/component_supports_migration.hpp>
+#include <hpx/traits/extract_action.hpp>
+#include <hpx/type_support/pack.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos {
+    /// \cond NOINTERNAL
+    namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // Executed on the locality of the target, invokes the action for all
+        // argument sets of a batch on the same HPX thread.
+        template <typename Action>
+        struct batched_invoker
+        {
+            using action_type = typename traits::extract_action<Action>::type;
+            using arguments_type = typename action_type::arguments_type;
+            using remote_result_type =
+                typename action_type::remote_result_type;
+            using local_result_type = typename action_type::local_result_type;
+
+            template <std::size_t... Is>
+            static remote_result_type invoke(naming::address const& addr,
+                arguments_type& args, util::index_pack<Is...>)
+            {
+                return action_type::execute_function(addr.address_,
+                    addr.type_, std::move(util::get<Is>(args))...);
+            }
+
+            template <std::size_t... Is>
+            static remote_result_type invoke_sync(naming::id_type const& id,
+                arguments_type& args, util::index_pack<Is...>, std::false_type)
+            {
+                return hpx::sync<action_type>(
+                    id, std::move(util::get<Is>(args))...);
+            }
+
+            template <std::size_t... Is>
+            static remote_result_type invoke_sync(naming::id_type const& id,
+                arguments_type& args, util::index_pack<Is...>, std::true_type)
+            {
+                hpx::sync<action_type>(id, std::move(util::get<Is>(args))...);
+                return remote_result_type();
+            }
+
+            static std::vector<remote_result_type> call(
+                naming::id_type const& id, std::vector<arguments_type> args)
+            {
+                using pack_type = typename util::make_index_pack<
+                    util::tuple_size<arguments_type>::value>::type;
+
+                std::vector<remote_result_type> results;
+                results.reserve(args.size());
+
+                naming::address addr;
+                if (!traits::component_supports_migration<
+                        typename action_type::component_type>::call() &&
+                    agas::is_local_address_cached(id, addr))
+                {
+                    // invoke all actions directly
+                    for (arguments_type& a : args)
+                    {
+                        results.push_back(invoke(addr, a, pack_type()));
+                    }
+                }
+                else
+                {
+                    // the target is not local (anymore)
+                    for (arguments_type& a : args)
+                    {
+                        results.push_back(invoke_sync(id, a, pack_type(),
+                            std::is_void<local_result_type>()));
+                    }
+                }
+                return results;
+            }
+        };
+
+        template <typename Action>
+        struct batched_invoke_action
+          : hpx::actions::make_action<
+                decltype(&batched_invoker<Action>::call),
+                &batched_invoker<Action>::call,
+                batched_invoke_action<Action>>::type
+        {
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Action>
+        class action_batcher_state
+          : public std::enable_shared_from_this<action_batcher_state<Action>>
+        {
+        public:
+            using action_type = typename traits::extract_action<Action>::type;
+            using arguments_type = typename action_type::arguments_type;
+            using remote_result_type =
+                typename action_type::remote_result_type;
+            using local_result_type = typename action_type::local_result_type;
+
+        private:
+            using mutex_type = lcos::local::spinlock;
+
+            struct batch
+            {
+                std::vector<arguments_type> args_;
+                std::vector<lcos::local::promise<local_result_type>> promises_;
+            };
+
+            struct target_data
+            {
+                naming::id_type id_;
+                naming::id_type locality_;
+                std::unique_ptr<batch> batch_;
+
+                // incremented whenever a batch is sent
+                std::size_t generation_ = 0;
+            };
+
+            struct pending_batch
+            {
+                naming::id_type id_;
+                naming::id_type locality_;
+                std::shared_ptr<batch> batch_;
+            };
+
+        public:
+            action_batcher_state(std::size_t max_batch_size,
+                util::steady_clock::duration const& window)
+              : max_batch_size_(max_batch_size != 0 ? max_batch_size : 1)
+              , window_(window)
+            {
+            }
+
+            template <typename... Ts>
+            hpx::future<local_result_type> async(
+                naming::id_type const& id, Ts&&... vs)
+            {
+                // there is nothing to gain from batching local invocations
+                if (agas::is_local_address_cached(id))
+                {
+                    return hpx::async<action_type>(
+                        id, std::forward<Ts>(vs)...);
+                }
+
+                std::unique_lock<mutex_type> l(mtx_);
+
+                target_data& target =
+                    targets_[naming::detail::get_stripped_gid(id.get_gid())];
+                if (!target.id_)
+                    target.id_ = id;
+                if (!target.batch_)
+                    target.batch_.reset(new batch);
+
+                batch& b = *target.batch_;
+                b.args_.emplace_back(std::forward<Ts>(vs)...);
+                b.promises_.emplace_back();
+                hpx::future<local_result_type> f =
+                    b.promises_.back().get_future();
+
+                if (b.args_.size() >= max_batch_size_)
+                {
+                    pending_batch pending = take(target);
+                    l.unlock();
+
+                    send(std::move(pending));
+                }
+                else if (b.args_.size() == 1 &&
+                    window_ != util::steady_clock::duration::zero())
+                {
+                    // send the batch at the latest after the window has
+                    // elapsed
+                    std::size_t generation = target.generation_;
+                    l.unlock();
+
+                    auto this_ = this->shared_from_this();
+                    naming::gid_type gid =
+                        naming::detail::get_stripped_gid(id.get_gid());
+                    hpx::apply([this_, gid, generation]() {
+                        hpx::this_thread::sleep_for(this_->window_);
+                        this_->flush(gid, generation);
+                    });
+                }
+                return f;
+            }
+
+            // send all pending batches
+            void flush()
+            {
+                std::vector<pending_batch> pending;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    for (auto& target : targets_)
+                    {
+                        if (target.second.batch_)
+                            pending.push_back(take(target.second));
+                    }
+                }
+
+                for (pending_batch& p : pending)
+                {
+                    send(std::move(p));
+                }
+            }
+
+        private:
+            void flush(naming::gid_type const& gid, std::size_t generation)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+
+                auto it = targets_.find(gid);
+                if (it != targets_.end() &&
+                    it->second.generation_ == generation &&
+                    it->second.batch_)
+                {
+                    pending_batch pending = take(it->second);
+                    l.unlock();
+
+                    send(std::move(pending));
+                }
+            }
+
+            static void set_value(
+                lcos::local::promise<void>& p, remote_result_type&&)
+            {
+                p.set_value();
+            }
+
+            template <typename T>
+            static void set_value(
+                lcos::local::promise<T>& p, remote_result_type&& r)
+            {
+                p.set_value(
+                    traits::get_remote_result<T, remote_result_type>::call(
+                        std::move(r)));
+            }
+
+            // detach the current batch of the given target, requires mtx_ to
+            // be held
+            pending_batch take(target_data& target)
+            {
+                ++target.generation_;
+                return pending_batch{target.id_, target.locality_,
+                    std::shared_ptr<batch>(std::move(target.batch_))};
+            }
+
+            void send(pending_batch&& pending)
+            {
+                if (!pending.locality_)
+                {
+                    // the target is assumed to not migrate, resolve its
+                    // locality only once
+                    pending.locality_ =
+                        hpx::get_colocation_id(launch::sync, pending.id_);
+
+                    std::lock_guard<mutex_type> l(mtx_);
+                    targets_[naming::detail::get_stripped_gid(
+                                 pending.id_.get_gid())]
+                        .locality_ = pending.locality_;
+                }
+
+                std::shared_ptr<batch> b = std::move(pending.batch_);
+
+                using batch_action = batched_invoke_action<Action>;
+                hpx::async<batch_action>(
+                    pending.locality_, pending.id_, std::move(b->args_))
+                    .then(hpx::launch::sync,
+                        [b](hpx::future<std::vector<remote_result_type>> f) {
+                            if (f.has_exception())
+                            {
+                                // the exception is reported to all
+                                // invocations of the batch
+                                std::exception_ptr e = f.get_exception_ptr();
+                                for (auto& p : b->promises_)
+                                {
+                                    p.set_exception(e);
+                                }
+                                return;
+                            }
+
+                            std::vector<remote_result_type> results = f.get();
+                            for (std::size_t i = 0; i != results.size(); ++i)
+                            {
+                                set_value(
+                                    b->promises_[i], std::move(results[i]));
+                            }
+                        });
+            }
+
+            mutex_type mtx_;
+            std::size_t const max_batch_size_;
+            util::steady_clock::duration const window_;
+            std::unordered_map<naming::gid_type, target_data> targets_;
+        };
+    }    // namespace detail
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An action_batcher collects invocations of the same action on the same
+    /// (remote) target and sends them as a single parcel. All invocations of
+    /// a batch are executed on the same HPX thread on the locality of the
+    /// target, and their results are sent back in a single response. This
+    /// is useful for fine grained (direct) actions, e.g. element accessors.
+    ///
+    /// A batch is sent once it holds \a max_batch_size invocations, once
+    /// \a window has elapsed after its first invocation, or on flush(). The
+    /// invocations of a batch are executed in order. If any of them throws,
+    /// the exception is reported to all invocations of the batch.
+    /// Invocations on local targets are not batched.
+    ///
+    /// \note The locality of each target is resolved once, i.e. targets
+    ///       should not be migrated while an action_batcher is in use.
+    template <typename Action>
+    class action_batcher
+    {
+        using state_type = detail::action_batcher_state<Action>;
+
+    public:
+        using local_result_type = typename state_type::local_result_type;
+
+        explicit action_batcher(std::size_t max_batch_size = 64,
+            util::steady_duration const& window =
+                std::chrono::microseconds(100))
+          : state_(std::make_shared<state_type>(max_batch_size, window.value()))
+        {
+            static_assert(!traits::is_future<typename state_type::action_type::
+                                  internal_result_type>::value,
+                "actions returning a future can't be batched");
+        }
+
+        action_batcher(action_batcher&&) = default;
+        action_batcher& operator=(action_batcher&&) = default;
+
+        ~action_batcher()
+        {
+            if (state_)
+                state_->flush();
+        }
+
+        /// Schedule the invocation of the action on the given target, the
+        /// returned future becomes ready once the batch it belongs to has
+        /// been executed.
+        template <typename... Ts>
+        hpx::future<local_result_type> async(
+            naming::id_type const& id, Ts&&... vs)
+        {
+            return state_->async(id, std::forward<Ts>(vs)...);
+        }
+
+        /// Send all pending batches right away.
+        void flush()
+        {
+            state_->flush();
+        }
+
+    private:
+        std::shared_ptr<state_type> state_;
+    };
+}}    // namespace hpx::lcos
+
+namespace hpx {
+    using lcos::action_batcher;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// These macros are needed only if automatic serialization registration is
+// disabled.
+#define HPX_REGISTER_BATCHED_ACTION_DECLARATION(Action, Name)                  \
+    HPX_REGISTER_ACTION_DECLARATION(                                           \
+        ::hpx::lcos::detail::batched_invoke_action<Action>,                    \
+        HPX_PP_CAT(batched_, Name))                                            \
+    /**/
+
+#define HPX_REGISTER_BATCHED_ACTION(Action, Name)                              \
+    HPX_REGISTER_ACTION(::hpx::lcos::detail::batched_invoke_action<Action>,    \
+        HPX_PP_CAT(batched_, Name))                                            \
+    /**/
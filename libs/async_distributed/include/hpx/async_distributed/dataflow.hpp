@@ -7,7 +7,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/async_base/traits/is_launch_policy.hpp>
 #include <hpx/async_local/dataflow.hpp>
@@ -137,11 +137,11 @@ namespace hpx {
             typename std::enable_if<traits::is_action<Action>::value>::type>
     HPX_FORCEINLINE auto dataflow(T0&& t0, Ts&&... ts)
         -> decltype(lcos::detail::dataflow_action_dispatch<Action, T0>::call(
-            hpx::util::internal_allocator<>{}, std::forward<T0>(t0),
+            hpx::util::thread_local_caching_allocator<>{}, std::forward<T0>(t0),
             std::forward<Ts>(ts)...))
     {
         return lcos::detail::dataflow_action_dispatch<Action, T0>::call(
-            hpx::util::internal_allocator<>{}, std::forward<T0>(t0),
+            hpx::util::thread_local_caching_allocator<>{}, std::forward<T0>(t0),
             std::forward<Ts>(ts)...);
     }
 
@@ -0,0 +1,173 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos_local.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::int32_t increment(std::int32_t i)
+{
+    return i + 1;
+}
+
+hpx::thread::id get_thread_id()
+{
+    return hpx::this_thread::get_id();
+}
+
+void throw_error()
+{
+    throw std::runtime_error("error");
+}
+
+std::uint64_t fibonacci(std::uint64_t n)
+{
+    if (n < 2)
+        return n;
+
+    hpx::future<std::uint64_t> lhs =
+        hpx::async(hpx::launch::lazy, &fibonacci, n - 1);
+    std::uint64_t rhs = fibonacci(n - 2);
+
+    return lhs.get() + rhs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_inline_execution()
+{
+    // no other worker is available to steal the task, it must run inline
+    hpx::future<hpx::thread::id> f =
+        hpx::async(hpx::launch::lazy, &get_thread_id);
+    HPX_TEST(f.get() == hpx::this_thread::get_id());
+
+    // timed waits run the task inline as well instead of reporting it as
+    // deferred
+    hpx::future<std::int32_t> f2 = hpx::async(hpx::launch::lazy, &increment, 1);
+    HPX_TEST(f2.wait_for(std::chrono::seconds(0)) ==
+        hpx::lcos::future_status::ready);
+    HPX_TEST_EQ(f2.get(), 2);
+}
+
+#if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
+void test_obsolete_staged_tasks()
+{
+    hpx::threads::thread_pool_base* pool = hpx::this_thread::get_pool();
+    std::int64_t const executed =
+        pool->get_executed_threads(std::size_t(-1), false);
+
+    // all tasks run inline, their staged work items must not turn into
+    // threads once the worker gets to convert them
+    std::size_t const num_tasks = 200;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        hpx::future<std::int32_t> f =
+            hpx::async(hpx::launch::lazy, &increment, std::int32_t(i));
+        HPX_TEST_EQ(f.get(), std::int32_t(i + 1));
+    }
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // allow for the threads needed for suspending this thread
+    HPX_TEST_LT(pool->get_executed_threads(std::size_t(-1), false) - executed,
+        std::int64_t(num_tasks / 2));
+}
+#endif
+
+void test_lazy_async()
+{
+    {
+        hpx::future<std::int32_t> f =
+            hpx::async(hpx::launch::lazy, &increment, 42);
+        HPX_TEST_EQ(f.get(), 43);
+    }
+
+    {
+        hpx::launch policy = hpx::launch::lazy;
+        hpx::future<std::int32_t> f = hpx::async(policy, &increment, 42);
+        HPX_TEST_EQ(f.get(), 43);
+    }
+
+    {
+        hpx::future<std::int32_t> f =
+            hpx::async(hpx::launch::lazy, &increment, 42);
+        HPX_TEST(f.wait_for(std::chrono::seconds(0)) !=
+            hpx::lcos::future_status::deferred);
+        HPX_TEST_EQ(f.get(), 43);
+    }
+
+    {
+        hpx::future<void> f = hpx::async(hpx::launch::lazy, &throw_error);
+        bool caught_exception = false;
+        try
+        {
+            f.get();
+        }
+        catch (std::runtime_error const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    {
+        // every task runs exactly once, independently of whether it was
+        // stolen or run inline
+        std::atomic<std::int32_t> count(0);
+
+        std::vector<hpx::future<void>> fs;
+        for (std::int32_t i = 0; i != 1000; ++i)
+        {
+            fs.push_back(
+                hpx::async(hpx::launch::lazy, [&count]() { ++count; }));
+        }
+        hpx::wait_all(fs);
+
+        HPX_TEST_EQ(count.load(), 1000);
+    }
+
+    HPX_TEST_EQ(fibonacci(20), std::uint64_t(6765));
+}
+
+int hpx_main()
+{
+    hpx::parallel::execution::pool_executor exec("single");
+    hpx::async(exec, &test_inline_execution).get();
+#if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
+    hpx::async(exec, &test_obsolete_staged_tasks).get();
+#endif
+
+    test_lazy_async();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::init_params init_args;
+    init_args.rp_callback = [](auto& rp) {
+        // a pool with a single worker thread to verify inline execution
+        rp.create_thread_pool("single");
+        rp.add_resource(rp.numa_domains()[0].cores()[0].pus()[0], "single");
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, init_args), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
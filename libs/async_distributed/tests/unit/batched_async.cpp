@@ -0,0 +1,194 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/async_distributed.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::int32_t increment(std::int32_t i)
+{
+    return i + 1;
+}
+HPX_PLAIN_ACTION(increment);
+
+std::atomic<std::int32_t> count(0);
+
+void add(std::int32_t i)
+{
+    count += i;
+}
+HPX_PLAIN_ACTION(add);
+
+std::int32_t get_count()
+{
+    return count.load();
+}
+HPX_PLAIN_ACTION(get_count);
+
+std::int32_t throw_on_odd(std::int32_t i)
+{
+    if (i % 2 != 0)
+        throw std::runtime_error("odd value");
+    return i;
+}
+HPX_PLAIN_ACTION(throw_on_odd);
+
+///////////////////////////////////////////////////////////////////////////////
+struct accumulator_server
+  : hpx::components::component_base<accumulator_server>
+{
+    std::int32_t get(std::int32_t i) const
+    {
+        return values_[i];
+    }
+
+    HPX_DEFINE_COMPONENT_DIRECT_ACTION(accumulator_server, get);
+
+    std::int32_t values_[4] = {1, 2, 3, 4};
+};
+
+typedef hpx::components::component<accumulator_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, accumulator_server);
+
+typedef accumulator_server::get_action get_action;
+HPX_REGISTER_ACTION_DECLARATION(get_action);
+HPX_REGISTER_ACTION(get_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_batched_plain(hpx::id_type const& target)
+{
+    // batches are sent once they are full and on flush()
+    hpx::action_batcher<increment_action> b(16, std::chrono::seconds(0));
+
+    std::vector<hpx::future<std::int32_t>> results;
+    for (std::int32_t i = 0; i != 100; ++i)
+    {
+        results.push_back(b.async(target, i));
+    }
+    b.flush();
+
+    for (std::int32_t i = 0; i != 100; ++i)
+    {
+        HPX_TEST_EQ(results[i].get(), i + 1);
+    }
+}
+
+void test_batched_window(hpx::id_type const& target)
+{
+    // pending batches are sent once the window has elapsed
+    hpx::action_batcher<increment_action> b(1000, std::chrono::milliseconds(1));
+
+    std::vector<hpx::future<std::int32_t>> results;
+    for (std::int32_t i = 0; i != 10; ++i)
+    {
+        results.push_back(b.async(target, i));
+    }
+
+    for (std::int32_t i = 0; i != 10; ++i)
+    {
+        HPX_TEST_EQ(results[i].get(), i + 1);
+    }
+}
+
+void test_batched_void(hpx::id_type const& target)
+{
+    std::int32_t before = hpx::sync<get_count_action>(target);
+
+    std::vector<hpx::future<void>> results;
+    {
+        hpx::action_batcher<add_action> b(8);
+        for (std::int32_t i = 0; i != 20; ++i)
+        {
+            results.push_back(b.async(target, 1));
+        }
+
+        // the destructor sends all pending batches
+    }
+    hpx::wait_all(results);
+
+    HPX_TEST_EQ(hpx::sync<get_count_action>(target), before + 20);
+}
+
+void test_batched_exception(hpx::id_type const& target)
+{
+    hpx::action_batcher<throw_on_odd_action> b(2, std::chrono::seconds(0));
+
+    // the first batch fails as a whole, the second one succeeds
+    hpx::future<std::int32_t> f1 = b.async(target, 0);
+    hpx::future<std::int32_t> f2 = b.async(target, 1);
+    hpx::future<std::int32_t> f3 = b.async(target, 2);
+    hpx::future<std::int32_t> f4 = b.async(target, 4);
+
+    if (target == hpx::find_here())
+    {
+        // local invocations are not batched
+        HPX_TEST_EQ(f1.get(), 0);
+        HPX_TEST_THROW(f2.get(), std::exception);
+    }
+    else
+    {
+        HPX_TEST_THROW(f1.get(), std::exception);
+        HPX_TEST_THROW(f2.get(), std::exception);
+    }
+
+    HPX_TEST_EQ(f3.get(), 2);
+    HPX_TEST_EQ(f4.get(), 4);
+}
+
+void test_batched_component(hpx::id_type const& locality)
+{
+    hpx::id_type target =
+        hpx::components::new_<accumulator_server>(locality).get();
+
+    hpx::action_batcher<get_action> b(3);
+
+    std::vector<hpx::future<std::int32_t>> results;
+    for (std::int32_t i = 0; i != 40; ++i)
+    {
+        results.push_back(b.async(target, i % 4));
+    }
+    b.flush();
+
+    for (std::int32_t i = 0; i != 40; ++i)
+    {
+        HPX_TEST_EQ(results[i].get(), i % 4 + 1);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    for (hpx::id_type const& id : localities)
+    {
+        test_batched_plain(id);
+        test_batched_window(id);
+        test_batched_void(id);
+        test_batched_exception(id);
+        test_batched_component(id);
+    }
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,587 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+// hpx::task relies on symmetric transfer, which is not available with the
+// emulated coroutine support library
+#if defined(HPX_HAVE_CXX20_COROUTINES) ||                                      \
+    (defined(HPX_HAVE_AWAIT) &&                                                \
+        !defined(HPX_HAVE_EMULATE_COROUTINE_SUPPORT_LIBRARY))
+
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/execution/executors/execution.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/futures/traits/detail/future_await_traits.hpp>
+#include <hpx/modules/errors.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx {
+
+    template <typename T = void>
+    class task;
+
+    namespace lcos { namespace detail {
+
+        ///////////////////////////////////////////////////////////////////////
+        // The frames of the coroutines are allocated from the caches of the
+        // worker threads, which avoids going to the global heap for each
+        // (usually short-lived) coroutine frame.
+        struct task_frame_allocation
+        {
+            HPX_NODISCARD static void* operator new(std::size_t size)
+            {
+                return util::thread_local_caching_allocator<char>{}.allocate(
+                    size);
+            }
+
+            static void operator delete(void* p, std::size_t size) noexcept
+            {
+                util::thread_local_caching_allocator<char>{}.deallocate(
+                    static_cast<char*>(p), size);
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class task_promise_base : public task_frame_allocation
+        {
+        private:
+            struct final_awaiter
+            {
+                constexpr bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                // resume the awaiting coroutine without growing the stack
+                template <typename Promise>
+                coroutine_handle<> await_suspend(
+                    coroutine_handle<Promise> h) noexcept
+                {
+                    HPX_ASSERT(h.promise().continuation_);
+                    return h.promise().continuation_;
+                }
+
+                constexpr void await_resume() const noexcept {}
+            };
+
+        public:
+            // tasks are lazy, they start running once they are awaited
+            constexpr suspend_always initial_suspend() const noexcept
+            {
+                return suspend_always{};
+            }
+
+            constexpr final_awaiter final_suspend() const noexcept
+            {
+                return final_awaiter{};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+
+            // This is invoked if an awaited future holds an exception, which
+            // will be rethrown from the corresponding await_resume anyways.
+            void set_exception(std::exception_ptr const&) noexcept {}
+
+            void set_continuation(coroutine_handle<> continuation) noexcept
+            {
+                continuation_ = continuation;
+            }
+
+        protected:
+            void rethrow_if_exception() const
+            {
+                if (exception_)
+                {
+                    std::rethrow_exception(exception_);
+                }
+            }
+
+        private:
+            coroutine_handle<> continuation_;
+            std::exception_ptr exception_;
+        };
+
+        template <typename T>
+        class task_promise : public task_promise_base
+        {
+        public:
+            task<T> get_return_object() noexcept;
+
+            template <typename U,
+                typename Enable = typename std::enable_if<
+                    std::is_convertible<U&&, T>::value>::type>
+            void return_value(U&& value)
+            {
+                value_.emplace(std::forward<U>(value));
+            }
+
+            T& result() &
+            {
+                rethrow_if_exception();
+                return *value_;
+            }
+
+            T&& result() &&
+            {
+                rethrow_if_exception();
+                return std::move(*value_);
+            }
+
+        private:
+            util::optional<T> value_;
+        };
+
+        template <typename T>
+        class task_promise<T&> : public task_promise_base
+        {
+        public:
+            task<T&> get_return_object() noexcept;
+
+            void return_value(T& value) noexcept
+            {
+                value_ = &value;
+            }
+
+            T& result() const
+            {
+                rethrow_if_exception();
+                return *value_;
+            }
+
+        private:
+            T* value_ = nullptr;
+        };
+
+        template <>
+        class task_promise<void> : public task_promise_base
+        {
+        public:
+            task<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+
+            void result() const
+            {
+                rethrow_if_exception();
+            }
+        };
+    }}    // namespace lcos::detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A lazily started coroutine producing a value of type T.
+    ///
+    /// Other than a coroutine returning an hpx::future<T>, a task does not
+    /// allocate a shared state. It starts running once it is awaited (using
+    /// co_await) and resumes the awaiting coroutine directly when it
+    /// finishes. The coroutine frame is owned by the task object.
+    template <typename T>
+    class task
+    {
+    public:
+        using promise_type = lcos::detail::task_promise<T>;
+        using value_type = T;
+
+    private:
+        using handle_type = lcos::detail::coroutine_handle<promise_type>;
+
+        struct awaiter_base
+        {
+            bool await_ready() const noexcept
+            {
+                return !coro_ || coro_.done();
+            }
+
+            // start the awaited task, it will resume the awaiting coroutine
+            // once it has finished
+            lcos::detail::coroutine_handle<> await_suspend(
+                lcos::detail::coroutine_handle<> awaiting) noexcept
+            {
+                coro_.promise().set_continuation(awaiting);
+                return coro_;
+            }
+
+            promise_type& promise() const
+            {
+                if (!coro_)
+                {
+                    HPX_THROW_EXCEPTION(no_state, "task<T>::operator co_await",
+                        "this task has no valid coroutine associated with it");
+                }
+                return coro_.promise();
+            }
+
+            handle_type coro_;
+        };
+
+    public:
+        constexpr task() noexcept = default;
+
+        explicit task(handle_type coro) noexcept
+          : coro_(coro)
+        {
+        }
+
+        task(task&& rhs) noexcept
+          : coro_(rhs.coro_)
+        {
+            rhs.coro_ = nullptr;
+        }
+
+        task& operator=(task&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (coro_)
+                    coro_.destroy();
+                coro_ = rhs.coro_;
+                rhs.coro_ = nullptr;
+            }
+            return *this;
+        }
+
+        task(task const&) = delete;
+        task& operator=(task const&) = delete;
+
+        ~task()
+        {
+            if (coro_)
+                coro_.destroy();
+        }
+
+        bool valid() const noexcept
+        {
+            return bool(coro_);
+        }
+
+        bool is_ready() const noexcept
+        {
+            return !coro_ || coro_.done();
+        }
+
+        auto operator co_await() const& noexcept
+        {
+            struct awaiter : awaiter_base
+            {
+                decltype(auto) await_resume()
+                {
+                    return this->promise().result();
+                }
+            };
+            return awaiter{{coro_}};
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct awaiter : awaiter_base
+            {
+                decltype(auto) await_resume()
+                {
+                    return std::move(this->promise()).result();
+                }
+            };
+            return awaiter{{coro_}};
+        }
+
+        /// Wait for the task to finish without retrieving its result (and
+        /// without rethrowing any exception it might hold).
+        auto when_ready() const noexcept
+        {
+            struct awaiter : awaiter_base
+            {
+                constexpr void await_resume() const noexcept {}
+            };
+            return awaiter{{coro_}};
+        }
+
+    private:
+        handle_type coro_ = nullptr;
+    };
+
+    namespace lcos { namespace detail {
+
+        template <typename T>
+        task<T> task_promise<T>::get_return_object() noexcept
+        {
+            return task<T>(coroutine_handle<task_promise>::from_promise(*this));
+        }
+
+        template <typename T>
+        task<T&> task_promise<T&>::get_return_object() noexcept
+        {
+            return task<T&>(
+                coroutine_handle<task_promise>::from_promise(*this));
+        }
+
+        inline task<void> task_promise<void>::get_return_object() noexcept
+        {
+            return task<void>(
+                coroutine_handle<task_promise>::from_promise(*this));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Executor>
+        struct schedule_awaiter
+        {
+            constexpr bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(coroutine_handle<> awaiting)
+            {
+                parallel::execution::post(
+                    exec_, [awaiting]() mutable { awaiting.resume(); });
+            }
+
+            constexpr void await_resume() const noexcept {}
+
+            Executor exec_;
+        };
+    }}    // namespace lcos::detail
+
+    /// Returns an awaitable which resumes the awaiting coroutine on a new
+    /// HPX thread created by the given executor, e.g.
+    ///
+    ///     co_await hpx::schedule(exec);
+    ///
+    /// continues running the coroutine on the thread pool associated with
+    /// the executor.
+    template <typename Executor>
+    lcos::detail::schedule_awaiter<typename std::decay<Executor>::type>
+    schedule(Executor&& exec)
+    {
+        return {std::forward<Executor>(exec)};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace lcos { namespace detail {
+
+        // The last of the tasks to finish (or the awaiting coroutine if all
+        // tasks have finished before it could be suspended) resumes the
+        // awaiting coroutine.
+        class when_all_counter
+        {
+        public:
+            explicit when_all_counter(std::size_t count) noexcept
+              : count_(count + 1)
+            {
+            }
+
+            // returns whether the awaiting coroutine has to be suspended
+            bool try_await(coroutine_handle<> awaiting) noexcept
+            {
+                awaiting_ = awaiting;
+                return count_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+            }
+
+            // returns the coroutine to resume after a task has finished
+            coroutine_handle<> notify_completed() noexcept
+            {
+                if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    return awaiting_;
+                }
+                return noop_coroutine();
+            }
+
+        private:
+            std::atomic<std::size_t> count_;
+            coroutine_handle<> awaiting_;
+        };
+
+        // Coroutine wrapping each of the tasks passed to when_all, its only
+        // purpose is to notify the counter once the wrapped task has
+        // finished.
+        class when_all_helper
+        {
+        public:
+            struct promise_type : task_frame_allocation
+            {
+                struct final_awaiter
+                {
+                    constexpr bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+
+                    coroutine_handle<> await_suspend(
+                        coroutine_handle<promise_type> h) noexcept
+                    {
+                        return h.promise().counter_->notify_completed();
+                    }
+
+                    constexpr void await_resume() const noexcept {}
+                };
+
+                when_all_helper get_return_object() noexcept
+                {
+                    return when_all_helper(
+                        coroutine_handle<promise_type>::from_promise(*this));
+                }
+
+                constexpr suspend_always initial_suspend() const noexcept
+                {
+                    return suspend_always{};
+                }
+
+                constexpr final_awaiter final_suspend() const noexcept
+                {
+                    return final_awaiter{};
+                }
+
+                constexpr void return_void() const noexcept {}
+
+                // the wrapped task is awaited using when_ready(), which
+                // never throws
+                void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+
+                when_all_counter* counter_ = nullptr;
+            };
+
+            explicit when_all_helper(
+                coroutine_handle<promise_type> coro) noexcept
+              : coro_(coro)
+            {
+            }
+
+            when_all_helper(when_all_helper&& rhs) noexcept
+              : coro_(rhs.coro_)
+            {
+                rhs.coro_ = nullptr;
+            }
+
+            when_all_helper(when_all_helper const&) = delete;
+            when_all_helper& operator=(when_all_helper&&) = delete;
+            when_all_helper& operator=(when_all_helper const&) = delete;
+
+            ~when_all_helper()
+            {
+                if (coro_)
+                    coro_.destroy();
+            }
+
+            void start(when_all_counter& counter) noexcept
+            {
+                coro_.promise().counter_ = &counter;
+                coro_.resume();
+            }
+
+        private:
+            coroutine_handle<promise_type> coro_;
+        };
+
+        template <typename T>
+        when_all_helper make_when_all_helper(task<T> const& t)
+        {
+            co_await t.when_ready();
+        }
+
+        template <typename T>
+        class when_all_awaitable
+        {
+        public:
+            explicit when_all_awaitable(std::vector<task<T>> const& tasks)
+              : counter_(tasks.size())
+            {
+                helpers_.reserve(tasks.size());
+                for (auto const& t : tasks)
+                {
+                    helpers_.push_back(make_when_all_helper(t));
+                }
+            }
+
+            bool await_ready() const noexcept
+            {
+                return helpers_.empty();
+            }
+
+            bool await_suspend(coroutine_handle<> awaiting) noexcept
+            {
+                for (auto& helper : helpers_)
+                {
+                    helper.start(counter_);
+                }
+                return counter_.try_await(awaiting);
+            }
+
+            constexpr void await_resume() const noexcept {}
+
+        private:
+            when_all_counter counter_;
+            std::vector<when_all_helper> helpers_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        hpx::future<T> make_future_from_task(task<T> t)
+        {
+            co_return co_await std::move(t);
+        }
+
+        inline hpx::future<void> make_future_from_task(task<void> t)
+        {
+            co_await std::move(t);
+        }
+    }}    // namespace lcos::detail
+
+    /// Returns a task which finishes once all of the given tasks have
+    /// finished. All tasks are started concurrently, the result holds the
+    /// values produced by the tasks in the order of the input. If any of the
+    /// tasks finished with an exception, the first of those is rethrown.
+    template <typename T,
+        typename Enable =
+            typename std::enable_if<!std::is_void<T>::value>::type>
+    task<std::vector<T>> when_all(std::vector<task<T>> tasks)
+    {
+        co_await lcos::detail::when_all_awaitable<T>(tasks);
+
+        std::vector<T> results;
+        results.reserve(tasks.size());
+        for (auto& t : tasks)
+        {
+            // all tasks are ready, this does not suspend
+            results.push_back(co_await std::move(t));
+        }
+        co_return results;
+    }
+
+    inline task<void> when_all(std::vector<task<void>> tasks)
+    {
+        co_await lcos::detail::when_all_awaitable<void>(tasks);
+
+        for (auto& t : tasks)
+        {
+            co_await std::move(t);
+        }
+    }
+
+    /// Runs the given task and blocks the calling HPX thread until it has
+    /// finished. Returns the value produced by the task.
+    template <typename T>
+    T sync_wait(task<T> t)
+    {
+        return lcos::detail::make_future_from_task(std::move(t)).get();
+    }
+}    // namespace hpx
+
+#endif
@@ -527,8 +527,9 @@ namespace hpx { namespace util {
                 ("hpx:queuing", value<std::string>(),
                   "the queue scheduling policy to use, options are "
                   "'local', 'local-priority-fifo','local-priority-lifo', "
-                  "'abp-priority-fifo', 'abp-priority-lifo', 'static', and "
-                  "'static-priority' (default: 'local-priority'; "
+                  "'abp-priority-fifo', 'abp-priority-lifo', 'static', "
+                  "'static-priority', and 'work-stealing' (default: "
+                  "'local-priority'; "
                   "all option values can be abbreviated)")
                 ("hpx:high-priority-threads", value<std::size_t>(),
                   "the number of operating system threads maintaining a high "
@@ -628,7 +629,8 @@ namespace hpx { namespace util {
                   "   'full' (prints all available counter infos)")
                 ("hpx:print-counter-format", value<std::string>(),
                   "print the performance counter(s) specified with --hpx:print-counter "
-                  "in a given format (default: normal)")
+                  "in a given format (default: normal), possible values: "
+                  "'normal', 'csv', 'csv-short', or 'openmetrics'")
                 ("hpx:csv-header",
                   "print the performance counter(s) specified with --hpx:print-counter "
                   "with header when format specified with --hpx:print-counter-format"
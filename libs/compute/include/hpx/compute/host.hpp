@@ -12,6 +12,8 @@
 #include <hpx/compute/host/block_executor.hpp>
 #include <hpx/compute/host/get_targets.hpp>
 #include <hpx/compute/host/numa_domains.hpp>
+#include <hpx/compute/host/numa_partitioned_executor.hpp>
+#include <hpx/compute/host/numa_partitioned_view.hpp>
 #include <hpx/compute/host/target.hpp>
 #include <hpx/compute/host/target_distribution_policy.hpp>
 #include <hpx/compute/host/traits/access_target.hpp>
@@ -0,0 +1,479 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/async_combinators/wait_all.hpp>
+#include <hpx/compute/host/target.hpp>
+#include <hpx/datastructures/tuple.hpp>
+#include <hpx/execution/executors/execution.hpp>
+#include <hpx/execution/executors/static_chunk_size.hpp>
+#include <hpx/execution/traits/executor_traits.hpp>
+#include <hpx/execution/traits/is_executor.hpp>
+#include <hpx/executors/restricted_thread_pool_executor.hpp>
+#include <hpx/functional/deferred_call.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/iterator_support/range.hpp>
+#include <hpx/iterator_support/traits/is_iterator.hpp>
+#include <hpx/iterator_support/zip_iterator.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace compute { namespace host {
+    namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // Keeps track of which target owns which part of the memory ranges
+        // registered by a numa_partitioned_view
+        class numa_partition_map
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            struct range
+            {
+                char const* begin_;
+                char const* end_;
+                // start address of the partition owned by target i
+                std::vector<char const*> bounds_;
+            };
+
+        public:
+            void add(char const* begin, char const* end,
+                std::vector<char const*>&& bounds)
+            {
+                HPX_ASSERT(!bounds.empty());
+
+                std::lock_guard<mutex_type> l(mtx_);
+                ranges_.push_back(range{begin, end, std::move(bounds)});
+            }
+
+            void remove(char const* begin)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = std::find_if(ranges_.begin(), ranges_.end(),
+                    [begin](range const& r) { return r.begin_ == begin; });
+                if (it != ranges_.end())
+                    ranges_.erase(it);
+            }
+
+            // store the index of the target owning each of the given
+            // addresses, or std::size_t(-1) if an address is not part of a
+            // registered range
+            template <typename Iter>
+            void find_targets(Iter first, Iter last, std::size_t* targets) const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (/**/; first != last; ++first, ++targets)
+                {
+                    *targets = find_target_locked(*first);
+                }
+            }
+
+        private:
+            std::size_t find_target_locked(void const* p) const
+            {
+                char const* addr = static_cast<char const*>(p);
+                if (addr == nullptr)
+                    return std::size_t(-1);
+
+                for (range const& r : ranges_)
+                {
+                    if (addr < r.begin_ || addr >= r.end_)
+                        continue;
+
+                    auto it = std::upper_bound(
+                        r.bounds_.begin(), r.bounds_.end(), addr);
+                    return std::size_t(std::distance(r.bounds_.begin(), it)) -
+                        1;
+                }
+                return std::size_t(-1);
+            }
+
+            mutable mutex_type mtx_;
+            std::vector<range> ranges_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Iter, typename Enable = void>
+        struct has_addressable_elements : std::false_type
+        {
+        };
+
+        template <typename Iter>
+        struct has_addressable_elements<Iter,
+            typename std::enable_if<
+                hpx::traits::is_iterator<Iter>::value>::type>
+          : std::is_lvalue_reference<
+                typename std::iterator_traits<Iter>::reference>
+        {
+        };
+
+        // Extract the address of the first element referred to by a chunk
+        // (as generated by the partitioners of the parallel algorithms).
+        template <typename Iter>
+        void const* get_iterator_address(Iter const& it, std::true_type)
+        {
+            return std::addressof(*it);
+        }
+
+        template <typename Iter>
+        void const* get_iterator_address(Iter const&, std::false_type)
+        {
+            return nullptr;
+        }
+
+        template <typename Iter>
+        void const* get_iterator_address(Iter const& it)
+        {
+            return get_iterator_address(
+                it, has_addressable_elements<Iter>());
+        }
+
+        // the first sequence of zipped ranges decides about the placement
+        template <typename... Iters>
+        void const* get_iterator_address(
+            hpx::util::zip_iterator<Iters...> const& it)
+        {
+            return get_iterator_address(
+                hpx::util::get<0>(it.get_iterator_tuple()));
+        }
+
+        template <typename Iter, typename... Ts>
+        void const* get_chunk_address(hpx::util::tuple<Iter, Ts...> const& t)
+        {
+            return get_iterator_address(hpx::util::get<0>(t));
+        }
+
+        template <typename T>
+        void const* get_chunk_address(T const&)
+        {
+            return nullptr;
+        }
+
+        // The first argument of a single task decides about its placement,
+        // it is either an iterator (as passed by the scan partitioner) or a
+        // chunk.
+        template <typename T>
+        void const* get_argument_address(T const& t, std::true_type)
+        {
+            return get_iterator_address(t);
+        }
+
+        template <typename T>
+        void const* get_argument_address(T const& t, std::false_type)
+        {
+            return get_chunk_address(t);
+        }
+
+        inline void const* get_task_address()
+        {
+            return nullptr;
+        }
+
+        template <typename T, typename... Ts>
+        void const* get_task_address(T const& t, Ts const&...)
+        {
+            return get_argument_address(t,
+                std::integral_constant<bool,
+                    hpx::traits::is_iterator<T>::value>());
+        }
+    }    // namespace detail
+
+    /// The numa_partitioned_executor runs each chunk of work generated by a
+    /// parallel algorithm on the target owning the memory the chunk refers
+    /// to. The ownership is recorded by the numa_partitioned_view instances
+    /// created for this executor. Chunks referring to memory not managed by
+    /// any view are distributed evenly across the targets (same as the
+    /// block_executor).
+    ///
+    /// Single tasks (post, async_execute, sync_execute) are placed the same
+    /// way if their first argument is an iterator or a chunk, which is the
+    /// case for the tasks created by the scan_partitioner and for the
+    /// workers of the single-pass scan (scan_lookback_partitioner). All
+    /// other tasks are distributed round robin.
+    ///
+    /// \tparam Executor The underlying executor to use for each target
+    template <typename Executor =
+                  hpx::parallel::execution::restricted_thread_pool_executor>
+    class numa_partitioned_executor
+    {
+    public:
+        typedef hpx::parallel::execution::static_chunk_size
+            executor_parameters_type;
+
+        explicit numa_partitioned_executor(
+            std::vector<host::target> const& targets,
+            threads::thread_priority priority = threads::thread_priority_high)
+          : targets_(targets)
+          , current_(0)
+          , map_(std::make_shared<detail::numa_partition_map>())
+        {
+            init_executors(priority);
+        }
+
+        numa_partitioned_executor(numa_partitioned_executor const& other)
+          : targets_(other.targets_)
+          , current_(0)
+          , executors_(other.executors_)
+          , map_(other.map_)
+        {
+        }
+
+        numa_partitioned_executor& operator=(
+            numa_partitioned_executor const& other)
+        {
+            if (&other != this)
+            {
+                targets_ = other.targets_;
+                current_ = 0;
+                executors_ = other.executors_;
+                map_ = other.map_;
+            }
+            return *this;
+        }
+
+        /// \cond NOINTERNAL
+        bool operator==(numa_partitioned_executor const& rhs) const noexcept
+        {
+            return map_ == rhs.map_;
+        }
+
+        bool operator!=(numa_partitioned_executor const& rhs) const noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        std::vector<host::target> const& context() const noexcept
+        {
+            return targets_;
+        }
+        /// \endcond
+
+        template <typename F, typename... Ts>
+        void post(F&& f, Ts&&... ts)
+        {
+            std::size_t current = get_target(ts...);
+            parallel::execution::post(executors_[current], std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename... Ts>
+        hpx::future<
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
+        async_execute(F&& f, Ts&&... ts)
+        {
+            std::size_t current = get_target(ts...);
+            return parallel::execution::async_execute(executors_[current],
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename... Ts>
+        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type
+        sync_execute(F&& f, Ts&&... ts)
+        {
+            std::size_t current = get_target(ts...);
+            return parallel::execution::sync_execute(executors_[current],
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename Shape, typename... Ts>
+        std::vector<hpx::future<typename parallel::execution::detail::
+                bulk_function_result<F, Shape, Ts...>::type>>
+        bulk_async_execute(F&& f, Shape const& shape, Ts&&... ts)
+        {
+            std::vector<hpx::future<typename parallel::execution::detail::
+                    bulk_function_result<F, Shape, Ts...>::type>>
+                results;
+            std::size_t const cnt = util::size(shape);
+            std::size_t const num_executors = executors_.size();
+
+            results.reserve(cnt);
+
+            try
+            {
+                // look up the owners of all chunks at once
+                std::vector<void const*> addresses;
+                addresses.reserve(cnt);
+                for (auto const& elem : shape)
+                {
+                    addresses.push_back(detail::get_chunk_address(elem));
+                }
+
+                std::vector<std::size_t> owners(cnt);
+                map_->find_targets(
+                    addresses.begin(), addresses.end(), owners.data());
+
+                std::size_t i = 0;
+                for (auto const& elem : shape)
+                {
+                    std::size_t owner = owners[i];
+                    if (owner >= num_executors)
+                    {
+                        // not part of a registered range, distribute evenly
+                        owner = (i * num_executors) / cnt;
+                    }
+
+                    results.push_back(parallel::execution::async_execute(
+                        executors_[owner], f, elem, ts...));
+                    ++i;
+                }
+                return results;
+            }
+            catch (std::bad_alloc const& ba)
+            {
+                throw ba;
+            }
+            catch (...)
+            {
+                throw exception_list(std::current_exception());
+            }
+        }
+
+        template <typename F, typename Shape, typename... Ts>
+        typename parallel::execution::detail::bulk_execute_result<F, Shape,
+            Ts...>::type
+        bulk_sync_execute(F&& f, Shape const& shape, Ts&&... ts)
+        {
+            using is_void = std::is_void<typename parallel::execution::detail::
+                    bulk_function_result<F, Shape, Ts...>::type>;
+
+            return bulk_sync_execute_impl(is_void(),
+                bulk_async_execute(
+                    std::forward<F>(f), shape, std::forward<Ts>(ts)...));
+        }
+
+        std::size_t processing_units_count() const
+        {
+            std::size_t count = 0;
+            for (auto const& tgt : targets_)
+            {
+                count += tgt.num_pus().second;
+            }
+            return count;
+        }
+
+        std::vector<host::target> const& targets() const
+        {
+            return targets_;
+        }
+
+        /// \cond NOINTERNAL
+        detail::numa_partition_map& partition_map() const
+        {
+            return *map_;
+        }
+        /// \endcond
+
+    private:
+        // find the target owning the data the task refers to, fall back to
+        // round robin for everything else
+        template <typename... Ts>
+        std::size_t get_target(Ts const&... ts)
+        {
+            void const* address = detail::get_task_address(ts...);
+
+            std::size_t owner = std::size_t(-1);
+            if (address != nullptr)
+            {
+                map_->find_targets(&address, &address + 1, &owner);
+            }
+
+            if (owner >= executors_.size())
+            {
+                owner = ++current_ % executors_.size();
+            }
+            return owner;
+        }
+
+        template <typename Future>
+        static void bulk_sync_execute_impl(
+            std::true_type, std::vector<Future>&& futures)
+        {
+            hpx::wait_all(futures);
+            for (auto& f : futures)
+            {
+                f.get();    // rethrow exceptions, if any
+            }
+        }
+
+        template <typename Future>
+        static auto bulk_sync_execute_impl(
+            std::false_type, std::vector<Future>&& futures)
+            -> std::vector<decltype(std::declval<Future>().get())>
+        {
+            std::vector<decltype(std::declval<Future>().get())> results;
+            results.reserve(futures.size());
+            for (auto& f : futures)
+            {
+                results.push_back(f.get());
+            }
+            return results;
+        }
+
+        void init_executors(threads::thread_priority priority)
+        {
+            executors_.reserve(targets_.size());
+            for (auto const& tgt : targets_)
+            {
+                auto num_pus = tgt.num_pus();
+                executors_.emplace_back(
+                    num_pus.first, num_pus.second, priority);
+            }
+        }
+
+        std::vector<host::target> targets_;
+        std::atomic<std::size_t> current_;
+        std::vector<Executor> executors_;
+        std::shared_ptr<detail::numa_partition_map> map_;
+    };
+}}}    // namespace hpx::compute::host
+
+namespace hpx { namespace parallel { namespace execution {
+    /// \cond NOINTERNAL
+    template <typename Executor>
+    struct executor_execution_category<
+        compute::host::numa_partitioned_executor<Executor>>
+    {
+        typedef parallel::execution::parallel_execution_tag type;
+    };
+
+    template <typename Executor>
+    struct is_one_way_executor<
+        compute::host::numa_partitioned_executor<Executor>> : std::true_type
+    {
+    };
+
+    template <typename Executor>
+    struct is_two_way_executor<
+        compute::host::numa_partitioned_executor<Executor>> : std::true_type
+    {
+    };
+
+    template <typename Executor>
+    struct is_bulk_one_way_executor<
+        compute::host::numa_partitioned_executor<Executor>> : std::true_type
+    {
+    };
+
+    template <typename Executor>
+    struct is_bulk_two_way_executor<
+        compute::host::numa_partitioned_executor<Executor>> : std::true_type
+    {
+    };
+    /// \endcond
+}}}    // namespace hpx::parallel::execution
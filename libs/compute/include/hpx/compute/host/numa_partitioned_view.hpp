@@ -0,0 +1,214 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/compute/host/numa_partitioned_executor.hpp>
+#include <hpx/compute/host/target.hpp>
+#include <hpx/execution/executors/static_chunk_size.hpp>
+#include <hpx/executors/restricted_thread_pool_executor.hpp>
+#include <hpx/iterator_support/iterator_range.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace compute { namespace host {
+    /// A numa_partitioned_view splits a contiguous range of elements into one
+    /// partition per target of the given numa_partitioned_executor and
+    /// records which target owns which partition. Parallel algorithms invoked
+    /// with an execution policy created from executor() and parameters()
+    /// schedule every chunk on the target owning the chunk's elements. In
+    /// particular, initializing not yet touched memory this way places its
+    /// pages on the NUMA domain of the owning target (first touch).
+    ///
+    /// Partition boundaries are multiples of the chunk size returned by
+    /// parameters(), which in turn is a multiple of the number of elements
+    /// per memory page (if possible). Chunks therefore never straddle
+    /// partitions as long as the algorithms are invoked on ranges starting at
+    /// begin() (or at the same offset for all views sharing an executor).
+    ///
+    /// \note The view does not own the referenced memory. Several views (for
+    ///       instance all arguments of a binary transform) may be associated
+    ///       with the same executor.
+    template <typename T,
+        typename Executor =
+            hpx::parallel::execution::restricted_thread_pool_executor>
+    class numa_partitioned_view
+    {
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = T const*;
+        using executor_type = numa_partitioned_executor<Executor>;
+
+        numa_partitioned_view(T* data, std::size_t size, executor_type exec)
+          : data_(data)
+          , size_(size)
+          , exec_(std::move(exec))
+          , chunk_size_(1)
+        {
+            init_partitions();
+        }
+
+        numa_partitioned_view(numa_partitioned_view&& rhs) noexcept
+          : data_(rhs.data_)
+          , size_(rhs.size_)
+          , exec_(rhs.exec_)
+          , offsets_(std::move(rhs.offsets_))
+          , chunk_size_(rhs.chunk_size_)
+        {
+            // the registration of the memory range is taken over
+            rhs.data_ = nullptr;
+            rhs.size_ = 0;
+        }
+
+        numa_partitioned_view(numa_partitioned_view const&) = delete;
+        numa_partitioned_view& operator=(numa_partitioned_view const&) = delete;
+        numa_partitioned_view& operator=(numa_partitioned_view&&) = delete;
+
+        ~numa_partitioned_view()
+        {
+            if (data_ != nullptr)
+            {
+                exec_.partition_map().remove(
+                    reinterpret_cast<char const*>(data_));
+            }
+        }
+
+        iterator begin() noexcept
+        {
+            return data_;
+        }
+        const_iterator begin() const noexcept
+        {
+            return data_;
+        }
+        iterator end() noexcept
+        {
+            return data_ + size_;
+        }
+        const_iterator end() const noexcept
+        {
+            return data_ + size_;
+        }
+
+        T* data() noexcept
+        {
+            return data_;
+        }
+        T const* data() const noexcept
+        {
+            return data_;
+        }
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Return the number of partitions (one per target)
+        std::size_t num_partitions() const noexcept
+        {
+            return offsets_.empty() ? 0 : offsets_.size() - 1;
+        }
+
+        /// Return the elements owned by the given target
+        hpx::util::iterator_range<iterator> partition(std::size_t i) noexcept
+        {
+            HPX_ASSERT(i < num_partitions());
+            return hpx::util::make_iterator_range(
+                data_ + offsets_[i], data_ + offsets_[i + 1]);
+        }
+
+        hpx::util::iterator_range<const_iterator> partition(
+            std::size_t i) const noexcept
+        {
+            HPX_ASSERT(i < num_partitions());
+            return hpx::util::make_iterator_range(
+                const_iterator(data_ + offsets_[i]),
+                const_iterator(data_ + offsets_[i + 1]));
+        }
+
+        /// Return the target owning the given partition
+        host::target const& target(std::size_t i) const
+        {
+            HPX_ASSERT(i < num_partitions());
+            return exec_.targets()[i];
+        }
+
+        /// Return the executor scheduling work according to the placement
+        /// recorded by this view
+        executor_type const& executor() const noexcept
+        {
+            return exec_;
+        }
+
+        /// Return the executor parameters generating chunks which are aligned
+        /// with the partitions of this view
+        hpx::parallel::execution::static_chunk_size parameters() const noexcept
+        {
+            return hpx::parallel::execution::static_chunk_size(chunk_size_);
+        }
+
+    private:
+        void init_partitions()
+        {
+            std::vector<host::target> const& targets = exec_.targets();
+            std::size_t const num_targets = targets.size();
+            if (data_ == nullptr || num_targets == 0)
+            {
+                data_ = nullptr;
+                size_ = 0;
+                return;
+            }
+
+            std::size_t max_pus = 1;
+            for (auto const& tgt : targets)
+            {
+                max_pus = (std::max)(max_pus, tgt.num_pus().second);
+            }
+
+            std::size_t const page_size = threads::get_memory_page_size();
+            std::size_t const page_elements =
+                (page_size % sizeof(T) == 0) ? page_size / sizeof(T) : 1;
+
+            // aim for 4 chunks per core in every partition while keeping the
+            // chunks (and therefore the partition boundaries) page aligned
+            std::size_t chunk_size = size_ / (num_targets * 4 * max_pus);
+            chunk_size = (std::max)(
+                (chunk_size / page_elements) * page_elements, page_elements);
+            chunk_size_ =
+                (std::min)(chunk_size, (std::max)(size_, std::size_t(1)));
+
+            offsets_.resize(num_targets + 1);
+            std::vector<char const*> bounds(num_targets);
+            for (std::size_t i = 0; i != num_targets; ++i)
+            {
+                std::size_t offset =
+                    ((i * size_ / num_targets + chunk_size_ / 2) /
+                        chunk_size_) *
+                    chunk_size_;
+                offsets_[i] = (std::min)(offset, size_);
+                bounds[i] = reinterpret_cast<char const*>(data_ + offsets_[i]);
+            }
+            offsets_[num_targets] = size_;
+
+            exec_.partition_map().add(reinterpret_cast<char const*>(data_),
+                reinterpret_cast<char const*>(data_ + size_),
+                std::move(bounds));
+        }
+
+        T* data_;
+        std::size_t size_;
+        executor_type exec_;
+        std::vector<std::size_t> offsets_;
+        std::size_t chunk_size_;
+    };
+}}}    // namespace hpx::compute::host
@@ -0,0 +1,258 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/compute/host.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_fill.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using executor_type = hpx::compute::host::numa_partitioned_executor<>;
+using view_type = hpx::compute::host::numa_partitioned_view<double>;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_partitions(view_type const& v, std::size_t num_targets)
+{
+    HPX_TEST_EQ(v.num_partitions(), num_targets);
+
+    // the partitions cover the whole range without gaps
+    double const* next = v.begin();
+    for (std::size_t i = 0; i != v.num_partitions(); ++i)
+    {
+        auto r = v.partition(i);
+        HPX_TEST(r.begin() == next);
+        next = r.end();
+    }
+    HPX_TEST(next == v.end());
+}
+
+void test_algorithms(executor_type const& exec, std::size_t count)
+{
+    std::vector<double> a(count), b(count), c(count);
+
+    view_type va(a.data(), count, exec);
+    view_type vb(b.data(), count, exec);
+    view_type vc(c.data(), count, exec);
+
+    test_partitions(va, exec.targets().size());
+
+    auto policy =
+        hpx::parallel::execution::par.on(va.executor()).with(va.parameters());
+
+    hpx::parallel::fill(policy, va.begin(), va.end(), 1.0);
+    hpx::parallel::fill(policy, vb.begin(), vb.end(), 2.0);
+
+    hpx::parallel::for_each(
+        policy, vb.begin(), vb.end(), [](double& d) { d *= 2.0; });
+
+    // binary transform over three views sharing the executor
+    hpx::parallel::transform(policy, va.begin(), va.end(), vb.begin(),
+        vc.begin(), [](double x, double y) { return x + y; });
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(c[i], 5.0);
+    }
+
+    double sum = hpx::parallel::reduce(policy, vc.begin(), vc.end(), 0.0);
+    HPX_TEST_EQ(sum, 5.0 * count);
+
+    hpx::parallel::inclusive_scan(policy, va.begin(), va.end(), vb.begin());
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(b[i], double(i + 1));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Records the address each task refers to together with the first thread of
+// the target it has been scheduled on.
+hpx::lcos::local::spinlock placement_mtx;
+std::vector<std::pair<void const*, std::size_t>> placements;
+
+struct recording_executor
+  : hpx::parallel::execution::restricted_thread_pool_executor
+{
+    using base_type = hpx::parallel::execution::restricted_thread_pool_executor;
+
+    recording_executor(std::size_t first_thread, std::size_t num_threads,
+        hpx::threads::thread_priority priority)
+      : base_type(first_thread, num_threads, priority)
+      , first_thread_(first_thread)
+    {
+    }
+
+    template <typename... Ts>
+    void record(Ts const&... ts) const
+    {
+        void const* address =
+            hpx::compute::host::detail::get_task_address(ts...);
+        if (address != nullptr)
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(placement_mtx);
+            placements.emplace_back(address, first_thread_);
+        }
+    }
+
+    template <typename F, typename... Ts>
+    auto async_execute(F&& f, Ts&&... ts) -> decltype(
+        std::declval<base_type&>().async_execute(
+            std::forward<F>(f), std::forward<Ts>(ts)...))
+    {
+        record(ts...);
+        return base_type::async_execute(
+            std::forward<F>(f), std::forward<Ts>(ts)...);
+    }
+
+    template <typename F, typename... Ts>
+    void post(F&& f, Ts&&... ts)
+    {
+        record(ts...);
+        base_type::post(std::forward<F>(f), std::forward<Ts>(ts)...);
+    }
+
+    std::size_t first_thread_;
+};
+
+namespace hpx { namespace parallel { namespace execution {
+    template <>
+    struct is_one_way_executor<recording_executor> : std::true_type
+    {
+    };
+
+    template <>
+    struct is_two_way_executor<recording_executor> : std::true_type
+    {
+    };
+}}}    // namespace hpx::parallel::execution
+
+using recording_executor_type =
+    hpx::compute::host::numa_partitioned_executor<recording_executor>;
+using recording_view_type =
+    hpx::compute::host::numa_partitioned_view<double, recording_executor>;
+
+// every recorded task referring to registered memory ran on its owner
+void check_placements(recording_executor_type const& exec)
+{
+    std::vector<std::pair<void const*, std::size_t>> recorded;
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> l(placement_mtx);
+        recorded.swap(placements);
+    }
+
+    std::size_t placed = 0;
+    for (auto const& p : recorded)
+    {
+        std::size_t owner = std::size_t(-1);
+        exec.partition_map().find_targets(&p.first, &p.first + 1, &owner);
+        if (owner < exec.targets().size())
+        {
+            HPX_TEST_EQ(exec.targets()[owner].num_pus().first, p.second);
+            ++placed;
+        }
+    }
+    HPX_TEST_NEQ(placed, std::size_t(0));
+}
+
+void test_placement(recording_executor_type const& exec, std::size_t count)
+{
+    std::vector<double> a(count), b(count);
+
+    recording_view_type va(a.data(), count, exec);
+    auto policy =
+        hpx::parallel::execution::par.on(va.executor()).with(va.parameters());
+
+    // chunks passed to bulk_async_execute
+    hpx::parallel::fill(policy, va.begin(), va.end(), 1.0);
+    check_placements(exec);
+
+    // tasks passed to async_execute by the scan_partitioner
+    auto result = hpx::parallel::copy_if(policy, va.begin(), va.end(),
+        b.begin(), [](double d) { return d != 0.0; });
+    HPX_TEST(result.out() == b.end());
+    check_placements(exec);
+
+    // workers of the single-pass scan
+    hpx::parallel::inclusive_scan(policy, va.begin(), va.end(), b.begin());
+    check_placements(exec);
+
+    // single tasks referring to elements of the view
+    auto exec_copy = va.executor();
+    for (std::size_t i = 0; i < count; i += (count + 7) / 8)
+    {
+        double* p = va.begin() + i;
+        hpx::parallel::execution::post(exec_copy, [](double*) {}, p);
+        hpx::parallel::execution::async_execute(exec_copy, [](double*) {}, p)
+            .get();
+        hpx::parallel::execution::sync_execute(
+            exec_copy, [](double*) {}, p);
+    }
+    check_placements(exec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int) std::random_device{}();
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(1, 100000);
+
+    {
+        // one target per NUMA domain
+        executor_type exec(hpx::compute::host::numa_domains());
+        test_algorithms(exec, dis(gen));
+    }
+
+    {
+        // one target per core
+        executor_type exec(hpx::compute::host::get_local_targets());
+        test_algorithms(exec, dis(gen));
+        test_algorithms(exec, 1);
+    }
+
+    {
+        recording_executor_type exec(hpx::compute::host::get_local_targets());
+        test_placement(exec, dis(gen));
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace hpx::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run");
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
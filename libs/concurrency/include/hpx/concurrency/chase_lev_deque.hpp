@@ -0,0 +1,189 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Dynamic circular work-stealing deque, see:
+//
+//   D. Chase and Y. Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005
+//   N.M. Le, A. Pop, A. Cohen, and F. Zappa Nardelli, "Correct and Efficient
+//   Work-Stealing for Weak Memory Models", PPoPP 2013
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace concurrency {
+
+    /// A single-owner, multiple-thief deque. Only the owning thread may call
+    /// push() and pop(), those operate on the bottom end of the deque (LIFO).
+    /// Any thread may call steal(), which removes elements from the top end
+    /// (FIFO). The deque grows as needed, retired buffers are kept alive
+    /// until the deque is destroyed as concurrent thieves might still read
+    /// from them.
+    template <typename T>
+    class chase_lev_deque
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "chase_lev_deque requires trivially copyable elements");
+
+        class circular_array
+        {
+        public:
+            explicit circular_array(std::int64_t size)
+              : mask_(size - 1)
+              , buffer_(new std::atomic<T>[std::size_t(size)])
+            {
+                HPX_ASSERT(size > 0 && (size & (size - 1)) == 0);
+            }
+
+            std::int64_t size() const noexcept
+            {
+                return mask_ + 1;
+            }
+
+            T get(std::int64_t i) const noexcept
+            {
+                return buffer_[i & mask_].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t i, T x) noexcept
+            {
+                buffer_[i & mask_].store(x, std::memory_order_relaxed);
+            }
+
+            circular_array* grow(std::int64_t bottom, std::int64_t top) const
+            {
+                circular_array* a = new circular_array(2 * size());
+                for (std::int64_t i = top; i != bottom; ++i)
+                {
+                    a->put(i, get(i));
+                }
+                return a;
+            }
+
+        private:
+            std::int64_t mask_;
+            std::unique_ptr<std::atomic<T>[]> buffer_;
+        };
+
+    public:
+        explicit chase_lev_deque(std::size_t initial_size = 128)
+        {
+            top_.data_.store(0, std::memory_order_relaxed);
+            bottom_.data_.store(0, std::memory_order_relaxed);
+
+            std::int64_t size = 1;
+            while (size < std::int64_t(initial_size))
+                size <<= 1;
+
+            buffers_.emplace_back(new circular_array(size));
+            array_.store(buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        chase_lev_deque(chase_lev_deque const&) = delete;
+        chase_lev_deque(chase_lev_deque&&) = delete;
+        chase_lev_deque& operator=(chase_lev_deque const&) = delete;
+        chase_lev_deque& operator=(chase_lev_deque&&) = delete;
+
+        /// Add an element at the bottom end (owner only)
+        bool push(T x)
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.data_.load(std::memory_order_acquire);
+            circular_array* a = array_.load(std::memory_order_relaxed);
+
+            if (b - t > a->size() - 1)
+            {
+                // the deque is full, replace the buffer with a larger copy
+                buffers_.emplace_back(a->grow(b, t));
+                a = buffers_.back().get();
+                array_.store(a, std::memory_order_release);
+            }
+
+            a->put(b, x);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.data_.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /// Remove the element at the bottom end (owner only)
+        bool pop(T& x)
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed) - 1;
+            circular_array* a = array_.load(std::memory_order_relaxed);
+            bottom_.data_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // the deque was empty
+                bottom_.data_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            x = a->get(b);
+            if (t == b)
+            {
+                // this was the last element, race against the thieves
+                bool result = top_.data_.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.data_.store(b + 1, std::memory_order_relaxed);
+                return result;
+            }
+            return true;
+        }
+
+        /// Remove the element at the top end (any thread)
+        bool steal(T& x)
+        {
+            std::int64_t t = top_.data_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t b = bottom_.data_.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return false;
+
+            circular_array* a = array_.load(std::memory_order_acquire);
+            x = a->get(t);
+            return top_.data_.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+        }
+
+        /// Return whether the deque is (very likely) empty
+        bool empty() const noexcept
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+            return b <= t;
+        }
+
+        /// Return the (approximate) number of elements in the deque
+        std::size_t size() const noexcept
+        {
+            std::int64_t b = bottom_.data_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.data_.load(std::memory_order_relaxed);
+            return b > t ? std::size_t(b - t) : 0;
+        }
+
+    private:
+        // top_ is modified by the thieves, bottom_ by the owner only
+        util::cache_line_data<std::atomic<std::int64_t>> top_;
+        util::cache_line_data<std::atomic<std::int64_t>> bottom_;
+        std::atomic<circular_array*> array_;
+
+        // all buffers ever used by this deque (owner only)
+        std::vector<std::unique_ptr<circular_array>> buffers_;
+    };
+}}    // namespace hpx::concurrency
@@ -0,0 +1,158 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/concurrency/chase_lev_deque.hpp>
+#include <hpx/modules/program_options.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+std::uint64_t threads = 2;
+std::uint64_t items = 100000;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_single_threaded()
+{
+    // start small to exercise growing the deque
+    hpx::concurrency::chase_lev_deque<std::uint64_t> q(2);
+    HPX_TEST(q.empty());
+
+    for (std::uint64_t i = 0; i != 100; ++i)
+        HPX_TEST(q.push(i));
+
+    HPX_TEST(!q.empty());
+    HPX_TEST_EQ(q.size(), std::size_t(100));
+
+    // steal() removes the oldest items
+    std::uint64_t val = 0;
+    HPX_TEST(q.steal(val));
+    HPX_TEST_EQ(val, std::uint64_t(0));
+    HPX_TEST(q.steal(val));
+    HPX_TEST_EQ(val, std::uint64_t(1));
+
+    // pop() removes the newest items
+    for (std::uint64_t i = 99; i != 1; --i)
+    {
+        HPX_TEST(q.pop(val));
+        HPX_TEST_EQ(val, i);
+    }
+
+    HPX_TEST(q.empty());
+    HPX_TEST(!q.pop(val));
+    HPX_TEST(!q.steal(val));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the owner pushes and pops all items while the thieves steal concurrently,
+// every item has to be seen exactly once
+void test_concurrent()
+{
+    hpx::concurrency::chase_lev_deque<std::uint64_t> q;
+
+    std::vector<std::atomic<std::uint64_t>> seen(items);
+    for (auto& s : seen)
+        s.store(0);
+
+    std::atomic<bool> done(false);
+    std::atomic<std::uint64_t> stolen(0);
+
+    auto thief = [&]() {
+        std::uint64_t val = 0;
+        while (!done.load())
+        {
+            if (q.steal(val))
+            {
+                ++seen[val];
+                ++stolen;
+            }
+        }
+    };
+
+    std::vector<std::thread> tg;
+    for (std::uint64_t i = 0; i != threads; ++i)
+        tg.push_back(std::thread(thief));
+
+    std::uint64_t val = 0;
+    std::uint64_t popped = 0;
+    for (std::uint64_t i = 0; i != items; ++i)
+    {
+        q.push(i);
+        if (i % 3 == 0 && q.pop(val))
+        {
+            ++seen[val];
+            ++popped;
+        }
+    }
+    while (q.pop(val))
+    {
+        ++seen[val];
+        ++popped;
+    }
+
+    done = true;
+    for (std::thread& t : tg)
+    {
+        if (t.joinable())
+            t.join();
+    }
+
+    for (std::uint64_t i = 0; i != items; ++i)
+        HPX_TEST_EQ(seen[i].load(), std::uint64_t(1));
+
+    // every item was either popped by the owner or stolen by a thief
+    HPX_TEST_EQ(popped + stolen.load(), items);
+}
+
+int main(int argc, char** argv)
+{
+    using hpx::program_options::command_line_parser;
+    using hpx::program_options::notify;
+    using hpx::program_options::options_description;
+    using hpx::program_options::store;
+    using hpx::program_options::value;
+    using hpx::program_options::variables_map;
+
+    variables_map vm;
+
+    options_description desc_cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("threads,t", value<std::uint64_t>(&threads)->default_value(2),
+         "the number of threads stealing from the deque")
+        ("items,i", value<std::uint64_t>(&items)->default_value(100000),
+         "the number of items to push onto the deque")
+    ;
+    // clang-format on
+
+    store(command_line_parser(argc, argv)
+              .options(desc_cmdline)
+              .allow_unregistered()
+              .run(),
+        vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return hpx::util::report_errors();
+    }
+
+    test_single_threaded();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
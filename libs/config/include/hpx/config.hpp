@@ -383,6 +383,13 @@
 #  define HPX_IDLE_LOOP_COUNT_MAX 200000
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Default number of messages the asynchronous logging backend buffers per
+// thread (see hpx.logging.async_buffer_size)
+#if !defined(HPX_LOGGING_ASYNC_BUFFER_SIZE_DEFAULT)
+#  define HPX_LOGGING_ASYNC_BUFFER_SIZE_DEFAULT 4096
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Count number of busy thread manager loop executions before forcefully
 // cleaning up terminated thread objects
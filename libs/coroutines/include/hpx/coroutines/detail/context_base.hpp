@@ -81,9 +81,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
 #if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
           , m_phase(0)
 #endif
-#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-          , m_thread_data(nullptr)
-#else
+#if !defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
           , m_thread_data(0)
 #endif
           , m_type_info()
@@ -95,7 +93,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         void reset_tss()
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            delete_tss_storage(m_thread_data);
+            m_thread_data.clear();
 #else
             m_thread_data = 0;
 #endif
@@ -200,9 +198,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
             HPX_ASSERT(!running());
             HPX_ASSERT(exited());
             m_thread_id.reset();
-#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            delete_tss_storage(m_thread_data);
-#else
+#if !defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
             m_thread_data = 0;
 #endif
         }
@@ -210,9 +206,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         std::size_t get_thread_data() const
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            if (!m_thread_data)
-                return 0;
-            return get_tss_thread_data(m_thread_data);
+            return m_thread_data.get_thread_data();
 #else
             return m_thread_data;
 #endif
@@ -221,7 +215,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         std::size_t set_thread_data(std::size_t data)
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            return set_tss_thread_data(m_thread_data, data);
+            return m_thread_data.set_thread_data(data);
 #else
             std::size_t olddata = m_thread_data;
             m_thread_data = data;
@@ -230,11 +224,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         }
 
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-        tss_storage* get_thread_tss_data(bool create_if_needed) const
+        tss_storage* get_thread_tss_data() const
         {
-            if (!m_thread_data && create_if_needed)
-                m_thread_data = create_tss_storage();
-            return m_thread_data;
+            return &m_thread_data;
         }
 #endif
 
@@ -342,7 +334,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         std::size_t m_phase;
 #endif
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-        mutable detail::tss_storage* m_thread_data;
+        mutable detail::tss_storage m_thread_data;
 #else
         mutable std::size_t m_thread_data;
 #endif
@@ -130,7 +130,6 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         virtual std::size_t set_thread_data(std::size_t data) = 0;
 
         virtual tss_storage* get_thread_tss_data() = 0;
-        virtual tss_storage* get_or_create_thread_tss_data() = 0;
 
         virtual std::size_t& get_continuation_recursion_count() = 0;
 
@@ -77,17 +77,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
             HPX_ASSERT(pimpl_);
-            return pimpl_->get_thread_tss_data(false);
-#else
-            return nullptr;
-#endif
-        }
-
-        tss_storage* get_or_create_thread_tss_data() override
-        {
-#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            HPX_ASSERT(pimpl_);
-            return pimpl_->get_thread_tss_data(true);
+            return pimpl_->get_thread_tss_data();
 #else
             return nullptr;
 #endif
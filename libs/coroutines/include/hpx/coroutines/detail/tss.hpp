@@ -15,9 +15,10 @@
 #include <hpx/assert.hpp>
 
 #include <cstddef>
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace threads { namespace coroutines { namespace detail {
     //////////////////////////////////////////////////////////////////////////
@@ -28,47 +29,52 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
         virtual void operator()(void* data) = 0;
     };
 
+    //////////////////////////////////////////////////////////////////////////
+    // Every thread_specific_ptr is assigned a slot index from a global
+    // registry, which is used to address its data in the storage of each
+    // thread. Slots are reused after the owning object has been destroyed.
+    HPX_EXPORT std::size_t allocate_tss_slot();
+    HPX_EXPORT void release_tss_slot(std::size_t slot) noexcept;
+
     //////////////////////////////////////////////////////////////////////////
     struct tss_data_node
     {
     private:
         std::shared_ptr<tss_cleanup_function> func_;
         void* value_;
+        void const* key_;
 
     public:
-        tss_data_node()
+        tss_data_node() noexcept
           : value_(nullptr)
-        {
-        }
-
-        tss_data_node(void* val)
-          : func_()
-          , value_(val)
-        {
-        }
-
-        tss_data_node(std::shared_ptr<tss_cleanup_function> f, void* val)
-          : func_(f)
-          , value_(val)
+          , key_(nullptr)
         {
         }
 
         tss_data_node(tss_data_node const&) = delete;
         tss_data_node& operator=(tss_data_node const&) = delete;
 
-        tss_data_node(tss_data_node&& other)
+        tss_data_node(tss_data_node&& other) noexcept
           : func_(std::move(other.func_))
           , value_(other.value_)
+          , key_(other.key_)
         {
             other.value_ = nullptr;
+            other.key_ = nullptr;
         }
 
         tss_data_node& operator=(tss_data_node&& other)
         {
-            cleanup();
-            func_ = std::move(other.func_);
-            value_ = other.value_;
-            other.value_ = nullptr;
+            if (this != &other)
+            {
+                // the previous data is cleaned up when old goes out of scope
+                tss_data_node old(std::move(*this));
+                func_ = std::move(other.func_);
+                value_ = other.value_;
+                key_ = other.key_;
+                other.value_ = nullptr;
+                other.key_ = nullptr;
+            }
             return *this;
         }
 
@@ -77,130 +83,136 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail {
             cleanup();
         }
 
-        template <typename T>
-        T get_data() const
-        {
-            HPX_ASSERT(value_ != nullptr);
-            return *reinterpret_cast<T*>(value_);
-        }
-
-        template <typename T>
-        void set_data(T const& val)
-        {
-            if (value_ == nullptr)
-                value_ = new T(val);
-            else
-                *reinterpret_cast<T*>(value_) = val;
-        }
-
         void cleanup(bool cleanup_existing = true);
 
-        void reinit(std::shared_ptr<tss_cleanup_function> const& f, void* data,
+        // The cleanup function may access thread specific data itself,
+        // which may move this node (if the storage grows). The previous data
+        // is therefore detached before it is cleaned up, and this node is
+        // not accessed anymore afterwards.
+        void reinit(void const* key,
+            std::shared_ptr<tss_cleanup_function> const& f, void* data,
             bool cleanup_existing)
         {
-            cleanup(cleanup_existing);
+            tss_data_node old(std::move(*this));
             func_ = f;
             value_ = data;
+            key_ = key;
+            old.cleanup(cleanup_existing);
         }
 
-        void* get_value() const
+        void* get_value() const noexcept
         {
             return value_;
         }
+
+        // the thread_specific_ptr this data belongs to
+        void const* get_key() const noexcept
+        {
+            return key_;
+        }
     };
 
     //////////////////////////////////////////////////////////////////////////
+    // The thread specific data of a single HPX thread. The entries are
+    // addressed by slot index, the first few of them are stored inline.
     class tss_storage
     {
-    private:
-        typedef std::map<void const*, tss_data_node> tss_node_data_map;
+    public:
+        static constexpr std::size_t num_inline_slots = 4;
 
-        tss_data_node const* find_entry(void const* key) const
-        {
-            tss_node_data_map::const_iterator it = data_.find(key);
-            if (it == data_.end())
-                return nullptr;
-            return &(it->second);
-        }
-        tss_data_node* find_entry(void const* key)
+        tss_storage() noexcept
+          : used_inline_slots_(0)
+          , thread_data_(0)
         {
-            tss_node_data_map::iterator it = data_.find(key);
-            if (it == data_.end())
-                return nullptr;
-            return &(it->second);
         }
 
-    public:
-        tss_storage() {}
+        tss_storage(tss_storage const&) = delete;
+        tss_storage& operator=(tss_storage const&) = delete;
 
-        ~tss_storage() {}
+        ~tss_storage()
+        {
+            clear();
+        }
 
-        std::size_t get_thread_data() const
+        std::size_t get_thread_data() const noexcept
         {
-            return 0;
+            return thread_data_;
         }
-        std::size_t set_thread_data(std::size_t /*val*/)
+        std::size_t set_thread_data(std::size_t val) noexcept
         {
-            return 0;
+            std::swap(thread_data_, val);
+            return val;
         }
 
-        tss_data_node* find(void const* key)
+        // Return the entry for the given slot, if it holds data belonging to
+        // the given key.
+        tss_data_node* find(std::size_t slot, void const* key) noexcept
         {
-            tss_node_data_map::iterator current_node = data_.find(key);
-            if (current_node != data_.end())
-                return &current_node->second;
-            return nullptr;
+            tss_data_node* node = nullptr;
+            if (slot < num_inline_slots)
+            {
+                node = &inline_slots_[slot];
+            }
+            else if (slot - num_inline_slots < overflow_slots_.size())
+            {
+                node = &overflow_slots_[slot - num_inline_slots];
+            }
+
+            if (node == nullptr || node->get_key() != key)
+                return nullptr;
+            return node;
         }
 
-        void insert(void const* key,
+        // Store the given data in the given slot, data left in the slot by
+        // a previous owner is cleaned up.
+        void insert(std::size_t slot, void const* key,
             std::shared_ptr<tss_cleanup_function> const& func, void* tss_data)
         {
-            data_.insert(std::make_pair(key, tss_data_node(func, tss_data)));
-        }
+            if (slot < num_inline_slots)
+            {
+                used_inline_slots_ |= std::uint8_t(1u << slot);
+                inline_slots_[slot].reinit(key, func, tss_data, true);
+                return;
+            }
 
-        void insert(void const* key, void* tss_data)
-        {
-            std::shared_ptr<tss_cleanup_function> func;
-            insert(key, func, tss_data);    //-V614
+            std::size_t const index = slot - num_inline_slots;
+            if (index >= overflow_slots_.size())
+                overflow_slots_.resize(index + 1);
+            overflow_slots_[index].reinit(key, func, tss_data, true);
         }
 
-        void erase(void const* key, bool cleanup_existing)
+        void erase(std::size_t slot, void const* key, bool cleanup_existing)
         {
-            tss_data_node* node = find(key);
-            if (node)
+            tss_data_node* node = find(slot, key);
+            if (node != nullptr)
             {
-                if (!cleanup_existing)
-                    node->cleanup(false);
-                data_.erase(key);
+                if (slot < num_inline_slots)
+                    used_inline_slots_ &= std::uint8_t(~(1u << slot));
+                node->reinit(nullptr, nullptr, nullptr, cleanup_existing);
             }
         }
 
+        // Run the cleanup functions for all entries holding data and reset
+        // the storage for reuse by the next HPX thread.
+        void clear();
+
     private:
-        tss_node_data_map data_;
+        static_assert(num_inline_slots <= 8,
+            "the inline slots in use are tracked by a std::uint8_t");
+
+        tss_data_node inline_slots_[num_inline_slots];
+        std::vector<tss_data_node> overflow_slots_;
+        std::uint8_t used_inline_slots_;
+        std::size_t thread_data_;
     };
 
     //////////////////////////////////////////////////////////////////////////
-    HPX_EXPORT tss_data_node* find_tss_data(void const* key);
-
-    HPX_EXPORT void* get_tss_data(void const* key);
-
-    HPX_EXPORT void add_new_tss_node(void const* key,
-        std::shared_ptr<tss_cleanup_function> const& func, void* tss_data);
+    HPX_EXPORT void* get_tss_data(std::size_t slot, void const* key);
 
     HPX_EXPORT void erase_tss_node(
-        void const* key, bool cleanup_existing = false);
+        std::size_t slot, void const* key, bool cleanup_existing = false);
 
-    HPX_EXPORT void set_tss_data(void const* key,
+    HPX_EXPORT void set_tss_data(std::size_t slot, void const* key,
         std::shared_ptr<tss_cleanup_function> const& func,
         void* tss_data = nullptr, bool cleanup_existing = false);
-
-    //////////////////////////////////////////////////////////////////////////
-    class tss_storage;
-
-    HPX_EXPORT tss_storage* create_tss_storage();
-    HPX_EXPORT void delete_tss_storage(tss_storage*& storage);
-
-    HPX_EXPORT std::size_t get_tss_thread_data(tss_storage* storage);
-    HPX_EXPORT std::size_t set_tss_thread_data(
-        tss_storage* storage, std::size_t);
 }}}}    // namespace hpx::threads::coroutines::detail
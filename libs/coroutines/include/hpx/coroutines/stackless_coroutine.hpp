@@ -65,9 +65,7 @@ namespace hpx { namespace threads { namespace coroutines {
 #if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
           , phase_(0)
 #endif
-#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-          , thread_data_(nullptr)
-#else
+#if !defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
           , thread_data_(0)
 #endif
           , continuation_recursion_count_(0)
@@ -76,9 +74,7 @@ namespace hpx { namespace threads { namespace coroutines {
 
         ~stackless_coroutine()
         {
-#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            detail::delete_tss_storage(thread_data_);
-#else
+#if !defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
             thread_data_ = 0;
 #endif
         }
@@ -102,9 +98,7 @@ namespace hpx { namespace threads { namespace coroutines {
         std::size_t get_thread_data() const
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            if (!thread_data_)
-                return 0;
-            return detail::get_tss_thread_data(thread_data_);
+            return thread_data_.get_thread_data();
 #else
             return thread_data_;
 #endif
@@ -113,7 +107,7 @@ namespace hpx { namespace threads { namespace coroutines {
         std::size_t set_thread_data(std::size_t data)
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            return detail::set_tss_thread_data(thread_data_, data);
+            return thread_data_.set_thread_data(data);
 #else
             std::size_t olddata = thread_data_;
             thread_data_ = data;
@@ -122,11 +116,9 @@ namespace hpx { namespace threads { namespace coroutines {
         }
 
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-        detail::tss_storage* get_thread_tss_data(bool create_if_needed) const
+        detail::tss_storage* get_thread_tss_data() const
         {
-            if (!thread_data_ && create_if_needed)
-                thread_data_ = detail::create_tss_storage();
-            return thread_data_;
+            return &thread_data_;
         }
 #endif
 
@@ -141,7 +133,7 @@ namespace hpx { namespace threads { namespace coroutines {
             phase_ = 0;
 #endif
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            HPX_ASSERT(thread_data_ == nullptr);
+            HPX_ASSERT(thread_data_.get_thread_data() == 0);
 #else
             HPX_ASSERT(thread_data_ == 0);
 #endif
@@ -151,7 +143,7 @@ namespace hpx { namespace threads { namespace coroutines {
         void reset_tss()
         {
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-            detail::delete_tss_storage(thread_data_);
+            thread_data_.clear();
 #else
             thread_data_ = 0;
 #endif
@@ -218,7 +210,7 @@ namespace hpx { namespace threads { namespace coroutines {
         std::size_t phase_;
 #endif
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
-        mutable detail::tss_storage* thread_data_;
+        mutable detail::tss_storage thread_data_;
 #else
         mutable std::size_t thread_data_;
 #endif
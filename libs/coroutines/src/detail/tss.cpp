@@ -15,206 +15,193 @@
 #include <hpx/coroutines/detail/coroutine_self.hpp>
 #include <hpx/coroutines/detail/tss.hpp>
 #include <hpx/modules/errors.hpp>
+#include <hpx/type_support/unused.hpp>
 
+#include <algorithm>
 #include <cstddef>
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace hpx { namespace threads { namespace coroutines { namespace detail {
     ///////////////////////////////////////////////////////////////////////////
-    void tss_data_node::cleanup(bool cleanup_existing)
-    {
-#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        if (cleanup_existing && func_ && (value_ != nullptr))
+    namespace {
+        struct tss_slot_registry
         {
-            (*func_)(value_);
+            tss_slot_registry()
+              : next_slot_(0)
+            {
+            }
+
+            std::size_t allocate()
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                if (free_slots_.empty())
+                    return next_slot_++;
+
+                // hand out the lowest free slot to keep the number of slots
+                // in use (and the storage needed per thread) small
+                auto it =
+                    std::min_element(free_slots_.begin(), free_slots_.end());
+                std::size_t slot = *it;
+                *it = free_slots_.back();
+                free_slots_.pop_back();
+                return slot;
+            }
+
+            void release(std::size_t slot)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                free_slots_.push_back(slot);
+            }
+
+            std::mutex mtx_;
+            std::vector<std::size_t> free_slots_;
+            std::size_t next_slot_;
+        };
+
+        tss_slot_registry& get_tss_slot_registry()
+        {
+            static tss_slot_registry registry;
+            return registry;
         }
-        func_.reset();
-        value_ = nullptr;
-#endif
-    }
+    }    // namespace
 
-    ///////////////////////////////////////////////////////////////////////////
-    tss_storage* create_tss_storage()
+    std::size_t allocate_tss_slot()
     {
-#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        return new tss_storage;
-#else
-        throw std::runtime_error(
-            "thread local storage has been disabled at configuration time, "
-            "please specify HPX_WITH_THREAD_LOCAL_STORAGE=ON to cmake");
-        return nullptr;
-#endif
+        return get_tss_slot_registry().allocate();
     }
 
-    void delete_tss_storage(tss_storage*& storage)
+    void release_tss_slot(std::size_t slot) noexcept
     {
-#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        delete storage;
-        storage = nullptr;
-#endif
+        try
+        {
+            get_tss_slot_registry().release(slot);
+        }
+        catch (...)
+        {
+            // the slot is leaked if it can't be put back
+        }
     }
 
-    std::size_t get_tss_thread_data(tss_storage* storage)
+    ///////////////////////////////////////////////////////////////////////////
+    void tss_data_node::cleanup(bool cleanup_existing)
     {
 #ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        coroutine_self* self = coroutine_self::get_self();
-        if (nullptr == self)
+        if (cleanup_existing && func_ && (value_ != nullptr))
         {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "hpx::threads::coroutines::detail::get_tss_thread_data",
-                "null thread id encountered");
-            return 0;
+            (*func_)(value_);
         }
-
-        detail::tss_storage* tss_map = self->get_thread_tss_data();
-        if (nullptr == tss_map)
-            return 0;
-
-        tss_data_node* node = tss_map->find(nullptr);
-        if (nullptr == node)
-            return 0;
-
-        return node->get_data<std::size_t>();
-#else
-        throw std::runtime_error(
-            "thread local storage has been disabled at configuration time, "
-            "please specify HPX_WITH_THREAD_LOCAL_STORAGE=ON to cmake");
-        return 0;
+        func_.reset();
+        value_ = nullptr;
+        key_ = nullptr;
 #endif
     }
 
-    std::size_t set_tss_thread_data(tss_storage* storage, std::size_t data)
+    ///////////////////////////////////////////////////////////////////////////
+    void tss_storage::clear()
     {
-#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        coroutine_self* self = coroutine_self::get_self();
-        if (nullptr == self)
+        // The cleanup functions may access thread specific data themselves,
+        // so every node is detached from the storage before it is cleaned up.
+        while (used_inline_slots_ != 0)
         {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "hpx::threads::coroutines::detail::set_tss_thread_data",
-                "null thread id encountered");
-            return 0;
-        }
+            std::size_t slot = 0;
+            while (!(used_inline_slots_ & (1u << slot)))
+                ++slot;
 
-        detail::tss_storage* tss_map = self->get_or_create_thread_tss_data();
-        if (nullptr == tss_map)
-        {
-            throw std::bad_alloc();
-            return 0;
+            used_inline_slots_ &= std::uint8_t(~(1u << slot));
+            tss_data_node node(std::move(inline_slots_[slot]));
         }
 
-        tss_data_node* node = tss_map->find(nullptr);
-        if (nullptr == node)
+        for (std::size_t i = 0; i != overflow_slots_.size(); ++i)
         {
-            tss_map->insert(nullptr, new std::size_t(data));    //-V508
-            return 0;
+            if (overflow_slots_[i].get_key() != nullptr)
+            {
+                tss_data_node node(std::move(overflow_slots_[i]));
+            }
         }
 
-        std::size_t prev_val = node->get_data<std::size_t>();
-        node->set_data(data);
-
-        return prev_val;
-#else
-        throw std::runtime_error(
-            "thread local storage has been disabled at configuration time, "
-            "please specify HPX_WITH_THREAD_LOCAL_STORAGE=ON to cmake");
-        return 0;
-#endif
+        thread_data_ = 0;
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    tss_data_node* find_tss_data(void const* key)
-    {
 #ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        coroutine_self* self = coroutine_self::get_self();
-        if (nullptr == self)
+    namespace {
+        tss_storage* get_tss_storage(char const* function_name)
         {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "hpx::threads::coroutines::detail::find_tss_data",
-                "null thread id encountered");
-            return nullptr;
+            coroutine_self* self = coroutine_self::get_self();
+            if (nullptr == self)
+            {
+                HPX_THROW_EXCEPTION(null_thread_id, function_name,
+                    "null thread id encountered");
+                return nullptr;
+            }
+            return self->get_thread_tss_data();
         }
-
-        detail::tss_storage* tss_map = self->get_thread_tss_data();
-        if (nullptr == tss_map)
-            return nullptr;
-
-        return tss_map->find(key);
-#else
-        throw std::runtime_error(
-            "thread local storage has been disabled at configuration time, "
-            "please specify HPX_WITH_THREAD_LOCAL_STORAGE=ON to cmake");
-        return nullptr;
+    }    // namespace
 #endif
-    }
 
-    void* get_tss_data(void const* key)
+    void* get_tss_data(std::size_t slot, void const* key)
     {
 #ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        if (tss_data_node* const current_node = find_tss_data(key))
-            return current_node->get_value();
-#endif
-        return nullptr;
-    }
-
-    void add_new_tss_node(void const* key,
-        std::shared_ptr<tss_cleanup_function> const& func, void* tss_data)
-    {
-#ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        coroutine_self* self = coroutine_self::get_self();
-        if (nullptr == self)
-        {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "hpx::threads::coroutines::detail::add_new_tss_node",
-                "null thread id encountered");
-            return;
-        }
-
-        detail::tss_storage* tss_map = self->get_or_create_thread_tss_data();
-        if (nullptr == tss_map)
-        {
-            throw std::bad_alloc();
-            return;
-        }
+        tss_storage* storage =
+            get_tss_storage("hpx::threads::coroutines::detail::get_tss_data");
+        if (nullptr == storage)
+            return nullptr;
 
-        tss_map->insert(key, func, tss_data);
+        if (tss_data_node* const node = storage->find(slot, key))
+            return node->get_value();
+#else
+        HPX_UNUSED(slot);
+        HPX_UNUSED(key);
 #endif
+        return nullptr;
     }
 
-    void erase_tss_node(void const* key, bool cleanup_existing)
+    void erase_tss_node(
+        std::size_t slot, void const* key, bool cleanup_existing)
     {
 #ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        coroutine_self* self = coroutine_self::get_self();
-        if (nullptr == self)
-        {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "hpx::threads::coroutines::detail::erase_tss_node",
-                "null thread id encountered");
-            return;
-        }
-
-        detail::tss_storage* tss_map = self->get_thread_tss_data();
-        if (nullptr != tss_map)
-            tss_map->erase(key, cleanup_existing);
+        tss_storage* storage =
+            get_tss_storage("hpx::threads::coroutines::detail::erase_tss_node");
+        if (nullptr != storage)
+            storage->erase(slot, key, cleanup_existing);
+#else
+        HPX_UNUSED(slot);
+        HPX_UNUSED(key);
+        HPX_UNUSED(cleanup_existing);
 #endif
     }
 
-    void set_tss_data(void const* key,
+    void set_tss_data(std::size_t slot, void const* key,
         std::shared_ptr<tss_cleanup_function> const& func, void* tss_data,
         bool cleanup_existing)
     {
 #ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
-        if (tss_data_node* const current_node = find_tss_data(key))
+        tss_storage* storage =
+            get_tss_storage("hpx::threads::coroutines::detail::set_tss_data");
+        if (nullptr == storage)
+            return;
+
+        if (tss_data_node* const node = storage->find(slot, key))
         {
             if (func || (tss_data != nullptr))
-                current_node->reinit(func, tss_data, cleanup_existing);
+                node->reinit(key, func, tss_data, cleanup_existing);
             else
-                erase_tss_node(key, cleanup_existing);
+                storage->erase(slot, key, cleanup_existing);
         }
         else if (func || (tss_data != nullptr))
         {
-            add_new_tss_node(key, func, tss_data);
+            storage->insert(slot, key, func, tss_data);
         }
+#else
+        HPX_UNUSED(slot);
+        HPX_UNUSED(key);
+        HPX_UNUSED(func);
+        HPX_UNUSED(tss_data);
+        HPX_UNUSED(cleanup_existing);
 #endif
     }
 }}}}    // namespace hpx::threads::coroutines::detail
@@ -10,7 +10,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/execution/algorithms/detail/predicates.hpp>
@@ -204,7 +204,7 @@ namespace hpx { namespace parallel { namespace execution {
 
             typename hpx::traits::detail::shared_state_ptr<result_type>::type
                 p = lcos::detail::make_continuation_alloc_nounwrap<result_type>(
-                    hpx::util::internal_allocator<>{},
+                    hpx::util::thread_local_caching_allocator<>{},
                     std::forward<Future>(predecessor), policy_,
                     std::move(func));
 
@@ -296,7 +296,7 @@ namespace hpx { namespace parallel { namespace execution {
             // vector<future<func_result_type>> -> vector<func_result_type>
             shared_state_type p =
                 lcos::detail::make_continuation_alloc<vector_result_type>(
-                    hpx::util::internal_allocator<>{},
+                    hpx::util::thread_local_caching_allocator<>{},
                     std::forward<Future>(predecessor), policy_,
                     [func = std::move(func)](future_type&& predecessor) mutable
                     -> vector_result_type {
@@ -10,19 +10,46 @@
 
 #include <boost/utility/string_ref.hpp>
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
-#include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <utility>
-#include <vector>
 
 namespace hpx { namespace util {
     namespace detail {
+        ///////////////////////////////////////////////////////////////////////
+        // Use dedicated macro so it may be overridden
+#if !defined(HPX_FORMAT_EXPORT)
+#define HPX_FORMAT_EXPORT HPX_EXPORT
+#endif
+
+        ///////////////////////////////////////////////////////////////////////
+        // All output is written to a sink, which forwards it to the final
+        // destination (a stream, a string, or an output iterator) without
+        // any intermediate buffering.
+        struct format_sink
+        {
+            using write_function = void(void*, char const*, std::size_t);
+
+            void write(char const* data, std::size_t size) const
+            {
+                write_(ctx_, data, size);
+            }
+
+            write_function* write_;
+            void* ctx_;
+
+            // non-null if the output is written to a stream, values without
+            // a dedicated formatter are then streamed to it directly
+            std::ostream* stream_;
+        };
+
         ///////////////////////////////////////////////////////////////////////
         template <typename T>
         struct type_specifier
@@ -66,53 +93,107 @@ namespace hpx { namespace util {
 
 #undef DECL_TYPE_SPECIFIER
 
+        ///////////////////////////////////////////////////////////////////////
+        // format a value using the printf-style specification spec followed
+        // by the conversion specifier conv_spec
+        HPX_FORMAT_EXPORT void format_printf(format_sink const& sink,
+            boost::string_ref spec, char const* conv_spec, ...);
+
+        // write the decimal representation of the given integer
+        HPX_FORMAT_EXPORT void format_decimal(
+            format_sink const& sink, long long value);
+        HPX_FORMAT_EXPORT void format_decimal(
+            format_sink const& sink, unsigned long long value);
+
+        HPX_FORMAT_EXPORT void format_time(format_sink const& sink,
+            boost::string_ref spec, std::tm const& value);
+
+        // write a value through an std::ostream (the stream of the sink, if
+        // any)
+        using stream_function = void(
+            std::ostream&, boost::string_ref spec, void const*);
+
+        HPX_FORMAT_EXPORT void format_stream(format_sink const& sink,
+            boost::string_ref spec, void const* value, stream_function* f);
+
+        ///////////////////////////////////////////////////////////////////////
+        // integers (but not characters) without a format specification are
+        // converted directly, bypassing printf
+        template <typename T>
+        struct is_decimal_integer
+          : std::integral_constant<bool,
+                std::is_integral<T>::value && !std::is_same<T, char>::value &&
+                    !std::is_same<T, wchar_t>::value &&
+                    !std::is_same<T, bool>::value>
+        {
+        };
+
+        template <typename T>
+        void format_fundamental(format_sink const& sink, boost::string_ref spec,
+            T const& value, std::false_type)
+        {
+            // conversion specifier
+            char const* conv_spec = "";
+            if (spec.empty() || !std::isalpha(spec.back()))
+                conv_spec = type_specifier<T>::value();
+
+            format_printf(sink, spec, conv_spec, value);
+        }
+
+        template <typename T>
+        void format_fundamental(format_sink const& sink, boost::string_ref spec,
+            T const& value, std::true_type)
+        {
+            if (spec.empty())
+            {
+                using type = typename std::conditional<std::is_signed<T>::value,
+                    long long, unsigned long long>::type;
+                format_decimal(sink, static_cast<type>(value));
+            }
+            else
+            {
+                format_fundamental(sink, spec, value, std::false_type());
+            }
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename T,
             bool IsFundamental = std::is_fundamental<T>::value>
         struct formatter
         {
-            static void call(
-                std::ostream& os, boost::string_ref spec, void const* ptr)
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
             {
-                // conversion specifier
-                char const* conv_spec = "";
-                if (spec.empty() || !std::isalpha(spec.back()))
-                    conv_spec = type_specifier<T>::value();
-
-                // copy spec to a null terminated buffer
-                char format[16];
-                std::sprintf(format, "%%%.*s%s", (int) spec.size(), spec.data(),
-                    conv_spec);
-
-                T const& value = *static_cast<T const*>(ptr);
-                std::size_t length = std::snprintf(nullptr, 0, format, value);
-                std::vector<char> buffer(length + 1);
-                length =
-                    std::snprintf(buffer.data(), length + 1, format, value);
-
-                os.write(buffer.data(), length);
+                format_fundamental(sink, spec, *static_cast<T const*>(ptr),
+                    is_decimal_integer<T>());
             }
         };
 
         template <>
         struct formatter<bool> : formatter<int>
         {
-            static void call(
-                std::ostream& os, boost::string_ref spec, void const* ptr)
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
             {
                 int const value = *static_cast<bool const*>(ptr) ? 1 : 0;
-                return formatter<int>::call(os, spec, &value);
+                return formatter<int>::call(sink, spec, &value);
             }
         };
 
         template <>
         struct formatter<void const*, /*IsFundamental=*/false>
         {
-            static void call(
+            static void stream(
                 std::ostream& os, boost::string_ref /*spec*/, void const* ptr)
             {
                 os << ptr;
             }
+
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
+            {
+                format_stream(sink, spec, ptr, &stream);
+            }
         };
 
         template <typename T>
@@ -124,31 +205,16 @@ namespace hpx { namespace util {
         template <>
         struct formatter<char const*, /*IsFundamental=*/false>
         {
-            static void call(
-                std::ostream& os, boost::string_ref spec, void const* ptr)
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
             {
                 char const* value = static_cast<char const*>(ptr);
 
                 // conversion specifier
                 if (spec.empty() || spec == "s")
-                {
-                    os << value;
-                }
+                    sink.write(value, std::strlen(value));
                 else
-                {
-                    // copy spec to a null terminated buffer
-                    char format[16];
-                    std::sprintf(
-                        format, "%%%.*ss", (int) spec.size(), spec.data());
-
-                    std::size_t length =
-                        std::snprintf(nullptr, 0, format, value);
-                    std::vector<char> buffer(length + 1);
-                    length =
-                        std::snprintf(buffer.data(), length + 1, format, value);
-
-                    os.write(buffer.data(), length);
-                }
+                    format_printf(sink, spec, "s", value);
             }
         };
 
@@ -156,46 +222,26 @@ namespace hpx { namespace util {
         struct formatter<std::string, /*IsFundamental=*/false>
           : formatter<char const*>
         {
-            static void call(
-                std::ostream& os, boost::string_ref spec, void const* ptr)
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
             {
                 std::string const& value =
                     *static_cast<std::string const*>(ptr);
 
                 if (spec.empty() || spec == "s")
-                    os.write(value.data(), value.size());
+                    sink.write(value.data(), value.size());
                 else
-                    formatter<char const*>::call(os, spec, value.c_str());
+                    formatter<char const*>::call(sink, spec, value.c_str());
             }
         };
 
         template <>
         struct formatter<std::tm, /*IsFundamental=*/false>
         {
-            static void call(
-                std::ostream& os, boost::string_ref spec, void const* ptr)
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
             {
-                std::tm const& value = *static_cast<std::tm const*>(ptr);
-
-                // conversion specifier
-                if (spec.empty())
-                    spec = "%c";    // standard date and time string
-
-                // copy spec to a null terminated buffer
-                std::string format(spec.to_string());
-
-                std::size_t length = 0;
-                std::vector<char> buffer(1);
-                buffer.resize(buffer.capacity());
-                do
-                {
-                    length = std::strftime(
-                        buffer.data(), buffer.size(), format.c_str(), &value);
-                    if (length == 0)
-                        buffer.resize(buffer.capacity() * 2);
-                } while (length == 0);
-
-                os.write(buffer.data(), length);
+                format_time(sink, spec, *static_cast<std::tm const*>(ptr));
             }
         };
 
@@ -212,12 +258,18 @@ namespace hpx { namespace util {
         template <typename T>
         struct formatter<T, /*IsFundamental=*/false>
         {
-            static void call(
+            static void stream(
                 std::ostream& os, boost::string_ref spec, void const* value)
             {
                 // ADL customization point
                 format_value(os, spec, *static_cast<T const*>(value));
             }
+
+            static void call(format_sink const& sink, boost::string_ref spec,
+                void const* ptr)
+            {
+                format_stream(sink, spec, ptr, &stream);
+            }
         };
 
         struct format_arg
@@ -242,35 +294,264 @@ namespace hpx { namespace util {
             {
             }
 
-            void operator()(std::ostream& os, boost::string_ref spec) const
+            void operator()(
+                format_sink const& sink, boost::string_ref spec) const
             {
-                _formatter(os, spec, _data);
+                _formatter(sink, spec, _data);
             }
 
             void const* _data;
             void (*_formatter)(
-                std::ostream&, boost::string_ref spec, void const*);
+                format_sink const&, boost::string_ref spec, void const*);
         };
 
         ///////////////////////////////////////////////////////////////////////
-        // Use dedicated macro so it may be overridden
-#if !defined(HPX_FORMAT_EXPORT)
-#define HPX_FORMAT_EXPORT HPX_EXPORT
-#endif
+        // replacement-field ::= '{' [arg-id] [':' format-spec] '}'
+        //
+        // A format string is a sequence of segments, each consisting of
+        // literal text followed by an optional replacement field.
+        constexpr std::size_t no_format_arg = std::size_t(-1);
+
+        struct format_segment
+        {
+            // offsets into the format string
+            std::size_t literal_begin = 0;
+            std::size_t literal_size = 0;
+
+            // zero based argument index, or no_format_arg
+            std::size_t arg_id = no_format_arg;
+            std::size_t spec_begin = 0;
+            std::size_t spec_size = 0;
+        };
+
+        HPX_NORETURN HPX_FORMAT_EXPORT void throw_format_error(
+            char const* msg);
+
+        // Parse the segment starting at pos, return the position of the next
+        // segment. The index of the next automatically numbered argument is
+        // updated accordingly. Invalid format strings cause a compile time
+        // error if parsed in a constant expression.
+        constexpr std::size_t parse_format_segment(char const* str,
+            std::size_t size, std::size_t pos, std::size_t& index,
+            format_segment& segment)
+        {
+            segment.literal_begin = pos;
+            segment.arg_id = no_format_arg;
+
+            while (pos != size && str[pos] != '{' && str[pos] != '}')
+                ++pos;
+
+            segment.literal_size = pos - segment.literal_begin;
+            if (pos == size)
+                return pos;
+
+            // '{{' or '}}'
+            if (pos + 1 != size && str[pos + 1] == str[pos])
+            {
+                ++segment.literal_size;
+                return pos + 2;
+            }
+
+            if (str[pos] == '}')
+                throw_format_error("unmatched '}' in format string");
+
+            std::size_t end = pos + 1;
+            while (end != size && str[end] != '}')
+                ++end;
+
+            if (end == size)
+                throw_format_error("unterminated replacement field");
+
+            // argument ids are one based, zero (or none) selects the next
+            // argument
+            std::size_t id = 0;
+            std::size_t p = pos + 1;
+            for (/**/; p != end && str[p] >= '0' && str[p] <= '9'; ++p)
+                id = id * 10 + static_cast<std::size_t>(str[p] - '0');
+
+            if (p != end && str[p] != ':')
+                throw_format_error("invalid argument id in format string");
+
+            segment.spec_begin = p != end ? p + 1 : end;
+            segment.spec_size = end - segment.spec_begin;
+            segment.arg_id = id != 0 ? id - 1 : index;
+            ++index;
+
+            return end + 1;
+        }
+
+        struct format_string_view
+        {
+            char const* str;
+            std::size_t size;
+
+            // segments parsed in advance, parse while formatting if nullptr
+            format_segment const* segments;
+            std::size_t num_segments;
+        };
+
+        HPX_FORMAT_EXPORT void format_to(format_sink const& sink,
+            format_string_view const& format_str, format_arg const* args,
+            std::size_t count);
+
+        HPX_FORMAT_EXPORT std::string format(
+            format_string_view const& format_str, format_arg const* args,
+            std::size_t count);
 
         HPX_FORMAT_EXPORT void format_to(std::ostream& os,
-            boost::string_ref format_str, format_arg const* args,
+            format_string_view const& format_str, format_arg const* args,
             std::size_t count);
 
-        HPX_FORMAT_EXPORT std::string format(boost::string_ref format_str,
-            format_arg const* args, std::size_t count);
+        inline format_string_view make_format_string_view(
+            boost::string_ref format_str) noexcept
+        {
+            return format_string_view{
+                format_str.data(), format_str.size(), nullptr, 0};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // sink writing to an output iterator, at most limit characters are
+        // written, all characters are counted
+        template <typename OutIter>
+        struct iterator_sink
+        {
+            static void write(void* ctx, char const* data, std::size_t size)
+            {
+                iterator_sink& self = *static_cast<iterator_sink*>(ctx);
+
+                std::size_t const available =
+                    self.size_ < self.limit_ ? self.limit_ - self.size_ : 0;
+                std::size_t const n = (std::min)(size, available);
+                self.out_ = std::copy(data, data + n, self.out_);
+                self.size_ += size;
+            }
+
+            format_sink sink() noexcept
+            {
+                return format_sink{&iterator_sink::write, this, nullptr};
+            }
+
+            OutIter out_;
+            std::size_t size_;
+            std::size_t limit_;
+        };
+
+        template <typename T>
+        struct is_format_stream
+          : std::is_convertible<typename std::decay<T>::type&, std::ostream&>
+        {
+        };
+    }    // namespace detail
+
+    namespace detail {
+        // the number of segments the given format string consists of
+        template <std::size_t N>
+        constexpr std::size_t count_format_segments(char const (&str)[N])
+        {
+            std::size_t count = 0;
+            std::size_t index = 0;
+            std::size_t pos = 0;
+            while (pos != N - 1)
+            {
+                format_segment segment;
+                pos = parse_format_segment(str, N - 1, pos, index, segment);
+                ++count;
+            }
+            return count;
+        }
     }    // namespace detail
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// A format string which is parsed (and validated) at compile time, see
+    /// HPX_FORMAT_STRING:
+    ///
+    /// \code
+    ///     static constexpr auto fmt = HPX_FORMAT_STRING("{}: {:04x}");
+    ///     static_assert(fmt.arguments() == 2, "");
+    ///     hpx::util::format_to(out, fmt, name, value);
+    /// \endcode
+    template <std::size_t NumSegments>
+    class static_format_string
+    {
+    public:
+        template <std::size_t N>
+        constexpr static_format_string(char const (&str)[N])
+          : str_(str)
+          , size_(N - 1)
+          , segments_{}
+          , num_segments_(0)
+          , num_args_(0)
+        {
+            std::size_t index = 0;
+            std::size_t pos = 0;
+            while (pos != size_)
+            {
+                if (num_segments_ == NumSegments)
+                {
+                    detail::throw_format_error(
+                        "format string has more segments than expected");
+                }
+
+                detail::format_segment& segment = segments_[num_segments_++];
+                pos = detail::parse_format_segment(
+                    str_, size_, pos, index, segment);
+
+                if (segment.arg_id != detail::no_format_arg &&
+                    segment.arg_id >= num_args_)
+                {
+                    num_args_ = segment.arg_id + 1;
+                }
+            }
+        }
+
+        constexpr char const* data() const noexcept
+        {
+            return str_;
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        // the number of arguments referred to by the format string
+        constexpr std::size_t arguments() const noexcept
+        {
+            return num_args_;
+        }
+
+        detail::format_string_view view() const noexcept
+        {
+            return detail::format_string_view{
+                str_, size_, segments_, num_segments_};
+        }
+
+    private:
+        char const* str_;
+        std::size_t size_;
+
+        // an empty format string has no segments
+        detail::format_segment segments_[NumSegments != 0 ? NumSegments : 1];
+        std::size_t num_segments_;
+        std::size_t num_args_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
     template <typename... Args>
     std::string format(boost::string_ref format_str, Args const&... args)
     {
         detail::format_arg const format_args[] = {args..., 0};
-        return detail::format(format_str, format_args, sizeof...(Args));
+        return detail::format(detail::make_format_string_view(format_str),
+            format_args, sizeof...(Args));
+    }
+
+    template <std::size_t NumSegments, typename... Args>
+    std::string format(static_format_string<NumSegments> const& format_str,
+        Args const&... args)
+    {
+        detail::format_arg const format_args[] = {args..., 0};
+        return detail::format(
+            format_str.view(), format_args, sizeof...(Args));
     }
 
     template <typename... Args>
@@ -278,7 +559,91 @@ namespace hpx { namespace util {
         std::ostream& os, boost::string_ref format_str, Args const&... args)
     {
         detail::format_arg const format_args[] = {args..., 0};
-        detail::format_to(os, format_str, format_args, sizeof...(Args));
+        detail::format_to(os, detail::make_format_string_view(format_str),
+            format_args, sizeof...(Args));
+        return os;
+    }
+
+    template <std::size_t NumSegments, typename... Args>
+    std::ostream& format_to(std::ostream& os,
+        static_format_string<NumSegments> const& format_str,
+        Args const&... args)
+    {
+        detail::format_arg const format_args[] = {args..., 0};
+        detail::format_to(os, format_str.view(), format_args, sizeof...(Args));
         return os;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Write the formatted output to the given output iterator, no memory is
+    // allocated (except by the formatting of user defined types).
+    template <typename OutIter, typename... Args,
+        typename Enable = typename std::enable_if<
+            !detail::is_format_stream<OutIter>::value>::type>
+    OutIter format_to(
+        OutIter out, boost::string_ref format_str, Args const&... args)
+    {
+        detail::format_arg const format_args[] = {args..., 0};
+        detail::iterator_sink<OutIter> sink{out, 0, std::size_t(-1)};
+        detail::format_to(sink.sink(),
+            detail::make_format_string_view(format_str), format_args,
+            sizeof...(Args));
+        return sink.out_;
+    }
+
+    template <typename OutIter, std::size_t NumSegments, typename... Args,
+        typename Enable = typename std::enable_if<
+            !detail::is_format_stream<OutIter>::value>::type>
+    OutIter format_to(OutIter out,
+        static_format_string<NumSegments> const& format_str,
+        Args const&... args)
+    {
+        detail::format_arg const format_args[] = {args..., 0};
+        detail::iterator_sink<OutIter> sink{out, 0, std::size_t(-1)};
+        detail::format_to(
+            sink.sink(), format_str.view(), format_args, sizeof...(Args));
+        return sink.out_;
+    }
+
+    template <typename OutIter>
+    struct format_to_n_result
+    {
+        OutIter out;
+
+        // the size of the complete output (including truncated characters)
+        std::size_t size;
+    };
+
+    // Write at most n characters of the formatted output to the given output
+    // iterator (e.g. a caller-supplied buffer).
+    template <typename OutIter, typename... Args>
+    format_to_n_result<OutIter> format_to_n(OutIter out, std::size_t n,
+        boost::string_ref format_str, Args const&... args)
+    {
+        detail::format_arg const format_args[] = {args..., 0};
+        detail::iterator_sink<OutIter> sink{out, 0, n};
+        detail::format_to(sink.sink(),
+            detail::make_format_string_view(format_str), format_args,
+            sizeof...(Args));
+        return format_to_n_result<OutIter>{sink.out_, sink.size_};
+    }
+
+    template <typename OutIter, std::size_t NumSegments, typename... Args>
+    format_to_n_result<OutIter> format_to_n(OutIter out, std::size_t n,
+        static_format_string<NumSegments> const& format_str,
+        Args const&... args)
+    {
+        detail::format_arg const format_args[] = {args..., 0};
+        detail::iterator_sink<OutIter> sink{out, 0, n};
+        detail::format_to(
+            sink.sink(), format_str.view(), format_args, sizeof...(Args));
+        return format_to_n_result<OutIter>{sink.out_, sink.size_};
+    }
 }}    // namespace hpx::util
+
+///////////////////////////////////////////////////////////////////////////////
+// Create a static_format_string from the given string literal, the storage
+// for the parsed segments is sized to fit.
+#define HPX_FORMAT_STRING(str)                                                 \
+    ::hpx::util::static_format_string<                                         \
+        ::hpx::util::detail::count_format_segments(str)>(str)
@@ -5,119 +5,258 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/config.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/modules/format.hpp>
 
 #include <boost/utility/string_ref.hpp>
 
-#include <algorithm>
+#include <cstdarg>
 #include <cstddef>
-#include <cstdlib>
+#include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <limits>
 #include <ostream>
-#include <sstream>
+#include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <vector>
+
+#if defined(HPX_HAVE_CXX17_STD_TO_CHARS)
+#include <charconv>
+#endif
 
 namespace hpx { namespace util { namespace detail {
     ///////////////////////////////////////////////////////////////////////////
-    inline std::size_t format_atoi(
-        boost::string_ref str, std::size_t* pos = nullptr) noexcept
+    void throw_format_error(char const* msg)
     {
-        // copy input to a null terminated buffer
-        static constexpr std::size_t digits10 =
-            std::numeric_limits<std::size_t>::digits10 + 1;
-        char buffer[digits10 + 1] = {};
-        std::memcpy(buffer, str.data(), (std::min)(str.size(), digits10));
-
-        char const* first = buffer;
-        char* last = buffer;
-        std::size_t r = std::strtoull(first, &last, 10);
-        if (pos != nullptr)
-            *pos = last - first;
-        return r;
+        throw std::runtime_error(msg);
     }
 
-    inline boost::string_ref format_substr(boost::string_ref str,
-        std::size_t start, std::size_t end = boost::string_ref::npos) noexcept
+    ///////////////////////////////////////////////////////////////////////////
+    void format_printf(format_sink const& sink, boost::string_ref spec,
+        char const* conv_spec, ...)
     {
-        return start < str.size() ? str.substr(start, end - start) :
-                                    boost::string_ref{};
+        // copy spec to a null terminated buffer
+        char format[32];
+        if (spec.size() + std::strlen(conv_spec) + 2 > sizeof(format))
+            throw_format_error("format specification too long");
+
+        std::sprintf(
+            format, "%%%.*s%s", (int) spec.size(), spec.data(), conv_spec);
+
+        // most values fit into the buffer on the stack
+        char buffer[128];
+
+        std::va_list args;
+        va_start(args, conv_spec);
+        std::va_list args_copy;
+        va_copy(args_copy, args);
+        int const length =
+            std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        if (length < 0)
+        {
+            va_end(args_copy);
+            throw_format_error("invalid format specification");
+        }
+
+        if (static_cast<std::size_t>(length) < sizeof(buffer))
+        {
+            va_end(args_copy);
+            sink.write(buffer, length);
+            return;
+        }
+
+        std::vector<char> large_buffer(length + 1);
+        std::vsnprintf(large_buffer.data(), length + 1, format, args_copy);
+        va_end(args_copy);
+
+        sink.write(large_buffer.data(), length);
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    // replacement-field ::= '{' [arg-id] [':' format-spec] '}'
-    struct format_field
-    {
-        std::size_t arg_id;
-        boost::string_ref spec;
-    };
+    static constexpr std::size_t max_decimal_digits =
+        std::numeric_limits<unsigned long long>::digits10 + 2;
 
-    inline format_field parse_field(boost::string_ref field) noexcept
+    void format_decimal(format_sink const& sink, unsigned long long value)
     {
-        std::size_t const sep = field.find(':');
-        if (sep != field.npos)
+        char buffer[max_decimal_digits];
+#if defined(HPX_HAVE_CXX17_STD_TO_CHARS)
+        char* const end =
+            std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        sink.write(buffer, end - buffer);
+#else
+        char* const end = buffer + sizeof(buffer);
+        char* p = end;
+        do
         {
-            boost::string_ref const arg_id = format_substr(field, 0, sep);
-            boost::string_ref const spec = format_substr(field, sep + 1);
+            *--p = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        sink.write(p, end - p);
+#endif
+    }
 
-            std::size_t const id = format_atoi(arg_id);
-            return format_field{id, spec};
-        }
-        else
+    void format_decimal(format_sink const& sink, long long value)
+    {
+        if (value >= 0)
         {
-            std::size_t const id = format_atoi(field);
-            return format_field{id, ""};
+            format_decimal(sink, static_cast<unsigned long long>(value));
+            return;
         }
+
+        sink.write("-", 1);
+        format_decimal(sink, 0ull - static_cast<unsigned long long>(value));
     }
 
-    void format_to(std::ostream& os, boost::string_ref format_str,
-        format_arg const* args, std::size_t count)
+    ///////////////////////////////////////////////////////////////////////////
+    void format_time(
+        format_sink const& sink, boost::string_ref spec, std::tm const& value)
     {
-        std::size_t index = 0;
-        while (!format_str.empty())
+        // conversion specifier
+        if (spec.empty())
+            spec = "%c";    // standard date and time string
+
+        // copy spec to a null terminated buffer
+        std::string format(spec.to_string());
+
+        std::size_t length = 0;
+        std::vector<char> buffer(1);
+        buffer.resize(buffer.capacity());
+        do
+        {
+            length = std::strftime(
+                buffer.data(), buffer.size(), format.c_str(), &value);
+            if (length == 0)
+                buffer.resize(buffer.capacity() * 2);
+        } while (length == 0);
+
+        sink.write(buffer.data(), length);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace {
+        // stream buffer forwarding all output to a sink
+        class format_sink_buffer : public std::streambuf
         {
-            if (format_str[0] == '{' || format_str[0] == '}')
+        public:
+            explicit format_sink_buffer(format_sink const& sink)
+              : sink_(sink)
             {
-                HPX_ASSERT(!format_str.empty());
-                if (format_str[1] == format_str[0])
-                {
-                    os.write(format_str.data(), 1);    // '{' or '}'
-                }
-                else
+            }
+
+        protected:
+            int_type overflow(int_type ch) override
+            {
+                if (!traits_type::eq_int_type(ch, traits_type::eof()))
                 {
-                    HPX_ASSERT(format_str[0] != '}');
-                    std::size_t const end = format_str.find('}');
-                    boost::string_ref field_str =
-                        format_substr(format_str, 1, end);
-                    format_field const field = parse_field(field_str);
-                    format_str.remove_prefix(end - 1);
-
-                    std::size_t const id =
-                        field.arg_id ? field.arg_id - 1 : index;
-                    HPX_ASSERT(id < count);
-                    args[id](os, field.spec);
-                    ++index;
+                    char const c = traits_type::to_char_type(ch);
+                    sink_.write(&c, 1);
                 }
-                format_str.remove_prefix(2);
+                return traits_type::not_eof(ch);
             }
-            else
+
+            std::streamsize xsputn(char const* s, std::streamsize n) override
             {
-                std::size_t const next = format_str.find_first_of("{}");
-                std::size_t const count =
-                    next != format_str.npos ? next : format_str.size();
+                sink_.write(s, static_cast<std::size_t>(n));
+                return n;
+            }
+
+        private:
+            format_sink const& sink_;
+        };
 
-                os.write(format_str.data(), count);
-                format_str.remove_prefix(count);
+        void write_to_stream(void* ctx, char const* data, std::size_t size)
+        {
+            static_cast<std::ostream*>(ctx)->write(
+                data, static_cast<std::streamsize>(size));
+        }
+
+        void write_to_string(void* ctx, char const* data, std::size_t size)
+        {
+            static_cast<std::string*>(ctx)->append(data, size);
+        }
+    }    // namespace
+
+    void format_stream(format_sink const& sink, boost::string_ref spec,
+        void const* value, stream_function* f)
+    {
+        if (sink.stream_ != nullptr)
+        {
+            f(*sink.stream_, spec, value);
+            return;
+        }
+
+        format_sink_buffer buffer(sink);
+        std::ostream os(&buffer);
+        f(os, spec, value);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline void format_segment_to(format_sink const& sink,
+        format_string_view const& format_str, format_segment const& segment,
+        format_arg const* args, std::size_t count)
+    {
+        if (segment.literal_size != 0)
+        {
+            sink.write(format_str.str + segment.literal_begin,
+                segment.literal_size);
+        }
+
+        if (segment.arg_id != no_format_arg)
+        {
+            if (segment.arg_id >= count)
+                throw_format_error("format argument index out of range");
+
+            args[segment.arg_id](sink,
+                boost::string_ref(format_str.str + segment.spec_begin,
+                    segment.spec_size));
+        }
+    }
+
+    void format_to(format_sink const& sink,
+        format_string_view const& format_str, format_arg const* args,
+        std::size_t count)
+    {
+        if (format_str.segments != nullptr)
+        {
+            for (std::size_t i = 0; i != format_str.num_segments; ++i)
+            {
+                format_segment_to(
+                    sink, format_str, format_str.segments[i], args, count);
             }
+            return;
+        }
+
+        std::size_t index = 0;
+        std::size_t pos = 0;
+        while (pos != format_str.size)
+        {
+            format_segment segment;
+            pos = parse_format_segment(
+                format_str.str, format_str.size, pos, index, segment);
+            format_segment_to(sink, format_str, segment, args, count);
         }
     }
 
-    std::string format(
-        boost::string_ref format_str, format_arg const* args, std::size_t count)
+    void format_to(std::ostream& os, format_string_view const& format_str,
+        format_arg const* args, std::size_t count)
     {
-        std::ostringstream os;
-        detail::format_to(os, format_str, args, count);
-        return os.str();
+        format_sink const sink{&write_to_stream, &os, &os};
+        detail::format_to(sink, format_str, args, count);
+    }
+
+    std::string format(format_string_view const& format_str,
+        format_arg const* args, std::size_t count)
+    {
+        std::string result;
+        result.reserve(format_str.size);
+
+        format_sink const sink{&write_to_string, &result, nullptr};
+        detail::format_to(sink, format_str, args, count);
+        return result;
     }
 }}}    // namespace hpx::util::detail
@@ -0,0 +1,89 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of formatting a typical log line using
+// hpx::util::format, hpx::util::format_to_n (with a format string parsed at
+// compile time, writing to a buffer on the stack), std::ostringstream and
+// std::snprintf.
+
+#include <hpx/config.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/timing/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// prevent the compiler from optimizing away the formatted output
+std::size_t volatile sink = 0;
+
+template <typename F>
+void measure(char const* name, std::size_t iterations, F&& f)
+{
+    // warm up
+    for (std::size_t i = 0; i != iterations / 10; ++i)
+        f(i);
+
+    hpx::util::high_resolution_timer t;
+    for (std::size_t i = 0; i != iterations; ++i)
+        f(i);
+    double const elapsed = t.elapsed();
+
+    std::cout << name << ": " << (elapsed * 1e9) / iterations
+              << " [ns/call]\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 1000000;
+    if (argc > 1)
+        iterations = std::strtoull(argv[1], nullptr, 10);
+
+    std::string const name("worker-thread");
+    double const value = 3.1415;
+
+    measure("hpx::util::format", iterations, [&](std::size_t i) {
+        std::string s = hpx::util::format(
+            "({}/{}) {}: {:016lx} {:.3}", i, i + 1, name, i, value);
+        sink = sink + s.size();
+    });
+
+    constexpr auto fmt = HPX_FORMAT_STRING("({}/{}) {}: {:016lx} {:.3}");
+    static_assert(fmt.arguments() == 5, "unexpected number of arguments");
+
+    measure("hpx::util::format_to_n (static)", iterations, [&](std::size_t i) {
+        char buffer[128];
+        auto result = hpx::util::format_to_n(
+            buffer, sizeof(buffer), fmt, i, i + 1, name, i, value);
+        sink = sink + result.size;
+    });
+
+    measure("std::ostringstream", iterations, [&](std::size_t i) {
+        std::ostringstream os;
+        os << "(" << i << "/" << i + 1 << ") " << name << ": ";
+        os.width(16);
+        os.fill('0');
+        os << std::hex << i << std::dec << " ";
+        os.precision(3);
+        os << std::fixed << value;
+        sink = sink + os.str().size();
+    });
+
+    measure("std::snprintf", iterations, [&](std::size_t i) {
+        char buffer[128];
+        int const size = std::snprintf(buffer, sizeof(buffer),
+            "(%zu/%zu) %s: %016zx %.3lf", i, i + 1, name.c_str(), i, value);
+        sink = sink + static_cast<std::size_t>(size);
+    });
+
+    return 0;
+}
@@ -8,8 +8,25 @@
 #include <hpx/modules/format.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstddef>
 #include <ctime>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+struct custom
+{
+    int value;
+};
+
+std::ostream& operator<<(std::ostream& os, custom const& c)
+{
+    return os << "custom(" << c.value << ")";
+}
 
 int main(int argc, char* argv[])
 {
@@ -64,5 +81,83 @@ int main(int argc, char* argv[])
         HPX_TEST_EQ((format("{{{1}}}", 2)), "{2}");
     }
 
+    {
+        HPX_TEST_EQ((format("{} {}", -42, 0)), "-42 0");
+        HPX_TEST_EQ((format("{}", std::numeric_limits<long long>::min())),
+            std::to_string(std::numeric_limits<long long>::min()));
+        HPX_TEST_EQ(
+            (format("{}", std::numeric_limits<unsigned long long>::max())),
+            std::to_string(std::numeric_limits<unsigned long long>::max()));
+        HPX_TEST_EQ((format("{} {}", 'a', std::string("b"))), "a b");
+        HPX_TEST_EQ((format("[{:5}]", "ab")), "[   ab]");
+        HPX_TEST_EQ((format("{}", custom{1})), "custom(1)");
+    }
+
+    {
+        std::ostringstream os;
+        hpx::util::format_to(os, "{} {}", 1, custom{2});
+        HPX_TEST_EQ(os.str(), "1 custom(2)");
+    }
+
+    {
+        std::string s;
+        hpx::util::format_to(
+            std::back_inserter(s), "{}-{:03}-{}", 1, 2, custom{3});
+        HPX_TEST_EQ(s, "1-002-custom(3)");
+
+        std::vector<char> v;
+        hpx::util::format_to(std::back_inserter(v), "{{{}}}", 42);
+        HPX_TEST_EQ(std::string(v.begin(), v.end()), "{42}");
+    }
+
+    {
+        char buffer[8] = {};
+        auto result = hpx::util::format_to_n(
+            buffer, sizeof(buffer) - 1, "Hello, {}!", "world");
+        HPX_TEST_EQ(result.size, std::size_t(13));
+        HPX_TEST_EQ(result.out, buffer + 7);
+        HPX_TEST_EQ(std::string(buffer), "Hello, ");
+
+        result = hpx::util::format_to_n(buffer, sizeof(buffer), "{}", 42);
+        HPX_TEST_EQ(result.size, std::size_t(2));
+        HPX_TEST_EQ(std::string(buffer, result.out), "42");
+    }
+
+    {
+        constexpr auto fmt = HPX_FORMAT_STRING("{} {2:04x} {{}}");
+        static_assert(fmt.arguments() == 2, "");
+        static_assert(fmt.size() == 15, "");
+
+        HPX_TEST_EQ((format(fmt, 1, 42)), "1 002a {}");
+
+        char buffer[32] = {};
+        auto result = hpx::util::format_to_n(
+            buffer, sizeof(buffer), fmt, 1, 43);
+        HPX_TEST_EQ(std::string(buffer, result.out), "1 002b {}");
+
+        std::ostringstream os;
+        hpx::util::format_to(os, fmt, 2, 44);
+        HPX_TEST_EQ(os.str(), "2 002c {}");
+
+        constexpr auto empty = HPX_FORMAT_STRING("");
+        static_assert(empty.arguments() == 0, "");
+        HPX_TEST_EQ((format(empty)), "");
+
+        // the storage for the parsed segments does not depend on the length
+        // of the literal text
+        static_assert(sizeof(HPX_FORMAT_STRING("a rather long literal text")) ==
+                sizeof(HPX_FORMAT_STRING("x")),
+            "");
+        static_assert(hpx::util::detail::count_format_segments("{}: {}") == 2,
+            "");
+    }
+
+    {
+        HPX_TEST_THROW((format("{", 1)), std::runtime_error);
+        HPX_TEST_THROW((format("}", 1)), std::runtime_error);
+        HPX_TEST_THROW((format("{a}", 1)), std::runtime_error);
+        HPX_TEST_THROW((format("{2}", 1)), std::runtime_error);
+    }
+
     return hpx::util::report_errors();
 }
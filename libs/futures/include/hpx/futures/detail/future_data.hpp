@@ -223,6 +223,18 @@ namespace hpx { namespace lcos { namespace detail {
             exception = 4 | ready
         };
 
+        // Additional flags kept in the state word. The first continuation
+        // is stored inline and is attached and invoked without acquiring
+        // the lock. Only blocking waiters and any additional continuations
+        // require the lock to be taken when the future is made ready.
+        enum state_flags
+        {
+            state_mask = 7,
+            continuation_pending = 8,    // inline continuation being stored
+            has_continuation = 16,       // inline continuation stored
+            needs_lock = 32              // waiters or more continuations
+        };
+
         /// Return whether or not the data is available for this
         /// \a future.
         bool is_ready(std::memory_order order = std::memory_order_acquire) const
@@ -232,12 +244,12 @@ namespace hpx { namespace lcos { namespace detail {
 
         bool has_value() const
         {
-            return state_.load(std::memory_order_acquire) == value;
+            return get_state() == value;
         }
 
         bool has_exception() const
         {
-            return state_.load(std::memory_order_acquire) == exception;
+            return get_state() == exception;
         }
 
         virtual void execute_deferred(error_code& /*ec*/ = throws) {}
@@ -301,8 +313,24 @@ namespace hpx { namespace lcos { namespace detail {
         }
 
     protected:
+        state get_state(
+            std::memory_order order = std::memory_order_acquire) const
+        {
+            return static_cast<state>(state_.load(order) & state_mask);
+        }
+
+        // Change the state to the given one (value or exception), invoke
+        // all continuations and wake up all waiting threads.
+        void make_ready(state s, char const* func);
+
+        // Make sure the thread making this future ready will acquire the
+        // lock, return false if the future has become ready in the meantime.
+        // Expects that \p l holds mtx_.
+        bool set_needs_lock(std::unique_lock<mutex_type>& l);
+
         mutable mutex_type mtx_;
-        std::atomic<state> state_;    // current state
+        std::atomic<int> state_;    // current state and flags
+        completed_callback_type continuation_;    // first continuation
         completed_callback_vector_type on_completed_;
         local::detail::condition_variable cond_;    // threads waiting in read
     };
@@ -420,48 +448,9 @@ namespace hpx { namespace lcos { namespace detail {
             result_type* value_ptr = reinterpret_cast<result_type*>(&storage_);
             construct(value_ptr, std::forward<Ts>(ts)...);
 
-            // At this point the lock needs to be acquired to safely access the
-            // registered continuations
-            std::unique_lock<mutex_type> l(mtx_);
-
-            // handle all threads waiting for the future to become ready
-            auto on_completed = std::move(on_completed_);
-            on_completed_.clear();
-
             // The value has been set, changing the state to 'value' at this
             // point signals to all other threads that this future is ready.
-            state expected = empty;
-            if (!state_.compare_exchange_strong(
-                    expected, value, std::memory_order_release))
-            {
-                // this future should be 'empty' still (it can't be made ready
-                // more than once).
-                l.unlock();
-                HPX_THROW_EXCEPTION(promise_already_satisfied,
-                    "future_data_base::set_value",
-                    "data has already been set for this future");
-                return;
-            }
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (
-                cond_.notify_one(std::move(l), threads::thread_priority_boost))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
-            }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (!on_completed.empty())
-                handle_on_completed(std::move(on_completed));
+            this->make_ready(value, "future_data_base::set_value");
         }
 
         void set_exception(std::exception_ptr data) override
@@ -477,48 +466,9 @@ namespace hpx { namespace lcos { namespace detail {
                 reinterpret_cast<std::exception_ptr*>(&storage_);
             ::new ((void*) exception_ptr) std::exception_ptr(std::move(data));
 
-            // At this point the lock needs to be acquired to safely access the
-            // registered continuations
-            std::unique_lock<mutex_type> l(mtx_);
-
-            // handle all threads waiting for the future to become ready
-            auto on_completed = std::move(on_completed_);
-            on_completed_.clear();
-
             // The value has been set, changing the state to 'exception' at this
             // point signals to all other threads that this future is ready.
-            state expected = empty;
-            if (!state_.compare_exchange_strong(
-                    expected, exception, std::memory_order_release))
-            {
-                // this future should be 'empty' still (it can't be made ready
-                // more than once).
-                l.unlock();
-                HPX_THROW_EXCEPTION(promise_already_satisfied,
-                    "future_data_base::set_exception",
-                    "data has already been set for this future");
-                return;
-            }
-
-            // Note: we use notify_one repeatedly instead of notify_all as we
-            //       know: a) that most of the time we have at most one thread
-            //       waiting on the future (most futures are not shared), and
-            //       b) our implementation of condition_variable::notify_one
-            //       relinquishes the lock before resuming the waiting thread
-            //       which avoids suspension of this thread when it tries to
-            //       re-lock the mutex while exiting from condition_variable::wait
-            while (
-                cond_.notify_one(std::move(l), threads::thread_priority_boost))
-            {
-                l = std::unique_lock<mutex_type>(mtx_);
-            }
-
-            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (!on_completed.empty())
-                handle_on_completed(std::move(on_completed));
+            this->make_ready(exception, "future_data_base::set_exception");
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -585,7 +535,7 @@ namespace hpx { namespace lcos { namespace detail {
             // and no reader
 
             // release any stored data and callback functions
-            switch (state_.exchange(empty))
+            switch (state_.exchange(empty) & base_type::state_mask)
             {
             case value:
             {
@@ -605,16 +555,18 @@ namespace hpx { namespace lcos { namespace detail {
                 break;
             }
 
+            continuation_.reset();
             on_completed_.clear();
         }
 
         std::exception_ptr get_exception_ptr() const override
         {
-            HPX_ASSERT(state_.load(std::memory_order_acquire) == exception);
+            HPX_ASSERT(this->get_state() == exception);
             return *reinterpret_cast<std::exception_ptr const*>(&storage_);
         }
 
     protected:
+        using base_type::continuation_;
         using base_type::mtx_;
         using base_type::on_completed_;
         using base_type::state_;
@@ -786,12 +738,14 @@ namespace hpx { namespace lcos { namespace detail {
     public:
         task_base()
           : started_(false)
+          , lazy_(false)
         {
         }
 
         task_base(init_no_addref no_addref)
           : base_type(no_addref)
           , started_(false)
+          , lazy_(false)
         {
         }
 
@@ -821,8 +775,20 @@ namespace hpx { namespace lcos { namespace detail {
             util::steady_clock::time_point const& abs_time,
             error_code& ec = throws)
         {
-            if (!started_test())
-                return future_status::deferred;    //-V110
+            {
+                std::unique_lock<mutex_type> l(this->mtx_);
+                if (!started_)
+                {
+                    if (!lazy_)
+                        return future_status::deferred;    //-V110
+
+                    // a task launched with launch::lazy is run by the first
+                    // thread waiting for it, as for wait() and get()
+                    started_ = true;
+                    l.unlock();
+                    this->do_run();
+                }
+            }
             return this->future_data<Result>::wait_until(abs_time, ec);
         }
 
@@ -851,6 +817,20 @@ namespace hpx { namespace lcos { namespace detail {
             return started_test_and_set_locked(l);
         }
 
+        // mark the task as launched with launch::lazy, see apply()
+        void set_lazy()
+        {
+            std::lock_guard<mutex_type> l(this->mtx_);
+            lazy_ = true;
+        }
+
+        // once set, this flag marks the staged work item of a task launched
+        // with launch::lazy as obsolete
+        std::atomic<bool> const* get_started_flag() const noexcept
+        {
+            return &started_;
+        }
+
         void check_started()
         {
             std::unique_lock<mutex_type> l(this->mtx_);
@@ -890,6 +870,14 @@ namespace hpx { namespace lcos { namespace detail {
             this_->do_run();
         }
 
+        // run only if no other thread has started this task yet, the task
+        // might have been run inline by a thread waiting for its result
+        static void run_lazy_impl(future_base_type this_)
+        {
+            if (!this_->started_test_and_set())
+                this_->do_run();
+        }
+
     public:
         template <typename T>
         void set_data(T&& result)
@@ -908,7 +896,10 @@ namespace hpx { namespace lcos { namespace detail {
         }
 
     protected:
-        bool started_;
+        // modified under the lock only, but read without it by the scheduler
+        // (see get_started_flag)
+        std::atomic<bool> started_;
+        bool lazy_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -9,7 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/allocator_support/allocator_deleter.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/concepts/concepts.hpp>
@@ -1372,7 +1372,8 @@ namespace hpx { namespace lcos {
         make_ready_future(Ts&&... ts)
     {
         return make_ready_future_alloc<T>(
-            hpx::util::internal_allocator<>{}, std::forward<Ts>(ts)...);
+            hpx::util::thread_local_caching_allocator<>{},
+            std::forward<Ts>(ts)...);
     }
     ///////////////////////////////////////////////////////////////////////////
     // extension: create a pre-initialized future object, with allocator
@@ -1391,7 +1392,8 @@ namespace hpx { namespace lcos {
     {
         using result_type = typename hpx::util::decay_unwrap<T>::type;
         return make_ready_future_alloc<result_type>(
-            hpx::util::internal_allocator<>{}, std::forward<T>(init));
+            hpx::util::thread_local_caching_allocator<>{},
+            std::forward<T>(init));
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1460,7 +1462,7 @@ namespace hpx { namespace lcos {
     HPX_FORCEINLINE future<void> make_ready_future()
     {
         return make_ready_future_alloc<void>(
-            hpx::util::internal_allocator<>{}, util::unused);
+            hpx::util::thread_local_caching_allocator<>{}, util::unused);
     }
 
     // Extension (see wg21.link/P0319)
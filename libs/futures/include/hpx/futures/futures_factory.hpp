@@ -8,7 +8,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/allocator_support/allocator_deleter.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/coroutines/thread_enums.hpp>
 #include <hpx/execution_base/execution.hpp>
@@ -107,9 +107,48 @@ namespace hpx { namespace lcos { namespace local {
                 threads::thread_schedule_hint schedulehint,
                 error_code& ec) override
             {
+                typedef typename Base::future_base_type future_base_type;
+
+                if (policy == launch::lazy)
+                {
+                    // the new task is not marked as started, the first
+                    // thread waiting for its result will run it inline
+                    // unless it was stolen by an idle worker before
+                    this->set_lazy();
+                    future_base_type this_(this);
+
+                    // stage the task on the current worker if that belongs
+                    // to the target pool (the hint is local to the pool)
+                    if (schedulehint.mode ==
+                        threads::thread_schedule_hint_mode_none)
+                    {
+                        std::size_t const local_thread_num =
+                            get_local_worker_thread_num();
+                        if (local_thread_num != std::size_t(-1) &&
+                            get_thread_pool_num() == pool->get_pool_index())
+                        {
+                            schedulehint = threads::thread_schedule_hint(
+                                static_cast<std::int16_t>(local_thread_num));
+                        }
+                    }
+
+                    threads::thread_init_data data(
+                        threads::make_thread_function_nullary(
+                            util::deferred_call(
+                                &base_type::run_lazy_impl, std::move(this_))),
+                        util::thread_description(f_, annotation), priority,
+                        schedulehint, stacksize, threads::pending);
+
+                    // the staged work item is dropped without creating a
+                    // thread if the task has been run inline in the meantime
+                    data.obsolete = this->get_started_flag();
+
+                    threads::register_work(data, pool, ec);
+                    return threads::invalid_thread_id;
+                }
+
                 this->check_started();
 
-                typedef typename Base::future_base_type future_base_type;
                 future_base_type this_(this);
 
                 if (policy == launch::fork)
@@ -707,14 +746,15 @@ namespace hpx { namespace lcos { namespace local {
                     futures_factory>::value>::type>
         explicit futures_factory(F&& f)
           : task_(detail::create_task_object<Result, Cancelable>::call(
-                hpx::util::internal_allocator<>{}, std::forward<F>(f)))
+                hpx::util::thread_local_caching_allocator<>{},
+                std::forward<F>(f)))
           , future_obtained_(false)
         {
         }
 
         explicit futures_factory(Result (*f)())
           : task_(detail::create_task_object<Result, Cancelable>::call(
-                hpx::util::internal_allocator<>{}, f))
+                hpx::util::thread_local_caching_allocator<>{}, f))
           , future_obtained_(false)
         {
         }
@@ -9,7 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/allocator_support/allocator_deleter.hpp>
-#include <hpx/allocator_support/internal_allocator.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/futures/detail/future_data.hpp>
 #include <hpx/futures/traits/acquire_shared_state.hpp>
@@ -826,8 +826,8 @@ namespace hpx { namespace lcos { namespace detail {
         typename future_unwrap_result<Future>::result_type>::type
     unwrap_impl(Future&& future, error_code& ec)
     {
-        return unwrap_impl_alloc(
-            util::internal_allocator<>{}, std::forward<Future>(future), ec);
+        return unwrap_impl_alloc(util::thread_local_caching_allocator<>{},
+            std::forward<Future>(future), ec);
     }
 
     template <typename Allocator, typename Future>
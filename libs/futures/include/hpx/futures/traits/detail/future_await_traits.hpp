@@ -13,7 +13,7 @@
 #include <hpx/futures/detail/future_data.hpp>
 #include <hpx/memory/intrusive_ptr.hpp>
 #include <hpx/modules/allocator_support.hpp>
-#include <hpx/traits/future_access.hpp>
+#include <hpx/futures/traits/future_access.hpp>
 
 #if defined(HPX_HAVE_CXX20_COROUTINES)
 #include <coroutine>
@@ -36,10 +36,16 @@ namespace hpx { namespace lcos { namespace detail {
     template <typename Promise = void>
     using coroutine_handle = std::coroutine_handle<Promise>;
     using suspend_never = std::suspend_never;
+    using suspend_always = std::suspend_always;
+    using std::noop_coroutine;
 #else
     template <typename Promise = void>
     using coroutine_handle = std::experimental::coroutine_handle<Promise>;
     using suspend_never = std::experimental::suspend_never;
+    using suspend_always = std::experimental::suspend_always;
+#if !defined(HPX_HAVE_EMULATE_COROUTINE_SUPPORT_LIBRARY)
+    using std::experimental::noop_coroutine;
+#endif
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -180,6 +186,11 @@ namespace hpx { namespace lcos { namespace detail {
             return suspend_if{!this->base_type::requires_delete()};
         }
 
+        void unhandled_exception() noexcept
+        {
+            this->base_type::set_exception(std::current_exception());
+        }
+
         void destroy() override
         {
             coroutine_handle<Derived>::from_promise(
@@ -246,7 +257,12 @@ namespace std {
 
                 promise_type() = default;
 
-                template <typename Allocator>
+                // only allocators are passed through, coroutine arguments
+                // of other types are ignored
+                template <typename Allocator,
+                    typename Enable = typename std::enable_if<
+                        std::is_convertible<Allocator const&,
+                            typename base_type::other_allocator>::value>::type>
                 promise_type(Allocator const& alloc)
                   : base_type(alloc)
                 {
@@ -288,7 +304,12 @@ namespace std {
 
                 promise_type() = default;
 
-                template <typename Allocator>
+                // only allocators are passed through, coroutine arguments
+                // of other types are ignored
+                template <typename Allocator,
+                    typename Enable = typename std::enable_if<
+                        std::is_convertible<Allocator const&,
+                            typename base_type::other_allocator>::value>::type>
                 promise_type(Allocator const& alloc)
                   : base_type(alloc)
                 {
@@ -302,7 +323,7 @@ namespace std {
                 HPX_NODISCARD HPX_FORCEINLINE static void* operator new(
                     std::size_t size)
                 {
-                    return base_type::allocate();
+                    return base_type::allocate(size);
                 }
 
                 HPX_FORCEINLINE static void operator delete(
@@ -331,7 +352,12 @@ namespace std {
 
                 promise_type() = default;
 
-                template <typename Allocator>
+                // only allocators are passed through, coroutine arguments
+                // of other types are ignored
+                template <typename Allocator,
+                    typename Enable = typename std::enable_if<
+                        std::is_convertible<Allocator const&,
+                            typename base_type::other_allocator>::value>::type>
                 promise_type(Allocator const& alloc)
                   : base_type(alloc)
                 {
@@ -373,7 +399,12 @@ namespace std {
 
                 promise_type() = default;
 
-                template <typename Allocator>
+                // only allocators are passed through, coroutine arguments
+                // of other types are ignored
+                template <typename Allocator,
+                    typename Enable = typename std::enable_if<
+                        std::is_convertible<Allocator const&,
+                            typename base_type::other_allocator>::value>::type>
                 promise_type(Allocator const& alloc)
                   : base_type(alloc)
                 {
@@ -387,7 +418,7 @@ namespace std {
                 HPX_NODISCARD HPX_FORCEINLINE static void* operator new(
                     std::size_t size)
                 {
-                    return base_type::allocate();
+                    return base_type::allocate(size);
                 }
 
                 HPX_FORCEINLINE static void operator delete(
@@ -16,6 +16,7 @@
 #include <hpx/futures/futures_factory.hpp>
 #include <hpx/memory/intrusive_ptr.hpp>
 #include <hpx/modules/errors.hpp>
+#include <hpx/thread_support/assert_owns_lock.hpp>
 #include <hpx/threading_base/annotated_function.hpp>
 
 #include <cstddef>
@@ -103,7 +104,7 @@ namespace hpx { namespace lcos { namespace detail {
         // thread was suspended, in this case we need to load it again.
         if (s == empty)
         {
-            s = state_.load(std::memory_order_relaxed);
+            s = get_state(std::memory_order_relaxed);
         }
 
         if (s == value)
@@ -234,6 +235,86 @@ namespace hpx { namespace lcos { namespace detail {
     future_data_base<traits::detail::future_data_void>::handle_on_completed<
         completed_callback_vector_type>(completed_callback_vector_type&&);
 
+    void future_data_base<traits::detail::future_data_void>::make_ready(
+        state s, char const* func)
+    {
+        int expected = state_.load(std::memory_order_relaxed);
+        do
+        {
+            // this future should be 'empty' still (it can't be made ready
+            // more than once).
+            if (expected & ready)
+            {
+                HPX_THROW_EXCEPTION(promise_already_satisfied, func,
+                    "data has already been set for this future");
+                return;
+            }
+        } while (!state_.compare_exchange_weak(expected, expected | s,
+            std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        // The inline continuation is invoked by this thread if it has been
+        // stored completely, otherwise the thread storing it will run it.
+        completed_callback_type on_completed;
+        if (expected & has_continuation)
+        {
+            on_completed = std::move(continuation_);
+        }
+
+        // Waiting threads and additional continuations are protected by the
+        // lock.
+        completed_callback_vector_type on_completed_vector;
+        if (expected & needs_lock)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // handle all threads waiting for the future to become ready
+            on_completed_vector = std::move(on_completed_);
+            on_completed_.clear();
+
+            // Note: we use notify_one repeatedly instead of notify_all as we
+            //       know: a) that most of the time we have at most one thread
+            //       waiting on the future (most futures are not shared), and
+            //       b) our implementation of condition_variable::notify_one
+            //       relinquishes the lock before resuming the waiting thread
+            //       which avoids suspension of this thread when it tries to
+            //       re-lock the mutex while exiting from condition_variable::wait
+            while (
+                cond_.notify_one(std::move(l), threads::thread_priority_boost))
+            {
+                l = std::unique_lock<mutex_type>(mtx_);
+            }
+
+            // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
+            //       it unlocked when returning.
+        }
+
+        // invoke the callback (continuation) functions
+        if (on_completed)
+            handle_on_completed(std::move(on_completed));
+
+        if (!on_completed_vector.empty())
+            handle_on_completed(std::move(on_completed_vector));
+    }
+
+    bool future_data_base<traits::detail::future_data_void>::set_needs_lock(
+        std::unique_lock<mutex_type>& l)
+    {
+        HPX_ASSERT_OWNS_LOCK(l);
+        HPX_UNUSED(l);
+
+        int expected = state_.load(std::memory_order_acquire);
+        while (!(expected & ready))
+        {
+            if ((expected & needs_lock) ||
+                state_.compare_exchange_weak(expected, expected | needs_lock,
+                    std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /// Set the callback which needs to be invoked when the future becomes
     /// ready. If the future is ready the function will be invoked
     /// immediately.
@@ -243,25 +324,48 @@ namespace hpx { namespace lcos { namespace detail {
         if (!data_sink)
             return;
 
-        if (is_ready())
+        int s = state_.load(std::memory_order_acquire);
+        if (s == empty &&
+            state_.compare_exchange_strong(s, continuation_pending,
+                std::memory_order_acquire, std::memory_order_acquire))
+        {
+            // This is the first continuation, store it without locking.
+            continuation_ = std::move(data_sink);
+
+            s = continuation_pending;
+            while (!state_.compare_exchange_weak(s,
+                (s & ~continuation_pending) | has_continuation,
+                std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                if (s & ready)
+                {
+                    // The future was made ready in the meantime, the thread
+                    // doing so has left the continuation to this thread.
+                    handle_on_completed(std::move(continuation_));
+                    return;
+                }
+            }
+            return;
+        }
+
+        if (s & ready)
         {
             // invoke the callback (continuation) function right away
             handle_on_completed(std::move(data_sink));
+            return;
         }
-        else
+
+        std::unique_lock<mutex_type> l(mtx_);
+        if (!set_needs_lock(l))
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            if (is_ready())
-            {
-                l.unlock();
+            l.unlock();
 
-                // invoke the callback (continuation) function
-                handle_on_completed(std::move(data_sink));
-            }
-            else
-            {
-                on_completed_.push_back(std::move(data_sink));
-            }
+            // invoke the callback (continuation) function
+            handle_on_completed(std::move(data_sink));
+        }
+        else
+        {
+            on_completed_.push_back(std::move(data_sink));
         }
     }
 
@@ -269,17 +373,20 @@ namespace hpx { namespace lcos { namespace detail {
     future_data_base<traits::detail::future_data_void>::wait(error_code& ec)
     {
         // block if this entry is empty
-        state s = state_.load(std::memory_order_acquire);
+        state s = get_state();
         if (s == empty)
         {
             std::unique_lock<mutex_type> l(mtx_);
-            s = state_.load(std::memory_order_relaxed);
-            if (s == empty)
+            if (set_needs_lock(l))
             {
                 cond_.wait(l, "future_data_base::wait", ec);
                 if (ec)
                     return s;
             }
+            else
+            {
+                s = get_state(std::memory_order_relaxed);
+            }
         }
 
         if (&ec != &throws)
@@ -292,10 +399,10 @@ namespace hpx { namespace lcos { namespace detail {
         util::steady_clock::time_point const& abs_time, error_code& ec)
     {
         // block if this entry is empty
-        if (state_.load(std::memory_order_acquire) == empty)
+        if (get_state() == empty)
         {
             std::unique_lock<mutex_type> l(mtx_);
-            if (state_.load(std::memory_order_relaxed) == empty)
+            if (set_needs_lock(l))
             {
                 threads::thread_state_ex_enum const reason = cond_.wait_until(
                     l, abs_time, "future_data_base::wait_until", ec);
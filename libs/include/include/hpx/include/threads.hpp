@@ -9,6 +9,7 @@
 #include <hpx/modules/thread_executors.hpp>
 #include <hpx/modules/thread_pools.hpp>
 #include <hpx/modules/threading.hpp>
+#include <hpx/runtime/threads/elastic_pool_policy.hpp>
 #include <hpx/runtime/threads/thread_pool_suspension_helpers.hpp>
 #include <hpx/runtime_local/run_as_hpx_thread.hpp>
 #include <hpx/runtime_local/run_as_os_thread.hpp>
@@ -9,6 +9,7 @@
 
 #include <hpx/hpx_init.hpp>
 
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/command_line_handling/command_line_handling.hpp>
 #include <hpx/coroutines/detail/context_impl.hpp>
@@ -392,6 +393,9 @@ namespace hpx {
                 cms.rtcfg_.get_spinlock_deadlock_detection_limit());
 #endif
 
+            util::set_allocator_cache_enabled(
+                cms.rtcfg_.enable_allocator_cache());
+
             // initialize logging
 #if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
             util::detail::init_logging(
@@ -82,12 +82,14 @@
 
 #include <hpx/config.hpp>
 #include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
 #include <hpx/functional/deferred_call.hpp>
 #include <hpx/functional/unique_function.hpp>
 #include <hpx/lcos_local/packaged_task.hpp>
 
 #include <atomic>
 #include <cstddef>
+#include <exception>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -129,6 +131,32 @@ namespace hpx { namespace lcos { namespace local {
         HPX_EXPORT void free(guard_task* task);
 
         typedef util::unique_function_nonser<void()> guard_function;
+
+        // A publication slot of a combining_guard
+        struct combining_slot
+        {
+            enum state
+            {
+                empty = 0,
+                busy = 1,
+                full = 2
+            };
+
+            combining_slot()
+              : state_(empty)
+            {
+            }
+
+            std::atomic<int> state_;
+            guard_function task_;
+        };
+
+        // Operations which did not find a free publication slot
+        struct combining_overflow_node
+        {
+            guard_function task_;
+            combining_overflow_node* next_;
+        };
     }    // namespace detail
 
     class guard : public detail::debug_object
@@ -204,4 +232,86 @@ namespace hpx { namespace lcos { namespace local {
             detail::guard_function(util::deferred_call(
                 std::forward<F>(f), std::forward<Args>(args)...)));
     }
+
+    /// A combining_guard serializes the tasks run on it like a guard, but uses
+    /// flat combining instead of chaining the tasks: a caller which finds the
+    /// guard busy publishes its task into one of the guard's slots and
+    /// returns, while the thread currently holding the guard executes all
+    /// published tasks inline before releasing it. Uncontended tasks run
+    /// without any allocation, and contended ones are run back to back on one
+    /// core, which keeps the protected data in its cache.
+    ///
+    /// A combining thread sweeps the published tasks at most once. If more
+    /// tasks were published in the meantime it hands the guard over to a
+    /// newly created HPX thread instead of sweeping again, which keeps a
+    /// steady stream of submissions from holding a caller indefinitely.
+    /// Exceptions thrown by tasks run on such a thread are kept by the guard
+    /// and are rethrown by the next thread which acquires it, see
+    /// run_guarded and wait.
+    ///
+    /// Tasks may still be running after run_guarded has returned. The
+    /// destructor waits for all submitted tasks to have been run, call wait
+    /// to do so explicitly and to observe any exception kept by the guard.
+    ///
+    /// Unlike for a guard the tasks are not guaranteed to run in the order
+    /// they were submitted, and a combining_guard can't be part of a
+    /// guard_set.
+    class combining_guard : public detail::debug_object
+    {
+    public:
+        /// \param num_slots  The number of publication slots, defaults to
+        ///                   the number of cores if zero.
+        HPX_EXPORT explicit combining_guard(std::size_t num_slots = 0);
+        HPX_EXPORT ~combining_guard();
+
+        combining_guard(combining_guard const&) = delete;
+        combining_guard& operator=(combining_guard const&) = delete;
+
+        /// Wait for all tasks submitted so far to have been run. Rethrows the
+        /// first exception thrown by a task which was not yet rethrown by
+        /// run_guarded. Must not be called from a task run on this guard.
+        HPX_EXPORT void wait();
+
+        friend HPX_EXPORT void run_guarded(
+            combining_guard& guard, detail::guard_function task);
+
+    private:
+        void publish(detail::guard_function&& task);
+        std::size_t combine(std::exception_ptr& exception);
+        void release(std::ptrdiff_t executed, std::exception_ptr& exception);
+        bool hand_over();
+        void resume();
+
+        // the number of tasks which were submitted but have not run yet, the
+        // caller incrementing it from zero becomes the combiner
+        util::cache_line_data<std::atomic<std::ptrdiff_t>> pending_;
+        util::cache_line_data<std::atomic<detail::combining_overflow_node*>>
+            overflow_;
+        std::vector<util::cache_aligned_data<detail::combining_slot>> slots_;
+
+        // the first exception thrown by a task run on a thread the guard was
+        // handed over to, accessed only while holding the guard
+        std::exception_ptr exception_;
+    };
+
+    /// Run the task while holding the combining_guard. If the guard is held
+    /// by another thread, the task is handed over to that thread and this
+    /// function returns immediately. Otherwise the task and all tasks
+    /// published in the meantime are run by the calling thread, as long as
+    /// a single sweep over the published tasks suffices. Otherwise the
+    /// remaining tasks are run on a new HPX thread. If any of the tasks run
+    /// by the calling thread throws, or if a task run on a new thread threw
+    /// since the guard was last acquired by a caller, the first of these
+    /// exceptions is rethrown once the calling thread is done running
+    /// tasks.
+    HPX_EXPORT void run_guarded(
+        combining_guard& guard, detail::guard_function task);
+
+    template <typename F, typename... Args>
+    void run_guarded(combining_guard& guard, F&& f, Args&&... args)
+    {
+        return run_guarded(guard,
+            detail::guard_function(util::deferred_call(
+                std::forward<F>(f), std::forward<Args>(args)...)));
+    }
 }}}    // namespace hpx::lcos::local
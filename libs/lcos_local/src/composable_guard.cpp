@@ -8,11 +8,19 @@
 #include <hpx/assert.hpp>
 #include <hpx/functional/bind_front.hpp>
 #include <hpx/functional/function.hpp>
+#include <hpx/execution_base/this_thread.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/threading_base/register_thread.hpp>
+#include <hpx/threading_base/thread_init_data.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
+#include <hpx/topology/topology.hpp>
 
 #include <hpx/lcos_local/composable_guard.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <exception>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -284,4 +292,216 @@ namespace hpx { namespace lcos { namespace local {
             free(zero);
         }
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    combining_guard::combining_guard(std::size_t num_slots)
+      : slots_(num_slots != 0 ? num_slots : threads::hardware_concurrency())
+    {
+        pending_.data_.store(0, std::memory_order_relaxed);
+        overflow_.data_.store(nullptr, std::memory_order_relaxed);
+    }
+
+    combining_guard::~combining_guard()
+    {
+        // tasks may still be running on a thread the guard was handed over
+        // to, that thread does not access the guard anymore once the count
+        // of pending tasks has dropped to zero
+        std::atomic<std::ptrdiff_t>& pending = pending_.data_;
+        hpx::util::yield_while(
+            [&]() { return pending.load(std::memory_order_acquire) != 0; },
+            "hpx::lcos::local::combining_guard::~combining_guard");
+
+        detail::combining_overflow_node* node =
+            overflow_.data_.load(std::memory_order_relaxed);
+        while (node != nullptr)
+        {
+            detail::combining_overflow_node* next = node->next_;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Hand the task over to the current combiner, which is guaranteed to pick
+    // it up as the task has been accounted for in pending_ already.
+    void combining_guard::publish(detail::guard_function&& task)
+    {
+        // start looking at a different slot on each core to avoid contention
+        // between publishers
+        std::size_t const num_slots = slots_.size();
+        std::size_t const start = get_worker_thread_num();
+        for (std::size_t i = 0; i != num_slots; ++i)
+        {
+            detail::combining_slot& slot =
+                slots_[(start + i) % num_slots].data_;
+
+            int expected = detail::combining_slot::empty;
+            if (slot.state_.load(std::memory_order_relaxed) == expected &&
+                slot.state_.compare_exchange_strong(expected,
+                    detail::combining_slot::busy, std::memory_order_acquire))
+            {
+                slot.task_ = std::move(task);
+                slot.state_.store(
+                    detail::combining_slot::full, std::memory_order_release);
+                return;
+            }
+        }
+
+        // all slots are occupied, fall back to pushing the task onto the
+        // overflow list
+        detail::combining_overflow_node* node =
+            new detail::combining_overflow_node{std::move(task),
+                overflow_.data_.load(std::memory_order_relaxed)};
+        while (!overflow_.data_.compare_exchange_weak(node->next_, node,
+            std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // The tasks are fire-and-forget, an exception thrown by one of them must
+    // not prevent the remaining ones from being run.
+    static void run_combined(
+        detail::guard_function& task, std::exception_ptr& exception)
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            if (!exception)
+                exception = std::current_exception();
+        }
+    }
+
+    // Run all tasks published so far, returns the number of tasks run.
+    std::size_t combining_guard::combine(std::exception_ptr& exception)
+    {
+        std::size_t executed = 0;
+        for (auto& s : slots_)
+        {
+            detail::combining_slot& slot = s.data_;
+            if (slot.state_.load(std::memory_order_acquire) ==
+                detail::combining_slot::full)
+            {
+                detail::guard_function task = std::move(slot.task_);
+                slot.state_.store(
+                    detail::combining_slot::empty, std::memory_order_release);
+
+                run_combined(task, exception);
+                ++executed;
+            }
+        }
+
+        detail::combining_overflow_node* node =
+            overflow_.data_.exchange(nullptr, std::memory_order_acquire);
+        while (node != nullptr)
+        {
+            std::unique_ptr<detail::combining_overflow_node> p(node);
+            node = node->next_;
+
+            run_combined(p->task_, exception);
+            ++executed;
+        }
+
+        return executed;
+    }
+
+    // Release the guard after the given number of tasks has been run. Tasks
+    // published in the meantime are swept once, if there are still tasks
+    // pending after that the guard is handed over to a new thread.
+    void combining_guard::release(
+        std::ptrdiff_t executed, std::exception_ptr& exception)
+    {
+        std::atomic<std::ptrdiff_t>& pending = pending_.data_;
+
+        bool swept = false;
+        for (std::size_t k = 0;
+             pending.fetch_sub(executed, std::memory_order_acq_rel) !=
+             executed;
+             /**/)
+        {
+            if (swept && hand_over())
+                return;
+
+            executed = static_cast<std::ptrdiff_t>(combine(exception));
+            if (executed == 0)
+            {
+                // a task was accounted for but has not been published yet
+                hpx::util::detail::yield_k(
+                    k++, "hpx::lcos::local::run_guarded(combining_guard)");
+            }
+            else
+            {
+                k = 0;
+                swept = true;
+            }
+        }
+    }
+
+    // Let a new thread continue running the pending tasks, returns false if
+    // no thread could be created.
+    bool combining_guard::hand_over()
+    {
+        threads::thread_init_data data(
+            threads::make_thread_function_nullary(
+                util::bind_front(&combining_guard::resume, this)),
+            "hpx::lcos::local::combining_guard::resume");
+
+        error_code ec(lightweight);
+        threads::register_work(data, ec);
+        return !ec;
+    }
+
+    // The guard is still held on behalf of the thread which handed it over.
+    // There is nobody to report exceptions to, keep the first one for the
+    // next thread acquiring the guard.
+    void combining_guard::resume()
+    {
+        release(0, exception_);
+    }
+
+    void combining_guard::wait()
+    {
+        check_();
+
+        // acquire the guard once all pending tasks have been run
+        std::atomic<std::ptrdiff_t>& pending = pending_.data_;
+        hpx::util::yield_while(
+            [&]() {
+                std::ptrdiff_t expected = 0;
+                return !pending.compare_exchange_weak(expected, 1,
+                    std::memory_order_acq_rel, std::memory_order_relaxed);
+            },
+            "hpx::lcos::local::combining_guard::wait");
+
+        std::exception_ptr exception = std::move(exception_);
+        exception_ = std::exception_ptr();
+        release(1, exception);
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    void run_guarded(combining_guard& guard, detail::guard_function task)
+    {
+        guard.check_();
+
+        std::atomic<std::ptrdiff_t>& pending = guard.pending_.data_;
+        if (pending.fetch_add(1, std::memory_order_acq_rel) != 0)
+        {
+            // somebody else holds the guard and will run the task
+            guard.publish(std::move(task));
+            return;
+        }
+
+        // this thread holds the guard now, run the given task and everything
+        // published in the meantime before releasing it
+        std::exception_ptr exception = std::move(guard.exception_);
+        guard.exception_ = std::exception_ptr();
+        run_combined(task, exception);
+        guard.release(1, exception);
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
 }}}    // namespace hpx::lcos::local
@@ -0,0 +1,156 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of a critical section protecting a
+// shared data structure which is updated concurrently by one worker per core.
+// It compares a mutex, the chained hpx::lcos::local::guard, and the flat
+// combining hpx::lcos::local::combining_guard, for instance:
+//
+//      guard_contention_test --hpx:threads=16 --updates=100000
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/lcos_local/composable_guard.hpp>
+#include <hpx/modules/synchronization.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t num_updates = 100000;
+std::size_t histogram_size = 1024;
+
+// the shared data structure, protected by the critical section
+std::vector<std::uint64_t> histogram;
+std::atomic<std::size_t> completed(0);
+
+void update(std::size_t rank, std::size_t i)
+{
+    histogram[(rank * 7919 + i * 104729) % histogram_size] += i;
+    completed.fetch_add(1, std::memory_order_relaxed);
+}
+
+struct mutex_section
+{
+    void run(std::size_t rank, std::size_t i)
+    {
+        std::lock_guard<hpx::lcos::local::mutex> l(mtx_);
+        update(rank, i);
+    }
+
+    void wait() {}
+
+    hpx::lcos::local::mutex mtx_;
+};
+
+template <typename Guard>
+struct guarded_section
+{
+    void run(std::size_t rank, std::size_t i)
+    {
+        hpx::lcos::local::run_guarded(guard_, &update, rank, i);
+    }
+
+    void wait()
+    {
+        wait_for(guard_);
+    }
+
+    static void wait_for(hpx::lcos::local::guard&) {}
+
+    // the guard may still be held after the last task has run
+    static void wait_for(hpx::lcos::local::combining_guard& g)
+    {
+        g.wait();
+    }
+
+    Guard guard_;
+};
+
+template <typename Section>
+void worker(Section& s, std::size_t rank)
+{
+    for (std::size_t i = 0; i != num_updates; ++i)
+    {
+        s.run(rank, i);
+    }
+}
+
+template <typename Section>
+void run_benchmark(char const* name)
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+
+    histogram.assign(histogram_size, 0);
+    completed = 0;
+
+    Section s;
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    std::vector<hpx::future<void>> tasks;
+    tasks.reserve(num_threads - 1);
+    for (std::size_t i = 1; i != num_threads; ++i)
+    {
+        tasks.push_back(hpx::async(&worker<Section>, std::ref(s), i));
+    }
+    worker(s, 0);
+    hpx::wait_all(tasks);
+
+    // guarded tasks may still be running after the workers have returned
+    std::size_t const total = num_threads * num_updates;
+    hpx::util::yield_while([total]() { return completed.load() != total; });
+
+    double const elapsed =
+        static_cast<double>(hpx::util::high_resolution_clock::now() - start) /
+        1e9;
+
+    s.wait();
+
+    std::cout << name << ": " << num_threads << " threads, "
+              << (elapsed / double(total)) * 1e9 << " [ns/update]\n";
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    num_updates = vm["updates"].as<std::size_t>();
+    histogram_size = vm["histogram_size"].as<std::size_t>();
+
+    run_benchmark<mutex_section>("mutex");
+    run_benchmark<guarded_section<hpx::lcos::local::guard>>("guard");
+    run_benchmark<guarded_section<hpx::lcos::local::combining_guard>>(
+        "combining_guard");
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("updates",
+         hpx::program_options::value<std::size_t>()->default_value(100000),
+         "the number of updates per worker")
+        ("histogram_size",
+         hpx::program_options::value<std::size_t>()->default_value(1024),
+         "the number of entries in the shared histogram")
+        ;
+    // clang-format on
+
+    return hpx::init(cmdline, argc, argv);
+}
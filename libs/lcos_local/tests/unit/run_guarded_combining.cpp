@@ -0,0 +1,227 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/lcos_local/composable_guard.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int increments = 3000;
+
+// protected by the guard, deliberately not atomic
+std::size_t counter = 0;
+std::atomic<bool> inside(false);
+
+void incr(std::size_t value)
+{
+    HPX_TEST(!inside.exchange(true));
+    counter += value;
+    inside.store(false);
+}
+
+// The tasks run on a combining_guard are not ordered, resubmit the check
+// until all increments have been executed.
+void check(hpx::lcos::local::combining_guard& g,
+    hpx::lcos::local::promise<void>& p, std::size_t expected)
+{
+    HPX_TEST(!inside.load());
+    HPX_TEST(counter <= expected);
+    if (counter == expected)
+    {
+        p.set_value();
+        return;
+    }
+    hpx::lcos::local::run_guarded(
+        g, &check, std::ref(g), std::ref(p), expected);
+}
+
+void test_combining(std::size_t num_slots)
+{
+    counter = 0;
+
+    hpx::lcos::local::combining_guard g(num_slots);
+
+    std::vector<hpx::future<void>> workers;
+    for (std::size_t i = 0; i != hpx::get_os_thread_count(); ++i)
+    {
+        workers.push_back(hpx::async([&g]() {
+            for (int j = 0; j != increments; ++j)
+            {
+                hpx::lcos::local::run_guarded(g, &incr, std::size_t(1));
+            }
+        }));
+    }
+    hpx::wait_all(workers);
+
+    hpx::lcos::local::promise<void> p;
+    hpx::future<void> f = p.get_future();
+    hpx::lcos::local::run_guarded(
+        g, &check, std::ref(g), std::ref(p), workers.size() * increments);
+    f.get();
+
+    // the thread running the check may still hold the guard
+    g.wait();
+
+    HPX_TEST_EQ(counter, workers.size() * increments);
+}
+
+void test_exception()
+{
+    counter = 0;
+
+    hpx::lcos::local::combining_guard g;
+
+    // the guard is not contended, the task runs inline and its exception is
+    // reported to the caller
+    bool caught = false;
+    try
+    {
+        hpx::lcos::local::run_guarded(
+            g, []() { throw std::runtime_error("test"); });
+    }
+    catch (std::runtime_error const&)
+    {
+        caught = true;
+    }
+    HPX_TEST(caught);
+
+    // the guard is released after the exception, tasks submitted from
+    // within a task are run before the guard is released
+    hpx::lcos::local::run_guarded(g, [&g]() {
+        hpx::lcos::local::run_guarded(g, &incr, std::size_t(2));
+        HPX_TEST_EQ(counter, std::size_t(0));
+    });
+    HPX_TEST_EQ(counter, std::size_t(2));
+}
+
+// Every task submits another one while it is being run by the combiner,
+// the caller which became the combiner has to return nevertheless.
+std::atomic<bool> stop_resubmitting(false);
+std::atomic<bool> resubmitting_done(false);
+std::atomic<std::size_t> resubmitted(0);
+
+void resubmit(hpx::lcos::local::combining_guard& g)
+{
+    HPX_TEST(!inside.exchange(true));
+    ++resubmitted;
+    inside.store(false);
+
+    if (stop_resubmitting.load())
+    {
+        resubmitting_done.store(true);
+        return;
+    }
+    hpx::lcos::local::run_guarded(g, &resubmit, std::ref(g));
+}
+
+void test_continuous_submissions()
+{
+    hpx::lcos::local::combining_guard g;
+
+    hpx::lcos::local::run_guarded(g, &resubmit, std::ref(g));
+    HPX_TEST(resubmitted.load() != 0);
+
+    stop_resubmitting.store(true);
+    hpx::util::yield_while([]() { return !resubmitting_done.load(); });
+
+    g.wait();
+}
+
+// Tasks throwing while the guard is contended must neither terminate the
+// runtime nor prevent the remaining tasks from being run, their exceptions
+// are reported either to a caller running tasks or by wait.
+void throw_every(std::size_t value, int every, int j)
+{
+    incr(value);
+    if (j % every == 0)
+        throw std::runtime_error("test");
+}
+
+void test_exception_under_contention()
+{
+    counter = 0;
+
+    hpx::lcos::local::combining_guard g;
+
+    std::atomic<std::size_t> caught(0);
+
+    std::vector<hpx::future<void>> workers;
+    for (std::size_t i = 0; i != hpx::get_os_thread_count(); ++i)
+    {
+        workers.push_back(hpx::async([&g, &caught]() {
+            for (int j = 1; j <= increments; ++j)
+            {
+                try
+                {
+                    hpx::lcos::local::run_guarded(
+                        g, &throw_every, std::size_t(1), 10, j);
+                }
+                catch (std::runtime_error const&)
+                {
+                    ++caught;
+                }
+            }
+        }));
+    }
+    hpx::wait_all(workers);
+
+    try
+    {
+        g.wait();
+    }
+    catch (std::runtime_error const&)
+    {
+        ++caught;
+    }
+
+    // all tasks have run, and at least one of the exceptions was reported
+    HPX_TEST_EQ(counter, workers.size() * increments);
+    HPX_TEST(caught.load() != 0);
+    HPX_TEST(caught.load() <= workers.size() * (increments / 10) + 1);
+
+    // the guard doesn't keep any exception once it has been reported
+    g.wait();
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    increments = vm["increments"].as<int>();
+
+    test_combining(0);
+    test_combining(1);
+    test_combining(64);
+    test_exception();
+    test_continuous_submissions();
+    test_exception_under_contention();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()("increments,n",
+        hpx::program_options::value<int>()->default_value(3000),
+        "the number of times each thread increments the counter");
+
+    // We force this test to use several threads by default.
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,54 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace util { namespace logging {
+
+    class logger;
+    class message;
+
+    namespace detail {
+        // Hand a message over to the background writer, returns false if
+        // the message was dropped as the buffer of the calling thread is
+        // full.
+        HPX_EXPORT bool async_log_push(logger* l, message&& msg);
+    }    // namespace detail
+
+    /**
+    @brief Asynchronous logging
+
+    If enabled, the loggers move the message into a lock-free ring buffer
+    owned by the calling thread, together with the context of the formatters
+    captured on the calling thread (thread ids, time stamps, etc.). A
+    background thread collects the messages from all buffers, applies the
+    formatters and writes the messages to the destinations in batches (one
+    write per logger and batch). Messages of loggers using formatters which
+    can't capture their context are formatted on the calling thread.
+
+    Messages are dropped (and counted) if the buffer of a thread overflows.
+    The order of messages logged from different threads is not preserved.
+    */
+    HPX_EXPORT void start_async_logging(
+        std::size_t buffer_size = HPX_LOGGING_ASYNC_BUFFER_SIZE_DEFAULT);
+
+    // write all pending messages and stop the background thread
+    HPX_EXPORT void stop_async_logging();
+
+    // synchronously write all messages logged so far
+    HPX_EXPORT void flush_async_logging();
+
+    HPX_EXPORT bool is_async_logging_enabled() noexcept;
+
+    // number of messages dropped because of buffer overflows
+    HPX_EXPORT std::uint64_t get_async_logging_dropped(bool reset);
+
+}}}    // namespace hpx::util::logging
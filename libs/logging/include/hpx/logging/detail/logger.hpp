@@ -17,6 +17,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
+#include <hpx/logging/async_logging.hpp>
 #include <hpx/logging/format/named_write.hpp>
 #include <hpx/logging/level.hpp>
 #include <hpx/modules/format.hpp>
@@ -171,12 +172,19 @@ namespace hpx { namespace util { namespace logging {
         // called after all data has been gathered
         void write(message msg)
         {
-            if (m_is_caching_off)
-                m_writer(msg);
-            else
+            if (!m_is_caching_off)
                 m_cache.push_back(std::move(msg));
+            else if (is_async_logging_enabled())
+                write_async(std::move(msg));
+            else
+                m_writer(msg);
         }
 
+    private:
+        // capture the context of the formatters on the calling thread and
+        // leave formatting and writing the message to the background thread
+        HPX_EXPORT void write_async(message&& msg);
+
     private:
         mutable std::vector<message> m_cache;
         mutable bool m_is_caching_off;
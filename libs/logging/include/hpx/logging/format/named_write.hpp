@@ -21,6 +21,7 @@
 #include <hpx/logging/format/formatters.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -91,6 +92,10 @@ You could have an output like this:
 @endcode
 
 */
+    // the maximum number of formatters whose context can be captured for
+    // formatting a message later
+    constexpr std::size_t max_captured_formatters = 16;
+
     struct named_formatters
     {
         HPX_NON_COPYABLE(named_formatters);
@@ -139,6 +144,44 @@ You could have an output like this:
             }
         }
 
+        // capture the context of all formatters, returns false if one of
+        // them doesn't support this
+        bool capture(std::uint64_t* captured) const
+        {
+            std::size_t i = 0;
+            for (auto const& step : write_steps)
+            {
+                if (step.fmt && step.fmt != (formatter::manipulator*) -1)
+                {
+                    if (i == max_captured_formatters ||
+                        !step.fmt->can_capture())
+                    {
+                        return false;
+                    }
+                    captured[i++] = step.fmt->capture();
+                }
+            }
+            return true;
+        }
+
+        // format the message using the context captured before
+        void operator()(std::ostream& out, message const& msg,
+            std::uint64_t const* captured) const
+        {
+            std::size_t i = 0;
+            for (auto const& step : write_steps)
+            {
+                out << step.prefix;
+                if (step.fmt)
+                {
+                    if (step.fmt == (formatter::manipulator*) -1)
+                        out << msg;
+                    else
+                        step.fmt->format_captured(out, captured[i++]);
+                }
+            }
+        }
+
     private:
         // recomputes the write steps - note that this takes place after
         // each operation for instance, the user might have first set the
@@ -404,6 +447,40 @@ This will just configure "file" twice, ending up with writing only to "two.txt"
 #endif
         }
 
+        /** @brief applies the formatters only, the result can be written to
+    the destinations later (see write_formatted)
+    */
+        message format_message(message const& msg) const
+        {
+            std::stringstream out;
+            m_format(out, msg);
+            return message(std::move(out));
+        }
+
+        /** @brief captures the context of the formatters on the logging
+    thread, returns false if not all of them support this. The message can
+    then be formatted on any thread (see format_captured).
+    */
+        bool capture(std::uint64_t* captured) const
+        {
+            return m_format.capture(captured);
+        }
+
+        /** @brief applies the formatters using the context captured before
+    */
+        void format_captured(std::ostream& out, message const& msg,
+            std::uint64_t const* captured) const
+        {
+            m_format(out, msg, captured);
+        }
+
+        /** @brief writes an already formatted message to the destinations
+    */
+        void write_formatted(message const& formatted) const
+        {
+            m_destination(formatted);
+        }
+
         /** @brief Replaces a formatter from the named formatter.
 
     You can use this, for instance, when you want to share
@@ -22,6 +22,7 @@
 
 #include <boost/utility/string_ref.hpp>
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 
@@ -53,6 +54,27 @@ namespace hpx { namespace util { namespace logging {
             /// That is, this allows configuration of your manipulator at run-time.
             virtual void configure(std::string const&) {}
 
+            /// @brief Override these to allow for the message to be formatted
+            /// on a different thread (see asynchronous logging).
+            ///
+            /// capture() is invoked on the logging thread and returns the
+            /// context the formatter depends on (e.g. the current time or the
+            /// id of the current thread), format_captured() later writes it.
+            virtual bool can_capture() const noexcept
+            {
+                return false;
+            }
+
+            virtual std::uint64_t capture() const
+            {
+                return 0;
+            }
+
+            virtual void format_captured(std::ostream& to, std::uint64_t) const
+            {
+                (*this)(to);
+            }
+
             HPX_EXPORT virtual ~manipulator();
 
         protected:
@@ -76,6 +76,17 @@ namespace hpx { namespace util { namespace logging {
             other.m_full_msg_computed = false;
         }
 
+        message& operator=(message&& other) noexcept
+        {
+#if !defined(HPX_COMPUTE_HOST_CODE)
+            m_str = std::move(other.m_str);
+            m_full_msg = std::move(other.m_full_msg);
+#endif
+            m_full_msg_computed = other.m_full_msg_computed;
+            other.m_full_msg_computed = false;
+            return *this;
+        }
+
         template <typename T>
         message& operator<<(T&& v)
         {
@@ -93,6 +104,16 @@ namespace hpx { namespace util { namespace logging {
             return *this;
         }
 
+        template <std::size_t NumSegments, typename... Args>
+        message& format(
+            util::static_format_string<NumSegments> const& format_str,
+            Args const&... args) noexcept
+        {
+            util::format_to(m_str, format_str, args...);
+            m_full_msg_computed = false;
+            return *this;
+        }
+
         /**
             returns the full string
         */
@@ -108,7 +129,11 @@ namespace hpx { namespace util { namespace logging {
 
         bool empty() const
         {
-            return full_string().empty();
+            // avoid copying the message just for checking its size
+            if (m_full_msg_computed)
+                return m_full_msg.empty();
+            return m_str.rdbuf()->pubseekoff(
+                       0, std::ios_base::cur, std::ios_base::out) == 0;
         }
 
         friend std::ostream& operator<<(std::ostream& os, message const& value)
@@ -34,13 +34,21 @@ namespace hpx { namespace util {
     namespace detail {
         HPX_EXPORT hpx::util::logging::level get_log_level(
             std::string const& env, bool allow_always = false);
-    }
+
+        // the format strings of the prefixes of all log records, these are
+        // parsed at compile time
+        constexpr auto log_format_level = HPX_FORMAT_STRING("{} ");
+        constexpr auto log_format_category = HPX_FORMAT_STRING("{}{}");
+        constexpr auto log_format_progress = HPX_FORMAT_STRING(" {}:{} {} ");
+        constexpr auto log_format_error = HPX_FORMAT_STRING("{} [ERR] ");
+    }    // namespace detail
 
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT HPX_DECLARE_LOG(agas)
 
 #define LAGAS_(lvl)                                                            \
-    HPX_LOG_FORMAT(hpx::util::agas, ::hpx::util::logging::level::lvl, "{} ",   \
+    HPX_LOG_FORMAT(hpx::util::agas, ::hpx::util::logging::level::lvl,          \
+        ::hpx::util::detail::log_format_level,                                 \
         ::hpx::util::logging::level::lvl) /**/
 
 #define LAGAS_ENABLED(lvl)                                                     \
@@ -50,7 +58,8 @@ namespace hpx { namespace util {
         HPX_EXPORT HPX_DECLARE_LOG(parcel)
 
 #define LPT_(lvl)                                                              \
-    HPX_LOG_FORMAT(hpx::util::parcel, ::hpx::util::logging::level::lvl, "{} ", \
+    HPX_LOG_FORMAT(hpx::util::parcel, ::hpx::util::logging::level::lvl,        \
+        ::hpx::util::detail::log_format_level,                                 \
         ::hpx::util::logging::level::lvl) /**/
 
 #define LPT_ENABLED(lvl)                                                       \
@@ -61,11 +70,13 @@ namespace hpx { namespace util {
         HPX_EXPORT HPX_DECLARE_LOG(timing)
 
 #define LTIM_(lvl)                                                             \
-    HPX_LOG_FORMAT(hpx::util::timing, ::hpx::util::logging::level::lvl, "{} ", \
+    HPX_LOG_FORMAT(hpx::util::timing, ::hpx::util::logging::level::lvl,        \
+        ::hpx::util::detail::log_format_level,                                 \
         ::hpx::util::logging::level::lvl) /**/
 #define LPROGRESS_                                                             \
     HPX_LOG_FORMAT(hpx::util::timing, ::hpx::util::logging::level::fatal,      \
-        " {}:{} {} ", __FILE__, __LINE__, HPX_ASSERT_CURRENT_FUNCTION) /**/
+        ::hpx::util::detail::log_format_progress, __FILE__, __LINE__,          \
+        HPX_ASSERT_CURRENT_FUNCTION) /**/
 
 #define LTIM_ENABLED(lvl)                                                      \
     hpx::util::timing_logger()->is_enabled(                                    \
@@ -75,7 +86,8 @@ namespace hpx { namespace util {
         HPX_EXPORT HPX_DECLARE_LOG(hpx)
 
 #define LHPX_(lvl, cat)                                                        \
-    HPX_LOG_FORMAT(hpx::util::hpx, ::hpx::util::logging::level::lvl, "{}{}",   \
+    HPX_LOG_FORMAT(hpx::util::hpx, ::hpx::util::logging::level::lvl,           \
+        ::hpx::util::detail::log_format_category,                              \
         ::hpx::util::logging::level::lvl, (cat)) /**/
 
 #define LHPX_ENABLED(lvl)                                                      \
@@ -85,7 +97,8 @@ namespace hpx { namespace util {
         HPX_EXPORT HPX_DECLARE_LOG(app)
 
 #define LAPP_(lvl)                                                             \
-    HPX_LOG_FORMAT(hpx::util::app, ::hpx::util::logging::level::lvl, "{} ",    \
+    HPX_LOG_FORMAT(hpx::util::app, ::hpx::util::logging::level::lvl,           \
+        ::hpx::util::detail::log_format_level,                                 \
         ::hpx::util::logging::level::lvl) /**/
 
 #define LAPP_ENABLED(lvl)                                                      \
@@ -97,7 +110,8 @@ namespace hpx { namespace util {
 
 #define LDEB_                                                                  \
     HPX_LOG_FORMAT(hpx::util::debuglog, ::hpx::util::logging::level::error,    \
-        "{} ", ::hpx::util::logging::level::error) /**/
+        ::hpx::util::detail::log_format_level,                                 \
+        ::hpx::util::logging::level::error) /**/
 
 #define LDEB_ENABLED                                                           \
     hpx::util::debuglog_logger()->is_enabled(                                  \
@@ -110,7 +124,8 @@ namespace hpx { namespace util {
 
 #define LFATAL_                                                                \
     HPX_LOG_FORMAT(hpx::util::hpx_error, ::hpx::util::logging::level::fatal,   \
-        "{} [ERR] ", ::hpx::util::logging::level::fatal) /**/
+        ::hpx::util::detail::log_format_error,                                 \
+        ::hpx::util::logging::level::fatal) /**/
 
             HPX_EXPORT HPX_DECLARE_LOG(agas_console) HPX_EXPORT
         HPX_DECLARE_LOG(parcel_console) HPX_EXPORT
@@ -0,0 +1,367 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_LOGGING)
+#include <hpx/logging/async_logging.hpp>
+#include <hpx/logging/detail/logger.hpp>
+#include <hpx/logging/format/named_write.hpp>
+#include <hpx/logging/message.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace logging {
+
+    namespace detail {
+
+        static std::atomic<bool> async_logging_enabled(false);
+        static std::atomic<std::uint64_t> async_logging_dropped(0);
+
+        struct log_record
+        {
+            logger* logger_ = nullptr;
+            message msg_;
+
+            // the message was formatted on the logging thread already
+            bool formatted_ = false;
+            std::uint64_t captured_[max_captured_formatters];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Bounded single-producer/single-consumer ring buffer. The producer
+        // is the thread owning the buffer, the consumer is whoever holds the
+        // drain lock of the log processor.
+        struct log_buffer
+        {
+            explicit log_buffer(std::size_t capacity)
+              : records_(capacity)
+            {
+            }
+
+            std::size_t capacity() const noexcept
+            {
+                return records_.size();
+            }
+
+            // returns the number of messages in the buffer after the push,
+            // zero if the buffer was full
+            std::size_t push(logger* l, message&& msg)
+            {
+                std::size_t const tail = tail_.load(std::memory_order_relaxed);
+                std::size_t const head = head_.load(std::memory_order_acquire);
+                if (tail - head == records_.size())
+                {
+                    return 0;
+                }
+
+                log_record& rec = records_[tail % records_.size()];
+                rec.logger_ = l;
+                rec.formatted_ = !l->writer().capture(rec.captured_);
+                if (rec.formatted_)
+                {
+                    // fall back to formatting the message right away
+                    rec.msg_ = l->writer().format_message(msg);
+                }
+                else
+                {
+                    rec.msg_ = std::move(msg);
+                }
+
+                tail_.store(tail + 1, std::memory_order_release);
+                return tail + 1 - head;
+            }
+
+            // move all available messages to the given vector
+            void pop_all(std::vector<log_record>& records)
+            {
+                std::size_t head = head_.load(std::memory_order_relaxed);
+                std::size_t const tail = tail_.load(std::memory_order_acquire);
+                for (/**/; head != tail; ++head)
+                {
+                    records.push_back(
+                        std::move(records_[head % records_.size()]));
+                }
+                head_.store(head, std::memory_order_release);
+            }
+
+            std::vector<log_record> records_;
+            std::atomic<std::size_t> head_{0};
+            std::atomic<std::size_t> tail_{0};
+
+            // set once the owning thread has exited
+            std::atomic<bool> orphaned_{false};
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class log_processor
+        {
+        public:
+            log_processor() = default;
+
+            ~log_processor()
+            {
+                stop();
+            }
+
+            void start(std::size_t buffer_size)
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                if (thread_.joinable())
+                {
+                    return;    // already running
+                }
+
+                buffer_size_ = buffer_size != 0 ? buffer_size : 1;
+                stop_ = false;
+                thread_ = std::thread(&log_processor::run, this);
+
+                async_logging_enabled.store(true);
+            }
+
+            void stop()
+            {
+                {
+                    std::lock_guard<std::mutex> l(mtx_);
+                    if (!thread_.joinable())
+                    {
+                        return;
+                    }
+
+                    async_logging_enabled.store(false);
+                    stop_ = true;
+                }
+                cond_.notify_one();
+                thread_.join();
+
+                // messages may have been logged concurrently with stopping
+                flush();
+            }
+
+            void flush()
+            {
+                std::lock_guard<std::mutex> l(drain_mtx_);
+                drain();
+            }
+
+            std::shared_ptr<log_buffer> create_buffer()
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+
+                auto buffer = std::make_shared<log_buffer>(buffer_size_);
+                buffers_.push_back(buffer);
+                return buffer;
+            }
+
+            // called by a producer if its buffer is filling up
+            void notify()
+            {
+                cond_.notify_one();
+            }
+
+        private:
+            void run()
+            {
+                std::unique_lock<std::mutex> l(mtx_);
+                while (!stop_)
+                {
+                    cond_.wait_for(l, std::chrono::milliseconds(10));
+
+                    l.unlock();
+                    flush();
+                    l.lock();
+                }
+            }
+
+            // requires drain_mtx_ to be held
+            void drain()
+            {
+                {
+                    std::lock_guard<std::mutex> l(mtx_);
+                    for (auto it = buffers_.begin(); it != buffers_.end();
+                         /**/)
+                    {
+                        // the owning thread of an orphaned buffer will not
+                        // push any more messages
+                        bool const orphaned =
+                            (*it)->orphaned_.load(std::memory_order_acquire);
+
+                        (*it)->pop_all(records_);
+
+                        if (orphaned)
+                            it = buffers_.erase(it);
+                        else
+                            ++it;
+                    }
+                }
+
+                if (records_.empty())
+                {
+                    return;
+                }
+
+                // combine all messages of a logger into one write
+                std::vector<std::pair<logger*, std::stringstream>> batches;
+                for (log_record& rec : records_)
+                {
+                    auto it = batches.begin();
+                    for (/**/; it != batches.end(); ++it)
+                    {
+                        if (it->first == rec.logger_)
+                            break;
+                    }
+                    if (it == batches.end())
+                    {
+                        batches.emplace_back(rec.logger_, std::stringstream());
+                        it = batches.end() - 1;
+                    }
+
+                    try
+                    {
+                        if (rec.formatted_)
+                        {
+                            it->second << rec.msg_;
+                        }
+                        else
+                        {
+                            rec.logger_->writer().format_captured(
+                                it->second, rec.msg_, rec.captured_);
+                        }
+                    }
+                    catch (...)
+                    {
+                        // there is nobody to report this error to
+                    }
+                }
+                records_.clear();
+
+                for (auto& batch : batches)
+                {
+                    try
+                    {
+                        message msg(std::move(batch.second));
+                        batch.first->writer().write_formatted(msg);
+                    }
+                    catch (...)
+                    {
+                        // there is nobody to report this error to
+                    }
+                }
+            }
+
+            std::mutex mtx_;
+            std::condition_variable cond_;
+            std::thread thread_;
+            bool stop_ = false;
+            std::size_t buffer_size_ =
+                HPX_LOGGING_ASYNC_BUFFER_SIZE_DEFAULT;
+            std::vector<std::shared_ptr<log_buffer>> buffers_;
+
+            std::mutex drain_mtx_;
+            std::vector<log_record> records_;
+        };
+
+        // The processor is created on first use, i.e. after the loggers have
+        // been created. It is therefore destroyed (and its thread joined)
+        // before the loggers go out of scope.
+        static log_processor& get_log_processor()
+        {
+            static log_processor processor;
+            return processor;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct log_buffer_holder
+        {
+            log_buffer_holder()
+              : buffer_(get_log_processor().create_buffer())
+            {
+            }
+
+            ~log_buffer_holder()
+            {
+                buffer_->orphaned_.store(true, std::memory_order_release);
+            }
+
+            std::shared_ptr<log_buffer> buffer_;
+        };
+
+        bool async_log_push(logger* l, message&& msg)
+        {
+            static thread_local log_buffer_holder holder;
+
+            log_buffer& buffer = *holder.buffer_;
+            std::size_t const count = buffer.push(l, std::move(msg));
+            if (count == 0)
+            {
+                async_logging_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // wake up the background thread early if the buffer is filling up
+            if (count == buffer.capacity() / 2)
+            {
+                get_log_processor().notify();
+            }
+            return true;
+        }
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start_async_logging(std::size_t buffer_size)
+    {
+        detail::get_log_processor().start(buffer_size);
+    }
+
+    void stop_async_logging()
+    {
+        if (detail::async_logging_enabled.load())
+        {
+            detail::get_log_processor().stop();
+        }
+    }
+
+    void flush_async_logging()
+    {
+        if (detail::async_logging_enabled.load())
+        {
+            detail::get_log_processor().flush();
+        }
+    }
+
+    bool is_async_logging_enabled() noexcept
+    {
+        return detail::async_logging_enabled.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t get_async_logging_dropped(bool reset)
+    {
+        if (reset)
+        {
+            return detail::async_logging_dropped.exchange(0);
+        }
+        return detail::async_logging_dropped.load();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void logger::write_async(message&& msg)
+    {
+        detail::async_log_push(this, std::move(msg));
+    }
+
+}}}    // namespace hpx::util::logging
+
+#endif    // HPX_HAVE_LOGGING
@@ -36,7 +36,23 @@ namespace hpx { namespace util { namespace logging { namespace formatter {
 
         void operator()(std::ostream& to) const override
         {
-            util::format_to(to, "{:016x}", ++value);
+            format_captured(to, capture());
+        }
+
+        bool can_capture() const noexcept override
+        {
+            return true;
+        }
+
+        std::uint64_t capture() const override
+        {
+            return ++value;
+        }
+
+        void format_captured(std::ostream& to, std::uint64_t idx) const override
+        {
+            static constexpr auto fmt = HPX_FORMAT_STRING("{:016x}");
+            util::format_to(to, fmt, idx);
         }
 
     private:
@@ -49,7 +49,30 @@ namespace hpx { namespace util { namespace logging { namespace formatter {
 
         void operator()(std::ostream& to) const override
         {
-            auto const val = std::chrono::system_clock::now();
+            format_captured(to, capture());
+        }
+
+        bool can_capture() const noexcept override
+        {
+            return true;
+        }
+
+        // the time is captured as nanoseconds since the epoch
+        std::uint64_t capture() const override
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count());
+        }
+
+        void format_captured(
+            std::ostream& to, std::uint64_t time) const override
+        {
+            std::chrono::system_clock::time_point const val(
+                std::chrono::duration_cast<
+                    std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(time)));
             std::time_t tt = std::chrono::system_clock::to_time_t(val);
 
 #if defined(__linux) || defined(linux) || defined(__linux__) ||                \
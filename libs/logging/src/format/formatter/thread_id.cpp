@@ -19,8 +19,10 @@
 #include <hpx/config.hpp>
 #include <hpx/modules/format.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <ostream>
+#include <type_traits>
 
 #if defined(HPX_WINDOWS)
 #include <windows.h>
@@ -32,17 +34,55 @@ namespace hpx { namespace util { namespace logging { namespace formatter {
 
     thread_id::~thread_id() = default;
 
+#if defined(HPX_WINDOWS)
+    using native_thread_id = DWORD;
+#else
+    using native_thread_id = pthread_t;
+#endif
+
     struct thread_id_impl : thread_id
     {
-        void operator()(std::ostream& to) const override
+        static native_thread_id get_native_id() noexcept
         {
-            util::format_to(to, "{}",
 #if defined(HPX_WINDOWS)
-                ::GetCurrentThreadId()
+            return ::GetCurrentThreadId();
 #else
-                pthread_self()
+            return pthread_self();
 #endif
-            );
+        }
+
+        void operator()(std::ostream& to) const override
+        {
+            static constexpr auto fmt = HPX_FORMAT_STRING("{}");
+            util::format_to(to, fmt, get_native_id());
+        }
+
+        // the thread id can be captured only if it is an integral value
+        bool can_capture() const noexcept override
+        {
+            return std::is_integral<native_thread_id>::value;
+        }
+
+        std::uint64_t capture() const override
+        {
+            return capture(std::is_integral<native_thread_id>());
+        }
+
+        void format_captured(std::ostream& to, std::uint64_t id) const override
+        {
+            static constexpr auto fmt = HPX_FORMAT_STRING("{}");
+            util::format_to(to, fmt, id);
+        }
+
+    private:
+        static std::uint64_t capture(std::true_type) noexcept
+        {
+            return static_cast<std::uint64_t>(get_native_id());
+        }
+
+        static std::uint64_t capture(std::false_type) noexcept
+        {
+            return 0;
         }
     };
 
@@ -0,0 +1,189 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/modules/testing.hpp>
+
+#if defined(HPX_HAVE_LOGGING)
+#include <hpx/logging/async_logging.hpp>
+#include <hpx/logging/format/destinations.hpp>
+#include <hpx/logging/manipulator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hpx::util::logging::level;
+using hpx::util::logging::logger;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t count_lines(std::string const& str)
+{
+    std::size_t count = 0;
+    for (char c : str)
+    {
+        if (c == '\n')
+            ++count;
+    }
+    return count;
+}
+
+void init_logger(logger& l, std::stringstream& out)
+{
+    l.writer().set_destination<hpx::util::logging::destination::stream>(
+        "stream", &out);
+    l.writer().write("[|]\n", "stream");
+    l.mark_as_initialized();
+}
+
+void test_async_logging()
+{
+    logger l(level::enable_all);
+    std::stringstream out;
+    init_logger(l, out);
+
+    hpx::util::logging::start_async_logging(1024);
+    HPX_TEST(hpx::util::logging::is_async_logging_enabled());
+
+    l.gather() << "message " << 1;
+    l.gather().format("message {}", 2);
+
+    hpx::util::logging::flush_async_logging();
+    HPX_TEST_EQ(out.str(), std::string("[message 1]\n[message 2]\n"));
+
+    // messages logged concurrently from different threads are all written
+    out.str(std::string());
+    hpx::util::logging::get_async_logging_dropped(true);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t)
+    {
+        threads.emplace_back([&l, t]() {
+            for (int i = 0; i != 100; ++i)
+                l.gather() << t << ":" << i;
+        });
+    }
+    for (std::thread& t : threads)
+        t.join();
+
+    hpx::util::logging::stop_async_logging();
+    HPX_TEST(!hpx::util::logging::is_async_logging_enabled());
+
+    std::uint64_t dropped =
+        hpx::util::logging::get_async_logging_dropped(true);
+    HPX_TEST_EQ(count_lines(out.str()) + dropped, std::size_t(400));
+}
+
+void test_dropped_messages()
+{
+    logger l(level::enable_all);
+    std::stringstream out;
+    init_logger(l, out);
+
+    // use tiny buffers to force messages to be dropped (the buffers are
+    // created on first use, i.e. we need a new thread)
+    hpx::util::logging::start_async_logging(2);
+    hpx::util::logging::get_async_logging_dropped(true);
+
+    std::thread t([&l]() {
+        for (int i = 0; i != 10000; ++i)
+            l.gather() << i;
+    });
+    t.join();
+
+    hpx::util::logging::stop_async_logging();
+
+    std::uint64_t dropped =
+        hpx::util::logging::get_async_logging_dropped(true);
+    HPX_TEST_LT(std::uint64_t(0), dropped);
+    HPX_TEST_EQ(count_lines(out.str()) + dropped, std::size_t(10000));
+
+    // messages are written synchronously once asynchronous logging has been
+    // stopped
+    out.str(std::string());
+    l.gather() << "sync";
+    HPX_TEST_EQ(out.str(), std::string("[sync]\n"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// formatter writing a value which is specific to the logging thread
+thread_local std::uint64_t thread_value = 0;
+
+struct thread_value_formatter : hpx::util::logging::formatter::manipulator
+{
+    explicit thread_value_formatter(bool can_capture)
+      : can_capture_(can_capture)
+    {
+    }
+
+    void operator()(std::ostream& to) const override
+    {
+        to << thread_value;
+    }
+
+    bool can_capture() const noexcept override
+    {
+        return can_capture_;
+    }
+
+    std::uint64_t capture() const override
+    {
+        return thread_value;
+    }
+
+    void format_captured(std::ostream& to, std::uint64_t value) const override
+    {
+        to << value;
+    }
+
+    bool can_capture_;
+};
+
+void test_captured_context(bool can_capture)
+{
+    logger l(level::enable_all);
+    std::stringstream out;
+    l.writer().set_formatter("value", thread_value_formatter(can_capture));
+    l.writer().set_destination<hpx::util::logging::destination::stream>(
+        "stream", &out);
+    l.writer().write("%value% [|]\n", "stream");
+    l.mark_as_initialized();
+
+    hpx::util::logging::start_async_logging(1024);
+
+    // the messages are formatted on the background thread (or on the calling
+    // thread if the formatter can't capture its context), either way the
+    // value of the logging thread is written
+    std::thread t([&l]() {
+        thread_value = 42;
+        l.gather() << "message";
+    });
+    t.join();
+
+    hpx::util::logging::stop_async_logging();
+    HPX_TEST_EQ(out.str(), std::string("42 [message]\n"));
+}
+
+int main()
+{
+    test_async_logging();
+    test_dropped_messages();
+    test_captured_context(true);
+    test_captured_context(false);
+
+    return hpx::util::report_errors();
+}
+#else
+int main()
+{
+    return hpx::util::report_errors();
+}
+#endif
@@ -11,6 +11,7 @@
 #include <hpx/modules/plugin.hpp>
 #include <hpx/runtime_configuration/component_registry_base.hpp>
 #include <hpx/runtime_configuration/ini.hpp>
+#include <hpx/runtime_configuration/module_manifest.hpp>
 #include <hpx/runtime_configuration/plugin_registry_base.hpp>
 
 #include <map>
@@ -46,10 +47,15 @@ namespace hpx { namespace util {
     ///////////////////////////////////////////////////////////////////////////
     // iterate over all shared libraries in the given directory and construct
     // default ini settings assuming all of those are components
+    //
+    // if a module manifest is given, libraries which are known not to be
+    // required at this point are not loaded, their cached ini data is used
+    // instead
     std::vector<std::shared_ptr<plugins::plugin_registry_base>>
     init_ini_data_default(std::string const& libs, section& ini,
         std::map<std::string, filesystem::path>& basenames,
         std::map<std::string, hpx::util::plugin::dll>& modules,
         std::vector<std::shared_ptr<components::component_registry_base>>&
-            component_registries);
+            component_registries,
+        module_manifest* manifest = nullptr);
 }}    // namespace hpx::util
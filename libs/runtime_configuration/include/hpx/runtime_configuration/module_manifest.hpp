@@ -0,0 +1,101 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/modules/filesystem.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace util {
+    ///////////////////////////////////////////////////////////////////////////
+    // The module manifest is a persistent cache of the registry information
+    // collected from the shared libraries found in the component search
+    // paths. Each entry is keyed by the canonical path of the library and is
+    // considered valid only as long as the modification time and size of the
+    // library match and the manifest was written by the same HPX build. This
+    // allows to avoid loading libraries at startup which either are no HPX
+    // modules at all or which are modules without component or plugin
+    // registries. Libraries implementing components are still loaded.
+    class HPX_EXPORT module_manifest
+    {
+    public:
+        enum module_flags : std::uint32_t
+        {
+            // the library does not expose any HPX registry data
+            not_a_module = 0x00,
+            // the library exposes component registry data
+            has_component_factory = 0x01,
+            // the library has component registries which need to be created
+            has_component_registries = 0x02,
+            // the library exposes plugin registry data
+            has_plugin_factory = 0x04,
+            // the library has plugin registries which need to be created
+            has_plugin_registries = 0x08,
+            // the library can be found again using its module name
+            loadable_by_name = 0x10
+        };
+
+        struct entry
+        {
+            std::int64_t mtime_ = 0;
+            std::uint64_t size_ = 0;
+            std::uint32_t flags_ = not_a_module;
+            std::vector<std::string> ini_data_;
+
+            // Return whether loading the library can be skipped during
+            // startup. The cached ini data has to be used instead. This is
+            // the case only for libraries which are no HPX modules, and for
+            // modules without any component or plugin registries. Libraries
+            // with registries register component types and actions while
+            // being loaded. The action ids are assigned at startup and have
+            // to match on all localities, so those are always loaded.
+            bool can_defer_loading() const
+            {
+                if (flags_ == not_a_module)
+                    return true;
+
+                return !(flags_ &
+                           (has_component_registries |
+                               has_plugin_registries)) &&
+                    (flags_ & loadable_by_name);
+            }
+        };
+
+        // An empty file name disables the manifest.
+        explicit module_manifest(std::string filename = std::string());
+
+        bool enabled() const
+        {
+            return !filename_.empty();
+        }
+
+        // Read the manifest file, returns false if the file doesn't exist or
+        // was written by a different HPX build.
+        bool load();
+
+        // Write the manifest file if any entry was changed.
+        bool save() const;
+
+        // Return the cached entry for the given library, or nullptr if the
+        // library is unknown or was modified since the entry was written.
+        entry const* find(filesystem::path const& lib) const;
+
+        // Create or replace the cached entry for the given library.
+        void update(filesystem::path const& lib, std::uint32_t flags,
+            std::vector<std::string> ini_data);
+
+    private:
+        std::string filename_;
+        std::map<std::string, entry> entries_;
+        bool modified_;
+    };
+}}    // namespace hpx::util
@@ -14,6 +14,7 @@
 #include <hpx/runtime_configuration/agas_service_mode.hpp>
 #include <hpx/runtime_configuration/component_registry_base.hpp>
 #include <hpx/runtime_configuration/ini.hpp>
+#include <hpx/runtime_configuration/module_manifest.hpp>
 #include <hpx/runtime_configuration/plugin_registry_base.hpp>
 #include <hpx/runtime_configuration/runtime_configuration_fwd.hpp>
 #include <hpx/runtime_configuration/runtime_mode.hpp>
@@ -107,6 +108,10 @@ namespace hpx { namespace util {
         bool enable_spinlock_deadlock_detection() const;
         std::size_t get_spinlock_deadlock_detection_limit() const;
 
+        // Enable the per-thread caches for shared states, task objects and
+        // dataflow frames
+        bool enable_allocator_cache() const;
+
 #if defined(__linux) || defined(linux) || defined(__linux__) ||                \
     defined(__FreeBSD__)
         bool use_stack_guard_pages() const;
@@ -170,7 +175,8 @@ namespace hpx { namespace util {
             std::string const& component_base_paths,
             std::string const& component_path_suffixes,
             std::set<std::string>& component_paths,
-            std::map<std::string, filesystem::path>& basenames);
+            std::map<std::string, filesystem::path>& basenames,
+            module_manifest* manifest);
 
         void load_component_path(
             std::vector<std::shared_ptr<plugins::plugin_registry_base>>&
@@ -178,7 +184,8 @@ namespace hpx { namespace util {
             std::vector<std::shared_ptr<components::component_registry_base>>&
                 component_registries,
             std::string const& path, std::set<std::string>& component_paths,
-            std::map<std::string, filesystem::path>& basenames);
+            std::map<std::string, filesystem::path>& basenames,
+            module_manifest* manifest);
 
     public:
         runtime_mode mode_;
@@ -15,6 +15,7 @@
 #include <hpx/runtime_configuration/component_registry_base.hpp>
 #include <hpx/runtime_configuration/ini.hpp>
 #include <hpx/runtime_configuration/init_ini_data.hpp>
+#include <hpx/runtime_configuration/module_manifest.hpp>
 #include <hpx/runtime_configuration/plugin_registry_base.hpp>
 #include <hpx/version.hpp>
 
@@ -22,6 +23,8 @@
 #include <boost/tokenizer.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -258,7 +261,7 @@ namespace hpx { namespace util {
             using namespace boost::assign;
 #if defined(HPX_DEBUG)
             // demangle the name in debug mode
-            if (name[name.size() - 1] == 'd')
+            if (!name.empty() && name[name.size() - 1] == 'd')
                 name.resize(name.size() - 1);
 #endif
             ini_data += std::string("[hpx.components.") + name + "]";
@@ -294,7 +297,8 @@ namespace hpx { namespace util {
         std::string const& curr,
         std::vector<std::shared_ptr<components::component_registry_base>>&
             component_registries,
-        std::string name, error_code& ec)
+        std::string name, std::vector<std::string>& manifest_data,
+        error_code& ec)
     {
         hpx::util::plugin::plugin_factory<components::component_registry_base>
             pf(d, "registry");
@@ -314,7 +318,7 @@ namespace hpx { namespace util {
             using namespace boost::assign;
 #if defined(HPX_DEBUG)
             // demangle the name in debug mode
-            if (name[name.size() - 1] == 'd')
+            if (!name.empty() && name[name.size() - 1] == 'd')
                 name.resize(name.size() - 1);
 #endif
             ini_data += std::string("[hpx.components.") + name + "]";
@@ -342,12 +346,16 @@ namespace hpx { namespace util {
         // incorporate all information from this module's
         // registry into our internal ini object
         ini.parse("<component registry>", ini_data, false, false);
+
+        manifest_data.insert(
+            manifest_data.end(), ini_data.begin(), ini_data.end());
     }
 
     ///////////////////////////////////////////////////////////////////////////
     std::vector<std::shared_ptr<plugins::plugin_registry_base>>
     load_plugin_factory(hpx::util::plugin::dll& d, util::section& ini,
-        std::string const& curr, std::string const& name, error_code& ec)
+        std::string const& curr, std::string const& name,
+        std::vector<std::string>& manifest_data, error_code& ec)
     {
         typedef std::vector<std::shared_ptr<plugins::plugin_registry_base>>
             plugin_list_type;
@@ -382,6 +390,9 @@ namespace hpx { namespace util {
         // incorporate all information from this module's
         // registry into our internal ini object
         ini.parse("<plugin registry>", ini_data, false, false);
+
+        manifest_data.insert(
+            manifest_data.end(), ini_data.begin(), ini_data.end());
         return plugin_registries;
     }
 
@@ -407,7 +418,8 @@ namespace hpx { namespace util {
         std::map<std::string, filesystem::path>& basenames,
         std::map<std::string, hpx::util::plugin::dll>& modules,
         std::vector<std::shared_ptr<components::component_registry_base>>&
-            component_registries)
+            component_registries,
+        module_manifest* manifest)
     {
         namespace fs = filesystem;
 
@@ -506,6 +518,26 @@ namespace hpx { namespace util {
         typedef std::pair<fs::path, std::string> libdata_type;
         for (libdata_type const& p : libdata)
         {
+            // avoid loading the library if the manifest knows that it doesn't
+            // have to be loaded at this point
+            module_manifest::entry const* cached =
+                manifest ? manifest->find(p.first) : nullptr;
+            if (cached != nullptr && cached->can_defer_loading())
+            {
+                if (cached->flags_ == module_manifest::not_a_module)
+                {
+                    LRT_(info) << "skipping (not an HPX module, cached): "
+                               << p.first.string();
+                }
+                else
+                {
+                    LRT_(info) << "deferring load of: " << p.first.string();
+                    ini.parse("<module manifest>", cached->ini_data_, false,
+                        false);
+                }
+                continue;
+            }
+
             LRT_(info) << "attempting to load: " << p.first.string();
 
             // get the handle of the library
@@ -520,11 +552,15 @@ namespace hpx { namespace util {
             }
 
             bool must_keep_loaded = false;
+            std::uint32_t flags = module_manifest::not_a_module;
+            std::vector<std::string> manifest_data;
 
             // get the component factory
             std::string curr_fullname(p.first.parent_path().string());
-            load_component_factory(
-                d, ini, curr_fullname, component_registries, p.second, ec);
+            std::size_t const num_component_registries =
+                component_registries.size();
+            load_component_factory(d, ini, curr_fullname, component_registries,
+                p.second, manifest_data, ec);
             if (ec)
             {
                 LRT_(info) << "skipping (load_component_factory failed): "
@@ -536,11 +572,15 @@ namespace hpx { namespace util {
                 LRT_(debug)
                     << "load_component_factory succeeded: " << p.first.string();
                 must_keep_loaded = true;
+
+                flags |= module_manifest::has_component_factory;
+                if (component_registries.size() != num_component_registries)
+                    flags |= module_manifest::has_component_registries;
             }
 
             // get the plugin factory
-            plugin_list_type tmp_regs =
-                load_plugin_factory(d, ini, curr_fullname, p.second, ec);
+            plugin_list_type tmp_regs = load_plugin_factory(
+                d, ini, curr_fullname, p.second, manifest_data, ec);
 
             if (ec)
             {
@@ -555,6 +595,25 @@ namespace hpx { namespace util {
                 std::copy(tmp_regs.begin(), tmp_regs.end(),
                     std::back_inserter(plugin_registries));
                 must_keep_loaded = true;
+
+                flags |= module_manifest::has_plugin_factory;
+                if (!tmp_regs.empty())
+                    flags |= module_manifest::has_plugin_registries;
+            }
+
+            // the runtime system will be able to load the library on demand
+            // only if its file name can be derived from the module name
+            if (manifest != nullptr)
+            {
+                std::string name(p.second);
+#if defined(HPX_DEBUG)
+                if (!name.empty() && name[name.size() - 1] == 'd')
+                    name.resize(name.size() - 1);
+#endif
+                if (p.first.filename().string() == HPX_MAKE_DLL_STRING(name))
+                    flags |= module_manifest::loadable_by_name;
+
+                manifest->update(p.first, flags, std::move(manifest_data));
             }
 
             // store loaded library for future use
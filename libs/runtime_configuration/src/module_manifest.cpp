@@ -0,0 +1,251 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/runtime_configuration/module_manifest.hpp>
+#include <hpx/version.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace util {
+    namespace {
+        // the first line of every manifest file
+        char const* const manifest_header = "hpx-module-manifest 1";
+
+        // manifests written by a different HPX build are discarded
+        std::string manifest_build_id()
+        {
+            return hpx::build_string() + " " + hpx::build_type() + " " +
+                hpx::build_date_time();
+        }
+
+        bool get_file_stamp(filesystem::path const& lib, std::int64_t& mtime,
+            std::uint64_t& size)
+        {
+            namespace fs = filesystem;
+
+            fs::error_code ec;
+            auto const t = fs::last_write_time(lib, ec);
+            if (ec)
+                return false;
+
+            auto const s = fs::file_size(lib, ec);
+            if (ec)
+                return false;
+
+#if !defined(HPX_FILESYSTEM_HAVE_BOOST_FILESYSTEM_COMPATIBILITY)
+            mtime = static_cast<std::int64_t>(t.time_since_epoch().count());
+#else
+            mtime = static_cast<std::int64_t>(t);
+#endif
+            size = static_cast<std::uint64_t>(s);
+            return true;
+        }
+
+        // split a line into its keyword and the remaining value
+        bool split_line(std::string const& line, std::string& keyword,
+            std::string& value)
+        {
+            std::string::size_type const pos = line.find(' ');
+            if (pos == std::string::npos)
+            {
+                keyword = line;
+                value.clear();
+                return !keyword.empty();
+            }
+
+            keyword = line.substr(0, pos);
+            value = line.substr(pos + 1);
+            return true;
+        }
+    }    // namespace
+
+    ///////////////////////////////////////////////////////////////////////////
+    module_manifest::module_manifest(std::string filename)
+      : filename_(std::move(filename))
+      , modified_(false)
+    {
+    }
+
+    bool module_manifest::load()
+    {
+        if (!enabled())
+            return false;
+
+        std::ifstream in(filename_.c_str());
+        if (!in.is_open())
+            return false;
+
+        std::string line;
+        if (!std::getline(in, line) || line != manifest_header)
+        {
+            LRT_(info) << "module manifest: ignoring " << filename_
+                       << ": unknown format";
+            return false;
+        }
+
+        std::string keyword, value;
+        if (!std::getline(in, line) ||
+            !split_line(line, keyword, value) || keyword != "build" ||
+            value != manifest_build_id())
+        {
+            LRT_(info) << "module manifest: ignoring " << filename_
+                       << ": written by a different build";
+            return false;
+        }
+
+        std::string module;
+        entry current;
+        while (std::getline(in, line))
+        {
+            if (!split_line(line, keyword, value))
+                continue;
+
+            try
+            {
+                if (keyword == "module")
+                {
+                    module = value;
+                    current = entry();
+                }
+                else if (keyword == "mtime")
+                {
+                    current.mtime_ = std::stoll(value);
+                }
+                else if (keyword == "size")
+                {
+                    current.size_ = std::stoull(value);
+                }
+                else if (keyword == "flags")
+                {
+                    current.flags_ = static_cast<std::uint32_t>(
+                        std::stoul(value));
+                }
+                else if (keyword == "ini")
+                {
+                    current.ini_data_.push_back(value);
+                }
+                else if (keyword == "end" && !module.empty())
+                {
+                    entries_[module] = std::move(current);
+                    module.clear();
+                }
+            }
+            catch (std::exception const&)
+            {
+                // skip the broken entry
+                module.clear();
+            }
+        }
+
+        LRT_(info) << "module manifest: loaded " << entries_.size()
+                   << " entries from " << filename_;
+        return true;
+    }
+
+    bool module_manifest::save() const
+    {
+        namespace fs = filesystem;
+
+        if (!enabled() || !modified_)
+            return false;
+
+        // several processes might update the manifest concurrently, write to
+        // a temporary file first and atomically replace the manifest
+        std::random_device random_device;
+        std::string const tmpname =
+            filename_ + "." + std::to_string(random_device()) + ".tmp";
+
+        {
+            std::ofstream out(tmpname.c_str());
+            if (!out.is_open())
+            {
+                LRT_(info) << "module manifest: couldn't write " << tmpname;
+                return false;
+            }
+
+            out << manifest_header << "\n";
+            out << "build " << manifest_build_id() << "\n";
+            for (auto const& e : entries_)
+            {
+                out << "module " << e.first << "\n";
+                out << "mtime " << e.second.mtime_ << "\n";
+                out << "size " << e.second.size_ << "\n";
+                out << "flags " << e.second.flags_ << "\n";
+                for (std::string const& ini : e.second.ini_data_)
+                    out << "ini " << ini << "\n";
+                out << "end\n";
+            }
+
+            if (!out)
+            {
+                fs::error_code ec;
+                fs::remove(tmpname, ec);
+                return false;
+            }
+        }
+
+        fs::error_code ec;
+        fs::rename(tmpname, filename_, ec);
+        if (ec)
+        {
+            LRT_(info) << "module manifest: couldn't replace " << filename_
+                       << ": " << ec.message();
+            fs::remove(tmpname, ec);
+            return false;
+        }
+
+        LRT_(info) << "module manifest: wrote " << entries_.size()
+                   << " entries to " << filename_;
+        return true;
+    }
+
+    module_manifest::entry const* module_manifest::find(
+        filesystem::path const& lib) const
+    {
+        if (!enabled())
+            return nullptr;
+
+        auto it = entries_.find(lib.string());
+        if (it == entries_.end())
+            return nullptr;
+
+        std::int64_t mtime = 0;
+        std::uint64_t size = 0;
+        if (!get_file_stamp(lib, mtime, size) ||
+            mtime != it->second.mtime_ || size != it->second.size_)
+        {
+            return nullptr;    // the library was modified
+        }
+        return &it->second;
+    }
+
+    void module_manifest::update(filesystem::path const& lib,
+        std::uint32_t flags, std::vector<std::string> ini_data)
+    {
+        if (!enabled())
+            return;
+
+        entry e;
+        if (!get_file_stamp(lib, e.mtime_, e.size_))
+            return;
+
+        e.flags_ = flags;
+        e.ini_data_ = std::move(ini_data);
+
+        entries_[lib.string()] = std::move(e);
+        modified_ = true;
+    }
+}}    // namespace hpx::util
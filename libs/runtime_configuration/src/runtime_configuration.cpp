@@ -97,6 +97,7 @@ namespace hpx { namespace util {
             "[hpx]",
             "location = ${HPX_LOCATION:$[system.prefix]}",
             "component_paths = ${HPX_COMPONENT_PATHS}",
+            "module_manifest = ${HPX_MODULE_MANIFEST}",
             "component_base_paths = $[hpx.location]"    // NOLINT
             HPX_INI_PATH_DELIMITER "$[system.executable_prefix]",
             "component_path_suffixes = /lib/hpx" HPX_INI_PATH_DELIMITER
@@ -144,6 +145,7 @@ namespace hpx { namespace util {
             "${HPX_SPINLOCK_DEADLOCK_DETECTION_LIMIT:" HPX_PP_STRINGIZE(
                 HPX_PP_EXPAND(HPX_SPINLOCK_DEADLOCK_DETECTION_LIMIT)) "}",
 #endif
+            "allocator_cache = ${HPX_ALLOCATOR_CACHE:1}",
             "expect_connecting_localities = "
             "${HPX_EXPECT_CONNECTING_LOCALITIES:0}",
 
@@ -188,6 +190,11 @@ namespace hpx { namespace util {
             "arity = ${HPX_LCOS_COLLECTIVES_ARITY:32}",
             "cut_off = ${HPX_LCOS_COLLECTIVES_CUT_OFF:-1}",
 
+            // buffered output for hpx::cout and hpx::consolestream
+            "[hpx.iostreams]",
+            "buffered = ${HPX_IOSTREAMS_BUFFERED:0}",
+            "flush_interval = ${HPX_IOSTREAMS_FLUSH_INTERVAL:10}",
+
             // connect back to the given latch if specified
             "[hpx.on_startup]",
             "wait_on_latch = ${HPX_ON_STARTUP_WAIT_ON_LATCH}",
@@ -371,6 +378,10 @@ namespace hpx { namespace util {
             // general logging
             "[hpx.logging]",
             "level = ${HPX_LOGLEVEL:0}",
+            "async = ${HPX_LOGGING_ASYNC:0}",
+            "async_buffer_size = ${HPX_LOGGING_ASYNC_BUFFER_SIZE:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(
+                    HPX_LOGGING_ASYNC_BUFFER_SIZE_DEFAULT)) "}",
             "destination = ${HPX_LOGDESTINATION:console}",
             "format = ${HPX_LOGFORMAT:"
                 "(T%locality%/%hpxthread%.%hpxphase%/%hpxcomponent%) "
@@ -545,7 +556,8 @@ namespace hpx { namespace util {
         std::vector<std::shared_ptr<components::component_registry_base>>&
             component_registries,
         std::string const& path, std::set<std::string>& component_paths,
-        std::map<std::string, filesystem::path>& basenames)
+        std::map<std::string, filesystem::path>& basenames,
+        module_manifest* manifest)
     {
         namespace fs = filesystem;
 
@@ -572,7 +584,8 @@ namespace hpx { namespace util {
                 {
                     plugin_list_type tmp_regs =
                         util::init_ini_data_default(this_path.string(), *this,
-                            basenames, modules_, component_registries);
+                            basenames, modules_, component_registries,
+                            manifest);
 
                     std::copy(tmp_regs.begin(), tmp_regs.end(),
                         std::back_inserter(plugin_registries));
@@ -589,7 +602,8 @@ namespace hpx { namespace util {
         std::string const& component_base_paths,
         std::string const& component_path_suffixes,
         std::set<std::string>& component_paths,
-        std::map<std::string, filesystem::path>& basenames)
+        std::map<std::string, filesystem::path>& basenames,
+        module_manifest* manifest)
     {
         namespace fs = filesystem;
 
@@ -617,13 +631,13 @@ namespace hpx { namespace util {
                     std::string p = path;
                     p += *jt;
                     load_component_path(plugin_registries, component_registries,
-                        p, component_paths, basenames);
+                        p, component_paths, basenames, manifest);
                 }
             }
             else
             {
                 load_component_path(plugin_registries, component_registries,
-                    path, component_paths, basenames);
+                    path, component_paths, basenames, manifest);
             }
         }
     }
@@ -652,14 +666,21 @@ namespace hpx { namespace util {
         std::string component_path_suffixes(
             get_entry("hpx.component_path_suffixes", "/lib/hpx"));
 
+        // the module manifest caches the registry data of all libraries
+        // found in the component paths (disabled if no file name is given)
+        module_manifest manifest(get_entry("hpx.module_manifest", ""));
+        manifest.load();
+
         load_component_paths(plugin_registries, component_registries,
             component_base_paths, component_path_suffixes, component_paths,
-            basenames);
+            basenames, &manifest);
 
         // load additional explicit plugin paths from plugin_paths key
         std::string plugin_paths(get_entry("hpx.component_paths", ""));
         load_component_paths(plugin_registries, component_registries,
-            plugin_paths, "", component_paths, basenames);
+            plugin_paths, "", component_paths, basenames, &manifest);
+
+        manifest.save();
 
         // read system and user ini files _again_, to allow the user to
         // overwrite the settings from the default component ini's.
@@ -1084,6 +1105,21 @@ namespace hpx { namespace util {
 #endif
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    bool runtime_configuration::enable_allocator_cache() const
+    {
+        if (has_section("hpx"))
+        {
+            util::section const* sec = get_section("hpx");
+            if (nullptr != sec)
+            {
+                return hpx::util::get_entry_as<int>(
+                           *sec, "allocator_cache", 1) != 0;
+            }
+        }
+        return true;
+    }
+
     std::size_t runtime_configuration::trace_depth() const
     {
         if (has_section("hpx"))
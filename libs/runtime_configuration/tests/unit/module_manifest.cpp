@@ -0,0 +1,287 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/runtime_configuration/module_manifest.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(HPX_FILESYSTEM_HAVE_BOOST_FILESYSTEM_COMPATIBILITY)
+#include <chrono>
+#endif
+
+namespace fs = hpx::filesystem;
+using hpx::util::module_manifest;
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> read_lines(fs::path const& p)
+{
+    std::vector<std::string> lines;
+    std::ifstream in(p.string().c_str());
+    std::string line;
+    while (std::getline(in, line))
+        lines.push_back(line);
+    return lines;
+}
+
+void write_lines(fs::path const& p, std::vector<std::string> const& lines)
+{
+    std::ofstream out(p.string().c_str(), std::ios::trunc);
+    for (std::string const& line : lines)
+        out << line << "\n";
+}
+
+void create_library(fs::path const& p, std::string const& contents)
+{
+    std::ofstream out(p.string().c_str(), std::ios::trunc);
+    out << contents;
+}
+
+void append_to_library(fs::path const& p)
+{
+    std::ofstream out(p.string().c_str(), std::ios::app);
+    out << "more";
+}
+
+void touch_library(fs::path const& p)
+{
+#if !defined(HPX_FILESYSTEM_HAVE_BOOST_FILESYSTEM_COMPATIBILITY)
+    fs::last_write_time(p, fs::last_write_time(p) - std::chrono::hours(1));
+#else
+    fs::last_write_time(p, fs::last_write_time(p) - 3600);
+#endif
+}
+
+// write a manifest holding entries for both libraries
+void write_manifest(fs::path const& manifest, fs::path const& lib1,
+    fs::path const& lib2)
+{
+    fs::remove(manifest);
+
+    module_manifest m(manifest.string());
+    m.update(lib1, module_manifest::has_component_factory,
+        {"[hpx.components.lib1]", "enabled = 1"});
+    m.update(lib2,
+        module_manifest::has_plugin_factory | module_manifest::loadable_by_name,
+        {"[hpx.plugins.lib2]", "enabled = 1"});
+    HPX_TEST(m.save());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_disabled()
+{
+    module_manifest m;
+    HPX_TEST(!m.enabled());
+    HPX_TEST(!m.load());
+    HPX_TEST(!m.save());
+}
+
+void test_round_trip(fs::path const& manifest, fs::path const& lib1,
+    fs::path const& lib2)
+{
+    write_manifest(manifest, lib1, lib2);
+
+    module_manifest m(manifest.string());
+    HPX_TEST(m.load());
+
+    module_manifest::entry const* e1 = m.find(lib1);
+    HPX_TEST(e1 != nullptr);
+    if (e1 != nullptr)
+    {
+        HPX_TEST_EQ(e1->flags_,
+            static_cast<std::uint32_t>(
+                module_manifest::has_component_factory));
+        HPX_TEST_EQ(e1->ini_data_.size(), std::size_t(2));
+        HPX_TEST(e1->ini_data_ ==
+            std::vector<std::string>({"[hpx.components.lib1]", "enabled = 1"}));
+    }
+
+    module_manifest::entry const* e2 = m.find(lib2);
+    HPX_TEST(e2 != nullptr);
+    if (e2 != nullptr)
+    {
+        HPX_TEST_EQ(e2->flags_,
+            static_cast<std::uint32_t>(module_manifest::has_plugin_factory |
+                module_manifest::loadable_by_name));
+        HPX_TEST(e2->ini_data_ ==
+            std::vector<std::string>({"[hpx.plugins.lib2]", "enabled = 1"}));
+    }
+
+    // nothing was changed, the manifest is not written again
+    HPX_TEST(!m.save());
+
+    // unknown libraries are not found
+    HPX_TEST(m.find(manifest.parent_path() / "unknown.so") == nullptr);
+}
+
+void test_unknown_format(fs::path const& manifest, fs::path const& lib1,
+    fs::path const& lib2)
+{
+    write_manifest(manifest, lib1, lib2);
+
+    std::vector<std::string> lines = read_lines(manifest);
+    HPX_TEST(!lines.empty());
+    lines[0] = "hpx-module-manifest 0";
+    write_lines(manifest, lines);
+
+    module_manifest m(manifest.string());
+    HPX_TEST(!m.load());
+    HPX_TEST(m.find(lib1) == nullptr);
+}
+
+void test_build_mismatch(fs::path const& manifest, fs::path const& lib1,
+    fs::path const& lib2)
+{
+    write_manifest(manifest, lib1, lib2);
+
+    std::vector<std::string> lines = read_lines(manifest);
+    HPX_TEST(lines.size() > 1);
+    lines[1] = "build some other build";
+    write_lines(manifest, lines);
+
+    module_manifest m(manifest.string());
+    HPX_TEST(!m.load());
+    HPX_TEST(m.find(lib1) == nullptr);
+    HPX_TEST(m.find(lib2) == nullptr);
+}
+
+void test_modified_library(fs::path const& manifest, fs::path const& lib1,
+    fs::path const& lib2)
+{
+    write_manifest(manifest, lib1, lib2);
+
+    // changing the size invalidates the entry
+    append_to_library(lib1);
+    {
+        module_manifest m(manifest.string());
+        HPX_TEST(m.load());
+        HPX_TEST(m.find(lib1) == nullptr);
+        HPX_TEST(m.find(lib2) != nullptr);
+    }
+
+    // changing the modification time invalidates the entry
+    touch_library(lib2);
+    {
+        module_manifest m(manifest.string());
+        HPX_TEST(m.load());
+        HPX_TEST(m.find(lib2) == nullptr);
+
+        // updating the entry makes it valid again
+        m.update(lib2, module_manifest::has_plugin_factory, {});
+        HPX_TEST(m.find(lib2) != nullptr);
+        HPX_TEST(m.save());
+    }
+
+    module_manifest m(manifest.string());
+    HPX_TEST(m.load());
+    HPX_TEST(m.find(lib2) != nullptr);
+}
+
+void test_corrupt_entry(fs::path const& manifest, fs::path const& lib1,
+    fs::path const& lib2)
+{
+    write_manifest(manifest, lib1, lib2);
+
+    // break the modification time of the first entry
+    std::vector<std::string> lines = read_lines(manifest);
+    bool replaced = false;
+    for (std::string& line : lines)
+    {
+        if (line.compare(0, 6, "mtime ") == 0)
+        {
+            line = "mtime garbage";
+            replaced = true;
+            break;
+        }
+    }
+    HPX_TEST(replaced);
+    write_lines(manifest, lines);
+
+    {
+        module_manifest m(manifest.string());
+        HPX_TEST(m.load());
+
+        // the broken entry is skipped, the other one survives
+        int found = (m.find(lib1) != nullptr) + (m.find(lib2) != nullptr);
+        HPX_TEST_EQ(found, 1);
+    }
+
+    // an entry which is not terminated is skipped as well
+    write_manifest(manifest, lib1, lib2);
+
+    lines = read_lines(manifest);
+    HPX_TEST(!lines.empty() && lines.back() == "end");
+    lines.pop_back();
+    write_lines(manifest, lines);
+
+    module_manifest m(manifest.string());
+    HPX_TEST(m.load());
+
+    int found = (m.find(lib1) != nullptr) + (m.find(lib2) != nullptr);
+    HPX_TEST_EQ(found, 1);
+}
+
+void test_can_defer_loading()
+{
+    module_manifest::entry e;
+
+    e.flags_ = module_manifest::not_a_module;
+    HPX_TEST(e.can_defer_loading());
+
+    e.flags_ = module_manifest::has_component_factory;
+    HPX_TEST(!e.can_defer_loading());
+
+    e.flags_ = module_manifest::has_component_factory |
+        module_manifest::loadable_by_name;
+    HPX_TEST(e.can_defer_loading());
+
+    e.flags_ = module_manifest::has_plugin_factory |
+        module_manifest::loadable_by_name;
+    HPX_TEST(e.can_defer_loading());
+
+    e.flags_ = module_manifest::has_component_factory |
+        module_manifest::has_component_registries |
+        module_manifest::loadable_by_name;
+    HPX_TEST(!e.can_defer_loading());
+
+    e.flags_ = module_manifest::has_plugin_factory |
+        module_manifest::has_plugin_registries |
+        module_manifest::loadable_by_name;
+    HPX_TEST(!e.can_defer_loading());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::random_device random_device;
+    fs::path const dir = fs::temp_directory_path() /
+        ("hpx_module_manifest_" + std::to_string(random_device()));
+    fs::create_directories(dir);
+
+    fs::path const manifest = dir / "manifest";
+    fs::path const lib1 = dir / "libfirst.so";
+    fs::path const lib2 = dir / "libsecond.so";
+
+    create_library(lib1, "first");
+    create_library(lib2, "second library");
+
+    test_disabled();
+    test_round_trip(manifest, lib1, lib2);
+    test_unknown_format(manifest, lib1, lib2);
+    test_build_mismatch(manifest, lib1, lib2);
+    test_modified_library(manifest, lib1, lib2);
+    test_corrupt_entry(manifest, lib1, lib2);
+    test_can_defer_loading();
+
+    fs::remove_all(dir);
+
+    return hpx::util::report_errors();
+}
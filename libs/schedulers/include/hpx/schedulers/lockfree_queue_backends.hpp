@@ -18,8 +18,10 @@
 #endif
 
 // Does not rely on CXX11_STD_ATOMIC_128BIT
+#include <hpx/concurrency/chase_lev_deque.hpp>
 #include <hpx/concurrency/concurrentqueue.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <utility>
@@ -138,6 +140,90 @@ namespace hpx { namespace threads { namespace policies {
         };
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Work-stealing LIFO: the OS thread owning the queue pushes to and pops
+    // from the bottom of a Chase-Lev deque, all other threads steal from its
+    // top. Items pushed by any other thread (or to the other end) are placed
+    // into a separate injection queue which is drained once the deque is
+    // empty.
+    //
+    // The owner is the first OS thread which pops without stealing.
+    template <typename T>
+    struct workstealing_lifo_backend
+    {
+        using container_type = hpx::concurrency::chase_lev_deque<T>;
+        using injection_queue_type = hpx::concurrency::ConcurrentQueue<T>;
+
+        using value_type = T;
+        using reference = T&;
+        using const_reference = T const&;
+        using size_type = std::uint64_t;
+
+        workstealing_lifo_backend(
+            size_type initial_size = 0, size_type num_thread = size_type(-1))
+          : deque_(std::size_t(initial_size))
+          , injected_(std::size_t(initial_size))
+          , owner_(nullptr)
+        {
+        }
+
+        bool push(const_reference val, bool other_end = false)
+        {
+            if (!other_end && is_owner())
+                return deque_.push(val);
+            return injected_.enqueue(val);
+        }
+
+        bool pop(reference val, bool steal = true)
+        {
+            if (!steal && bind_owner())
+            {
+                return deque_.pop(val) || injected_.try_dequeue(val);
+            }
+            return deque_.steal(val) || injected_.try_dequeue(val);
+        }
+
+        bool empty()
+        {
+            return deque_.empty() && injected_.size_approx() == 0;
+        }
+
+    private:
+        static void const* this_thread_token()
+        {
+            static HPX_NATIVE_TLS char token = 0;
+            return &token;
+        }
+
+        bool is_owner() const
+        {
+            return owner_.load(std::memory_order_relaxed) ==
+                this_thread_token();
+        }
+
+        bool bind_owner()
+        {
+            void const* token = this_thread_token();
+            void const* expected = nullptr;
+            return owner_.compare_exchange_strong(expected, token,
+                       std::memory_order_relaxed) ||
+                expected == token;
+        }
+
+        container_type deque_;
+        injection_queue_type injected_;
+        std::atomic<void const*> owner_;
+    };
+
+    struct workstealing_lifo
+    {
+        template <typename T>
+        struct apply
+        {
+            using type = workstealing_lifo_backend<T>;
+        };
+    };
+
 // LIFO
 #if defined(HPX_HAVE_CXX11_STD_ATOMIC_128BIT)
             struct lockfree_lifo;
@@ -218,6 +218,17 @@ namespace hpx { namespace threads { namespace policies {
 #endif
                 // create the new thread
                 threads::thread_init_data& data = task->data;
+
+                // drop work items which became obsolete while being staged
+                if (data.is_obsolete())
+                {
+                    task->~task_description();
+                    task_description_alloc_.deallocate(task, 1);
+
+                    --addfrom->new_tasks_count_.data_;
+                    continue;
+                }
+
                 threads::thread_id_type thrd;
 
                 bool schedule_now = data.initial_state == pending;
@@ -113,6 +113,14 @@ namespace hpx { namespace threads { namespace policies {
             {
                 // create the new thread
                 threads::thread_init_data& data = task;
+
+                // drop work items which became obsolete while being staged
+                if (data.is_obsolete())
+                {
+                    --addfrom->new_tasks_count_.data_;
+                    continue;
+                }
+
                 threads::thread_id_type tid;
 
                 holder_->create_thread_object(tid, data);
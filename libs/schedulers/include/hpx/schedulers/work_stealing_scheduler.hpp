@@ -0,0 +1,276 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_WORK_STEALING_SCHEDULER)
+#include <hpx/affinity/affinity_data.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/schedulers/local_queue_scheduler.hpp>
+#include <hpx/schedulers/lockfree_queue_backends.hpp>
+#include <hpx/threading_base/scheduler_base.hpp>
+#include <hpx/threading_base/thread_data.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
+#include <hpx/threading_base/thread_pool_base.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies {
+    ///////////////////////////////////////////////////////////////////////////
+    /// The work_stealing_scheduler maintains one Chase-Lev deque per OS
+    /// thread. Threads created or made runnable by a worker of this scheduler
+    /// are pushed onto the bottom of the worker's own deque and are executed
+    /// in LIFO order. Idle workers steal the oldest items from the top of the
+    /// deques of randomly chosen victims, preferring victims in the same NUMA
+    /// domain. Threads scheduled from outside of the pool go to a small
+    /// injection queue associated with each deque.
+    template <typename Mutex = std::mutex,
+        typename PendingQueuing = workstealing_lifo,
+        typename StagedQueuing = lockfree_fifo,
+        typename TerminatedQueuing =
+            default_local_queue_scheduler_terminated_queue>
+    class HPX_EXPORT work_stealing_scheduler
+      : public local_queue_scheduler<Mutex, PendingQueuing, StagedQueuing,
+            TerminatedQueuing>
+    {
+    private:
+        using base_type = local_queue_scheduler<Mutex, PendingQueuing,
+            StagedQueuing, TerminatedQueuing>;
+
+    public:
+        using thread_queue_type = typename base_type::thread_queue_type;
+        using init_parameter_type = typename base_type::init_parameter_type;
+
+        work_stealing_scheduler(init_parameter_type const& init,
+            bool deferred_initialization = true)
+          : base_type(init, deferred_initialization)
+          , near_victims_(init.num_queues_)
+          , far_victims_(init.num_queues_)
+          , random_state_(init.num_queues_)
+        {
+        }
+
+        static std::string get_scheduler_name()
+        {
+            return "work_stealing_scheduler";
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // create a new thread and schedule it if the initial state is equal to
+        // pending
+        void create_thread(
+            thread_init_data& data, thread_id_type* id, error_code& ec) override
+        {
+            std::size_t num_thread =
+                data.schedulehint.mode == thread_schedule_hint_mode_thread ?
+                data.schedulehint.hint :
+                std::size_t(-1);
+
+            std::size_t queue_size = this->queues_.size();
+
+            if (std::size_t(-1) == num_thread)
+            {
+                num_thread = get_default_queue();
+            }
+            else if (num_thread >= queue_size)
+            {
+                num_thread %= queue_size;
+            }
+
+            std::unique_lock<scheduler_base::pu_mutex_type> l;
+            num_thread = this->select_active_pu(l, num_thread);
+
+            HPX_ASSERT(num_thread < queue_size);
+            this->queues_[num_thread]->create_thread(data, id, ec);
+        }
+
+        /// Return the next thread to be executed, return false if none is
+        /// available
+        bool get_next_thread(std::size_t num_thread, bool running,
+            threads::thread_data*& thrd, bool /*enable_stealing*/) override
+        {
+            {
+                HPX_ASSERT(num_thread < this->queues_.size());
+
+                // the owner pops from the bottom of its own deque
+                thread_queue_type* q = this->queues_[num_thread];
+                bool result = q->get_next_thread(thrd, false, false);
+
+                q->increment_num_pending_accesses();
+                if (result)
+                    return true;
+                q->increment_num_pending_misses();
+
+                bool have_staged =
+                    q->get_staged_queue_length(std::memory_order_relaxed) != 0;
+
+                // Give up, we should have work to convert.
+                if (have_staged)
+                    return false;
+            }
+
+            if (!running)
+            {
+                return false;
+            }
+
+            // steal from the top of the deques of randomly chosen victims,
+            // first in the same NUMA domain
+            if (steal_from(num_thread, near_victims_[num_thread], thrd))
+                return true;
+
+            if (this->has_scheduler_mode(policies::enable_stealing_numa))
+            {
+                return steal_from(num_thread, far_victims_[num_thread], thrd);
+            }
+
+            return false;
+        }
+
+        /// Schedule the passed thread
+        void schedule_thread(threads::thread_data* thrd,
+            threads::thread_schedule_hint schedulehint, bool allow_fallback,
+            thread_priority priority = thread_priority_normal) override
+        {
+            // NOTE: This scheduler ignores NUMA hints.
+            std::size_t num_thread = std::size_t(-1);
+            if (schedulehint.mode == thread_schedule_hint_mode_thread)
+            {
+                num_thread = schedulehint.hint;
+            }
+            else
+            {
+                allow_fallback = false;
+            }
+
+            std::size_t queue_size = this->queues_.size();
+
+            if (std::size_t(-1) == num_thread)
+            {
+                num_thread = get_default_queue();
+            }
+            else if (num_thread >= queue_size)
+            {
+                num_thread %= queue_size;
+            }
+
+            std::unique_lock<scheduler_base::pu_mutex_type> l;
+            num_thread = this->select_active_pu(l, num_thread, allow_fallback);
+
+            HPX_ASSERT(thrd->get_scheduler_base() == this);
+
+            HPX_ASSERT(num_thread < queue_size);
+            this->queues_[num_thread]->schedule_thread(thrd);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void on_start_thread(std::size_t num_thread) override
+        {
+            base_type::on_start_thread(num_thread);
+
+            // partition the other workers into victims sharing the NUMA
+            // domain of this worker and all others
+            mask_cref_type numa_domain = this->numa_domain_masks_[num_thread];
+
+            std::vector<std::size_t>& near = near_victims_[num_thread];
+            std::vector<std::size_t>& far = far_victims_[num_thread];
+            near.clear();
+            far.clear();
+
+            std::size_t queues_size = this->queues_.size();
+            for (std::size_t i = 1; i != queues_size; ++i)
+            {
+                std::size_t const idx = (i + num_thread) % queues_size;
+                if (test(numa_domain, this->affinity_data_.get_pu_num(idx)))
+                {
+                    near.push_back(idx);
+                }
+                else
+                {
+                    far.push_back(idx);
+                }
+            }
+
+            // seed the victim selection of this worker (must not be zero)
+            random_state_[num_thread].data_ =
+                0x9e3779b97f4a7c15ull * (num_thread + 1);
+        }
+
+    private:
+        // Threads created by a worker of this scheduler are placed on that
+        // worker's deque, all others are distributed round robin
+        std::size_t get_default_queue()
+        {
+            if (this->get_parent_pool()->get_pool_index() ==
+                threads::detail::get_thread_pool_num_tss())
+            {
+                std::size_t num_thread =
+                    threads::detail::get_local_thread_num_tss();
+                if (num_thread < this->queues_.size())
+                    return num_thread;
+            }
+            return this->curr_queue_++ % this->queues_.size();
+        }
+
+        // xorshift64*
+        std::uint64_t next_random(std::size_t num_thread)
+        {
+            std::uint64_t& x = random_state_[num_thread].data_;
+            x ^= x >> 12;
+            x ^= x << 25;
+            x ^= x >> 27;
+            return x * 0x2545f4914f6cdd1dull;
+        }
+
+        bool steal_from(std::size_t num_thread,
+            std::vector<std::size_t> const& victims,
+            threads::thread_data*& thrd)
+        {
+            std::size_t const num_victims = victims.size();
+            if (num_victims == 0)
+                return false;
+
+            // start at a random victim, then visit all others once
+            std::size_t const start =
+                std::size_t(next_random(num_thread) % num_victims);
+            for (std::size_t i = 0; i != num_victims; ++i)
+            {
+                std::size_t const idx = victims[(start + i) % num_victims];
+                HPX_ASSERT(idx != num_thread);
+
+                thread_queue_type* q = this->queues_[idx];
+                if (q->get_next_thread(thrd, true, true))
+                {
+                    q->increment_num_stolen_from_pending();
+                    this->queues_[num_thread]
+                        ->increment_num_stolen_to_pending();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::vector<std::vector<std::size_t>> near_victims_;
+        std::vector<std::vector<std::size_t>> far_victims_;
+        std::vector<util::cache_line_data<std::uint64_t>> random_state_;
+    };
+}}}    // namespace hpx::threads::policies
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,87 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// All tasks are spawned by a single worker, which then stays busy without
+// ever yielding. The tasks can therefore only run if the other workers steal
+// them from the deque of the spawning worker.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::size_t const num_tasks = 1000;
+
+void test_unbalanced_spawn()
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    std::size_t const spawner = hpx::get_worker_thread_num();
+
+    std::vector<std::atomic<std::size_t>> executed(num_threads);
+    for (auto& e : executed)
+        e.store(0);
+
+    std::atomic<std::size_t> count(0);
+
+    // without a hint all tasks are placed on the deque of this worker
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        futures.push_back(hpx::async([&]() {
+            ++executed[hpx::get_worker_thread_num()];
+            ++count;
+        }));
+    }
+
+    // keep this worker busy, it doesn't pick up any of its own tasks
+    auto const timeout =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (count.load() != num_tasks &&
+        std::chrono::steady_clock::now() < timeout)
+    {
+        std::this_thread::yield();
+    }
+
+    HPX_TEST_EQ(count.load(), num_tasks);
+    HPX_TEST_EQ(executed[spawner].load(), std::size_t(0));
+
+    hpx::wait_all(futures);
+}
+
+int hpx_main()
+{
+    auto const sched = hpx::threads::get_self_id_data()->get_scheduler_base();
+    HPX_TEST_EQ(std::string(sched->get_description()),
+        std::string("core-work_stealing_scheduler"));
+
+    test_unbalanced_spawn();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::init_params init_args;
+
+    init_args.cfg = {"hpx.os_threads=4"};
+    init_args.rp_callback = [](auto& rp) {
+        rp.create_thread_pool("default",
+            hpx::resource::scheduling_policy::work_stealing);
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, init_args), 0);
+
+    return hpx::util::report_errors();
+}
@@ -24,6 +24,24 @@
 
 namespace hpx { namespace serialization {
 
+    namespace detail {
+
+        // Elements of contiguous ranges which can be copied as a whole.
+        // Arrays of bitwise serializable elements qualify as well, which
+        // allows sequences of those to be sent as a single (zero-copy) chunk.
+        template <typename T>
+        struct is_bitwise_serializable_element
+          : hpx::traits::is_bitwise_serializable<T>
+        {
+        };
+
+        template <typename T, std::size_t N>
+        struct is_bitwise_serializable_element<std::array<T, N>>
+          : is_bitwise_serializable_element<typename std::remove_const<T>::type>
+        {
+        };
+    }    // namespace detail
+
     template <class T>
     class array
     {
@@ -72,7 +90,7 @@ namespace hpx { namespace serialization {
         void serialize(Archive& ar, unsigned int v)
         {
             using use_optimized = std::integral_constant<bool,
-                hpx::traits::is_bitwise_serializable<
+                detail::is_bitwise_serializable_element<
                     typename std::remove_const<T>::type>::value>;
 
 #if BOOST_ENDIAN_BIG_BYTE
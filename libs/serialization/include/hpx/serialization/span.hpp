@@ -0,0 +1,284 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/serialization/array.hpp>
+#include <hpx/serialization/serialization_fwd.hpp>
+#include <hpx/serialization/serialize.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace serialization {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Receive buffers for tagged spans. A tagged span which is deserialized
+    // into a span not referring to any memory (such as the arguments of an
+    // action) is loaded directly into the buffer registered for its tag on
+    // the receiving side. A registration is used (and removed) by the first
+    // span received with the tag, the size of the buffer (in bytes) has to
+    // match the size of the received data.
+    HPX_EXPORT void register_receive_buffer(
+        std::uint64_t tag, void* data, std::size_t size);
+    HPX_EXPORT bool unregister_receive_buffer(std::uint64_t tag);
+
+    namespace detail {
+        // remove and return the buffer registered for the given tag, returns
+        // nullptr if there is none
+        HPX_EXPORT void* take_receive_buffer(
+            std::uint64_t tag, std::size_t size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A span refers to a contiguous sequence of elements owned by somebody
+    // else. Sending a span does not copy the referenced elements if they are
+    // bitwise serializable and large enough for zero-copy serialization.
+    //
+    // A span which refers to (non-const) elements when being deserialized
+    // acts as a receive buffer: the data is loaded directly into the
+    // referenced memory (the number of elements has to match). An unbound
+    // span receiving a tagged span uses the receive buffer registered for
+    // the tag instead (see register_receive_buffer). Otherwise the span
+    // allocates memory for the received elements, which is kept alive by
+    // all copies of the span.
+    //
+    // In either case the received data is copied once from the buffers of
+    // the parcel layer into its final location.
+    template <typename T>
+    class span
+    {
+    public:
+        using element_type = T;
+        using value_type = typename std::remove_cv<T>::type;
+        using size_type = std::size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+
+        constexpr span() noexcept
+          : data_(nullptr)
+          , size_(0)
+          , tag_(0)
+        {
+        }
+
+        constexpr span(
+            T* data, std::size_t size, std::uint64_t tag = 0) noexcept
+          : data_(data)
+          , size_(size)
+          , tag_(tag)
+        {
+        }
+
+        template <std::size_t N>
+        constexpr span(T (&data)[N]) noexcept
+          : data_(data)
+          , size_(N)
+          , tag_(0)
+        {
+        }
+
+        template <typename U, std::size_t N,
+            typename Enable = typename std::enable_if<
+                std::is_convertible<U (*)[], T (*)[]>::value>::type>
+        span(std::array<U, N>& data) noexcept
+          : data_(data.data())
+          , size_(N)
+          , tag_(0)
+        {
+        }
+
+        template <typename U, std::size_t N,
+            typename Enable = typename std::enable_if<
+                std::is_convertible<U const (*)[], T (*)[]>::value>::type>
+        span(std::array<U, N> const& data) noexcept
+          : data_(data.data())
+          , size_(N)
+          , tag_(0)
+        {
+        }
+
+        template <typename U, typename Allocator,
+            typename Enable = typename std::enable_if<
+                std::is_convertible<U (*)[], T (*)[]>::value>::type>
+        span(std::vector<U, Allocator>& data) noexcept
+          : data_(data.data())
+          , size_(data.size())
+          , tag_(0)
+        {
+        }
+
+        template <typename U, typename Allocator,
+            typename Enable = typename std::enable_if<
+                std::is_convertible<U const (*)[], T (*)[]>::value>::type>
+        span(std::vector<U, Allocator> const& data) noexcept
+          : data_(data.data())
+          , size_(data.size())
+          , tag_(0)
+        {
+        }
+
+        T* data() const noexcept
+        {
+            return data_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        T& operator[](std::size_t idx) const noexcept
+        {
+            return data_[idx];
+        }
+
+        T* begin() const noexcept
+        {
+            return data_;
+        }
+
+        T* end() const noexcept
+        {
+            return data_ + size_;
+        }
+
+        // returns whether the referenced elements were allocated during
+        // deserialization
+        bool owns_data() const noexcept
+        {
+            return storage_ != nullptr;
+        }
+
+        // the tag selecting the receive buffer on the receiving side, zero
+        // if none
+        std::uint64_t tag() const noexcept
+        {
+            return tag_;
+        }
+
+        void set_tag(std::uint64_t tag) noexcept
+        {
+            tag_ = tag;
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void save(Archive& ar, unsigned int const) const
+        {
+            std::uint64_t size = size_;
+            ar << tag_ << size;
+            if (size_ != 0)
+            {
+                ar << hpx::serialization::make_array(data_, size_);
+            }
+        }
+
+        template <typename Archive>
+        void load(Archive& ar, unsigned int const)
+        {
+            std::uint64_t tag = 0;
+            std::uint64_t size = 0;
+            ar >> tag >> size;
+
+            if (data_ == nullptr || std::is_const<T>::value)
+            {
+                void* buffer = nullptr;
+                if (tag != 0 && size != 0)
+                {
+                    buffer = detail::take_receive_buffer(
+                        tag, size * sizeof(value_type));
+                }
+
+                if (buffer != nullptr)
+                {
+                    storage_.reset();
+                    data_ = static_cast<value_type*>(buffer);
+                    size_ = size;
+                }
+                else
+                {
+                    allocate(size);
+                }
+            }
+            else if (size != size_)
+            {
+                HPX_THROW_EXCEPTION(serialization_error, "span::load",
+                    "the number of received elements does not match the "
+                    "size of the receive buffer");
+                return;
+            }
+
+            tag_ = tag;
+            if (size != 0)
+            {
+                ar >> hpx::serialization::make_array(
+                          const_cast<value_type*>(data_), size_);
+            }
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER()
+
+        void allocate(std::size_t size)
+        {
+            storage_.reset(
+                new value_type[size], std::default_delete<value_type[]>());
+            data_ = storage_.get();
+            size_ = size;
+        }
+
+    private:
+        T* data_;
+        std::size_t size_;
+        std::uint64_t tag_;
+        std::shared_ptr<value_type> storage_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    void register_receive_buffer(std::uint64_t tag, span<T> const& buffer)
+    {
+        static_assert(!std::is_const<T>::value,
+            "a receive buffer has to refer to writable memory");
+        register_receive_buffer(tag, buffer.data(), buffer.size() * sizeof(T));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    span<T> make_span(
+        T* data, std::size_t size, std::uint64_t tag = 0) noexcept
+    {
+        return span<T>(data, size, tag);
+    }
+
+    template <typename T, typename Allocator>
+    span<T> make_span(
+        std::vector<T, Allocator>& data, std::uint64_t tag = 0) noexcept
+    {
+        return span<T>(data.data(), data.size(), tag);
+    }
+
+    template <typename T, typename Allocator>
+    span<T const> make_span(
+        std::vector<T, Allocator> const& data, std::uint64_t tag = 0) noexcept
+    {
+        return span<T const>(data.data(), data.size(), tag);
+    }
+}}    // namespace hpx::serialization
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <hpx/config.hpp>
+#include <hpx/serialization/array.hpp>
 #include <hpx/serialization/serialization_fwd.hpp>
 #include <hpx/serialization/traits/is_bitwise_serializable.hpp>
 
@@ -25,8 +26,7 @@ namespace hpx { namespace serialization {
         if (sz < 1)
             return;
 
-        for (std::size_t i = 0; i < sz; ++i)
-            ar >> arr[i];
+        ar >> hpx::serialization::make_array(&arr[0], sz);
     }
 
     template <typename T>
@@ -35,7 +35,10 @@ namespace hpx { namespace serialization {
     {
         const std::size_t sz = arr.size();
         ar& sz;
-        for (auto v : arr)
-            ar << v;
+        if (sz < 1)
+            return;
+
+        // bitwise serializable elements are sent as a single chunk
+        ar << hpx::serialization::make_array(&arr[0], sz);
     }
 }}    // namespace hpx::serialization
@@ -82,7 +82,7 @@ namespace hpx { namespace serialization {
     void serialize(input_archive& ar, std::vector<T, Allocator>& v, unsigned)
     {
         using use_optimized = std::integral_constant<bool,
-            hpx::traits::is_bitwise_serializable<typename std::remove_const<
+            detail::is_bitwise_serializable_element<typename std::remove_const<
                 typename std::vector<T, Allocator>::value_type>::type>::value>;
 
         v.clear();
@@ -136,7 +136,7 @@ namespace hpx { namespace serialization {
         output_archive& ar, std::vector<T, Allocator> const& v, unsigned)
     {
         using use_optimized = std::integral_constant<bool,
-            hpx::traits::is_bitwise_serializable<typename std::remove_const<
+            detail::is_bitwise_serializable_element<typename std::remove_const<
                 typename std::vector<T, Allocator>::value_type>::type>::value>;
 
         std::uint64_t size = v.size();
@@ -0,0 +1,106 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/serialization/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace hpx { namespace serialization {
+
+    namespace detail {
+
+        struct receive_buffer
+        {
+            void* data_;
+            std::size_t size_;
+        };
+
+        struct receive_buffer_registry
+        {
+            std::mutex mtx_;
+            std::unordered_map<std::uint64_t, receive_buffer> buffers_;
+        };
+
+        static receive_buffer_registry& get_receive_buffer_registry()
+        {
+            static receive_buffer_registry registry;
+            return registry;
+        }
+
+        void* take_receive_buffer(std::uint64_t tag, std::size_t size)
+        {
+            receive_buffer buffer{nullptr, 0};
+            {
+                receive_buffer_registry& registry =
+                    get_receive_buffer_registry();
+
+                std::lock_guard<std::mutex> l(registry.mtx_);
+                auto it = registry.buffers_.find(tag);
+                if (it == registry.buffers_.end())
+                {
+                    return nullptr;
+                }
+
+                buffer = it->second;
+                registry.buffers_.erase(it);
+            }
+
+            if (buffer.size_ != size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "serialization::detail::take_receive_buffer",
+                    hpx::util::format(
+                        "the size of the received data ({} bytes) does not "
+                        "match the size of the receive buffer registered for "
+                        "tag {} ({} bytes)",
+                        size, tag, buffer.size_));
+                return nullptr;
+            }
+            return buffer.data_;
+        }
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    void register_receive_buffer(
+        std::uint64_t tag, void* data, std::size_t size)
+    {
+        if (tag == 0)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "serialization::register_receive_buffer",
+                "receive buffers can't be registered for the tag zero");
+            return;
+        }
+
+        detail::receive_buffer_registry& registry =
+            detail::get_receive_buffer_registry();
+
+        std::lock_guard<std::mutex> l(registry.mtx_);
+        if (!registry.buffers_.emplace(tag, detail::receive_buffer{data, size})
+                 .second)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "serialization::register_receive_buffer",
+                hpx::util::format(
+                    "a receive buffer is already registered for tag {}", tag));
+        }
+    }
+
+    bool unregister_receive_buffer(std::uint64_t tag)
+    {
+        detail::receive_buffer_registry& registry =
+            detail::get_receive_buffer_registry();
+
+        std::lock_guard<std::mutex> l(registry.mtx_);
+        return registry.buffers_.erase(tag) != 0;
+    }
+}}    // namespace hpx::serialization
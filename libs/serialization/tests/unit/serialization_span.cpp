@@ -0,0 +1,246 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#include <hpx/serialization/array.hpp>
+#include <hpx/serialization/input_archive.hpp>
+#include <hpx/serialization/output_archive.hpp>
+#include <hpx/serialization/serialization_chunk.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/span.hpp>
+#include <hpx/serialization/valarray.hpp>
+#include <hpx/serialization/vector.hpp>
+
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <valarray>
+#include <vector>
+
+using hpx::serialization::chunk_type_pointer;
+using hpx::serialization::serialization_chunk;
+
+// number of elements guaranteed to exceed the zero-copy threshold
+constexpr std::size_t large_size =
+    HPX_ZERO_COPY_SERIALIZATION_THRESHOLD / sizeof(double) + 16;
+
+std::size_t count_pointer_chunks(std::vector<serialization_chunk> const& c)
+{
+    std::size_t count = 0;
+    for (serialization_chunk const& chunk : c)
+    {
+        if (chunk.type_ == chunk_type_pointer)
+            ++count;
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_span(bool chunked)
+{
+    std::vector<double> os(large_size);
+    std::iota(os.begin(), os.end(), 0.0);
+
+    std::vector<char> buffer;
+    std::vector<serialization_chunk> chunks;
+    hpx::serialization::output_archive oarchive(
+        buffer, 0, chunked ? &chunks : nullptr);
+
+    hpx::serialization::span<double const> s(os);
+    oarchive << s;
+    oarchive.flush();
+
+    if (chunked)
+    {
+        // the data has been referenced, not copied
+        HPX_TEST_EQ(count_pointer_chunks(chunks), std::size_t(1));
+        HPX_TEST(buffer.size() < large_size * sizeof(double));
+    }
+
+    // load into storage allocated by the span
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, oarchive.bytes_written(), chunked ? &chunks : nullptr);
+
+        hpx::serialization::span<double> is;
+        iarchive >> is;
+
+        HPX_TEST(is.owns_data());
+        HPX_TEST_EQ(is.size(), os.size());
+        for (std::size_t i = 0; i != os.size(); ++i)
+        {
+            HPX_TEST_EQ(is[i], os[i]);
+        }
+    }
+
+    // load directly into a user provided receive buffer
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, oarchive.bytes_written(), chunked ? &chunks : nullptr);
+
+        std::vector<double> recv(large_size, 0.0);
+        hpx::serialization::span<double> is(recv);
+        iarchive >> is;
+
+        HPX_TEST(!is.owns_data());
+        HPX_TEST_EQ(is.data(), recv.data());
+        for (std::size_t i = 0; i != os.size(); ++i)
+        {
+            HPX_TEST_EQ(recv[i], os[i]);
+        }
+    }
+
+    // the size of the receive buffer has to match
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, oarchive.bytes_written(), chunked ? &chunks : nullptr);
+
+        std::vector<double> recv(large_size - 1, 0.0);
+        hpx::serialization::span<double> is(recv);
+
+        HPX_TEST_THROW(iarchive >> is, hpx::exception);
+    }
+}
+
+// a span without memory to load into (as for the arguments of an action) is
+// loaded into the receive buffer registered for the tag of the sent span
+void test_receive_buffer(bool chunked)
+{
+    std::uint64_t const tag = 42;
+
+    std::vector<double> os(large_size);
+    std::iota(os.begin(), os.end(), 0.0);
+
+    std::vector<char> buffer;
+    std::vector<serialization_chunk> chunks;
+    hpx::serialization::output_archive oarchive(
+        buffer, 0, chunked ? &chunks : nullptr);
+
+    oarchive << hpx::serialization::make_span(os, tag);
+    oarchive.flush();
+
+    std::vector<double> recv(large_size, 0.0);
+    hpx::serialization::register_receive_buffer(
+        tag, hpx::serialization::make_span(recv));
+
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, oarchive.bytes_written(), chunked ? &chunks : nullptr);
+
+        hpx::serialization::span<double const> is;
+        iarchive >> is;
+
+        HPX_TEST(!is.owns_data());
+        HPX_TEST_EQ(is.tag(), tag);
+        HPX_TEST_EQ(is.data(), recv.data());
+        HPX_TEST(std::equal(recv.begin(), recv.end(), os.begin()));
+    }
+
+    // the registration has been used up, the next span allocates memory
+    HPX_TEST(!hpx::serialization::unregister_receive_buffer(tag));
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, oarchive.bytes_written(), chunked ? &chunks : nullptr);
+
+        hpx::serialization::span<double> is;
+        iarchive >> is;
+
+        HPX_TEST(is.owns_data());
+        HPX_TEST(std::equal(is.begin(), is.end(), os.begin()));
+    }
+
+    // the size of the registered buffer has to match
+    std::vector<double> small(large_size - 1, 0.0);
+    hpx::serialization::register_receive_buffer(
+        tag, hpx::serialization::make_span(small));
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, oarchive.bytes_written(), chunked ? &chunks : nullptr);
+
+        hpx::serialization::span<double> is;
+        HPX_TEST_THROW(iarchive >> is, hpx::exception);
+    }
+
+    // registrations can be withdrawn
+    hpx::serialization::register_receive_buffer(
+        tag, hpx::serialization::make_span(recv));
+    HPX_TEST(hpx::serialization::unregister_receive_buffer(tag));
+}
+
+void test_empty_span()
+{
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer);
+
+    hpx::serialization::span<int> s;
+    oarchive << s;
+
+    hpx::serialization::input_archive iarchive(buffer);
+
+    hpx::serialization::span<int> is;
+    iarchive >> is;
+    HPX_TEST(is.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// contiguous ranges of bitwise serializable elements are sent as chunks
+template <typename T>
+void test_zero_copy(T const& os, std::size_t expected_chunks)
+{
+    std::vector<char> buffer;
+    std::vector<serialization_chunk> chunks;
+    hpx::serialization::output_archive oarchive(buffer, 0, &chunks);
+
+    oarchive << os;
+    oarchive.flush();
+
+    HPX_TEST_EQ(count_pointer_chunks(chunks), expected_chunks);
+
+    hpx::serialization::input_archive iarchive(
+        buffer, oarchive.bytes_written(), &chunks);
+
+    T is;
+    iarchive >> is;
+    HPX_TEST(is.size() == os.size());
+    HPX_TEST(std::equal(std::begin(is), std::end(is), std::begin(os)));
+}
+
+void test_containers()
+{
+    std::valarray<double> va(large_size);
+    std::iota(std::begin(va), std::end(va), 0.0);
+    test_zero_copy(va, 1);
+
+    std::vector<std::array<double, 3>> vs(large_size);
+    for (std::size_t i = 0; i != vs.size(); ++i)
+    {
+        vs[i] = std::array<double, 3>{{double(i), double(i + 1), 0.0}};
+    }
+    test_zero_copy(vs, 1);
+
+    std::vector<std::vector<double>> nested(
+        3, std::vector<double>(large_size, 1.0));
+    test_zero_copy(nested, 3);
+}
+
+int main()
+{
+    test_span(false);
+    test_span(true);
+    test_receive_buffer(false);
+    test_receive_buffer(true);
+    test_empty_span();
+    test_containers();
+
+    return hpx::util::report_errors();
+}
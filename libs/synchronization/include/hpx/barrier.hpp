@@ -7,9 +7,19 @@
 #pragma once
 
 #include <hpx/synchronization/barrier.hpp>
+#include <hpx/synchronization/scalable_barrier.hpp>
 
 namespace hpx {
 
     template <typename OnCompletion = lcos::local::detail::empty_oncompletion>
     using barrier = lcos::local::cpp20_barrier<OnCompletion>;
+
+    using lcos::local::central_barrier_policy;
+    using lcos::local::combining_tree_barrier_policy;
+    using lcos::local::dissemination_barrier_policy;
+
+    template <typename Policy = lcos::local::combining_tree_barrier_policy,
+        typename OnCompletion = lcos::local::detail::empty_oncompletion>
+    using scalable_barrier =
+        lcos::local::scalable_barrier<Policy, OnCompletion>;
 }
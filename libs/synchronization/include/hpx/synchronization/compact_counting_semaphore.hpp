@@ -0,0 +1,160 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/synchronization/detail/parking_lot.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace lcos { namespace local {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A counting semaphore for HPX threads which occupies a single word.
+    ///
+    /// The lowest bit of the word marks whether threads are parked, the
+    /// remaining bits hold the value of the semaphore. Releasing the
+    /// semaphore hands the released units directly to parked threads.
+    class compact_counting_semaphore
+    {
+    private:
+        static constexpr std::ptrdiff_t parked_bit = 1;
+        static constexpr std::ptrdiff_t one = 2;
+        static constexpr std::size_t spin_limit = 40;
+
+    public:
+        HPX_NON_COPYABLE(compact_counting_semaphore);
+
+        explicit compact_counting_semaphore(std::ptrdiff_t value = 0) noexcept
+          : state_(value * one)
+        {
+            HPX_ASSERT(value >= 0);
+        }
+
+        bool try_acquire() noexcept
+        {
+            std::ptrdiff_t state = state_.load(std::memory_order_relaxed);
+            while (state >= one)
+            {
+                if (state_.compare_exchange_weak(state, state - one,
+                        std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void acquire()
+        {
+            if (!try_acquire())
+            {
+                acquire_slow();
+            }
+        }
+
+        void release(std::ptrdiff_t update = 1)
+        {
+            HPX_ASSERT(update >= 0);
+
+            std::ptrdiff_t state =
+                state_.fetch_add(update * one, std::memory_order_release);
+            if (state & parked_bit)
+            {
+                release_slow(update);
+            }
+        }
+
+        std::ptrdiff_t value() const noexcept
+        {
+            return state_.load(std::memory_order_relaxed) / one;
+        }
+
+    private:
+        void acquire_slow()
+        {
+            std::size_t spin_count = 0;
+            while (true)
+            {
+                if (try_acquire())
+                    return;
+
+                std::ptrdiff_t state = state_.load(std::memory_order_relaxed);
+
+                // spin for a while if nobody is parked yet
+                if (!(state & parked_bit) && spin_count < spin_limit)
+                {
+                    ++spin_count;
+                    HPX_SMT_PAUSE;
+                    continue;
+                }
+
+                // announce that a thread is about to be parked
+                if (!(state & parked_bit) &&
+                    !state_.compare_exchange_weak(state, state | parked_bit,
+                        std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                std::uintptr_t token = detail::parking_lot::park(
+                    this,
+                    [this]() {
+                        return state_.load(std::memory_order_relaxed) ==
+                            parked_bit;
+                    },
+                    "compact_counting_semaphore::acquire");
+
+                if (token == detail::parking_lot::handoff_token)
+                {
+                    // the releasing thread has handed a unit to us
+                    return;
+                }
+                spin_count = 0;
+            }
+        }
+
+        void release_slow(std::ptrdiff_t update)
+        {
+            for (std::ptrdiff_t i = 0; i != update; ++i)
+            {
+                bool handed_over = false;
+                bool unparked = detail::parking_lot::unpark_one(this,
+                    [&](bool unparked, bool have_more) -> std::uintptr_t {
+                        std::ptrdiff_t state =
+                            state_.load(std::memory_order_relaxed);
+                        std::ptrdiff_t desired;
+                        do
+                        {
+                            handed_over = unparked && state >= one;
+                            desired = (handed_over ? state - one : state) &
+                                ~parked_bit;
+                            if (have_more)
+                                desired |= parked_bit;
+                        } while (!state_.compare_exchange_weak(state, desired,
+                            std::memory_order_acq_rel,
+                            std::memory_order_relaxed));
+
+                        return handed_over ?
+                            detail::parking_lot::handoff_token :
+                            detail::parking_lot::default_token;
+                    });
+
+                // stop if there are no more parked threads or if the units
+                // have been taken by running threads
+                if (!unparked || !handed_over)
+                    return;
+            }
+        }
+
+    private:
+        std::atomic<std::ptrdiff_t> state_;
+    };
+}}}    // namespace hpx::lcos::local
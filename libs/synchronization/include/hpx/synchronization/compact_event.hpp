@@ -0,0 +1,88 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/synchronization/detail/parking_lot.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace hpx { namespace lcos { namespace local {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An event semaphore for HPX threads which occupies a single byte.
+    class compact_event
+    {
+    private:
+        static constexpr std::uint8_t unset = 0;
+        static constexpr std::uint8_t set_ = 1;
+        static constexpr std::uint8_t unset_parked = 2;
+
+    public:
+        HPX_NON_COPYABLE(compact_event);
+
+        constexpr compact_event() noexcept
+          : state_(unset)
+        {
+        }
+
+        /// \brief Check if the event has occurred.
+        bool occurred() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) == set_;
+        }
+
+        /// \brief Wait for the event to occur.
+        void wait()
+        {
+            while (true)
+            {
+                std::uint8_t state = state_.load(std::memory_order_acquire);
+                if (state == set_)
+                    return;
+
+                // announce that a thread is about to be parked
+                if (state == unset &&
+                    !state_.compare_exchange_weak(state, unset_parked,
+                        std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                detail::parking_lot::park(
+                    this,
+                    [this]() {
+                        return state_.load(std::memory_order_relaxed) ==
+                            unset_parked;
+                    },
+                    "compact_event::wait");
+            }
+        }
+
+        /// \brief Release all threads waiting on this event.
+        void set()
+        {
+            if (state_.exchange(set_, std::memory_order_acq_rel) ==
+                unset_parked)
+            {
+                detail::parking_lot::unpark_all(this);
+            }
+        }
+
+        /// \brief Reset the event.
+        void reset() noexcept
+        {
+            std::uint8_t expected = set_;
+            state_.compare_exchange_strong(
+                expected, unset, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::uint8_t> state_;
+    };
+}}}    // namespace hpx::lcos::local
@@ -0,0 +1,100 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/synchronization/detail/parking_lot.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace hpx { namespace lcos { namespace local {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A latch for HPX threads which occupies a single word.
+    ///
+    /// The lowest bit of the word marks whether threads are parked, the
+    /// remaining bits hold the counter of the latch.
+    class compact_latch
+    {
+    private:
+        static constexpr std::ptrdiff_t parked_bit = 1;
+        static constexpr std::ptrdiff_t one = 2;
+
+    public:
+        HPX_NON_COPYABLE(compact_latch);
+
+        explicit compact_latch(std::ptrdiff_t count) noexcept
+          : state_(count * one)
+        {
+            HPX_ASSERT(count >= 0);
+        }
+
+        ~compact_latch()
+        {
+            HPX_ASSERT(!(state_.load(std::memory_order_relaxed) & parked_bit));
+        }
+
+        void count_down(std::ptrdiff_t update = 1)
+        {
+            HPX_ASSERT(update >= 0);
+
+            std::ptrdiff_t state =
+                state_.fetch_sub(update * one, std::memory_order_acq_rel);
+            HPX_ASSERT(state / one >= update);
+
+            if (state / one == update && (state & parked_bit))
+            {
+                // the counter reached zero, release all waiting threads
+                state_.fetch_and(~parked_bit, std::memory_order_relaxed);
+                detail::parking_lot::unpark_all(this);
+            }
+        }
+
+        bool try_wait() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) < one;
+        }
+
+        void wait()
+        {
+            while (true)
+            {
+                std::ptrdiff_t state = state_.load(std::memory_order_acquire);
+                if (state < one)
+                    return;
+
+                // announce that a thread is about to be parked
+                if (!(state & parked_bit) &&
+                    !state_.compare_exchange_weak(state, state | parked_bit,
+                        std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                detail::parking_lot::park(
+                    this,
+                    [this]() {
+                        std::ptrdiff_t state =
+                            state_.load(std::memory_order_relaxed);
+                        return state >= one && (state & parked_bit);
+                    },
+                    "compact_latch::wait");
+            }
+        }
+
+        void arrive_and_wait(std::ptrdiff_t update = 1)
+        {
+            count_down(update);
+            wait();
+        }
+
+    private:
+        std::atomic<std::ptrdiff_t> state_;
+    };
+}}}    // namespace hpx::lcos::local
@@ -0,0 +1,223 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/synchronization/detail/parking_lot.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace hpx { namespace lcos { namespace local {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A mutex for HPX threads which occupies a single byte.
+    ///
+    /// Threads trying to acquire a locked mutex spin for a short while and
+    /// park themselves in the global parking lot afterwards. Unlocking a
+    /// mutex with parked threads hands the lock directly to the thread which
+    /// has been waiting the longest, i.e. the woken thread does not have to
+    /// compete with running threads for the lock.
+    class compact_mutex
+    {
+    private:
+        static constexpr std::uint8_t locked_bit = 1;
+        static constexpr std::uint8_t parked_bit = 2;
+
+        static constexpr std::size_t spin_limit = 40;
+
+    public:
+        HPX_NON_COPYABLE(compact_mutex);
+
+        constexpr compact_mutex() noexcept
+          : state_(0)
+        {
+        }
+
+        ~compact_mutex()
+        {
+            HPX_ASSERT(state_.load(std::memory_order_relaxed) == 0);
+        }
+
+        void lock()
+        {
+            std::uint8_t expected = 0;
+            if (!state_.compare_exchange_weak(expected, locked_bit,
+                    std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                lock_slow();
+            }
+        }
+
+        bool try_lock() noexcept
+        {
+            std::uint8_t state = state_.load(std::memory_order_relaxed);
+            while (!(state & locked_bit))
+            {
+                if (state_.compare_exchange_weak(state, state | locked_bit,
+                        std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void unlock()
+        {
+            std::uint8_t expected = locked_bit;
+            if (!state_.compare_exchange_strong(expected, 0,
+                    std::memory_order_release, std::memory_order_relaxed))
+            {
+                unlock_slow();
+            }
+        }
+
+    private:
+        void lock_slow()
+        {
+            std::size_t spin_count = 0;
+            while (true)
+            {
+                std::uint8_t state = state_.load(std::memory_order_relaxed);
+
+                // try to acquire the lock, even if other threads are parked
+                if (!(state & locked_bit))
+                {
+                    if (state_.compare_exchange_weak(state, state | locked_bit,
+                            std::memory_order_acquire,
+                            std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    continue;
+                }
+
+                // spin for a while if nobody is parked yet
+                if (!(state & parked_bit) && spin_count < spin_limit)
+                {
+                    ++spin_count;
+                    HPX_SMT_PAUSE;
+                    continue;
+                }
+
+                // announce that a thread is about to be parked
+                if (!(state & parked_bit) &&
+                    !state_.compare_exchange_weak(state, state | parked_bit,
+                        std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                std::uintptr_t token = detail::parking_lot::park(
+                    this,
+                    [this]() {
+                        return state_.load(std::memory_order_relaxed) ==
+                            (locked_bit | parked_bit);
+                    },
+                    "compact_mutex::lock");
+
+                if (token == detail::parking_lot::handoff_token)
+                {
+                    // the unlocking thread has handed the lock to us
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    HPX_ASSERT(
+                        state_.load(std::memory_order_relaxed) & locked_bit);
+                    return;
+                }
+                spin_count = 0;
+            }
+        }
+
+        void unlock_slow()
+        {
+            detail::parking_lot::unpark_one(
+                this, [this](bool unparked, bool have_more) -> std::uintptr_t {
+                    if (unparked)
+                    {
+                        // hand the lock over to the unparked thread, the lock
+                        // remains locked
+                        state_.store(locked_bit | (have_more ? parked_bit : 0),
+                            std::memory_order_release);
+                        return detail::parking_lot::handoff_token;
+                    }
+
+                    state_.store(0, std::memory_order_release);
+                    return detail::parking_lot::default_token;
+                });
+        }
+
+    private:
+        std::atomic<std::uint8_t> state_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A condition variable to be used with compact_mutex which occupies a
+    /// single byte.
+    class compact_condition_variable
+    {
+    public:
+        HPX_NON_COPYABLE(compact_condition_variable);
+
+        constexpr compact_condition_variable() noexcept
+          : has_waiters_(false)
+        {
+        }
+
+        void notify_one()
+        {
+            if (!has_waiters_.load(std::memory_order_acquire))
+                return;
+
+            detail::parking_lot::unpark_one(
+                this, [this](bool, bool have_more) -> std::uintptr_t {
+                    has_waiters_.store(have_more, std::memory_order_relaxed);
+                    return detail::parking_lot::default_token;
+                });
+        }
+
+        void notify_all()
+        {
+            if (!has_waiters_.load(std::memory_order_acquire))
+                return;
+
+            has_waiters_.store(false, std::memory_order_relaxed);
+            detail::parking_lot::unpark_all(this);
+        }
+
+        void wait(std::unique_lock<compact_mutex>& lock)
+        {
+            HPX_ASSERT(lock.owns_lock());
+
+            detail::parking_lot::park(
+                this,
+                [this]() {
+                    has_waiters_.store(true, std::memory_order_relaxed);
+                    return true;
+                },
+                [&lock]() { lock.unlock(); },
+                "compact_condition_variable::wait");
+
+            lock.lock();
+        }
+
+        template <typename Predicate>
+        void wait(std::unique_lock<compact_mutex>& lock, Predicate pred)
+        {
+            while (!pred())
+            {
+                wait(lock);
+            }
+        }
+
+    private:
+        std::atomic<bool> has_waiters_;
+    };
+}}}    // namespace hpx::lcos::local
@@ -0,0 +1,192 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/execution_base/agent_ref.hpp>
+#include <hpx/execution_base/this_thread.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <boost/intrusive/list.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The parking lot is a global hash table of queues of suspended threads,
+// keyed by an arbitrary address (usually the address of the synchronization
+// primitive the threads are waiting for). This allows synchronization
+// primitives to consist of a single atomic word only: all state needed for
+// suspending threads lives in the parking lot.
+namespace hpx { namespace lcos { namespace local { namespace detail {
+    namespace parking_lot {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The value returned by park() if the thread was not suspended because
+    // the validation failed.
+    constexpr std::uintptr_t invalid_token = 0;
+
+    // The value returned by park() if the thread was woken up without
+    // being given a specific token.
+    constexpr std::uintptr_t default_token = 1;
+
+    // The value returned by park() if the thread was resumed for another
+    // reason than being unparked (for instance when it was aborted).
+    constexpr std::uintptr_t aborted_token = 2;
+
+    // The value passed to an unparked thread if the ownership of the
+    // synchronization primitive has been handed over to it.
+    constexpr std::uintptr_t handoff_token = 3;
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct parked_thread
+    {
+        using hook_type = boost::intrusive::list_member_hook<
+            boost::intrusive::link_mode<boost::intrusive::normal_link>>;
+
+        parked_thread(void const* key, hpx::execution_base::agent_ref ctx)
+          : key_(key)
+          , ctx_(ctx)
+          , token_(aborted_token)
+        {
+        }
+
+        void const* key_;
+        hpx::execution_base::agent_ref ctx_;
+        std::uintptr_t token_;
+        hook_type list_hook_;
+    };
+
+    struct bucket
+    {
+        using mutex_type = lcos::local::spinlock;
+        using list_option_type = boost::intrusive::member_hook<parked_thread,
+            parked_thread::hook_type, &parked_thread::list_hook_>;
+        using queue_type = boost::intrusive::list<parked_thread,
+            list_option_type, boost::intrusive::constant_time_size<false>>;
+
+        mutex_type mtx_;
+        queue_type queue_;
+    };
+
+    // return the bucket the threads waiting for the given key are queued in
+    HPX_EXPORT bucket& get_bucket(void const* key) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Suspend the current thread until it is unparked using the given key.
+    //
+    // The function 'validate' is invoked while the bucket for the key is
+    // locked, the thread is suspended only if it returns true. The function
+    // 'before_sleep' is invoked after the thread has been queued, but before
+    // it is suspended. Unparking threads invoke their callbacks while the
+    // bucket is locked as well, which allows to atomically check and update
+    // the state of a synchronization primitive with respect to parking.
+    //
+    // Returns the token passed by the unparking thread, or invalid_token if
+    // the validation failed.
+    template <typename Validate, typename BeforeSleep>
+    std::uintptr_t park(void const* key, Validate&& validate,
+        BeforeSleep&& before_sleep, char const* description)
+    {
+        bucket& b = get_bucket(key);
+
+        auto this_ctx = hpx::execution_base::this_thread::agent();
+        parked_thread t(key, this_ctx);
+        {
+            std::lock_guard<bucket::mutex_type> l(b.mtx_);
+            if (!validate())
+                return invalid_token;
+
+            b.queue_.push_back(t);
+        }
+
+        before_sleep();
+        this_ctx.suspend(description);
+
+        std::lock_guard<bucket::mutex_type> l(b.mtx_);
+        if (t.ctx_)
+        {
+            // we were not unparked, remove the entry from the queue
+            b.queue_.erase(b.queue_.iterator_to(t));
+        }
+        return t.token_;
+    }
+
+    template <typename Validate>
+    std::uintptr_t park(
+        void const* key, Validate&& validate, char const* description)
+    {
+        return park(key, std::forward<Validate>(validate), []() {},
+            description);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Wake up the thread which has been waiting the longest for the given
+    // key, if any.
+    //
+    // The function 'callback' is invoked with two arguments while the bucket
+    // is locked: whether a thread is being unparked and whether more threads
+    // are waiting for the same key. It returns the token to pass to the
+    // unparked thread.
+    //
+    // Returns whether a thread was unparked.
+    template <typename Callback>
+    bool unpark_one(void const* key, Callback&& callback)
+    {
+        bucket& b = get_bucket(key);
+        std::unique_lock<bucket::mutex_type> l(b.mtx_);
+
+        auto end = b.queue_.end();
+        auto it = b.queue_.begin();
+        while (it != end && it->key_ != key)
+            ++it;
+
+        if (it == end)
+        {
+            callback(false, false);
+            return false;
+        }
+
+        parked_thread& t = *it;
+        it = b.queue_.erase(it);
+
+        bool have_more = false;
+        for (/**/; it != end; ++it)
+        {
+            if (it->key_ == key)
+            {
+                have_more = true;
+                break;
+            }
+        }
+
+        t.token_ = callback(true, have_more);
+
+        // the parked thread may return (and destroy its entry) as soon as
+        // the bucket is unlocked
+        auto ctx = t.ctx_;
+        t.ctx_.reset();
+        l.unlock();
+
+        ctx.resume("parking_lot::unpark_one");
+        return true;
+    }
+
+    inline bool unpark_one(void const* key)
+    {
+        return unpark_one(
+            key, [](bool, bool) -> std::uintptr_t { return default_token; });
+    }
+
+    // Wake up all threads waiting for the given key, returns the number of
+    // threads which were unparked.
+    HPX_EXPORT std::size_t unpark_all(
+        void const* key, std::uintptr_t token = default_token);
+}}}}}    // namespace hpx::lcos::local::detail::parking_lot
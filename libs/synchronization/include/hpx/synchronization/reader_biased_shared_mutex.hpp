@@ -0,0 +1,177 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/synchronization/condition_variable.hpp>
+#include <hpx/synchronization/mutex.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace local {
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A reader-writer lock for HPX threads optimized for read-mostly data.
+    ///
+    /// Readers announce themselves by incrementing a counter in a cache-line
+    /// padded slot owned by the worker thread they run on. As long as no
+    /// writer is active, acquiring and releasing a shared lock does not touch
+    /// any cache line written by other cores.
+    ///
+    /// A writer first acquires the exclusive writer mutex, then revokes the
+    /// reader bias (new readers back out and suspend on the writer mutex
+    /// until the writer has finished) and waits for all active readers to
+    /// leave. The writer is suspended on a condition variable while waiting,
+    /// the last reader leaving while the bias is revoked wakes it up.
+    ///
+    /// HPX threads may be migrated to another worker thread while holding a
+    /// shared lock, i.e. a shared lock may be released through a different
+    /// slot than it was acquired with. The slots are therefore signed
+    /// counters, and only their sum is meaningful.
+    class reader_biased_shared_mutex
+    {
+    private:
+        using mutex_type = lcos::local::mutex;
+        using counter_type = std::atomic<std::int64_t>;
+
+    public:
+        HPX_NON_COPYABLE(reader_biased_shared_mutex);
+
+        explicit reader_biased_shared_mutex(
+            std::size_t num_slots = threads::hardware_concurrency())
+          : readers_(num_slots == 0 ? 1 : num_slots)
+          , writer_active_(false)
+        {
+            for (auto& slot : readers_)
+                slot.data_.store(0, std::memory_order_relaxed);
+        }
+
+        ~reader_biased_shared_mutex()
+        {
+            HPX_ASSERT(active_readers() == 0);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void lock_shared()
+        {
+            while (!try_lock_shared())
+            {
+                // wait for the writer to release the lock, this suspends the
+                // current HPX thread
+                std::lock_guard<mutex_type> l(writer_mtx_);
+            }
+        }
+
+        bool try_lock_shared()
+        {
+            counter_type& slot = get_slot();
+            slot.fetch_add(1, std::memory_order_seq_cst);
+
+            if (!writer_active_.load(std::memory_order_seq_cst))
+                return true;
+
+            // back out, a writer has revoked the reader bias
+            slot.fetch_sub(1, std::memory_order_seq_cst);
+            notify_writer();
+            return false;
+        }
+
+        void unlock_shared()
+        {
+            get_slot().fetch_sub(1, std::memory_order_seq_cst);
+            if (writer_active_.load(std::memory_order_seq_cst))
+                notify_writer();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void lock()
+        {
+            writer_mtx_.lock();
+            writer_active_.store(true, std::memory_order_seq_cst);
+
+            // wait for the active readers to leave
+            std::unique_lock<mutex_type> l(readers_mtx_);
+            while (active_readers() != 0)
+            {
+                readers_cv_.wait(l);
+            }
+        }
+
+        bool try_lock()
+        {
+            if (!writer_mtx_.try_lock())
+                return false;
+
+            writer_active_.store(true, std::memory_order_seq_cst);
+            if (active_readers() != 0)
+            {
+                writer_active_.store(false, std::memory_order_release);
+                writer_mtx_.unlock();
+                return false;
+            }
+            return true;
+        }
+
+        void unlock()
+        {
+            HPX_ASSERT(writer_active_.load(std::memory_order_relaxed));
+
+            // restore the reader bias, this releases the waiting readers
+            writer_active_.store(false, std::memory_order_release);
+            writer_mtx_.unlock();
+        }
+
+    private:
+        // Called by readers after leaving while the reader bias is revoked.
+        // Either the reader observes the revoked bias or the writer observes
+        // the decremented slot, and both check the number of active readers
+        // while holding readers_mtx_, so the last reader can't be missed.
+        void notify_writer()
+        {
+            std::lock_guard<mutex_type> l(readers_mtx_);
+            if (active_readers() == 0)
+                readers_cv_.notify_one();
+        }
+
+        counter_type& get_slot() noexcept
+        {
+            // threads which are not HPX worker threads all share one slot
+            return readers_[get_worker_thread_num() % readers_.size()].data_;
+        }
+
+        // Returns the number of readers which currently hold the lock (or are
+        // about to back out). Readers which have observed the revoked bias
+        // do not increment their slots anymore, hence the sum is never less
+        // than the number of active readers once the bias has been revoked.
+        std::int64_t active_readers() const noexcept
+        {
+            std::int64_t count = 0;
+            for (auto const& slot : readers_)
+            {
+                count += slot.data_.load(std::memory_order_seq_cst);
+            }
+            return count;
+        }
+
+    private:
+        std::vector<util::cache_line_data<counter_type>> readers_;
+        std::atomic<bool> writer_active_;
+        mutex_type writer_mtx_;
+
+        // used by the writer to wait for the active readers to leave
+        mutex_type readers_mtx_;
+        condition_variable readers_cv_;
+    };
+}}}    // namespace hpx::lcos::local
@@ -0,0 +1,402 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The combining tree and dissemination algorithms are described in:
+//  J. M. Mellor-Crummey and M. L. Scott, "Algorithms for scalable
+//  synchronization on shared-memory multiprocessors", ACM TOCS 9(1), 1991.
+
+#pragma once
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/execution_base/this_thread.hpp>
+#include <hpx/synchronization/barrier.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Barrier policies to be used with scalable_barrier.
+
+    // All participants decrement a single counter and wait on a single
+    // release flag.
+    struct central_barrier_policy
+    {
+    };
+
+    // The participants are combined in a tree with a fan-in of four. Sub-trees
+    // never span more than one group of participants (NUMA domain). Every
+    // participant waits on the release flag of the tree node it arrived at
+    // last, which is shared with at most three other participants.
+    struct combining_tree_barrier_policy
+    {
+    };
+
+    // In round k every participant signals participant (rank + 2^k) % size
+    // and waits for the signal of participant (rank - 2^k) % size. All flags
+    // a participant waits on are owned by that participant.
+    struct dissemination_barrier_policy
+    {
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+
+        using barrier_flag =
+            hpx::util::cache_line_data<std::atomic<std::size_t>>;
+
+        // All flags store the number of the phase they were last signaled
+        // for. A phase has ended for a waiting participant as soon as the
+        // flag it waits on holds the participant's current phase.
+        inline void barrier_wait_for(
+            std::atomic<std::size_t> const& flag, std::size_t phase)
+        {
+            hpx::util::yield_while(
+                [&]() {
+                    return flag.load(std::memory_order_acquire) < phase;
+                },
+                "scalable_barrier::arrive_and_wait");
+        }
+
+        // By default, participants are assumed to be assigned to the
+        // processing units in order, all participants running in the same
+        // NUMA domain form a group.
+        inline std::size_t get_barrier_group_size(std::size_t group_size)
+        {
+            if (group_size != 0)
+                return group_size;
+
+            threads::topology& topo = threads::create_topology();
+            std::size_t const numa_nodes =
+                (std::max)(topo.get_number_of_numa_nodes(), std::size_t(1));
+            return (std::max)(
+                topo.get_number_of_pus() / numa_nodes, std::size_t(1));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Policy>
+        class scalable_barrier_impl;
+
+        ///////////////////////////////////////////////////////////////////////
+        template <>
+        class scalable_barrier_impl<central_barrier_policy>
+        {
+        public:
+            scalable_barrier_impl(std::size_t size, std::size_t)
+              : size_(size)
+              , phases_(new hpx::util::cache_line_data<std::size_t>[size])
+            {
+                count_.data_.store(size, std::memory_order_relaxed);
+                release_.data_.store(0, std::memory_order_relaxed);
+            }
+
+            template <typename F>
+            void arrive_and_wait(std::size_t rank, F& completion)
+            {
+                std::size_t const phase = ++phases_[rank].data_;
+
+                if (count_.data_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                {
+                    barrier_wait_for(release_.data_, phase);
+                    return;
+                }
+
+                count_.data_.store(size_, std::memory_order_relaxed);
+                completion();
+                release_.data_.store(phase, std::memory_order_release);
+            }
+
+        private:
+            std::size_t const size_;
+            std::unique_ptr<hpx::util::cache_line_data<std::size_t>[]> phases_;
+            barrier_flag count_;
+            barrier_flag release_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <>
+        class scalable_barrier_impl<combining_tree_barrier_policy>
+        {
+        private:
+            HPX_STATIC_CONSTEXPR std::size_t fan_in = 4;
+            HPX_STATIC_CONSTEXPR std::size_t max_depth = 64;
+            HPX_STATIC_CONSTEXPR std::size_t no_parent = std::size_t(-1);
+
+            struct node
+            {
+                node()
+                  : count_(0)
+                  , release_(0)
+                  , expected_(0)
+                  , parent_(no_parent)
+                {
+                }
+
+                std::atomic<std::size_t> count_;
+                std::atomic<std::size_t> release_;
+                std::size_t expected_;
+                std::size_t parent_;
+            };
+
+            using padded_node = hpx::util::cache_aligned_data_derived<node>;
+
+        public:
+            scalable_barrier_impl(std::size_t size, std::size_t group_size)
+              : leaves_(size)
+              , phases_(new hpx::util::cache_line_data<std::size_t>[size])
+            {
+                group_size = get_barrier_group_size(group_size);
+
+                // build the tree bottom up for each of the groups first, then
+                // combine the roots of the groups
+                tree_builder builder;
+                std::vector<std::size_t> group_roots;
+                for (std::size_t first = 0; first < size; first += group_size)
+                {
+                    std::size_t const last =
+                        (std::min)(first + group_size, size);
+
+                    std::vector<std::size_t> leaves;
+                    for (std::size_t rank = first; rank < last; rank += fan_in)
+                    {
+                        std::size_t const children =
+                            (std::min)(std::size_t(fan_in), last - rank);
+                        std::size_t const leaf = builder.add_node(children);
+                        for (std::size_t i = 0; i != children; ++i)
+                            leaves_[rank + i] = leaf;
+                        leaves.push_back(leaf);
+                    }
+                    group_roots.push_back(builder.combine(std::move(leaves)));
+                }
+                builder.combine(std::move(group_roots));
+
+                std::size_t const num_nodes = builder.expected_.size();
+                nodes_.reset(new padded_node[num_nodes]);
+                for (std::size_t i = 0; i != num_nodes; ++i)
+                {
+                    nodes_[i].count_.store(
+                        builder.expected_[i], std::memory_order_relaxed);
+                    nodes_[i].expected_ = builder.expected_[i];
+                    nodes_[i].parent_ = builder.parents_[i];
+                }
+            }
+
+            template <typename F>
+            void arrive_and_wait(std::size_t rank, F& completion)
+            {
+                std::size_t const phase = ++phases_[rank].data_;
+
+                // the nodes this participant was the last to arrive at
+                std::size_t path[max_depth];
+                std::size_t depth = 0;
+
+                std::size_t n = leaves_[rank];
+                while (true)
+                {
+                    node& current = nodes_[n];
+                    if (current.count_.fetch_sub(
+                            1, std::memory_order_acq_rel) != 1)
+                    {
+                        barrier_wait_for(current.release_, phase);
+                        break;
+                    }
+
+                    // all participants of this sub-tree have arrived, the
+                    // node can be reused for the next phase
+                    current.count_.store(
+                        current.expected_, std::memory_order_relaxed);
+
+                    HPX_ASSERT(depth < max_depth);
+                    path[depth++] = n;
+
+                    if (current.parent_ == no_parent)
+                    {
+                        completion();
+                        break;
+                    }
+                    n = current.parent_;
+                }
+
+                // release the waiting participants top down
+                while (depth != 0)
+                {
+                    nodes_[path[--depth]].release_.store(
+                        phase, std::memory_order_release);
+                }
+            }
+
+        private:
+            struct tree_builder
+            {
+                std::size_t add_node(std::size_t children)
+                {
+                    expected_.push_back(children);
+                    parents_.push_back(std::size_t(no_parent));
+                    return expected_.size() - 1;
+                }
+
+                // combine the given nodes into a tree, returns its root
+                std::size_t combine(std::vector<std::size_t> nodes)
+                {
+                    HPX_ASSERT(!nodes.empty());
+                    while (nodes.size() > 1)
+                    {
+                        std::vector<std::size_t> parents;
+                        for (std::size_t i = 0; i < nodes.size(); i += fan_in)
+                        {
+                            std::size_t const children = (std::min)(
+                                std::size_t(fan_in), nodes.size() - i);
+                            std::size_t const parent = add_node(children);
+                            for (std::size_t j = 0; j != children; ++j)
+                                parents_[nodes[i + j]] = parent;
+                            parents.push_back(parent);
+                        }
+                        nodes = std::move(parents);
+                    }
+                    return nodes[0];
+                }
+
+                std::vector<std::size_t> expected_;
+                std::vector<std::size_t> parents_;
+            };
+
+            std::vector<std::size_t> leaves_;
+            std::unique_ptr<padded_node[]> nodes_;
+            std::unique_ptr<hpx::util::cache_line_data<std::size_t>[]> phases_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <>
+        class scalable_barrier_impl<dissemination_barrier_policy>
+        {
+        public:
+            scalable_barrier_impl(std::size_t size, std::size_t)
+              : size_(size)
+              , rounds_(0)
+              , phases_(new hpx::util::cache_line_data<std::size_t>[size])
+              , wakeup_(new barrier_flag[size])
+            {
+                while ((std::size_t(1) << rounds_) < size)
+                    ++rounds_;
+
+                flags_.reset(new barrier_flag[size * rounds_]);
+                for (std::size_t i = 0; i != size * rounds_; ++i)
+                    flags_[i].data_.store(0, std::memory_order_relaxed);
+                for (std::size_t i = 0; i != size; ++i)
+                    wakeup_[i].data_.store(0, std::memory_order_relaxed);
+            }
+
+            template <typename F>
+            void arrive_and_wait(std::size_t rank, F& completion)
+            {
+                std::size_t const phase = ++phases_[rank].data_;
+
+                std::size_t distance = 1;
+                for (std::size_t k = 0; k != rounds_; ++k, distance <<= 1)
+                {
+                    std::size_t const partner = (rank + distance) % size_;
+                    flags_[partner * rounds_ + k].data_.store(
+                        phase, std::memory_order_release);
+                    barrier_wait_for(flags_[rank * rounds_ + k].data_, phase);
+                }
+
+                complete(rank, phase, completion);
+            }
+
+        private:
+            // without a completion function all participants can leave the
+            // barrier after the last round
+            void complete(std::size_t, std::size_t, empty_oncompletion&) {}
+
+            // otherwise the first participant runs the completion function and
+            // releases the others along a binary tree
+            template <typename F>
+            void complete(std::size_t rank, std::size_t phase, F& completion)
+            {
+                if (rank == 0)
+                    completion();
+                else
+                    barrier_wait_for(wakeup_[rank].data_, phase);
+
+                for (std::size_t child = 2 * rank + 1;
+                     child < size_ && child <= 2 * rank + 2; ++child)
+                {
+                    wakeup_[child].data_.store(
+                        phase, std::memory_order_release);
+                }
+            }
+
+            std::size_t const size_;
+            std::size_t rounds_;
+            std::unique_ptr<hpx::util::cache_line_data<std::size_t>[]> phases_;
+            std::unique_ptr<barrier_flag[]> flags_;
+            std::unique_ptr<barrier_flag[]> wakeup_;
+        };
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A barrier for a fixed number of participants identified by their rank
+    /// (0 <= rank < size) which scales to large numbers of participants.
+    /// Waiting participants spin (and eventually yield) on flags shared with
+    /// few or no other participants instead of blocking on a single wait
+    /// queue.
+    ///
+    /// \tparam Policy          One of central_barrier_policy,
+    ///                         combining_tree_barrier_policy, or
+    ///                         dissemination_barrier_policy.
+    /// \tparam OnCompletion    The completion function, it is run by one of
+    ///                         the participants after all participants
+    ///                         arrived and before any of them leaves the
+    ///                         barrier (see cpp20_barrier).
+    template <typename Policy = combining_tree_barrier_policy,
+        typename OnCompletion = detail::empty_oncompletion>
+    class scalable_barrier
+    {
+    public:
+        HPX_NON_COPYABLE(scalable_barrier);
+
+        /// Create a barrier for \a size participants. \a group_size is the
+        /// number of consecutive ranks sharing a NUMA domain, it is derived
+        /// from the machine topology if zero.
+        explicit scalable_barrier(std::size_t size,
+            OnCompletion completion = OnCompletion(),
+            std::size_t group_size = 0)
+          : impl_(size, group_size)
+          , completion_(std::move(completion))
+          , size_(size)
+        {
+            HPX_ASSERT(size > 0);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// Block the participant \a rank until all participants arrived at
+        /// the barrier. Every participant has to call this exactly once per
+        /// phase.
+        void arrive_and_wait(std::size_t rank)
+        {
+            HPX_ASSERT(rank < size_);
+            impl_.arrive_and_wait(rank, completion_);
+        }
+
+    private:
+        detail::scalable_barrier_impl<Policy> impl_;
+        OnCompletion completion_;
+        std::size_t const size_;
+    };
+}}}    // namespace hpx::lcos::local
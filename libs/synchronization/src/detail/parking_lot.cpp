@@ -0,0 +1,62 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/concurrency/cache_line_data.hpp>
+#include <hpx/execution_base/agent_ref.hpp>
+#include <hpx/hashing/fibhash.hpp>
+#include <hpx/synchronization/detail/parking_lot.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace local { namespace detail {
+    namespace parking_lot {
+
+    constexpr std::size_t num_buckets = 256;
+
+    bucket& get_bucket(void const* key) noexcept
+    {
+        static util::cache_aligned_data<bucket> buckets[num_buckets];
+
+        std::size_t i = util::fibhash<num_buckets>(
+            reinterpret_cast<std::size_t>(key));
+        return buckets[i].data_;
+    }
+
+    std::size_t unpark_all(void const* key, std::uintptr_t token)
+    {
+        bucket& b = get_bucket(key);
+        std::vector<hpx::execution_base::agent_ref> threads;
+
+        {
+            std::lock_guard<bucket::mutex_type> l(b.mtx_);
+
+            auto end = b.queue_.end();
+            for (auto it = b.queue_.begin(); it != end; /**/)
+            {
+                if (it->key_ != key)
+                {
+                    ++it;
+                    continue;
+                }
+
+                threads.push_back(it->ctx_);
+                it->token_ = token;
+                it->ctx_.reset();
+                it = b.queue_.erase(it);
+            }
+        }
+
+        for (auto& ctx : threads)
+        {
+            ctx.resume("parking_lot::unpark_all");
+        }
+        return threads.size();
+    }
+}}}}}    // namespace hpx::lcos::local::detail::parking_lot
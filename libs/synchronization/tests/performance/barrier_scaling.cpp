@@ -0,0 +1,112 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the time per phase of the centralized hpx::barrier
+// with the barrier policies of hpx::scalable_barrier. One participant is run
+// per core, run it with an increasing number of cores to see how the
+// barriers scale, for instance:
+//
+//      barrier_scaling_test --hpx:threads=64 --iterations=100000
+
+#include <hpx/barrier.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t num_iterations = 100000;
+
+// the participants of hpx::barrier are not identified by their rank
+struct cpp20_barrier_adaptor
+{
+    explicit cpp20_barrier_adaptor(std::size_t size)
+      : barrier_(static_cast<std::ptrdiff_t>(size))
+    {
+    }
+
+    void arrive_and_wait(std::size_t)
+    {
+        barrier_.arrive_and_wait();
+    }
+
+    hpx::barrier<> barrier_;
+};
+
+template <typename Barrier>
+void worker(Barrier& b, std::size_t rank)
+{
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        b.arrive_and_wait(rank);
+    }
+}
+
+template <typename Barrier>
+void run_benchmark(char const* name)
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+
+    Barrier b(num_threads);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    std::vector<hpx::future<void>> tasks;
+    tasks.reserve(num_threads - 1);
+    for (std::size_t i = 1; i != num_threads; ++i)
+    {
+        tasks.push_back(hpx::async(&worker<Barrier>, std::ref(b), i));
+    }
+    worker(b, 0);
+    hpx::wait_all(tasks);
+
+    double const elapsed =
+        static_cast<double>(hpx::util::high_resolution_clock::now() - start) /
+        1e9;
+
+    std::cout << name << ": " << num_threads << " threads, "
+              << (elapsed / double(num_iterations)) * 1e6
+              << " [us/phase]\n";
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    num_iterations = vm["iterations"].as<std::size_t>();
+
+    run_benchmark<cpp20_barrier_adaptor>("barrier");
+    run_benchmark<hpx::scalable_barrier<hpx::central_barrier_policy>>(
+        "scalable_barrier<central>");
+    run_benchmark<hpx::scalable_barrier<hpx::combining_tree_barrier_policy>>(
+        "scalable_barrier<combining_tree>");
+    run_benchmark<hpx::scalable_barrier<hpx::dissemination_barrier_policy>>(
+        "scalable_barrier<dissemination>");
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("iterations",
+         hpx::program_options::value<std::size_t>()->default_value(100000),
+         "the number of barrier phases")
+        ;
+    // clang-format on
+
+    return hpx::init(cmdline, argc, argv);
+}
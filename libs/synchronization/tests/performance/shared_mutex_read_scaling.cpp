@@ -0,0 +1,115 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the throughput of the reader-writer locks for a
+// read-mostly workload. Run it with an increasing number of cores to see how
+// the locks scale, for instance:
+//
+//      shared_mutex_read_scaling_test --hpx:threads=8 --write-percentage=1
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/synchronization/reader_biased_shared_mutex.hpp>
+#include <hpx/synchronization/shared_mutex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t num_iterations = 1000000;
+std::size_t write_percentage = 1;
+
+template <typename Mutex>
+void worker(Mutex& mtx, std::uint64_t& shared_data, std::size_t id)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        if ((id + i) % 100 < write_percentage)
+        {
+            std::lock_guard<Mutex> l(mtx);
+            ++shared_data;
+        }
+        else
+        {
+            mtx.lock_shared();
+            sum += shared_data;
+            mtx.unlock_shared();
+        }
+    }
+
+    // prevent the reads from being optimized away
+    if (sum == std::uint64_t(-1))
+        std::cout << sum << "\n";
+}
+
+template <typename Mutex>
+void run_benchmark(char const* name)
+{
+    Mutex mtx;
+    std::uint64_t shared_data = 0;
+
+    std::size_t const num_threads = hpx::get_os_thread_count();
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    std::vector<hpx::future<void>> tasks;
+    tasks.reserve(num_threads);
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        tasks.push_back(hpx::async(
+            &worker<Mutex>, std::ref(mtx), std::ref(shared_data), i));
+    }
+    hpx::wait_all(tasks);
+
+    double const elapsed =
+        static_cast<double>(hpx::util::high_resolution_clock::now() - start) /
+        1e9;
+    double const total_ops = double(num_threads * num_iterations);
+
+    std::cout << name << ": " << num_threads << " threads, "
+              << write_percentage << "% writes, " << (total_ops / elapsed)
+              << " [op/s] (" << (elapsed / total_ops) << " [s/op])\n";
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    num_iterations = vm["iterations"].as<std::size_t>();
+    write_percentage = vm["write-percentage"].as<std::size_t>();
+
+    run_benchmark<hpx::lcos::local::shared_mutex>("shared_mutex");
+    run_benchmark<hpx::lcos::local::reader_biased_shared_mutex>(
+        "reader_biased_shared_mutex");
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("iterations",
+         hpx::program_options::value<std::size_t>()->default_value(1000000),
+         "the number of lock operations per thread")
+        ("write-percentage",
+         hpx::program_options::value<std::size_t>()->default_value(1),
+         "the percentage of lock operations acquiring exclusive access")
+        ;
+    // clang-format on
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,188 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/synchronization/compact_counting_semaphore.hpp>
+#include <hpx/synchronization/compact_event.hpp>
+#include <hpx/synchronization/compact_latch.hpp>
+#include <hpx/synchronization/compact_mutex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#define NUM_THREADS std::size_t(100)
+#define NUM_ITERATIONS std::size_t(1000)
+
+///////////////////////////////////////////////////////////////////////////////
+void test_mutex()
+{
+    hpx::lcos::local::compact_mutex mtx;
+    std::size_t counter = 0;
+
+    std::vector<hpx::future<void>> results;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        results.push_back(hpx::async([&]() {
+            for (std::size_t j = 0; j != NUM_ITERATIONS; ++j)
+            {
+                std::lock_guard<hpx::lcos::local::compact_mutex> l(mtx);
+                ++counter;
+            }
+        }));
+    }
+    hpx::wait_all(results);
+
+    HPX_TEST_EQ(counter, NUM_THREADS * NUM_ITERATIONS);
+
+    HPX_TEST(mtx.try_lock());
+    HPX_TEST(!mtx.try_lock());
+    mtx.unlock();
+}
+
+void test_condition_variable()
+{
+    hpx::lcos::local::compact_mutex mtx;
+    hpx::lcos::local::compact_condition_variable cv;
+    std::size_t ready = 0;
+    bool go = false;
+
+    std::vector<hpx::future<void>> results;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        results.push_back(hpx::async([&]() {
+            std::unique_lock<hpx::lcos::local::compact_mutex> l(mtx);
+            ++ready;
+            cv.notify_all();
+            cv.wait(l, [&]() { return go; });
+        }));
+    }
+
+    {
+        std::unique_lock<hpx::lcos::local::compact_mutex> l(mtx);
+        cv.wait(l, [&]() { return ready == NUM_THREADS; });
+        go = true;
+    }
+    cv.notify_all();
+
+    hpx::wait_all(results);
+    HPX_TEST_EQ(ready, NUM_THREADS);
+}
+
+void test_counting_semaphore()
+{
+    hpx::lcos::local::compact_counting_semaphore sem(2);
+    std::atomic<std::size_t> active(0);
+    std::atomic<std::size_t> max_active(0);
+
+    std::vector<hpx::future<void>> results;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        results.push_back(hpx::async([&]() {
+            for (std::size_t j = 0; j != NUM_ITERATIONS / 10; ++j)
+            {
+                sem.acquire();
+
+                std::size_t current = ++active;
+                std::size_t prev = max_active.load();
+                while (current > prev &&
+                    !max_active.compare_exchange_weak(prev, current))
+                {
+                }
+                --active;
+
+                sem.release();
+            }
+        }));
+    }
+    hpx::wait_all(results);
+
+    HPX_TEST(max_active.load() <= std::size_t(2));
+    HPX_TEST_EQ(sem.value(), std::ptrdiff_t(2));
+
+    HPX_TEST(sem.try_acquire());
+    HPX_TEST(sem.try_acquire());
+    HPX_TEST(!sem.try_acquire());
+    sem.release(2);
+    HPX_TEST_EQ(sem.value(), std::ptrdiff_t(2));
+}
+
+void test_latch()
+{
+    hpx::lcos::local::compact_latch l(NUM_THREADS + 1);
+    std::atomic<std::size_t> num_threads(0);
+
+    std::vector<hpx::future<void>> results;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        results.push_back(hpx::async([&]() {
+            ++num_threads;
+            HPX_TEST(!l.try_wait());
+            l.arrive_and_wait();
+        }));
+    }
+
+    HPX_TEST(!l.try_wait());
+    l.arrive_and_wait();
+
+    hpx::wait_all(results);
+
+    HPX_TEST(l.try_wait());
+    HPX_TEST_EQ(num_threads.load(), NUM_THREADS);
+}
+
+void test_event()
+{
+    hpx::lcos::local::compact_event e;
+    std::atomic<std::size_t> num_threads(0);
+
+    std::vector<hpx::future<void>> results;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        results.push_back(hpx::async([&]() {
+            e.wait();
+            ++num_threads;
+        }));
+    }
+
+    HPX_TEST(!e.occurred());
+    e.set();
+
+    hpx::wait_all(results);
+
+    HPX_TEST(e.occurred());
+    HPX_TEST_EQ(num_threads.load(), NUM_THREADS);
+
+    e.reset();
+    HPX_TEST(!e.occurred());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    HPX_TEST_EQ(sizeof(hpx::lcos::local::compact_mutex), std::size_t(1));
+    HPX_TEST_EQ(sizeof(hpx::lcos::local::compact_event), std::size_t(1));
+
+    test_mutex();
+    test_condition_variable();
+    test_counting_semaphore();
+    test_latch();
+    test_event();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,107 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+
+#include <hpx/barrier.hpp>
+#include <hpx/modules/async_local.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t iterations = 50;
+
+std::atomic<std::size_t> arrived(0);
+std::atomic<std::size_t> complete(0);
+
+struct oncomplete
+{
+    void operator()() const noexcept
+    {
+        ++complete;
+    }
+};
+
+template <typename Barrier>
+void participant(Barrier& b, std::size_t rank, bool check_completion)
+{
+    std::size_t const size = b.size();
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        ++arrived;
+
+        b.arrive_and_wait(rank);
+
+        // all participants have arrived during this phase
+        HPX_TEST_EQ(arrived.load(), (i + 1) * size);
+        if (check_completion)
+        {
+            HPX_TEST_EQ(complete.load(), 2 * i + 1);
+        }
+
+        // nobody enters the next phase before everybody checked the counters
+        b.arrive_and_wait(rank);
+    }
+}
+
+template <typename Policy, typename OnCompletion>
+void test_barrier(std::size_t size, std::size_t group_size, bool completion)
+{
+    arrived = 0;
+    complete = 0;
+
+    hpx::scalable_barrier<Policy, OnCompletion> b(
+        size, OnCompletion(), group_size);
+    HPX_TEST_EQ(b.size(), size);
+
+    std::vector<hpx::future<void>> results;
+    results.reserve(size - 1);
+    for (std::size_t rank = 1; rank != size; ++rank)
+    {
+        results.push_back(hpx::async(&participant<decltype(b)>, std::ref(b),
+            rank, completion));
+    }
+
+    participant(b, 0, completion);
+    hpx::wait_all(results);
+
+    HPX_TEST_EQ(arrived.load(), iterations * size);
+    if (completion)
+    {
+        HPX_TEST_EQ(complete.load(), 2 * iterations);
+    }
+}
+
+template <typename Policy>
+void test_policy()
+{
+    std::size_t const sizes[] = {1, 2, 5, 16, 33};
+    std::size_t const group_sizes[] = {0, 1, 3, 8};
+
+    for (std::size_t size : sizes)
+    {
+        for (std::size_t group_size : group_sizes)
+        {
+            test_barrier<Policy, hpx::lcos::local::detail::empty_oncompletion>(
+                size, group_size, false);
+            test_barrier<Policy, oncomplete>(size, group_size, true);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_policy<hpx::central_barrier_policy>();
+    test_policy<hpx::combining_tree_barrier_policy>();
+    test_policy<hpx::dissemination_barrier_policy>();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,178 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/synchronization/latch.hpp>
+#include <hpx/synchronization/reader_biased_shared_mutex.hpp>
+
+#include <boost/thread/locks.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using shared_mutex_type = hpx::lcos::local::reader_biased_shared_mutex;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_multiple_readers()
+{
+    shared_mutex_type mtx;
+
+    // all readers hold the lock at the same time
+    std::size_t const num_readers = 10;
+    hpx::lcos::local::latch l(num_readers + 1);
+
+    std::vector<hpx::future<void>> readers;
+    for (std::size_t i = 0; i != num_readers; ++i)
+    {
+        readers.push_back(hpx::async([&]() {
+            boost::shared_lock<shared_mutex_type> lk(mtx);
+            l.count_down_and_wait();
+        }));
+    }
+
+    l.count_down_and_wait();
+    hpx::wait_all(readers);
+
+    HPX_TEST(mtx.try_lock());
+    mtx.unlock();
+}
+
+void test_try_lock()
+{
+    shared_mutex_type mtx;
+
+    {
+        boost::shared_lock<shared_mutex_type> lk(mtx);
+        HPX_TEST(!mtx.try_lock());
+        HPX_TEST(mtx.try_lock_shared());
+        mtx.unlock_shared();
+    }
+
+    {
+        std::unique_lock<shared_mutex_type> lk(mtx);
+        HPX_TEST(!mtx.try_lock());
+        HPX_TEST(!mtx.try_lock_shared());
+    }
+
+    HPX_TEST(mtx.try_lock_shared());
+    mtx.unlock_shared();
+}
+
+void test_reader_blocks_writer()
+{
+    shared_mutex_type mtx;
+    std::atomic<bool> reader_done(false);
+
+    hpx::future<void> writer;
+    {
+        boost::shared_lock<shared_mutex_type> lk(mtx);
+
+        writer = hpx::async([&]() {
+            std::unique_lock<shared_mutex_type> lk(mtx);
+            HPX_TEST(reader_done.load());
+        });
+
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+        HPX_TEST(!writer.is_ready());
+
+        reader_done = true;
+    }
+    writer.get();
+}
+
+void test_writer_blocks_readers()
+{
+    shared_mutex_type mtx;
+    std::atomic<bool> writer_done(false);
+
+    std::vector<hpx::future<void>> readers;
+    {
+        std::unique_lock<shared_mutex_type> lk(mtx);
+
+        for (std::size_t i = 0; i != 10; ++i)
+        {
+            readers.push_back(hpx::async([&]() {
+                boost::shared_lock<shared_mutex_type> lk(mtx);
+                HPX_TEST(writer_done.load());
+            }));
+        }
+
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+        writer_done = true;
+    }
+    hpx::wait_all(readers);
+}
+
+// readers always observe a consistent state while writers modify it
+void test_mixed()
+{
+    shared_mutex_type mtx;
+    std::int64_t values[2] = {0, 0};
+
+    std::size_t const num_tasks = 32;
+    std::size_t const num_iterations = 1000;
+
+    std::vector<hpx::future<void>> tasks;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        tasks.push_back(hpx::async([&, i]() {
+            for (std::size_t j = 0; j != num_iterations; ++j)
+            {
+                if ((i + j) % 16 == 0)
+                {
+                    std::unique_lock<shared_mutex_type> lk(mtx);
+                    ++values[0];
+                    hpx::this_thread::yield();
+                    ++values[1];
+                }
+                else
+                {
+                    boost::shared_lock<shared_mutex_type> lk(mtx);
+                    std::int64_t v = values[0];
+                    hpx::this_thread::yield();
+                    HPX_TEST_EQ(v, values[1]);
+                }
+            }
+        }));
+    }
+    hpx::wait_all(tasks);
+
+    HPX_TEST_EQ(values[0], values[1]);
+    HPX_TEST_EQ(values[0], std::int64_t(num_tasks * num_iterations / 16));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_multiple_readers();
+    test_try_lock();
+    test_reader_blocks_writer();
+    test_writer_blocks_readers();
+    test_mixed();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv, cfg), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -69,3 +69,10 @@ template class HPX_EXPORT
 template class HPX_EXPORT hpx::threads::detail::scheduled_thread_pool<
     hpx::threads::policies::shared_priority_queue_scheduler<>>;
 #endif
+
+#if defined(HPX_HAVE_WORK_STEALING_SCHEDULER)
+#include <hpx/schedulers/work_stealing_scheduler.hpp>
+template class HPX_EXPORT hpx::threads::policies::work_stealing_scheduler<>;
+template class HPX_EXPORT hpx::threads::detail::scheduled_thread_pool<
+    hpx::threads::policies::work_stealing_scheduler<>>;
+#endif
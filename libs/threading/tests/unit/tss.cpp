@@ -12,6 +12,8 @@
 #include <hpx/modules/testing.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <utility>
 #include <vector>
@@ -209,6 +211,57 @@ void test_tss_cleanup_not_called_for_null_pointer()
     HPX_TEST(!tss_cleanup_called);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The cleanup function sets other thread specific data, which grows the
+// storage of the thread while the data being cleaned up is replaced.
+std::vector<std::unique_ptr<hpx::threads::thread_specific_ptr<int>>>
+    tss_others;
+
+void tss_cleanup_sets_others(int* p)
+{
+    for (auto& other : tss_others)
+    {
+        other->reset(new int(*p));
+    }
+    delete p;
+}
+
+void thread_with_reentrant_cleanup()
+{
+    hpx::threads::thread_specific_ptr<int> local_tss(&tss_cleanup_sets_others);
+    for (std::size_t i = 0; i != 32; ++i)
+    {
+        tss_others.emplace_back(new hpx::threads::thread_specific_ptr<int>);
+    }
+
+    // replacing the data runs the cleanup function for the previous data
+    local_tss.reset(new int(1));
+    local_tss.reset(new int(2));
+
+    HPX_TEST(local_tss.get() != nullptr && *local_tss == 2);
+    for (auto& other : tss_others)
+    {
+        HPX_TEST(other->get() != nullptr && **other == 1);
+    }
+
+    // so does erasing the data
+    local_tss.reset();
+
+    HPX_TEST(local_tss.get() == nullptr);
+    for (auto& other : tss_others)
+    {
+        HPX_TEST(other->get() != nullptr && **other == 2);
+    }
+
+    tss_others.clear();
+}
+
+void test_tss_cleanup_sets_other_tss()
+{
+    hpx::thread t(&thread_with_reentrant_cleanup);
+    t.join();
+}
+
 int main(int argc, char** argv)
 {
     test_tss();
@@ -217,6 +270,7 @@ int main(int argc, char** argv)
     test_tss_does_no_cleanup_with_null_cleanup_function();
     test_tss_does_not_call_cleanup_after_ptr_destroyed();
     test_tss_cleanup_not_called_for_null_pointer();
+    test_tss_cleanup_sets_other_tss();
 
     return hpx::util::report_errors();
 }
@@ -324,14 +324,16 @@ namespace hpx { namespace threads { namespace policies {
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
     public:
         // manage scheduler-local data
-        coroutines::detail::tss_data_node* find_tss_data(void const* key);
-        void add_new_tss_node(void const* key,
+        coroutines::detail::tss_data_node* find_tss_data(
+            std::size_t slot, void const* key);
+        void add_new_tss_node(std::size_t slot, void const* key,
             std::shared_ptr<coroutines::detail::tss_cleanup_function> const&
                 func,
             void* tss_data);
-        void erase_tss_node(void const* key, bool cleanup_existing);
-        void* get_tss_data(void const* key);
-        void set_tss_data(void const* key,
+        void erase_tss_node(
+            std::size_t slot, void const* key, bool cleanup_existing);
+        void* get_tss_data(std::size_t slot, void const* key);
+        void set_tss_data(std::size_t slot, void const* key,
             std::shared_ptr<coroutines::detail::tss_cleanup_function> const&
                 func,
             void* tss_data, bool cleanup_existing);
@@ -15,6 +15,7 @@
 #include <hpx/threading_base/external_timer.hpp>
 #endif
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -47,6 +48,7 @@ namespace hpx { namespace threads {
           , initial_state(pending)
           , run_now(false)
           , scheduler_base(nullptr)
+          , obsolete(nullptr)
         {
         }
 
@@ -59,6 +61,7 @@ namespace hpx { namespace threads {
             initial_state = rhs.initial_state;
             run_now = rhs.run_now;
             scheduler_base = rhs.scheduler_base;
+            obsolete = rhs.obsolete;
 #if defined(HPX_HAVE_THREAD_DESCRIPTION)
             description = rhs.description;
 #endif
@@ -97,6 +100,7 @@ namespace hpx { namespace threads {
           , initial_state(rhs.initial_state)
           , run_now(rhs.run_now)
           , scheduler_base(rhs.scheduler_base)
+          , obsolete(rhs.obsolete)
         {
         }
 
@@ -128,6 +132,7 @@ namespace hpx { namespace threads {
           , initial_state(initial_state_)
           , run_now(run_now_)
           , scheduler_base(scheduler_base_)
+          , obsolete(nullptr)
         {
         }
 
@@ -154,5 +159,15 @@ namespace hpx { namespace threads {
         bool run_now;
 
         policies::scheduler_base* scheduler_base;
+
+        // If set, the scheduler drops the staged work item without creating
+        // a thread for it once the referenced flag is true.
+        std::atomic<bool> const* obsolete;
+
+        bool is_obsolete() const noexcept
+        {
+            return obsolete != nullptr &&
+                obsolete->load(std::memory_order_acquire);
+        }
     };
 }}    // namespace hpx::threads
@@ -15,6 +15,7 @@
 #include <hpx/coroutines/detail/tss.hpp>
 #include <hpx/threading_base/thread_data.hpp>
 
+#include <cstddef>
 #include <memory>
 
 namespace hpx { namespace threads {
@@ -52,17 +53,20 @@ namespace hpx { namespace threads {
             void (*cleanup_function)(T*);
         };
 
+        std::size_t slot_;
         std::shared_ptr<cleanup_function> cleanup_;
 
     public:
         typedef T element_type;
 
         thread_specific_ptr()
-          : cleanup_(std::make_shared<delete_data>())
+          : slot_(coroutines::detail::allocate_tss_slot())
+          , cleanup_(std::make_shared<delete_data>())
         {
         }
 
         explicit thread_specific_ptr(void (*func_)(T*))
+          : slot_(coroutines::detail::allocate_tss_slot())
         {
             if (func_)
                 cleanup_.reset(new run_custom_cleanup_function(func_));
@@ -72,12 +76,14 @@ namespace hpx { namespace threads {
         {
             // clean up data if this type is used locally for one thread
             if (get_self_ptr())
-                coroutines::detail::erase_tss_node(this, true);
+                coroutines::detail::erase_tss_node(slot_, this, true);
+            coroutines::detail::release_tss_slot(slot_);
         }
 
         T* get() const
         {
-            return static_cast<T*>(coroutines::detail::get_tss_data(this));
+            return static_cast<T*>(
+                coroutines::detail::get_tss_data(slot_, this));
         }
 
         T* operator->() const
@@ -94,7 +100,7 @@ namespace hpx { namespace threads {
         {
             T* const temp = get();
             coroutines::detail::set_tss_data(
-                this, std::shared_ptr<cleanup_function>());
+                slot_, this, std::shared_ptr<cleanup_function>());
             return temp;
         }
         void reset(T* new_value = nullptr)
@@ -103,7 +109,7 @@ namespace hpx { namespace threads {
             if (current_value != new_value)
             {
                 coroutines::detail::set_tss_data(
-                    this, cleanup_, new_value, true);
+                    slot_, this, cleanup_, new_value, true);
             }
         }
     };
@@ -49,8 +49,9 @@ namespace hpx { namespace threads {
                 "HPX-thread?)");
         }
 
+        static constexpr auto fmt = HPX_FORMAT_STRING("{}: {}");
         return hpx::util::format(
-            "{}: {}", id, get_thread_id_data(id)->get_description());
+            fmt, id, get_thread_id_data(id)->get_description());
     }
 
     void execution_agent::yield(const char* desc)
@@ -363,14 +363,14 @@ namespace hpx { namespace threads { namespace policies {
 
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
     coroutines::detail::tss_data_node* scheduler_base::find_tss_data(
-        void const* key)
+        std::size_t slot, void const* key)
     {
         if (!thread_data_)
             return nullptr;
-        return thread_data_->find(key);
+        return thread_data_->find(slot, key);
     }
 
-    void scheduler_base::add_new_tss_node(void const* key,
+    void scheduler_base::add_new_tss_node(std::size_t slot, void const* key,
         std::shared_ptr<coroutines::detail::tss_cleanup_function> const& func,
         void* tss_data)
     {
@@ -378,40 +378,41 @@ namespace hpx { namespace threads { namespace policies {
         {
             thread_data_ = std::make_shared<coroutines::detail::tss_storage>();
         }
-        thread_data_->insert(key, func, tss_data);
+        thread_data_->insert(slot, key, func, tss_data);
     }
 
-    void scheduler_base::erase_tss_node(void const* key, bool cleanup_existing)
+    void scheduler_base::erase_tss_node(
+        std::size_t slot, void const* key, bool cleanup_existing)
     {
         if (thread_data_)
-            thread_data_->erase(key, cleanup_existing);
+            thread_data_->erase(slot, key, cleanup_existing);
     }
 
-    void* scheduler_base::get_tss_data(void const* key)
+    void* scheduler_base::get_tss_data(std::size_t slot, void const* key)
     {
         if (coroutines::detail::tss_data_node* const current_node =
-                find_tss_data(key))
+                find_tss_data(slot, key))
         {
             return current_node->get_value();
         }
         return nullptr;
     }
 
-    void scheduler_base::set_tss_data(void const* key,
+    void scheduler_base::set_tss_data(std::size_t slot, void const* key,
         std::shared_ptr<coroutines::detail::tss_cleanup_function> const& func,
         void* tss_data, bool cleanup_existing)
     {
         if (coroutines::detail::tss_data_node* const current_node =
-                find_tss_data(key))
+                find_tss_data(slot, key))
         {
-            if (func || (tss_data != 0))
-                current_node->reinit(func, tss_data, cleanup_existing);
+            if (func || (tss_data != nullptr))
+                current_node->reinit(key, func, tss_data, cleanup_existing);
             else
-                erase_tss_node(key, cleanup_existing);
+                erase_tss_node(slot, key, cleanup_existing);
         }
-        else if (func || (tss_data != 0))
+        else if (func || (tss_data != nullptr))
         {
-            add_new_tss_node(key, func, tss_data);
+            add_new_tss_node(slot, key, func, tss_data);
         }
     }
 #endif
@@ -7,11 +7,10 @@
 #include <hpx/config.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/threading_base/thread_data.hpp>
+#include <hpx/modules/format.hpp>
 #include <hpx/threading_base/thread_description.hpp>
-#include <hpx/util/to_string.hpp>
 
 #include <iostream>
-#include <sstream>
 #include <string>
 
 namespace hpx { namespace util {
@@ -39,10 +38,8 @@ namespace hpx { namespace util {
         if (desc.kind() == util::thread_description::data_type_description)
             return desc ? desc.get_description() : "<unknown>";
 
-        std::stringstream strm;
-        strm << "address: 0x" << std::hex
-             << util::to_string(desc.get_address());
-        return strm.str();
+        static constexpr auto fmt = HPX_FORMAT_STRING("address: 0x{:x}");
+        return util::format(fmt, desc.get_address());
 #else
         return "<unknown>";
 #endif
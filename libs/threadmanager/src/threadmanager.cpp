@@ -553,6 +553,45 @@ namespace hpx { namespace threads {
 #endif
                 break;
             }
+
+            case resource::work_stealing:
+            {
+#if defined(HPX_HAVE_WORK_STEALING_SCHEDULER)
+                // set parameters for scheduler and pool instantiation and
+                // perform compatibility checks
+                hpx::detail::ensure_high_priority_compatibility(cfg_.vm_);
+
+                // instantiate the scheduler
+                using local_sched_type =
+                    hpx::threads::policies::work_stealing_scheduler<>;
+
+                local_sched_type::init_parameter_type init(
+                    thread_pool_init.num_threads_,
+                    thread_pool_init.affinity_data_, thread_queue_init,
+                    "core-work_stealing_scheduler");
+
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // set the default scheduler flags
+                sched->add_scheduler_mode(thread_pool_init.mode_);
+                // conditionally set/unset this flag
+                sched->update_scheduler_mode(
+                    policies::enable_stealing_numa, !numa_sensitive);
+
+                // instantiate the pool
+                std::unique_ptr<thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                        local_sched_type>(std::move(sched), thread_pool_init));
+                pools_.push_back(std::move(pool));
+#else
+                throw hpx::detail::command_line_error(
+                    "Command line option --hpx:queuing=work-stealing "
+                    "is not configured in this build. Please rebuild with "
+                    "'cmake -DHPX_WITH_THREAD_SCHEDULERS=work-stealing'.");
+#endif
+                break;
+            }
             }
 
             // update the thread_offset for the next pool
@@ -11,6 +11,7 @@
 #include <hpx/runtime_distributed.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/agas/server/primary_namespace.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/components/stubs/runtime_support.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
@@ -243,6 +244,51 @@ bool is_local_address_cached(
     return naming::get_agas_client().is_local_address_cached(gid, addr, ec);
 }
 
+bool is_local_address_cached(
+    naming::id_type const& id
+  , error_code& ec
+    )
+{
+    naming::address addr;
+    return is_local_address_cached(id, addr, ec);
+}
+
+bool is_local_address_cached(
+    naming::id_type const& id
+  , naming::address& addr
+  , error_code& ec
+    )
+{
+    naming::detail::id_type_impl const& impl =
+        static_cast<naming::detail::id_type_impl const&>(id.get_gid());
+
+    std::uint64_t rebind_count = server::primary_namespace::get_rebind_count();
+
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    if (impl.get_cached_address(rebind_count, addr.address_, addr.type_))
+    {
+        addr.locality_ = agas_.get_local_locality();
+        if (&ec != &throws)
+            ec = make_success_code();
+        return true;
+    }
+
+    if (!agas_.is_local_address_cached(id.get_gid(), addr, ec))
+        return false;
+
+    // the object can't go away while a managed id refers to it
+    naming::id_type::management_type type = id.get_management_type();
+    if ((type == naming::id_type::managed ||
+            type == naming::id_type::managed_move_credit) &&
+        !naming::detail::is_migratable(id.get_gid()) &&
+        naming::detail::store_in_cache(id.get_gid()))
+    {
+        const_cast<naming::detail::id_type_impl&>(impl).set_cached_address(
+            rebind_count, addr.address_, addr.type_);
+    }
+    return true;
+}
+
 bool is_local_lva_encoded_address(
     naming::gid_type const& gid
     )
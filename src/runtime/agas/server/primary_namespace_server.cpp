@@ -193,6 +193,17 @@ void primary_namespace::unregister_server_instance(
     this->base_type::finalize();
 }
 
+namespace {
+
+    // number of existing bindings which have been changed on this locality
+    std::atomic<std::uint64_t> rebind_count(0);
+}
+
+std::uint64_t primary_namespace::get_rebind_count() noexcept
+{
+    return rebind_count.load(std::memory_order_acquire);
+}
+
 void primary_namespace::finalize()
 {
     if (!instance_name_.empty())
@@ -235,6 +246,124 @@ serialization::binary_filter* primary_namespace::get_serialization_filter(
 }
 #endif
 
+namespace {
+
+    // find the entry of the given table whose range contains the given id
+    primary_namespace::gva_table_type::iterator find_range(
+        primary_namespace::gva_table_type& gvas, naming::gid_type const& id)
+    {
+        primary_namespace::gva_table_type::iterator it = gvas.lower_bound(id);
+
+        // exact match
+        if (it != gvas.end() && it->first == id)
+            return it;
+
+        // check whether the previous range covers the id
+        if (it == gvas.begin())
+            return gvas.end();
+
+        --it;
+        if ((it->first + it->second.first.count) > id)
+            return it;
+
+        return gvas.end();
+    }
+}
+
+primary_namespace::gva_stripe_set primary_namespace::get_gva_stripes(
+    naming::gid_type const& id, std::uint64_t count)
+{
+    gva_stripe_set stripes;
+    stripes.set(get_gva_stripe_index(id));
+    if (count <= 1)
+        return stripes;
+
+    naming::gid_type const upper = id + (count - 1);
+    if (upper.get_msb() != id.get_msb())
+    {
+        // such ranges are rejected anyways
+        stripes.set();
+        return stripes;
+    }
+
+    // consecutive blocks differ in their lowest bits, num_gva_stripes of
+    // them are hashed to all stripes
+    std::uint64_t const first = id.get_lsb() >> gva_block_bits;
+    std::uint64_t const last = upper.get_lsb() >> gva_block_bits;
+    if (last - first + 1 >= num_gva_stripes)
+    {
+        stripes.set();
+        return stripes;
+    }
+
+    for (std::uint64_t block = first + 1; block <= last; ++block)
+    {
+        stripes.set(get_gva_stripe_index(naming::gid_type(
+            id.get_msb(), block << gva_block_bits)));
+    }
+    return stripes;
+}
+
+// Lock the given GVA stripes in ascending order
+class primary_namespace::gva_stripes_lock
+{
+public:
+    gva_stripes_lock(primary_namespace& ns, gva_stripe_set const& stripes)
+      : ns_(ns)
+      , stripes_(stripes)
+      , locked_(false)
+    {
+        lock();
+    }
+
+    ~gva_stripes_lock()
+    {
+        if (locked_)
+            unlock();
+    }
+
+    HPX_NON_COPYABLE(gva_stripes_lock);
+
+    void lock()
+    {
+        HPX_ASSERT(!locked_);
+        for (std::size_t i = 0; i != num_gva_stripes; ++i)
+        {
+            if (stripes_.test(i))
+                ns_.gva_stripes_[i].data_.mutex_.lock();
+        }
+        locked_ = true;
+    }
+
+    void unlock()
+    {
+        HPX_ASSERT(locked_);
+        locked_ = false;
+        for (std::size_t i = num_gva_stripes; i != 0; --i)
+        {
+            if (stripes_.test(i - 1))
+                ns_.gva_stripes_[i - 1].data_.mutex_.unlock();
+        }
+    }
+
+    // apply the given function to the tables of all locked stripes
+    template <typename F>
+    void for_each(F&& f)
+    {
+        HPX_ASSERT(locked_);
+        for (std::size_t i = 0; i != num_gva_stripes; ++i)
+        {
+            if (stripes_.test(i))
+                f(ns_.gva_stripes_[i].data_.gvas_);
+        }
+    }
+
+private:
+    primary_namespace& ns_;
+    gva_stripe_set const stripes_;
+    bool locked_;
+};
+
 // start migration of the given object
 std::pair<naming::id_type, naming::address>
 primary_namespace::begin_migration(naming::gid_type id)
@@ -246,10 +375,11 @@ primary_namespace::begin_migration(naming::gid_type id)
     counter_data_.increment_begin_migration_count();
     using hpx::util::get;
 
-    std::unique_lock<mutex_type> l(mutex_);
+    migration_table_stripe& stripe = get_migration_stripe(id);
+    std::unique_lock<mutex_type> l(stripe.mutex_);
 
-    wait_for_migration_locked(l, id, hpx::throws);
-    resolved_type r = resolve_gid_locked(l, id, hpx::throws);
+    wait_for_migration_locked(l, stripe, id, hpx::throws);
+    resolved_type r = resolve_gid_impl(id, hpx::throws);
     if (get<0>(r) == naming::invalid_gid)
     {
         l.unlock();
@@ -261,11 +391,12 @@ primary_namespace::begin_migration(naming::gid_type id)
         return std::make_pair(naming::invalid_id, naming::address());
     }
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end())
+    migration_table_type& migrating_objects = stripe.migrating_objects_;
+    migration_table_type::iterator it = migrating_objects.find(id);
+    if (it == migrating_objects.end())
     {
         std::pair<migration_table_type::iterator, bool> p =
-            migrating_objects_.emplace(std::piecewise_construct,
+            migrating_objects.emplace(std::piecewise_construct,
                 std::forward_as_tuple(id), std::forward_as_tuple());
         HPX_ASSERT(p.second);
         it = p.first;
@@ -293,12 +424,14 @@ bool primary_namespace::end_migration(naming::gid_type const& id)
     );
     counter_data_.increment_end_migration_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    migration_table_stripe& stripe = get_migration_stripe(id);
+    std::unique_lock<mutex_type> l(stripe.mutex_);
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it != migrating_objects_.end())
+    migration_table_type& migrating_objects = stripe.migrating_objects_;
+    migration_table_type::iterator it = migrating_objects.find(id);
+    if (it != migrating_objects.end())
     {
         // flag this id as not being migrated anymore
         get<0>(it->second) = false;
@@ -308,7 +441,7 @@ bool primary_namespace::end_migration(naming::gid_type const& id)
         }
         else
         {
-            migrating_objects_.erase(it);
+            migrating_objects.erase(it);
         }
     }
 
@@ -317,14 +450,16 @@ bool primary_namespace::end_migration(naming::gid_type const& id)
 
 // wait if given object is currently being migrated
 void primary_namespace::wait_for_migration_locked(
-    std::unique_lock<mutex_type>& l, naming::gid_type const& id, error_code& ec)
+    std::unique_lock<mutex_type>& l, migration_table_stripe& stripe,
+    naming::gid_type const& id, error_code& ec)
 {
     HPX_ASSERT_OWNS_LOCK(l);
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it != migrating_objects_.end())
+    migration_table_type& migrating_objects = stripe.migrating_objects_;
+    migration_table_type::iterator it = migrating_objects.find(id);
+    if (it != migrating_objects.end())
     {
         if (get<0>(it->second))
         {
@@ -333,13 +468,13 @@ void primary_namespace::wait_for_migration_locked(
             get<2>(it->second).wait(l, ec);
 
             if (--get<1>(it->second) == 0)
-                migrating_objects_.erase(it);
+                migrating_objects.erase(it);
         }
         else
         {
             if (get<1>(it->second) == 0)
             {
-                migrating_objects_.erase(it);
+                migrating_objects.erase(it);
             }
         }
     }
@@ -361,13 +496,14 @@ bool primary_namespace::bind_gid(
     naming::gid_type gid = id;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
-
-    gva_table_type::iterator it = gvas_.lower_bound(id)
-                           , begin = gvas_.begin()
-                           , end = gvas_.end();
+    // The range is registered in the stripes of all blocks it covers, any
+    // range covering the id is registered in the stripe of its block.
+    gva_table_stripe& stripe = get_gva_stripe(id);
+    gva_stripes_lock l(*this, get_gva_stripes(id, g.count));
 
-    if (it != end)
+    gva_table_type* table = &stripe.gvas_;
+    gva_table_type::iterator it = find_range(*table, id);
+    if (it != table->end())
     {
         // If we got an exact match, this is a request to update an existing
         // binding (e.g. move semantics).
@@ -385,8 +521,7 @@ bool primary_namespace::bind_gid(
                 return false;
             }
 
-            gva& gaddr = it->second.first;
-            naming::gid_type& loc = it->second.second;
+            gva const& gaddr = it->second.first;
 
             // Check for count mismatch (we can't change block sizes of
             // existing bindings).
@@ -425,11 +560,18 @@ bool primary_namespace::bind_gid(
             }
 
             // Store the new endpoint and offset
-            gaddr.prefix = g.prefix;
-            gaddr.type   = g.type;
-            gaddr.lva(g.lva());
-            gaddr.offset = g.offset;
-            loc = locality;
+            ++rebind_count;
+            l.for_each([&](gva_table_type& gvas) {
+                gva_table_type::iterator e = gvas.find(id);
+                HPX_ASSERT(e != gvas.end());
+
+                gva& gaddr = e->second.first;
+                gaddr.prefix = g.prefix;
+                gaddr.type   = g.type;
+                gaddr.lva(g.lva());
+                gaddr.offset = g.offset;
+                e->second.second = locality;
+            });
 
             l.unlock();
 
@@ -441,39 +583,13 @@ bool primary_namespace::bind_gid(
             return false;
         }
 
-        // We're about to decrement the iterator it - first, we
-        // check that it's safe to do this.
-        else if (it != begin)
-        {
-            --it;
-
-            // Check that a previous range doesn't cover the new id.
-            if (HPX_UNLIKELY((it->first + it->second.first.count) > id))
-            {
-                // REVIEW: Is this the right error code to use?
-                l.unlock();
-
-                HPX_THROW_EXCEPTION(bad_parameter
-                  , "primary_namespace::bind_gid"
-                  , "the new GID is contained in an existing range");
-            }
-        }
-    }
-
-    else if (HPX_LIKELY(!gvas_.empty()))
-    {
-        --it;
-
         // Check that a previous range doesn't cover the new id.
-        if ((it->first + it->second.first.count) > id)
-        {
-            // REVIEW: Is this the right error code to use?
-            l.unlock();
+        // REVIEW: Is this the right error code to use?
+        l.unlock();
 
-            HPX_THROW_EXCEPTION(bad_parameter
-              , "primary_namespace::bind_gid"
-              , "the new GID is contained in an existing range");
-        }
+        HPX_THROW_EXCEPTION(bad_parameter
+          , "primary_namespace::bind_gid"
+          , "the new GID is contained in an existing range");
     }
 
     // non-migratable gids don't need to be bound
@@ -510,9 +626,14 @@ bool primary_namespace::bind_gid(
                 id, g, locality));
     }
 
-    // Insert a GID -> GVA entry into the GVA table.
-    if (HPX_UNLIKELY(!util::insert_checked(gvas_.insert(
-            std::make_pair(id, std::make_pair(g, locality))))))
+    // Insert a GID -> GVA entry into the GVA table of all stripes.
+    bool inserted = true;
+    l.for_each([&](gva_table_type& gvas) {
+        inserted = util::insert_checked(gvas.insert(
+                       std::make_pair(id, std::make_pair(g, locality)))) &&
+            inserted;
+    });
+    if (HPX_UNLIKELY(!inserted))
     {
         l.unlock();
 
@@ -543,20 +664,8 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(
     counter_data_.increment_resolve_gid_count();
     using hpx::util::get;
 
-    resolved_type r;
-
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
-        // wait for any migration to be completed
-        if (naming::detail::is_migratable(id))
-        {
-            wait_for_migration_locked(l, id, hpx::throws);
-        }
-
-        // now, resolve the id
-        r = resolve_gid_locked(l, id, hpx::throws);
-    }
+    // wait for any migration to be completed, then resolve the id
+    resolved_type r = wait_and_resolve_gid(id, hpx::throws);
 
     if (get<0>(r) == naming::invalid_gid)
     {
@@ -592,12 +701,13 @@ naming::address primary_namespace::unbind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
-
-    gva_table_type::iterator it = gvas_.find(id)
-                           , end = gvas_.end();
+    // the entry is registered in the stripes of all blocks it covers, the
+    // stripe of its first block is one of those
+    gva_table_stripe& stripe = get_gva_stripe(id);
+    gva_stripes_lock l(*this, get_gva_stripes(id, count));
 
-    if (it != end)
+    gva_table_type::iterator it = stripe.gvas_.find(id);
+    if (it != stripe.gvas_.end())
     {
         if (HPX_UNLIKELY(it->second.first.count != count))
         {
@@ -610,7 +720,7 @@ naming::address primary_namespace::unbind_gid(
 
         gva_table_data_type data = it->second;
 
-        gvas_.erase(it);
+        l.for_each([&](gva_table_type& gvas) { gvas.erase(id); });
 
         l.unlock();
         LAGAS_(info) << hpx::util::format(
@@ -795,36 +905,40 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         )
     { // dump_refcnt_matches implementation
-        HPX_ASSERT(l.owns_lock());
-
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         hpx::util::format_to(ss,
             "{1}, dumping server-side refcnt table matches, lower({2}), "
             "upper({3}):",
             func_name, lower, upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        bool found = false;
+        for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
+            refcnt_table_stripe& stripe = get_refcnt_stripe(raw);
+            std::lock_guard<mutex_type> l(stripe.mutex_);
+
+            refcnt_table_type::iterator it = stripe.refcnts_.find(raw);
+            if (it == stripe.refcnts_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             hpx::util::format_to(ss,
                 "\n  [server] lower({1}), credits({2})",
-                lower_it->first,
-                lower_it->second);
+                it->first,
+                it->second);
+            found = true;
         }
 
+        // We got nothing, bail - our caller is probably about to throw.
+        if (!found)
+            return;
+
         LAGAS_(debug) << ss.str();
     } // dump_refcnt_matches implementation
 #endif
@@ -837,28 +951,10 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
     {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
+        dump_refcnt_matches(lower, upper, "primary_namespace::increment");
     }
 #endif
 
@@ -874,14 +970,18 @@ void primary_namespace::increment(
 
     for (naming::gid_type raw = lower; raw != upper; ++raw)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        refcnt_table_stripe& stripe = get_refcnt_stripe(raw);
+        std::unique_lock<mutex_type> l(stripe.mutex_);
+
+        refcnt_table_type::iterator it = stripe.refcnts_.find(raw);
+        if (it == stripe.refcnts_.end())
         {
             std::int64_t count =
                 std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
             std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                stripe.refcnts_.insert(
+                    refcnt_table_type::value_type(raw, count));
             if (!p.second)
             {
                 l.unlock();
@@ -902,9 +1002,12 @@ void primary_namespace::increment(
             it->second += credits;
         }
 
+        std::int64_t const refcnt = it->second;
+        l.unlock();
+
         LAGAS_(info) << hpx::util::format(
             "primary_namespace::increment, raw({1}), refcnt({2})",
-            lower, it->second);
+            lower, refcnt);
     }
 
     if (&ec != &throws)
@@ -913,42 +1016,24 @@ void primary_namespace::increment(
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
-    std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+    std::list<naming::gid_type> const& free_list
   , free_entry_list_type& free_entry_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
   , error_code& ec
     )
 {
-    HPX_ASSERT_OWNS_LOCK(l);
-
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
-
-    for (iterator const& it : free_list)
+    for (naming::gid_type const& gid : free_list)
     {
-        typedef refcnt_table_type::key_type key_type;
-
-        // The mapping's key space.
-        key_type gid = it->first;
-
-        if (naming::detail::is_migratable(gid))
-        {
-            // wait for any migration to be completed
-            wait_for_migration_locked(l, gid, ec);
-        }
-
-        // Resolve the query GID.
-        resolved_type r = resolve_gid_locked(l, gid, ec);
+        // Resolve the query GID, waiting for any migration to be completed.
+        resolved_type r = wait_and_resolve_gid(gid, ec);
         if (ec) return;
 
         naming::gid_type& raw = get<0>(r);
         if (raw == naming::invalid_gid)
         {
-            l.unlock();
-
             HPX_THROWS_IF(ec, internal_server_error
                 , "primary_namespace::resolve_free_list"
                 , hpx::util::format(
@@ -964,8 +1049,6 @@ void primary_namespace::resolve_free_list(
         // REVIEW: Should we do more to make sure the GVA is valid?
         if (HPX_UNLIKELY(components::component_invalid == g.type))
         {
-            l.unlock();
-
             HPX_THROWS_IF(ec, internal_server_error
                 , "primary_namespace::resolve_free_list"
                 , hpx::util::format(
@@ -976,8 +1059,6 @@ void primary_namespace::resolve_free_list(
         }
         else if (HPX_UNLIKELY(0 == g.count))
         {
-            l.unlock();
-
             HPX_THROWS_IF(ec, internal_server_error
                 , "primary_namespace::resolve_free_list"
                 , hpx::util::format(
@@ -998,9 +1079,6 @@ void primary_namespace::resolve_free_list(
         // Add the information needed to destroy these components to the
         // free list.
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
-
-        // remove this entry from the refcnt table
-        refcnts_.erase(it);
     }
 }
 
@@ -1020,109 +1098,97 @@ void primary_namespace::decrement_sweep(
 
     free_entry_list.clear();
 
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-        {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-                "primary_namespace::decrement_sweep");
-        }
+    if (LAGAS_ENABLED(debug))
+    {
+        dump_refcnt_matches(lower, upper, "primary_namespace::decrement_sweep");
+    }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
 
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
 
-        std::list<refcnt_table_type::iterator> free_list;
-        for (naming::gid_type raw = lower; raw != upper; ++raw)
+    std::list<naming::gid_type> free_list;
+    for (naming::gid_type raw = lower; raw != upper; ++raw)
+    {
+        refcnt_table_stripe& stripe = get_refcnt_stripe(raw);
+        std::unique_lock<mutex_type> l(stripe.mutex_);
+
+        refcnt_table_type::iterator it = stripe.refcnts_.find(raw);
+        if (it == stripe.refcnts_.end())
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
+            if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
             {
-                if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , hpx::util::format(
-                            "negative entry in reference count table, raw({1}), "
-                            "refcount({2})",
-                            raw,
-                            std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits));
-                    return;
-                }
-
-                std::int64_t count =
-                    std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
-
-                std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
-                if (!p.second)
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , hpx::util::format(
-                            "couldn't create entry in reference count table, "
-                            "raw({1}), ref-count({2})",
-                            raw, count));
-                    return;
-                }
-
-                it = p.first;
-            }
-            else
-            {
-                it->second -= credits;
+                l.unlock();
+
+                HPX_THROWS_IF(ec, invalid_data
+                  , "primary_namespace::decrement_sweep"
+                  , hpx::util::format(
+                        "negative entry in reference count table, raw({1}), "
+                        "refcount({2})",
+                        raw,
+                        std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits));
+                return;
             }
 
-            // Sanity check.
-            if (it->second < 0)
+            std::int64_t count =
+                std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
+
+            std::pair<refcnt_table_type::iterator, bool> p =
+                stripe.refcnts_.insert(
+                    refcnt_table_type::value_type(raw, count));
+            if (!p.second)
             {
                 l.unlock();
 
                 HPX_THROWS_IF(ec, invalid_data
                   , "primary_namespace::decrement_sweep"
                   , hpx::util::format(
-                        "negative entry in reference count table, raw({1}), "
-                        "refcount({2})",
-                        raw, it->second));
+                        "couldn't create entry in reference count table, "
+                        "raw({1}), ref-count({2})",
+                        raw, count));
                 return;
             }
 
-            // this objects needs to be deleted
-            if (it->second == 0)
-                free_list.push_back(it);
+            it = p.first;
+        }
+        else
+        {
+            it->second -= credits;
+        }
+
+        // Sanity check.
+        if (it->second < 0)
+        {
+            std::int64_t const refcnt = it->second;
+            l.unlock();
+
+            HPX_THROWS_IF(ec, invalid_data
+              , "primary_namespace::decrement_sweep"
+              , hpx::util::format(
+                    "negative entry in reference count table, raw({1}), "
+                    "refcount({2})",
+                    raw, refcnt));
+            return;
         }
 
-        // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
+        // this objects needs to be deleted, no other references to it
+        // exist, so the entry can be removed right away
+        if (it->second == 0)
+        {
+            stripe.refcnts_.erase(it);
+            free_list.push_back(raw);
+        }
+    }
 
-    } // Unlock the mutex.
+    // Resolve the objects which have to be deleted.
+    resolve_free_list(free_list, free_entry_list, lower, upper, ec);
 
     if (&ec != &throws)
         ec = make_success_code();
@@ -1189,14 +1255,32 @@ void primary_namespace::free_components_sync(
         ec = make_success_code();
 } // }}}
 
-primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
-    std::unique_lock<mutex_type>& l
-  , naming::gid_type const& gid
-  , error_code& ec
+bool primary_namespace::find_gva_range(
+    naming::gid_type const& id
+  , naming::gid_type& base
+  , gva_table_data_type& data
     )
-{ // {{{ resolve_gid_locked implementation
-    HPX_ASSERT_OWNS_LOCK(l);
+{
+    // all ranges covering the id are registered in the stripe of its block
+    gva_table_stripe& stripe = get_gva_stripe(id);
+    std::lock_guard<mutex_type> l(stripe.mutex_);
 
+    gva_table_type::iterator it = find_range(stripe.gvas_, id);
+    if (it != stripe.gvas_.end())
+    {
+        base = it->first;
+        data = it->second;
+        return true;
+    }
+
+    return false;
+}
+
+primary_namespace::resolved_type primary_namespace::resolve_gid_impl(
+    naming::gid_type const& gid
+  , error_code& ec
+    )
+{ // {{{ resolve_gid_impl implementation
     // handle (non-migratable) components located on this locality first
     if (naming::refers_to_local_lva(gid) &&
         !naming::refers_to_virtual_memory(gid))
@@ -1212,75 +1296,23 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
     naming::gid_type id = gid;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    gva_table_type::const_iterator it = gvas_.lower_bound(id)
-                                 , begin = gvas_.begin()
-                                 , end = gvas_.end();
-
-    if (it != end)
+    naming::gid_type base;
+    gva_table_data_type data;
+    if (find_gva_range(id, base, data))
     {
-        // Check for exact match
-        if (it->first == id)
-        {
-            if (&ec != &throws)
-                ec = make_success_code();
-
-            gva_table_data_type const& data = it->second;
-            return resolved_type(it->first, data.first, data.second);
-        }
-
-        // We need to decrement the iterator, first we check that it's safe
-        // to do this.
-        else if (it != begin)
+        if (HPX_UNLIKELY(id.get_msb() != base.get_msb()))
         {
-            --it;
-
-            // Found the GID in a range
-            gva_table_data_type const& data = it->second;
-            if ((it->first + data.first.count) > id)
-            {
-                if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, internal_server_error
-                      , "primary_namespace::resolve_gid_locked"
-                      , "MSBs of lower and upper range bound do not match");
-                    return resolved_type(naming::invalid_gid, gva(),
-                        naming::invalid_gid);
-                }
-
-                if (&ec != &throws)
-                    ec = make_success_code();
-
-                return resolved_type(it->first, data.first, data.second);
-            }
+            HPX_THROWS_IF(ec, internal_server_error
+              , "primary_namespace::resolve_gid_impl"
+              , "MSBs of lower and upper range bound do not match");
+            return resolved_type(naming::invalid_gid, gva(),
+                naming::invalid_gid);
         }
-    }
-
-    else if (HPX_LIKELY(!gvas_.empty()))
-    {
-        --it;
-
-        // Found the GID in a range
-        gva_table_data_type const& data = it->second;
-        if ((it->first + data.first.count) > id)
-        {
-            if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-            {
-                l.unlock();
-
-                HPX_THROWS_IF(ec, internal_server_error
-                  , "primary_namespace::resolve_gid_locked"
-                  , "MSBs of lower and upper range bound do not match");
-                return resolved_type(naming::invalid_gid, gva(),
-                    naming::invalid_gid);
-            }
 
-            if (&ec != &throws)
-                ec = make_success_code();
+        if (&ec != &throws)
+            ec = make_success_code();
 
-            return resolved_type(it->first, data.first, data.second);
-        }
+        return resolved_type(base, data.first, data.second);
     }
 
     if (&ec != &throws)
@@ -1289,6 +1321,24 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
     return resolved_type(naming::invalid_gid, gva(), naming::invalid_gid);
 } // }}}
 
+primary_namespace::resolved_type primary_namespace::wait_and_resolve_gid(
+    naming::gid_type const& gid
+  , error_code& ec
+    )
+{
+    if (naming::detail::is_migratable(gid))
+    {
+        // no migration of this id may start while it is being resolved
+        migration_table_stripe& stripe = get_migration_stripe(gid);
+        std::unique_lock<mutex_type> l(stripe.mutex_);
+
+        wait_for_migration_locked(l, stripe, gid, ec);
+        return resolve_gid_impl(gid, ec);
+    }
+
+    return resolve_gid_impl(gid, ec);
+}
+
 naming::gid_type primary_namespace::statistics_counter(std::string const& name)
 { // {{{ statistics_counter implementation
     LAGAS_(info) << "primary_namespace::statistics_counter";
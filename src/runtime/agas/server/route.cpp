@@ -23,7 +23,6 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -60,22 +59,13 @@ namespace hpx { namespace agas { namespace server
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            std::unique_lock<mutex_type> l(mutex_);
-
             error_code& ec = throws;
 
             // wait for any migration to be completed
-            if (naming::detail::is_migratable(gid))
-            {
-                wait_for_migration_locked(l, gid, ec);
-            }
-
-            cache_address = resolve_gid_locked(l, gid, ec);
+            cache_address = wait_and_resolve_gid(gid, ec);
 
             if (ec || hpx::util::get<0>(cache_address) == naming::invalid_gid)
             {
-                l.unlock();
-
                 HPX_THROWS_IF(ec, no_success,
                     "primary_namespace::route",
                     hpx::util::format(
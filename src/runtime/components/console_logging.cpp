@@ -8,6 +8,9 @@
 #include <hpx/config.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/modules/errors.hpp>
+#if defined(HPX_HAVE_LOGGING)
+#include <hpx/logging/async_logging.hpp>
+#endif
 #include <hpx/runtime_local/runtime_local.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/runtime/agas/addressing_service.hpp>
@@ -268,6 +271,11 @@ namespace hpx { namespace components
 
     void cleanup_logging()
     {
+#if defined(HPX_HAVE_LOGGING)
+        // write out the messages still held by the asynchronous logging
+        // backend, those may have to be forwarded to the console as well
+        util::logging::flush_async_logging();
+#endif
         detail::logger().cleanup();
     }
 
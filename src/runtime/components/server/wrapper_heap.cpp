@@ -78,8 +78,10 @@ namespace hpx { namespace components { namespace detail
         , heap_parameters parameters)
       : pool_(nullptr)
       , first_free_(nullptr)
+      , begin_(nullptr)
+      , end_(nullptr)
       , parameters_(parameters)
-      , free_size_(0)
+      , num_freed_(0)
       , base_gid_(naming::invalid_gid)
       , class_name_(class_name)
 #if defined(HPX_DEBUG)
@@ -98,8 +100,10 @@ namespace hpx { namespace components { namespace detail
     wrapper_heap::wrapper_heap()
       : pool_(nullptr)
       , first_free_(nullptr)
+      , begin_(nullptr)
+      , end_(nullptr)
       , parameters_({0, 0, 0})
-      , free_size_(0)
+      , num_freed_(0)
       , base_gid_(naming::invalid_gid)
 #if defined(HPX_DEBUG)
       , alloc_count_(0)
@@ -121,26 +125,33 @@ namespace hpx { namespace components { namespace detail
     std::size_t wrapper_heap::size() const
     {
         util::itt::heap_internal_access hia; HPX_UNUSED(hia);
-        return parameters_.capacity - free_size_;
+        if (nullptr == pool_.load(std::memory_order_relaxed))
+            return 0;
+
+        std::size_t const freed = num_freed_.load(std::memory_order_relaxed);
+        std::size_t const allocated = allocated_size();
+        return allocated > freed ? allocated - freed : 0;
     }
 
     std::size_t wrapper_heap::free_size() const
     {
         util::itt::heap_internal_access hia; HPX_UNUSED(hia);
-        return free_size_;
+        if (nullptr == pool_.load(std::memory_order_relaxed))
+            return 0;
+
+        return parameters_.capacity - size();
     }
 
     bool wrapper_heap::is_empty() const
     {
         util::itt::heap_internal_access hia; HPX_UNUSED(hia);
-        return nullptr == pool_;
+        return nullptr == pool_.load(std::memory_order_relaxed);
     }
 
     bool wrapper_heap::has_allocatable_slots() const
     {
         util::itt::heap_internal_access hia; HPX_UNUSED(hia);
-        std::size_t const num_bytes = parameters_.capacity * parameters_.element_size;
-        return first_free_ < pool_ + num_bytes;
+        return ensure_pool(first_free_.load(std::memory_order_relaxed), 1);
     }
 
     bool wrapper_heap::alloc(void** result, std::size_t count)
@@ -149,26 +160,27 @@ namespace hpx { namespace components { namespace detail
             heap_alloc_function_, result, count * parameters_.element_size,
             HPX_WRAPPER_HEAP_INITIALIZED_MEMORY);
 
-        scoped_lock l(mtx_);
+        std::size_t const num_bytes = count * parameters_.element_size;
 
-        if (!ensure_pool(count))
-            return false;
+        // grab the requested number of slots by bumping the free pointer
+        char* p = first_free_.load(std::memory_order_relaxed);
+        do
+        {
+            if (!ensure_pool(p, count))
+                return false;
 
-#if defined(HPX_DEBUG)
-        alloc_count_ += count;
-#endif
+        } while (!first_free_.compare_exchange_weak(p, p + num_bytes,
+            std::memory_order_acquire, std::memory_order_relaxed));
 
-        void* p = first_free_;
         HPX_ASSERT(p != nullptr);
 
-        first_free_ = first_free_ + count * parameters_.element_size;
-
-        HPX_ASSERT(free_size_ >= count);
-        free_size_ -= count;
+#if defined(HPX_DEBUG)
+        alloc_count_ += count;
+#endif
 
 #if HPX_DEBUG_WRAPPER_HEAP != 0
         // init memory blocks
-        debug::fill_bytes(p, initial_value, count * parameters_.element_size);
+        debug::fill_bytes(p, initial_value, num_bytes);
 #endif
 
         *result = p;
@@ -181,21 +193,12 @@ namespace hpx { namespace components { namespace detail
 
 #if HPX_DEBUG_WRAPPER_HEAP != 0
         HPX_ASSERT(did_alloc(p));
-#endif
-        scoped_lock l(mtx_);
 
-#if HPX_DEBUG_WRAPPER_HEAP != 0
-        char* p1 = p;
-        std::size_t const total_num_bytes =
-            parameters_.capacity * parameters_.element_size;
+        char* p1 = static_cast<char*>(p);
         std::size_t const num_bytes = count * parameters_.element_size;
 
-        HPX_ASSERT(nullptr != pool_ && p1 >= pool_);
-        HPX_ASSERT(nullptr != pool_ &&
-            p1 + num_bytes <=
-                pool_ + total_num_bytes);
-        HPX_ASSERT(first_free_ == nullptr || p1 != first_free_);
-        HPX_ASSERT(free_size_ + count <= parameters_.capacity);
+        HPX_ASSERT(p1 >= begin_ && p1 + num_bytes <= end_);
+        HPX_ASSERT(p1 + num_bytes <= first_free_.load());
         // make sure this has not been freed yet
         HPX_ASSERT(!debug::test_fill_bytes(p1, freed_value,
             num_bytes));
@@ -209,23 +212,22 @@ namespace hpx { namespace components { namespace detail
 #if defined(HPX_DEBUG)
         free_count_ += count;
 #endif
-        free_size_ += count;
+        std::size_t const freed =
+            num_freed_.fetch_add(count, std::memory_order_acq_rel) + count;
+        HPX_ASSERT(freed <= parameters_.capacity);
 
         // release the pool if this one was the last allocated item
-        test_release(l);
+        test_release(freed);
     }
 
     bool wrapper_heap::did_alloc (void *p) const
     {
         // no lock is necessary here as all involved variables are immutable
         util::itt::heap_internal_access hia; HPX_UNUSED(hia);
-        if (nullptr == pool_) return false;
+        if (nullptr == pool_.load(std::memory_order_relaxed)) return false;
         if (nullptr == p) return false;
 
-        std::size_t const total_num_bytes =
-            parameters_.capacity * parameters_.element_size;
-        return p >= pool_ &&
-            static_cast<char*>(p) < pool_ + total_num_bytes;
+        return p >= begin_ && static_cast<char*>(p) < end_;
     }
 
     naming::gid_type wrapper_heap::get_gid(
@@ -250,7 +252,7 @@ namespace hpx { namespace components { namespace detail
                 // register the global ids and the base address of this heap
                 // with the AGAS
                 if (!applier::bind_range_local(base_gid, parameters_.capacity,
-                        naming::address(hpx::get_locality(), type, pool_),
+                        naming::address(hpx::get_locality(), type, pool_.load()),
                         parameters_.element_size))
                 {
                     return naming::invalid_gid;
@@ -273,7 +275,7 @@ namespace hpx { namespace components { namespace detail
             }
         }
 
-        std::uint64_t const distance = static_cast<char*>(p) - pool_;
+        std::uint64_t const distance = static_cast<char*>(p) - pool_.load();
         return base_gid_ + distance / parameters_.element_size;
     }
 
@@ -285,22 +287,21 @@ namespace hpx { namespace components { namespace detail
         base_gid_ = g;
     }
 
-    bool wrapper_heap::test_release(scoped_lock& lk)
+    bool wrapper_heap::test_release(std::size_t freed)
     {
-        if (pool_ == nullptr)
-            return false;
-
-        std::size_t const total_num_bytes =
-            parameters_.capacity * parameters_.element_size;
-
-        if (first_free_ < pool_ + total_num_bytes ||
-            free_size_ < parameters_.capacity)
+        // Only the thread freeing the last of all slots handed out by this
+        // heap will observe freed == allocated_size() after the heap has
+        // run out of slots, no other thread can concurrently touch the pool.
+        if (ensure_pool(first_free_.load(std::memory_order_acquire), 1) ||
+            freed != allocated_size())
         {
             return false;
         }
 
-        HPX_ASSERT(free_size_ == parameters_.capacity);
-        HPX_ASSERT(first_free_ == pool_ + total_num_bytes);
+        scoped_lock l(mtx_);
+
+        if (pool_.load(std::memory_order_relaxed) == nullptr)
+            return false;
 
         // unbind in AGAS service
         if (base_gid_)
@@ -308,7 +309,7 @@ namespace hpx { namespace components { namespace detail
             naming::gid_type base_gid = base_gid_;
             base_gid_ = naming::invalid_gid;
 
-            util::unlock_guard<scoped_lock> ull(lk);
+            util::unlock_guard<scoped_lock> ull(l);
             applier::unbind_range_local(base_gid, parameters_.capacity);
         }
 
@@ -316,47 +317,55 @@ namespace hpx { namespace components { namespace detail
         return true;
     }
 
-    bool wrapper_heap::ensure_pool(std::size_t count)
+    bool wrapper_heap::ensure_pool(char* first_free, std::size_t count) const
     {
-        if (nullptr == pool_)
+        if (nullptr == pool_.load(std::memory_order_relaxed))
         {
             return false;
         }
 
         std::size_t const num_bytes =
             count * parameters_.element_size;
-        std::size_t const total_num_bytes =
-            parameters_.capacity * parameters_.element_size;
 
-        if (first_free_ + num_bytes > pool_ + total_num_bytes)
+        if (first_free + num_bytes > end_)
         {
             return false;
         }
         return true;
     }
 
+    std::size_t wrapper_heap::allocated_size() const
+    {
+        char* first_free = first_free_.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(first_free - begin_) /
+            parameters_.element_size;
+    }
+
     bool wrapper_heap::init_pool()
     {
         HPX_ASSERT(first_free_ == nullptr);
 
         std::size_t const total_num_bytes =
             parameters_.capacity * parameters_.element_size;
-        pool_ = static_cast<char *>(allocator_type::alloc(total_num_bytes));
-        if (nullptr == pool_)
+        char* pool = static_cast<char *>(allocator_type::alloc(total_num_bytes));
+        if (nullptr == pool)
         {
             return false;
         }
 
-        first_free_ = (reinterpret_cast<std::size_t>(pool_)
-            % parameters_.element_alignment == 0) ? pool_ :
-            pool_ + parameters_.element_alignment;
+        begin_ = (reinterpret_cast<std::size_t>(pool)
+            % parameters_.element_alignment == 0) ? pool :
+            pool + parameters_.element_alignment;
+        end_ = pool + total_num_bytes;
 
-        free_size_ = parameters_.capacity;
+        first_free_.store(begin_, std::memory_order_relaxed);
+        num_freed_.store(0, std::memory_order_relaxed);
+        pool_.store(pool, std::memory_order_release);
 
         LOSH_(info)    //-V128
             << "wrapper_heap ("
             << (!class_name_.empty() ? class_name_.c_str() : "<Unknown>")
-            << "): init_pool (" << std::hex << static_cast<void*>(pool_) << ")"
+            << "): init_pool (" << std::hex << static_cast<void*>(pool) << ")"
             << " size: " << total_num_bytes << ".";
 
         return true;
@@ -364,7 +373,8 @@ namespace hpx { namespace components { namespace detail
 
     void wrapper_heap::tidy()
     {
-        if (pool_ != nullptr)
+        char* pool = pool_.load(std::memory_order_relaxed);
+        if (pool != nullptr)
         {
             LOSH_(debug) //-V128
                 << "wrapper_heap ("
@@ -387,15 +397,17 @@ namespace hpx { namespace components { namespace detail
                     << (!class_name_.empty() ? class_name_.c_str() :
                                                "<Unknown>")
                     << "): releasing heap (" << std::hex
-                    << static_cast<void*>(pool_) << ")"
+                    << static_cast<void*>(pool) << ")"
                     << " with " << size() << " allocated object(s)!";
             }
 
+            // Note: first_free_ and end_ are left untouched, this keeps any
+            // concurrent (failing) alloc() from handing out stale slots.
+            pool_.store(nullptr, std::memory_order_release);
+
             std::size_t const total_num_bytes =
                 parameters_.capacity * parameters_.element_size;
-            allocator_type::free(pool_, total_num_bytes);
-            pool_ = first_free_ = nullptr;
-            free_size_ = 0;
+            allocator_type::free(pool, total_num_bytes);
         }
     }
 }}}
@@ -35,7 +35,6 @@ namespace hpx { namespace parcelset
     parcelport::parcelport(util::runtime_configuration const& ini,
             locality const & here, std::string const& type)
       : applier_(nullptr),
-        num_parcel_destinations_(0),
         here_(here),
         max_inbound_message_size_(ini.get_max_inbound_message_size()),
         max_outbound_message_size_(ini.get_max_outbound_message_size()),
@@ -186,20 +185,6 @@ namespace hpx { namespace parcelset
         return parcels_received_.total_buffer_allocate_time(reset);
     }
 
-    std::int64_t parcelport::get_pending_parcels_count(bool /*reset*/)
-    {
-        std::lock_guard<lcos::local::spinlock> l(mtx_);
-        std::int64_t count = 0;
-        for (auto && p : pending_parcels_)
-        {
-            count += hpx::util::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::util::get<0>(p.second).size() ==
-                hpx::util::get<1>(p.second).size());
-        }
-        return count;
-    }
-
     ///////////////////////////////////////////////////////////////////////////
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     // same as above, just separated data for each action
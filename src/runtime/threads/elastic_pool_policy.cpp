@@ -0,0 +1,379 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/assert.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/logging.hpp>
+#include <hpx/resource_partitioner/detail/partitioner.hpp>
+#include <hpx/runtime/threads/elastic_pool_policy.hpp>
+#include <hpx/runtime_local/thread_pool_helpers.hpp>
+#include <hpx/threading_base/scheduler_base.hpp>
+#include <hpx/threading_base/thread_pool_base.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads {
+    namespace detail {
+        // accumulated number of moves of all elastic_pool_policy instances
+        static std::atomic<std::int64_t> elastic_core_moves(0);
+    }    // namespace detail
+
+    std::int64_t get_elastic_core_move_count(bool reset)
+    {
+        if (reset)
+            return detail::elastic_core_moves.exchange(0);
+        return detail::elastic_core_moves.load();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t elastic_pool_policy::pu_data::virt_core(std::size_t pool) const
+    {
+        for (auto const& m : members_)
+        {
+            if (m.first == pool)
+                return m.second;
+        }
+        HPX_ASSERT(false);
+        return std::size_t(-1);
+    }
+
+    bool elastic_pool_policy::pu_data::is_member(std::size_t pool) const
+    {
+        return std::find_if(members_.begin(), members_.end(),
+                   [pool](std::pair<std::size_t, std::size_t> const& m) {
+                       return m.first == pool;
+                   }) != members_.end();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    elastic_pool_policy::elastic_pool_policy(
+        std::chrono::microseconds interval, std::size_t hysteresis)
+      : interval_(interval)
+      , hysteresis_(hysteresis == 0 ? 1 : hysteresis)
+      , stop_requested_(false)
+      , move_count_(0)
+    {
+    }
+
+    elastic_pool_policy::~elastic_pool_policy()
+    {
+        stop();
+    }
+
+    void elastic_pool_policy::add_pool(
+        std::string const& pool_name, elastic_pool_parameters const& params)
+    {
+        if (is_running())
+        {
+            HPX_THROW_EXCEPTION(invalid_status, "elastic_pool_policy::add_pool",
+                "cannot add a pool to a running elastic_pool_policy");
+        }
+
+        thread_pool_base& pool = resource::get_thread_pool(pool_name);
+        if (!pool.get_scheduler()->has_scheduler_mode(
+                policies::enable_elasticity))
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "elastic_pool_policy::add_pool",
+                "thread pool '" + pool_name +
+                    "' does not support suspending processing units");
+        }
+        if (params.min_cores > params.max_cores)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "elastic_pool_policy::add_pool",
+                "min_cores must not be larger than max_cores");
+        }
+
+        std::size_t const pool_index = pools_.size();
+        std::size_t const num_threads = pool.get_os_thread_count();
+        pools_.push_back(pool_data{&pool, params, num_threads, 0, 0, 0});
+
+        auto& rp = resource::get_partitioner();
+        for (std::size_t virt_core = 0; virt_core != num_threads; ++virt_core)
+        {
+            std::size_t const pu_num =
+                rp.get_pu_num(pool.get_thread_offset() + virt_core);
+
+            auto it = std::find_if(pus_.begin(), pus_.end(),
+                [pu_num](pu_data const& pu) { return pu.pu_num_ == pu_num; });
+            if (it == pus_.end())
+            {
+                pus_.push_back(pu_data{pu_num, pool_index, pool_index, {}});
+                it = pus_.end() - 1;
+            }
+            it->members_.emplace_back(pool_index, virt_core);
+        }
+    }
+
+    void elastic_pool_policy::start()
+    {
+        if (is_running())
+            return;
+
+        num_cores_ = std::vector<std::atomic<std::size_t>>(pools_.size());
+        for (std::size_t i = 0; i != pools_.size(); ++i)
+            num_cores_[i].store(pools_[i].active_cores_);
+
+        stop_requested_ = false;
+        monitor_thread_ = std::thread(&elastic_pool_policy::monitor, this);
+    }
+
+    void elastic_pool_policy::stop()
+    {
+        if (!is_running())
+            return;
+
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            stop_requested_ = true;
+        }
+        cond_.notify_all();
+        monitor_thread_.join();
+    }
+
+    std::size_t elastic_pool_policy::get_num_cores(
+        std::string const& pool_name) const
+    {
+        for (std::size_t i = 0; i != pools_.size(); ++i)
+        {
+            if (pools_[i].pool_->get_pool_name() == pool_name)
+            {
+                return i < num_cores_.size() ? num_cores_[i].load() :
+                                               pools_[i].active_cores_;
+            }
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter, "elastic_pool_policy::get_num_cores",
+            "thread pool '" + pool_name +
+                "' is not managed by this elastic_pool_policy");
+        return 0;
+    }
+
+    std::int64_t elastic_pool_policy::get_move_count(bool reset)
+    {
+        if (reset)
+            return move_count_.exchange(0);
+        return move_count_.load();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void elastic_pool_policy::monitor()
+    {
+        initialize_assignment();
+
+        std::unique_lock<std::mutex> l(mtx_);
+        while (!stop_requested_)
+        {
+            if (cond_.wait_for(l, interval_, [this] { return stop_requested_; }))
+            {
+                break;
+            }
+
+            l.unlock();
+            sample();
+            evaluate();
+            l.lock();
+        }
+        l.unlock();
+
+        restore_assignment();
+    }
+
+    // suspend every shared processing unit in all pools but the one holding
+    // it, which is its owner unless that would leave another pool with less
+    // than its minimal number of processing units
+    void elastic_pool_policy::initialize_assignment()
+    {
+        std::vector<std::size_t> held(pools_.size(), 0);
+        for (pu_data const& pu : pus_)
+            ++held[pu.holder_];
+
+        for (std::size_t to = 0; to != pools_.size(); ++to)
+        {
+            std::size_t const min_cores = pools_[to].params_.min_cores;
+            for (pu_data& pu : pus_)
+            {
+                if (held[to] >= min_cores)
+                    break;
+
+                std::size_t const from = pu.holder_;
+                if (from == to || !pu.is_member(to) ||
+                    held[from] <= pools_[from].params_.min_cores)
+                {
+                    continue;
+                }
+
+                pu.holder_ = to;
+                --held[from];
+                ++held[to];
+            }
+
+            if (held[to] < min_cores)
+            {
+                LTM_(warning)
+                    << "elastic_pool_policy: pool '"
+                    << pools_[to].pool_->get_pool_name() << "' runs on "
+                    << held[to] << " processing units only, less than its "
+                    << "minimum of " << min_cores;
+            }
+        }
+
+        for (pu_data& pu : pus_)
+        {
+            for (auto const& m : pu.members_)
+            {
+                error_code ec(lightweight);
+                if (m.first == pu.holder_)
+                {
+                    // the processing unit may have been left suspended by a
+                    // previous policy
+                    pools_[m.first].pool_->resume_processing_unit_direct(
+                        m.second, ec);
+                    continue;
+                }
+
+                pools_[m.first].pool_->suspend_processing_unit_direct(
+                    m.second, ec);
+                if (!ec)
+                {
+                    --pools_[m.first].active_cores_;
+                    num_cores_[m.first].store(pools_[m.first].active_cores_);
+                }
+            }
+        }
+    }
+
+    // hand all lent processing units back to their owners
+    void elastic_pool_policy::restore_assignment()
+    {
+        for (pu_data& pu : pus_)
+        {
+            if (pu.holder_ != pu.owner_)
+                move_pu(pu, pu.owner_);
+        }
+    }
+
+    void elastic_pool_policy::sample()
+    {
+        for (std::size_t i = 0; i != pools_.size(); ++i)
+        {
+            pool_data& pd = pools_[i];
+
+            pd.pending_ = pd.pool_->get_queue_length(std::size_t(-1), false);
+
+            // suspended processing units are reported as idle as well
+            std::int64_t const suspended = static_cast<std::int64_t>(
+                pd.pool_->get_os_thread_count() - pd.active_cores_);
+            std::int64_t const idle =
+                (std::max)(pd.pool_->get_idle_core_count() - suspended,
+                    std::int64_t(0));
+
+            bool const overloaded =
+                pd.pending_ > static_cast<std::int64_t>(pd.active_cores_) &&
+                idle == 0;
+            bool const underloaded = pd.pending_ == 0 && idle != 0;
+
+            pd.overloaded_samples_ = overloaded ? pd.overloaded_samples_ + 1 : 0;
+            pd.idle_samples_ = underloaded ? pd.idle_samples_ + 1 : 0;
+        }
+    }
+
+    void elastic_pool_policy::evaluate()
+    {
+        // reclaim lent processing units as soon as their owner has work,
+        // unless the borrower would drop below its minimal number of cores
+        for (pu_data& pu : pus_)
+        {
+            if (pu.holder_ != pu.owner_ && pools_[pu.owner_].pending_ != 0 &&
+                pools_[pu.holder_].active_cores_ >
+                    pools_[pu.holder_].params_.min_cores)
+            {
+                move_pu(pu, pu.owner_);
+            }
+        }
+
+        // lend at most one processing unit to each overloaded pool per sample
+        for (std::size_t to = 0; to != pools_.size(); ++to)
+        {
+            pool_data& borrower = pools_[to];
+            if (borrower.overloaded_samples_ < hysteresis_ ||
+                borrower.active_cores_ >= borrower.params_.max_cores)
+            {
+                continue;
+            }
+
+            for (pu_data& pu : pus_)
+            {
+                if (pu.holder_ == to || !pu.is_member(to))
+                    continue;
+
+                pool_data& lender = pools_[pu.holder_];
+                if (lender.idle_samples_ < hysteresis_ ||
+                    lender.active_cores_ <= lender.params_.min_cores)
+                {
+                    continue;
+                }
+
+                if (move_pu(pu, to))
+                {
+                    borrower.overloaded_samples_ = 0;
+                    lender.idle_samples_ = 0;
+                    break;
+                }
+            }
+        }
+    }
+
+    bool elastic_pool_policy::move_pu(pu_data& pu, std::size_t to)
+    {
+        std::size_t const from = pu.holder_;
+        HPX_ASSERT(from != to);
+
+        // suspending blocks the monitor thread until the processing unit has
+        // stopped running work of its current pool (this is the case for
+        // reclaiming as well), resuming it in the target pool makes it pick
+        // up work there
+        error_code ec(lightweight);
+        pools_[from].pool_->suspend_processing_unit_direct(
+            pu.virt_core(from), ec);
+        if (ec)
+            return false;
+
+        pools_[to].pool_->resume_processing_unit_direct(pu.virt_core(to), ec);
+        if (ec)
+        {
+            // undo the suspension, the processing unit stays where it was
+            pools_[from].pool_->resume_processing_unit_direct(
+                pu.virt_core(from), ec);
+            return false;
+        }
+
+        pu.holder_ = to;
+        --pools_[from].active_cores_;
+        ++pools_[to].active_cores_;
+        num_cores_[from].store(pools_[from].active_cores_);
+        num_cores_[to].store(pools_[to].active_cores_);
+
+        ++move_count_;
+        ++detail::elastic_core_moves;
+
+        LTM_(info) << "elastic_pool_policy: moved pu#" << pu.pu_num_
+                   << " from pool '" << pools_[from].pool_->get_pool_name()
+                   << "' to pool '" << pools_[to].pool_->get_pool_name()
+                   << "'";
+
+        return true;
+    }
+}}    // namespace hpx::threads
@@ -18,6 +18,7 @@
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/runtime_local/thread_pool_helpers.hpp>
 #include <hpx/modules/threadmanager.hpp>
+#include <hpx/runtime/threads/elastic_pool_policy.hpp>
 #include <hpx/runtime/threads/threadmanager_counters.hpp>
 #include <hpx/schedulers/maintain_queue_wait_times.hpp>
 
@@ -828,6 +829,14 @@ namespace hpx { namespace threads {
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types) / sizeof(counter_types[0]));
+
+        // processing units moved between pools by elastic pool policies
+        performance_counters::install_counter_type(
+            "/threads/count/elastic-core-moves",
+            &get_elastic_core_move_count,
+            "returns the overall number of processing units moved between "
+            "thread pools by elastic pool policies on this locality",
+            "", performance_counters::counter_monotonically_increasing);
     }
 }    // namespace threads
 }    // namespace hpx
@@ -7,6 +7,7 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 #include <hpx/assert.hpp>
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/async_distributed/applier/applier.hpp>
@@ -19,6 +20,9 @@
 #include <hpx/datastructures/tuple.hpp>
 #include <hpx/execution_base/this_thread.hpp>
 #include <hpx/itt_notify/thread_name.hpp>
+#if defined(HPX_HAVE_LOGGING)
+#include <hpx/logging/async_logging.hpp>
+#endif
 #include <hpx/modules/errors.hpp>
 #include <hpx/modules/functional.hpp>
 #include <hpx/modules/logging.hpp>
@@ -61,6 +65,7 @@
 #include <hpx/threading_base/external_timer.hpp>
 #include <hpx/timing/high_resolution_clock.hpp>
 #include <hpx/util/from_string.hpp>
+#include <hpx/util/one_size_heap_list.hpp>
 #include <hpx/util/query_counters.hpp>
 #include <hpx/version.hpp>
 
@@ -115,6 +120,10 @@ namespace hpx {
         lbt_ << "(2nd stage) pre_main: registered thread-manager performance "
                 "counter types";
 
+        util::one_size_heap_list::register_counter_types();
+        lbt_ << "(2nd stage) pre_main: registered component heap performance "
+                "counter types";
+
 #if defined(HPX_HAVE_NETWORKING)
         applier::get_applier().get_parcel_handler().register_counter_types();
         lbt_ << "(2nd stage) pre_main: registered parcelset performance "
@@ -768,6 +777,11 @@ namespace hpx {
 #endif
 #ifdef HPX_HAVE_IO_POOL
         io_pool_.stop();    // stops io_pool_ as well
+#endif
+#if defined(HPX_HAVE_LOGGING)
+        // write all pending log messages, anything logged from now on is
+        // written synchronously
+        util::logging::stop_async_logging();
 #endif
         // deinit_tss();
     }
@@ -1061,6 +1075,42 @@ namespace hpx {
         return id_pool_;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+        static std::int64_t get_allocator_cache_allocations(bool reset)
+        {
+            return util::get_allocator_cache_statistics(reset).allocations;
+        }
+
+        static std::int64_t get_allocator_cache_hits(bool reset)
+        {
+            return util::get_allocator_cache_statistics(reset).cache_hits;
+        }
+
+        static std::int64_t get_allocator_cache_uncached(bool reset)
+        {
+            return util::get_allocator_cache_statistics(reset).uncached;
+        }
+
+        // hit rate in 0.01%
+        static std::int64_t get_allocator_cache_hit_rate(bool reset)
+        {
+            util::allocator_cache_statistics stats =
+                util::get_allocator_cache_statistics(reset);
+            if (stats.allocations == 0)
+                return 0;
+            return (stats.cache_hits * 10000) / stats.allocations;
+        }
+
+#if defined(HPX_HAVE_LOGGING)
+        static std::int64_t get_async_logging_dropped(bool reset)
+        {
+            return static_cast<std::int64_t>(
+                util::logging::get_async_logging_dropped(reset));
+        }
+#endif
+    }    // namespace detail
+
     /// \brief Register all performance counter types related to this runtime
     ///        instance
     void runtime_distributed::register_counter_types()
@@ -1344,6 +1394,48 @@ namespace hpx {
         performance_counters::install_counter_types(arithmetic_counter_types,
             sizeof(arithmetic_counter_types) /
                 sizeof(arithmetic_counter_types[0]));
+
+        // per-thread allocator caches for shared states, task objects and
+        // dataflow frames
+        performance_counters::install_counter_type(
+            "/runtime/count/allocator-cache/allocations",
+            &detail::get_allocator_cache_allocations,
+            "returns the overall number of allocations of shared states, "
+            "task objects and dataflow frames which were eligible for being "
+            "served from the per-thread allocator caches",
+            "", performance_counters::counter_monotonically_increasing);
+
+        performance_counters::install_counter_type(
+            "/runtime/count/allocator-cache/cache-hits",
+            &detail::get_allocator_cache_hits,
+            "returns the number of allocations which were served from the "
+            "per-thread allocator caches without calling into the memory "
+            "allocator",
+            "", performance_counters::counter_monotonically_increasing);
+
+        performance_counters::install_counter_type(
+            "/runtime/count/allocator-cache/uncached",
+            &detail::get_allocator_cache_uncached,
+            "returns the number of allocations which bypassed the per-thread "
+            "allocator caches (because they were too large or the caches were "
+            "switched off) and were forwarded to the memory allocator",
+            "", performance_counters::counter_monotonically_increasing);
+
+        performance_counters::install_counter_type(
+            "/runtime/allocator-cache/hit-rate",
+            &detail::get_allocator_cache_hit_rate,
+            "returns the ratio of allocations which were served from the "
+            "per-thread allocator caches",
+            "0.01%", performance_counters::counter_raw);
+
+#if defined(HPX_HAVE_LOGGING)
+        performance_counters::install_counter_type(
+            "/runtime/count/logging/dropped-messages",
+            &detail::get_async_logging_dropped,
+            "returns the number of log messages which were dropped as the "
+            "buffers of the asynchronous logging backend were full",
+            "", performance_counters::counter_monotonically_increasing);
+#endif
     }
 
     ///////////////////////////////////////////////////////////////////////////
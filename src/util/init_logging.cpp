@@ -8,7 +8,9 @@
 #include <hpx/config.hpp>
 
 #if defined(HPX_HAVE_LOGGING)
+#include <hpx/modules/format.hpp>
 #include <hpx/modules/logging.hpp>
+#include <hpx/logging/async_logging.hpp>
 #include <hpx/logging/format/named_write.hpp>
 #include <hpx/logging/manipulator.hpp>
 #include <hpx/modules/naming_base.hpp>
@@ -32,6 +34,7 @@
 #include <cstdlib>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #if defined(ANDROID) || defined(__ANDROID__)
@@ -47,55 +50,103 @@
 namespace hpx { namespace util {
     typedef logging::writer::named_write logger_writer_type;
 
+    namespace detail {
+        // the format strings used by the custom formatters are parsed at
+        // compile time
+        constexpr auto log_format_hex4 = HPX_FORMAT_STRING("{:04x}");
+        constexpr auto log_format_hex8 = HPX_FORMAT_STRING("{:08x}");
+        constexpr auto log_format_hex16 = HPX_FORMAT_STRING("{:016x}");
+    }    // namespace detail
+
     ///////////////////////////////////////////////////////////////////////////
-    // custom formatter: shepherd
-    struct shepherd_thread_id : logging::formatter::manipulator
+    // All custom formatters capture their context on the logging thread as a
+    // single value, which allows for formatting the message asynchronously.
+    using log_format_hex_type =
+        std::decay<decltype(detail::log_format_hex16)>::type;
+
+    struct captured_hex_formatter : logging::formatter::manipulator
     {
-        shepherd_thread_id() {}
+        captured_hex_formatter(log_format_hex_type const& format,
+            std::size_t width, std::uint64_t invalid_value)
+          : format_(format)
+          , width_(width)
+          , invalid_value_(invalid_value)
+        {
+        }
 
         void operator()(std::ostream& to) const override
         {
-            error_code ec(lightweight);
-            std::size_t thread_num = hpx::get_worker_thread_num(ec);
+            format_captured(to, capture());
+        }
+
+        bool can_capture() const noexcept override
+        {
+            return true;
+        }
 
-            if (std::size_t(-1) != thread_num)
+        void format_captured(
+            std::ostream& to, std::uint64_t value) const override
+        {
+            if (invalid_value_ != value)
             {
-                util::format_to(to, "{:016x}", thread_num);
+                util::format_to(to, format_, value);
             }
             else
             {
-                to << std::string(16, '-');
+                // called from outside a HPX thread or no value given
+                to << std::string(width_, '-');
             }
         }
+
+    protected:
+        log_format_hex_type const& format_;
+        std::size_t width_;
+        std::uint64_t invalid_value_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
-    // custom formatter: locality prefix
-    struct locality_prefix : logging::formatter::manipulator
+    // custom formatter: shepherd
+    struct shepherd_thread_id : captured_hex_formatter
     {
-        locality_prefix() {}
+        shepherd_thread_id()
+          : captured_hex_formatter(
+                detail::log_format_hex16, 16, std::size_t(-1))
+        {
+        }
 
-        void operator()(std::ostream& to) const override
+        std::uint64_t capture() const override
         {
-            std::uint32_t locality_id = hpx::get_locality_id();
+            error_code ec(lightweight);
+            return hpx::get_worker_thread_num(ec);
+        }
+    };
 
-            if (naming::invalid_locality_id != locality_id)
-            {
-                util::format_to(to, "{:08x}", locality_id);
-            }
-            else
-            {
-                // called from outside a HPX thread
-                to << std::string(8, '-');
-            }
+    ///////////////////////////////////////////////////////////////////////////
+    // custom formatter: locality prefix
+    struct locality_prefix : captured_hex_formatter
+    {
+        locality_prefix()
+          : captured_hex_formatter(
+                detail::log_format_hex8, 8, naming::invalid_locality_id)
+        {
+        }
+
+        std::uint64_t capture() const override
+        {
+            return hpx::get_locality_id();
         }
     };
 
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: HPX thread id
-    struct thread_id : logging::formatter::manipulator
+    struct thread_id : captured_hex_formatter
     {
-        void operator()(std::ostream& to) const override
+        thread_id()
+          : captured_hex_formatter(detail::log_format_hex16, 16, 0)
+        {
+        }
+
+        std::uint64_t capture() const override
         {
             threads::thread_self* self = threads::get_self_ptr();
             if (nullptr != self)
@@ -104,121 +155,104 @@ namespace hpx { namespace util {
                 threads::thread_id_type id = threads::get_self_id();
                 if (id != threads::invalid_thread_id)
                 {
-                    std::ptrdiff_t value =
-                        reinterpret_cast<std::ptrdiff_t>(id.get());
-                    util::format_to(to, "{:016x}", value);
-                    return;
+                    return reinterpret_cast<std::uintptr_t>(id.get());
                 }
             }
 
             // called from outside a HPX thread or invalid thread id
-            to << std::string(16, '-');
+            return invalid_value_;
         }
     };
 
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: HPX thread phase
-    struct thread_phase : logging::formatter::manipulator
+    struct thread_phase : captured_hex_formatter
     {
-        void operator()(std::ostream& to) const override
+        thread_phase()
+          : captured_hex_formatter(detail::log_format_hex4, 4, 0)
+        {
+        }
+
+        std::uint64_t capture() const override
         {
             threads::thread_self* self = threads::get_self_ptr();
             if (nullptr != self)
             {
                 // called from inside a HPX thread
-                std::size_t phase = self->get_thread_phase();
-                if (0 != phase)
-                {
-                    util::format_to(to, "{:04x}", self->get_thread_phase());
-                    return;
-                }
+                return self->get_thread_phase();
             }
 
-            // called from outside a HPX thread or no phase given
-            to << std::string(4, '-');
+            // called from outside a HPX thread
+            return invalid_value_;
         }
     };
 
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: locality prefix of parent thread
-    struct parent_thread_locality : logging::formatter::manipulator
+    struct parent_thread_locality : captured_hex_formatter
     {
-        void operator()(std::ostream& to) const override
+        parent_thread_locality()
+          : captured_hex_formatter(
+                detail::log_format_hex8, 8, naming::invalid_locality_id)
         {
-            std::uint32_t parent_locality_id =
-                threads::get_parent_locality_id();
-            if (naming::invalid_locality_id != parent_locality_id)
-            {
-                // called from inside a HPX thread
-                util::format_to(to, "{:08x}", parent_locality_id);
-            }
-            else
-            {
-                // called from outside a HPX thread
-                to << std::string(8, '-');
-            }
+        }
+
+        std::uint64_t capture() const override
+        {
+            return threads::get_parent_locality_id();
         }
     };
 
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: HPX parent thread id
-    struct parent_thread_id : logging::formatter::manipulator
+    struct parent_thread_id : captured_hex_formatter
     {
-        void operator()(std::ostream& to) const override
+        parent_thread_id()
+          : captured_hex_formatter(detail::log_format_hex16, 16, 0)
+        {
+        }
+
+        std::uint64_t capture() const override
         {
             threads::thread_id_type parent_id = threads::get_parent_id();
             if (nullptr != parent_id && threads::invalid_thread_id != parent_id)
             {
                 // called from inside a HPX thread
-                std::ptrdiff_t value =
-                    reinterpret_cast<std::ptrdiff_t>(parent_id.get());
-                util::format_to(to, "{:016x}", value);
-            }
-            else
-            {
-                // called from outside a HPX thread
-                to << std::string(16, '-');
+                return reinterpret_cast<std::uintptr_t>(parent_id.get());
             }
+
+            // called from outside a HPX thread
+            return invalid_value_;
         }
     };
 
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: HPX parent thread phase
-    struct parent_thread_phase : logging::formatter::manipulator
+    struct parent_thread_phase : captured_hex_formatter
     {
-        void operator()(std::ostream& to) const override
+        parent_thread_phase()
+          : captured_hex_formatter(detail::log_format_hex4, 4, 0)
         {
-            std::size_t parent_phase = threads::get_parent_phase();
-            if (0 != parent_phase)
-            {
-                // called from inside a HPX thread
-                util::format_to(to, "{:04x}", parent_phase);
-            }
-            else
-            {
-                // called from outside a HPX thread
-                to << std::string(4, '-');
-            }
+        }
+
+        std::uint64_t capture() const override
+        {
+            return threads::get_parent_phase();
         }
     };
 
     ///////////////////////////////////////////////////////////////////////////
     // custom formatter: HPX component id of current thread
-    struct thread_component_id : logging::formatter::manipulator
+    struct thread_component_id : captured_hex_formatter
     {
-        void operator()(std::ostream& to) const override
+        thread_component_id()
+          : captured_hex_formatter(detail::log_format_hex16, 16, 0)
         {
-            std::uint64_t component_id = threads::get_self_component_id();
-            if (0 != component_id)
-            {
-                // called from inside a HPX thread
-                util::format_to(to, "{:016x}", component_id);
-            }
-            else
-            {
-                // called from outside a HPX thread
-                to << std::string(16, '-');
-            }
+        }
+
+        std::uint64_t capture() const override
+        {
+            return threads::get_self_component_id();
         }
     };
 
@@ -906,6 +940,15 @@ namespace hpx { namespace util { namespace detail
     ///////////////////////////////////////////////////////////////////////////
     void init_logging(runtime_configuration& ini, bool isconsole)
     {
+        // messages are formatted and written to the destinations by a
+        // background thread
+        if (util::get_entry_as<int>(ini, "hpx.logging.async", 0) != 0)
+        {
+            logging::start_async_logging(util::get_entry_as<std::size_t>(ini,
+                "hpx.logging.async_buffer_size",
+                HPX_LOGGING_ASYNC_BUFFER_SIZE_DEFAULT));
+        }
+
         // initialize normal logs
         init_agas_log(ini, isconsole);
         init_parcel_log(ini, isconsole);
@@ -1,4 +1,4 @@
-//  Copyright (c) 1998-2017 Hartmut Kaiser
+//  Copyright (c) 1998-2020 Hartmut Kaiser
 //  Copyright (c)      2011 Bryce Lelbach
 //
 //  SPDX-License-Identifier: BSL-1.0
@@ -15,53 +15,299 @@
 #if defined(HPX_DEBUG)
 #include <hpx/modules/logging.hpp>
 #endif
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/resource_partitioner/detail/partitioner.hpp>
 #include <hpx/threading_base/register_thread.hpp>
+#include <hpx/threading_base/thread_num_tss.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
+#include <hpx/topology/topology.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/util/wrapper_heap_base.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace hpx { namespace util
 {
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // All existing heap lists, this is used for collecting the statistics
+        // exposed through the performance counters.
+        struct heap_list_registry
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            heap_list_registry()
+              : retired_{0, 0, 0, 0}
+            {
+            }
+
+            mutex_type mtx_;
+            std::vector<one_size_heap_list const*> lists_;
+
+            // statistics of heap lists which were already destroyed
+            one_size_heap_list::statistics retired_;
+        };
+
+        static heap_list_registry& get_heap_list_registry()
+        {
+            static heap_list_registry registry;
+            return registry;
+        }
+
+        static std::int64_t get_counter_value(std::atomic<std::int64_t>& value,
+            bool reset)
+        {
+            if (reset)
+                return value.exchange(0, std::memory_order_relaxed);
+            return value.load(std::memory_order_relaxed);
+        }
+
+        static std::int64_t get_counter_value(std::int64_t& value, bool reset)
+        {
+            std::int64_t result = value;
+            if (reset)
+                value = 0;
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void one_size_heap_list::initialize()
+    {
+        // one slot per core, the additional slot is shared by all threads
+        // which are not HPX worker threads
+        num_workers_ = hpx::threads::hardware_concurrency();
+        worker_data_.reset(new cached_worker_data[num_workers_ + 1]);
+
+        auto& registry = detail::get_heap_list_registry();
+
+        std::lock_guard<detail::heap_list_registry::mutex_type> l(
+            registry.mtx_);
+        registry.lists_.push_back(this);
+    }
+
     one_size_heap_list::~one_size_heap_list() noexcept
     {
+        if (!worker_data_)
+            return;
+
+        statistics stats = {0, 0, 0, 0};
+        accumulate_statistics(stats, false);
+
 #if defined(HPX_DEBUG)
         LOSH_(info) << hpx::util::format(
-            "{1}::~{1}: size({2}), max_count({3}), alloc_count({4}), "
-            "free_count({5})",
+            "{1}::~{1}: size({2}), alloc_count({3}), free_count({4})",
             name(),
             heap_count_,
-            max_alloc_count_,
-            alloc_count_,
-            free_count_);
+            stats.alloc_count,
+            stats.free_count);
 
-        if (alloc_count_ > free_count_)
+        if (stats.alloc_count > stats.free_count)
         {
             LOSH_(warning) << hpx::util::format(
                 "{1}::~{1}: releasing with {2} allocated objects",
                 name(),
-                alloc_count_ - free_count_);
+                stats.alloc_count - stats.free_count);
         }
 #endif
+
+        auto& registry = detail::get_heap_list_registry();
+
+        std::lock_guard<detail::heap_list_registry::mutex_type> l(
+            registry.mtx_);
+
+        auto it = std::find(registry.lists_.begin(), registry.lists_.end(),
+            this);
+        if (it != registry.lists_.end())
+            registry.lists_.erase(it);
+
+        registry.retired_.alloc_count += stats.alloc_count;
+        registry.retired_.free_count += stats.free_count;
+        registry.retired_.cache_hits += stats.cache_hits;
+        registry.retired_.contention_count += stats.contention_count;
     }
 
-    void* one_size_heap_list::alloc(std::size_t count)
+    ///////////////////////////////////////////////////////////////////////////
+    one_size_heap_list::cached_worker_data*
+    one_size_heap_list::get_worker_data() const
+    {
+        if (!worker_data_)
+            return nullptr;
+
+        std::size_t num_thread = hpx::get_worker_thread_num();
+        if (num_thread == std::size_t(-1))
+            return &worker_data_[num_workers_];
+
+        return &worker_data_[num_thread % num_workers_];
+    }
+
+    std::size_t one_size_heap_list::get_numa_domain(cached_worker_data& data)
+    {
+        std::size_t domain = data.numa_domain_.load(std::memory_order_relaxed);
+        if (domain == std::size_t(-1))
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread == std::size_t(-1))
+                return domain;
+
+            std::size_t pu_num =
+                resource::get_partitioner().get_pu_num(num_thread);
+            domain = threads::create_topology().get_numa_node_number(pu_num);
+
+            data.numa_domain_.store(domain, std::memory_order_relaxed);
+        }
+        return domain;
+    }
+
+    void* one_size_heap_list::try_alloc_cached(
+        cached_worker_data& data, std::size_t count)
     {
-        unique_lock_type guard(mtx_);
+        void* p = nullptr;
+
+        // try the heap this worker has allocated from last
+        util::wrapper_heap_base* heap =
+            data.heap_.load(std::memory_order_acquire);
+        if (heap != nullptr && heap->alloc(&p, count))
+        {
+            ++data.cache_hits_;
+            data.alloc_count_ += count;
+            return p;
+        }
 
+        // try the heaps used by other workers on the same NUMA domain
+        if (&data == &worker_data_[num_workers_])
+            return nullptr;
+
+        std::size_t const domain = get_numa_domain(data);
+        if (domain == std::size_t(-1))
+            return nullptr;
+
+        for (std::size_t i = 0; i != num_workers_; ++i)
+        {
+            cached_worker_data& other = worker_data_[i];
+            if (&other == &data ||
+                other.numa_domain_.load(std::memory_order_relaxed) != domain)
+            {
+                continue;
+            }
+
+            util::wrapper_heap_base* other_heap =
+                other.heap_.load(std::memory_order_acquire);
+            if (other_heap != nullptr && other_heap != heap &&
+                other_heap->alloc(&p, count))
+            {
+                data.heap_.store(other_heap, std::memory_order_release);
+
+                ++data.cache_hits_;
+                data.alloc_count_ += count;
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    bool one_size_heap_list::try_free_cached(
+        cached_worker_data& data, void* p, std::size_t count)
+    {
+        util::wrapper_heap_base* heap =
+            data.heap_.load(std::memory_order_acquire);
+        if (heap != nullptr && heap->did_alloc(p))
+        {
+            heap->free(p, count);
+            data.free_count_ += count;
+            return true;
+        }
+        return false;
+    }
+
+    util::wrapper_heap_base* one_size_heap_list::get_cached_heap(void* p) const
+    {
+        cached_worker_data* data = get_worker_data();
+        if (data == nullptr)
+            return nullptr;
+
+        util::wrapper_heap_base* heap =
+            data->heap_.load(std::memory_order_acquire);
+        if (heap != nullptr && heap->did_alloc(p))
+            return heap;
+
+        return nullptr;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void one_size_heap_list::accumulate_statistics(
+        statistics& stats, bool reset) const
+    {
+        for (std::size_t i = 0; i != num_workers_ + 1; ++i)
+        {
+            cached_worker_data& data = worker_data_[i];
+            stats.alloc_count +=
+                detail::get_counter_value(data.alloc_count_, reset);
+            stats.free_count +=
+                detail::get_counter_value(data.free_count_, reset);
+            stats.cache_hits +=
+                detail::get_counter_value(data.cache_hits_, reset);
+            stats.contention_count +=
+                detail::get_counter_value(data.contention_count_, reset);
+        }
+    }
+
+    one_size_heap_list::statistics one_size_heap_list::get_statistics(
+        bool reset)
+    {
+        auto& registry = detail::get_heap_list_registry();
+
+        std::lock_guard<detail::heap_list_registry::mutex_type> l(
+            registry.mtx_);
+
+        statistics stats = {
+            detail::get_counter_value(registry.retired_.alloc_count, reset),
+            detail::get_counter_value(registry.retired_.free_count, reset),
+            detail::get_counter_value(registry.retired_.cache_hits, reset),
+            detail::get_counter_value(
+                registry.retired_.contention_count, reset)};
+
+        for (one_size_heap_list const* list : registry.lists_)
+        {
+            list->accumulate_statistics(stats, reset);
+        }
+        return stats;
+    }
+
+    void* one_size_heap_list::alloc(std::size_t count)
+    {
         if (HPX_UNLIKELY(0 == count))
         {
-            guard.unlock();
             HPX_THROW_EXCEPTION(bad_parameter,
                 name() + "::alloc",
                 "cannot allocate 0 objects");
         }
 
+        // try to allocate without touching the list of heaps first
+        cached_worker_data* data = get_worker_data();
+        HPX_ASSERT(data != nullptr);
+
+        if (void* p = try_alloc_cached(*data, count))
+        {
+            return p;
+        }
+
+        unique_lock_type guard(mtx_, std::try_to_lock);
+        if (!guard.owns_lock())
+        {
+            ++data->contention_count_;
+            guard.lock();
+        }
+
         //std::size_t size = 0;
         void* p = nullptr;
         {
@@ -79,12 +325,9 @@ namespace hpx { namespace util
 
                     if (allocated)
                     {
-#if defined(HPX_DEBUG)
                         // Allocation succeeded, update statistics.
-                        alloc_count_ += count;
-                        if (alloc_count_ - free_count_ > max_alloc_count_)
-                            max_alloc_count_ = alloc_count_- free_count_;
-#endif
+                        data->heap_.store(heap.get(), std::memory_order_release);
+                        data->alloc_count_ += count;
                         return p;
                     }
 
@@ -133,8 +376,10 @@ namespace hpx { namespace util
                         count));
             }
 
+            data->heap_.store(heap.get(), std::memory_order_release);
+            data->alloc_count_ += count;
+
 #if defined(HPX_DEBUG)
-            alloc_count_ += count;
             ++heap_count_;
 
             LOSH_(info) << hpx::util::format(
@@ -171,8 +416,6 @@ namespace hpx { namespace util
 
     void one_size_heap_list::free(void* p, std::size_t count)
     {
-        unique_lock_type ul(mtx_);
-
         if (nullptr == p || !threads::threadmanager_is(state_running))
             return;
 
@@ -181,6 +424,20 @@ namespace hpx { namespace util
         if (reschedule(p, count))
             return;
 
+        // most objects are freed on the worker they were allocated on
+        cached_worker_data* data = get_worker_data();
+        HPX_ASSERT(data != nullptr);
+
+        if (try_free_cached(*data, p, count))
+            return;
+
+        unique_lock_type ul(mtx_, std::try_to_lock);
+        if (!ul.owns_lock())
+        {
+            ++data->contention_count_;
+            ul.lock();
+        }
+
         // Find the heap which allocated this pointer.
         for (auto & heap : heap_list_)
         {
@@ -195,9 +452,7 @@ namespace hpx { namespace util
 
             if (did_allocate)
             {
-#if defined(HPX_DEBUG)
-                free_count_ += count;
-#endif
+                data->free_count_ += count;
                 return;
             }
         }
@@ -213,6 +468,9 @@ namespace hpx { namespace util
 
     bool one_size_heap_list::did_alloc(void* p) const
     {
+        if (get_cached_heap(p) != nullptr)
+            return true;
+
         unique_lock_type ul(mtx_);
         for (typename list_type::value_type const& heap : heap_list_)
         {
@@ -235,4 +493,60 @@ namespace hpx { namespace util
             return std::string("one_size_heap_list(unknown)");
         return std::string("one_size_heap_list(") + class_name_ + ")";
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::int64_t get_heap_alloc_count(bool reset)
+        {
+            return one_size_heap_list::get_statistics(reset).alloc_count;
+        }
+
+        static std::int64_t get_heap_free_count(bool reset)
+        {
+            return one_size_heap_list::get_statistics(reset).free_count;
+        }
+
+        static std::int64_t get_heap_cache_hits(bool reset)
+        {
+            return one_size_heap_list::get_statistics(reset).cache_hits;
+        }
+
+        static std::int64_t get_heap_contention_count(bool reset)
+        {
+            return one_size_heap_list::get_statistics(reset).contention_count;
+        }
+    }
+
+    void one_size_heap_list::register_counter_types()
+    {
+        performance_counters::install_counter_type(
+            "/runtime/count/component-heap/allocations",
+            &detail::get_heap_alloc_count,
+            "returns the overall number of objects allocated from the "
+            "component heaps on this locality",
+            "", performance_counters::counter_monotonically_increasing);
+
+        performance_counters::install_counter_type(
+            "/runtime/count/component-heap/deallocations",
+            &detail::get_heap_free_count,
+            "returns the overall number of objects freed back to the "
+            "component heaps on this locality",
+            "", performance_counters::counter_monotonically_increasing);
+
+        performance_counters::install_counter_type(
+            "/runtime/count/component-heap/cache-hits",
+            &detail::get_heap_cache_hits,
+            "returns the number of component heap allocations which were "
+            "served from a per-worker cached heap without acquiring the "
+            "heap list lock",
+            "", performance_counters::counter_monotonically_increasing);
+
+        performance_counters::install_counter_type(
+            "/runtime/count/component-heap/contentions",
+            &detail::get_heap_contention_count,
+            "returns the number of times the lock protecting a list of "
+            "component heaps was found to be held by another thread",
+            "", performance_counters::counter_monotonically_increasing);
+    }
 }}
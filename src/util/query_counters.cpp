@@ -6,6 +6,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/assert.hpp>
+#include <hpx/modules/filesystem.hpp>
 #include <hpx/modules/format.hpp>
 #include <hpx/functional/bind_front.hpp>
 #include <hpx/async_combinators/wait_all.hpp>
@@ -23,18 +24,29 @@
 #include <hpx/threading_base/external_timer.hpp>
 #include <hpx/util/query_counters.hpp>
 
+#include <cerrno>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#if !defined(HPX_WINDOWS)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
-#include <map>
 #include <ittnotify.h>
 #endif
 
@@ -53,7 +65,8 @@ namespace hpx { namespace util
         counter_types_(counter_types),
         timer_(util::bind_front(&query_counters::evaluate, this_(), false),
             util::bind_front(&query_counters::terminate, this_()),
-            interval*1000, "query_counters", true)
+            interval*1000, "query_counters", true),
+        batch_size_(1)
     {
         // add counter prefix, if necessary
         for (std::string& name : names_)
@@ -99,13 +112,44 @@ namespace hpx { namespace util
 #endif
     }
 
+    namespace openmetrics {
+        std::string get_locality_destination(
+            std::string const& destination, std::uint32_t locality_id);
+    }
+
     void query_counters::start()
     {
-        if (print_counters_locally_ && destination_ != "cout")
-            destination_ += "." + std::to_string(hpx::get_locality_id());
+        if (print_counters_locally_ && destination_ != "cout" &&
+            destination_ != "none")
+        {
+            if (format_ == "openmetrics")
+            {
+                destination_ = openmetrics::get_locality_destination(
+                    destination_, hpx::get_locality_id());
+            }
+            else
+            {
+                destination_ += "." + std::to_string(hpx::get_locality_id());
+            }
+        }
 
         find_counters();
 
+        if (format_ == "openmetrics")
+        {
+            std::size_t batch_size = 1;
+            try
+            {
+                batch_size = std::stoul(
+                    get_config_entry("hpx.print_counter.batch_size", "1"));
+            }
+            catch (std::exception const&)
+            {
+                // ignore invalid values, write every sample right away
+            }
+            batch_size_ = batch_size != 0 ? batch_size : 1;
+        }
+
         counters_.start(launch::sync);
 
         // this will invoke the evaluate function for the first time
@@ -116,6 +160,10 @@ namespace hpx { namespace util
     {
         timer_.stop(terminate);
         counters_.stop(launch::sync);
+
+        // make sure no buffered samples are lost
+        if (format_ == "openmetrics")
+            flush_openmetrics();
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -133,6 +181,10 @@ namespace hpx { namespace util
             "histogram",
             "values",
         };
+
+        // elapsed times and timestamps are given in seconds
+        constexpr auto elapsed_time_format = HPX_FORMAT_STRING("{:.6}");
+        constexpr auto timestamp_format = HPX_FORMAT_STRING("{:.3f}");
     }
 
     char const* get_counter_short_type_name(
@@ -188,7 +240,7 @@ namespace hpx { namespace util
             *out  << "," << value.count_ << ",";
 
             double elapsed = static_cast<double>(value.time_) * 1e-9;
-            *out << hpx::util::format("{:.6}", elapsed)
+            hpx::util::format_to(*out, strings::elapsed_time_format, elapsed)
                 << ",[s]," << val;
             if (!uom.empty())
                 *out << ",[" << uom << "]";
@@ -224,7 +276,8 @@ namespace hpx { namespace util
         *out << "," << value.count_ << ",";
 
         double elapsed = static_cast<double>(value.time_) * 1e-9;
-        *out << hpx::util::format("{:.6}", elapsed) << ",[s],";
+        hpx::util::format_to(*out, strings::elapsed_time_format, elapsed)
+            << ",[s],";
 
         bool first = true;
         for (std::int64_t val : value.values_)
@@ -639,6 +692,18 @@ namespace hpx { namespace util
         std::vector<performance_counters::counter_info> infos =
             counters_.get_counter_infos();
 
+        if (format_ == "openmetrics")
+        {
+            result = sample_openmetrics_counters(
+                destination_is_cout, reset, no_output, force, infos, ec);
+            if (ec) return false;
+
+            if (&ec != &throws)
+                ec = make_success_code();
+
+            return result;
+        }
+
         result = print_raw_counters(destination_is_cout, reset, no_output,
             description, infos, ec);
         if (ec) return false;
@@ -652,4 +717,584 @@ namespace hpx { namespace util
 
         return result;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // OpenMetrics text format, see https://openmetrics.io
+    namespace openmetrics {
+
+        bool is_array_counter(performance_counters::counter_type type)
+        {
+            return type == performance_counters::counter_histogram ||
+                type == performance_counters::counter_raw_values;
+        }
+
+        // Return the OpenMetrics type to use for the given counter type,
+        // text counters can't be exposed.
+        char const* get_metric_type(performance_counters::counter_type type)
+        {
+            switch (type)
+            {
+            case performance_counters::counter_monotonically_increasing:
+                return "counter";
+
+            case performance_counters::counter_raw:
+            case performance_counters::counter_average_base:
+            case performance_counters::counter_average_count:
+            case performance_counters::counter_aggregating:
+            case performance_counters::counter_average_timer:
+            case performance_counters::counter_elapsed_time:
+                return "gauge";
+
+            // histogram counters expose the relative frequencies (in
+            // per-mille) of the most recent measurements only
+            case performance_counters::counter_histogram:
+                return "gaugehistogram";
+
+            case performance_counters::counter_raw_values:
+                return "unknown";
+
+            default:
+                break;
+            }
+            return nullptr;
+        }
+
+        // the counter '/threads{...}/count/cumulative' is exposed as the
+        // metric 'hpx_threads_count_cumulative'
+        void append_name(std::string& result, std::string const& name)
+        {
+            for (char c : name)
+            {
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                    (c >= '0' && c <= '9'))
+                {
+                    result += c;
+                }
+                else if (result.back() != '_')
+                {
+                    result += '_';
+                }
+            }
+            if (result.back() == '_')
+                result.pop_back();
+        }
+
+        std::string get_metric_name(
+            performance_counters::counter_path_elements const& p)
+        {
+            std::string result("hpx_");
+            append_name(result, p.objectname_);
+            result += '_';
+            append_name(result, p.countername_);
+            return result;
+        }
+
+        void append_label(std::string& result, char const* label,
+            std::string const& value)
+        {
+            if (!result.empty())
+                result += ',';
+            result += label;
+            result += "=\"";
+            for (char c : value)
+            {
+                if (c == '\\' || c == '"')
+                    result += '\\';
+                if (c == '\n')
+                    result += "\\n";
+                else
+                    result += c;
+            }
+            result += '"';
+        }
+
+        std::string get_instance_name(std::string const& name,
+            std::int64_t index)
+        {
+            if (index < 0)
+                return name;
+            return name + "#" + std::to_string(index);
+        }
+
+        // the label set (without the enclosing braces) identifying a counter
+        // instance inside its metric family
+        std::string get_metric_labels(
+            performance_counters::counter_path_elements const& p)
+        {
+            std::string result;
+            if (p.parentinstancename_ == "locality" &&
+                p.parentinstanceindex_ >= 0)
+            {
+                append_label(result, "locality",
+                    std::to_string(p.parentinstanceindex_));
+            }
+            else if (!p.parentinstancename_.empty())
+            {
+                append_label(result, "parent",
+                    get_instance_name(
+                        p.parentinstancename_, p.parentinstanceindex_));
+            }
+
+            if (!p.instancename_.empty())
+            {
+                std::string instance =
+                    get_instance_name(p.instancename_, p.instanceindex_);
+                if (!p.subinstancename_.empty())
+                {
+                    instance += '/';
+                    instance += get_instance_name(
+                        p.subinstancename_, p.subinstanceindex_);
+                }
+                append_label(result, "instance", instance);
+            }
+
+            if (!p.parameters_.empty())
+                append_label(result, "parameters", p.parameters_);
+
+            return result;
+        }
+
+        void print_labels(std::ostream& out, std::string const& labels,
+            char const* extra_label = nullptr,
+            std::string const& extra_value = std::string())
+        {
+            std::string all_labels(labels);
+            if (extra_label != nullptr)
+                append_label(all_labels, extra_label, extra_value);
+
+            if (!all_labels.empty())
+                out << '{' << all_labels << '}';
+        }
+
+        void print_help(std::ostream& out, std::string const& name,
+            performance_counters::counter_info const& info)
+        {
+            std::string help(info.helptext_);
+            if (!info.unit_of_measure_.empty())
+                help += " [" + info.unit_of_measure_ + "]";
+            if (help.empty())
+                return;
+
+            out << "# HELP " << name << ' ';
+            for (char c : help)
+            {
+                if (c == '\\')
+                    out << "\\\\";
+                else if (c == '\n')
+                    out << "\\n";
+                else
+                    out << c;
+            }
+            out << '\n';
+        }
+
+        // The first three values of a histogram are the lower and upper
+        // boundaries and the number of buckets, followed by the values for
+        // the underflow bucket, the buckets, and the overflow bucket.
+        void print_histogram(std::ostream& out, std::string const& name,
+            std::string const& labels, std::int64_t const* begin,
+            std::int64_t const* end, std::string const& timestamp)
+        {
+            if (end - begin < 3)
+                return;
+
+            std::int64_t const min_boundary = begin[0];
+            std::int64_t const max_boundary = begin[1];
+            std::int64_t const num_buckets = begin[2];
+            if (num_buckets <= 0 || end - begin != num_buckets + 5)
+                return;
+
+            double const bucket_size =
+                double(max_boundary - min_boundary) / double(num_buckets);
+
+            std::int64_t count = 0;
+            for (std::int64_t i = 0; i != num_buckets + 2; ++i)
+            {
+                count += begin[3 + i];
+
+                std::string le("+Inf");
+                if (i <= num_buckets)
+                {
+                    std::ostringstream strm;
+                    strm << double(min_boundary) + double(i) * bucket_size;
+                    le = strm.str();
+                }
+
+                out << name << "_bucket";
+                print_labels(out, labels, "le", le);
+                out << ' ' << count << ' ' << timestamp << '\n';
+            }
+
+            out << name << "_gcount";
+            print_labels(out, labels);
+            out << ' ' << count << ' ' << timestamp << '\n';
+        }
+
+        void print_raw_values(std::ostream& out, std::string const& name,
+            std::string const& labels, std::int64_t const* begin,
+            std::int64_t const* end, std::string const& timestamp)
+        {
+            for (std::int64_t const* it = begin; it != end; ++it)
+            {
+                out << name;
+                print_labels(out, labels, "index", std::to_string(it - begin));
+                out << ' ' << *it << ' ' << timestamp << '\n';
+            }
+        }
+
+        // The locality id is inserted before the extension of the file name
+        // (counters.prom becomes counters.1.prom), which keeps the files
+        // recognizable for tools collecting them by their extension.
+        std::string get_locality_destination(
+            std::string const& destination, std::uint32_t locality_id)
+        {
+            filesystem::path p(destination);
+            std::string name = p.stem().string() + "." +
+                std::to_string(locality_id) + p.extension().string();
+            return (p.parent_path() / name).string();
+        }
+
+#if !defined(HPX_WINDOWS)
+        // Write the data to a named pipe. The pipe is opened without
+        // blocking, the data is dropped if no reader has opened the pipe.
+        bool write_fifo(std::string const& destination,
+            std::string const& data, error_code& ec)
+        {
+            int fd = ::open(destination.c_str(), O_WRONLY | O_NONBLOCK);
+            if (fd < 0)
+            {
+                if (errno == ENXIO)
+                    return true;    // nobody is listening
+
+                HPX_THROWS_IF(ec, filesystem_error,
+                    "openmetrics::write_fifo",
+                    hpx::util::format("could not open {}: {}", destination,
+                        std::strerror(errno)));
+                return false;
+            }
+
+            // a reader is connected, wait for it to consume the data
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+
+            char const* p = data.data();
+            std::size_t size = data.size();
+            while (size != 0)
+            {
+                ssize_t written = ::write(fd, p, size);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    int const error = errno;
+                    ::close(fd);
+
+                    // the reader went away
+                    if (error == EPIPE)
+                        return true;
+
+                    HPX_THROWS_IF(ec, filesystem_error,
+                        "openmetrics::write_fifo",
+                        hpx::util::format("could not write to {}: {}",
+                            destination, std::strerror(error)));
+                    return false;
+                }
+                p += written;
+                size -= std::size_t(written);
+            }
+
+            ::close(fd);
+            return true;
+        }
+#endif
+
+        // Regular files are replaced atomically. Existing files of other
+        // types are written to directly, this allows for named pipes to be
+        // used as the destination.
+        void write_output(std::string const& destination,
+            std::string const& data, error_code& ec)
+        {
+            namespace fs = filesystem;
+
+            fs::error_code fsec;
+            fs::file_status st = fs::status(destination, fsec);
+            if (!fsec && fs::exists(st) && !fs::is_regular_file(st))
+            {
+#if !defined(HPX_WINDOWS)
+                struct stat sb;
+                if (::stat(destination.c_str(), &sb) == 0 &&
+                    S_ISFIFO(sb.st_mode))
+                {
+                    if (write_fifo(destination, data, ec) && &ec != &throws)
+                        ec = make_success_code();
+                    return;
+                }
+#endif
+                std::ofstream out(destination.c_str(), std::ofstream::app);
+                out << data << std::flush;
+                if (!out)
+                {
+                    HPX_THROWS_IF(ec, filesystem_error,
+                        "openmetrics::write_output",
+                        hpx::util::format("could not write to {}",
+                            destination));
+                    return;
+                }
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            // readers never see a partially written exposition
+            std::string const tmpname = destination + ".tmp";
+            {
+                std::ofstream out(tmpname.c_str());
+                out << data << std::flush;
+                if (!out)
+                {
+                    out.close();
+                    fs::remove(tmpname, fsec);
+                    HPX_THROWS_IF(ec, filesystem_error,
+                        "openmetrics::write_output",
+                        hpx::util::format("could not write to {}", tmpname));
+                    return;
+                }
+            }
+
+            fs::rename(tmpname, destination, fsec);
+            if (fsec)
+            {
+                std::string const message = fsec.message();
+                fs::remove(tmpname, fsec);
+                HPX_THROWS_IF(ec, filesystem_error,
+                    "openmetrics::write_output",
+                    hpx::util::format("could not rename {} to {}: {}",
+                        tmpname, destination, message));
+                return;
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+    }    // namespace openmetrics
+
+    bool query_counters::sample_openmetrics_counters(bool destination_is_cout,
+        bool reset, bool no_output, bool flush,
+        std::vector<performance_counters::counter_info> const& infos,
+        error_code& ec)
+    {
+        std::size_t num_arrays = 0;
+        for (auto const& info : infos)
+        {
+            if (openmetrics::is_array_counter(info.type_))
+                ++num_arrays;
+        }
+        std::size_t const num_values = infos.size() - num_arrays;
+
+        // query all values at once
+        std::vector<performance_counters::counter_value> values;
+        if (num_values != 0)
+        {
+            values = counters_.get_counter_values(launch::sync, reset, ec);
+            if (ec)
+                return false;
+            HPX_ASSERT(values.size() == num_values);
+        }
+
+        std::vector<performance_counters::counter_values_array> arrays;
+        if (num_arrays != 0)
+        {
+            arrays =
+                counters_.get_counter_values_array(launch::sync, reset, ec);
+            if (ec)
+                return false;
+            HPX_ASSERT(arrays.size() == num_arrays);
+        }
+
+        if (no_output)
+            return true;
+
+        double const now = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+
+        std::lock_guard<mutex_type> l(mtx_);
+
+        // store the sampled values, defer formatting until the batch is full
+        sample_times_.push_back(now);
+        for (auto const& value : values)
+        {
+            error_code ec2(lightweight);    // do not throw
+            double val = value.get_value<double>(ec2);
+            if (ec2)
+                val = std::numeric_limits<double>::quiet_NaN();
+            sample_values_.push_back(val);
+        }
+        for (auto const& array : arrays)
+        {
+            sample_array_offsets_.push_back(sample_arrays_.size());
+            sample_arrays_.insert(sample_arrays_.end(), array.values_.begin(),
+                array.values_.end());
+        }
+
+        if (flush || sample_times_.size() >= batch_size_)
+        {
+            print_openmetrics(destination_is_cout, infos, ec);
+            if (ec)
+                return false;
+        }
+
+        return true;
+    }
+
+    // write all buffered samples, the caller holds the lock
+    void query_counters::print_openmetrics(bool destination_is_cout,
+        std::vector<performance_counters::counter_info> const& infos,
+        error_code& ec)
+    {
+        using openmetrics::is_array_counter;
+
+        std::size_t const num_samples = sample_times_.size();
+        if (num_samples == 0)
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
+        // group the counters into metric families, each family has to be
+        // written in one piece
+        std::vector<std::string> names(infos.size());
+        std::vector<std::string> labels(infos.size());
+        std::vector<std::size_t> columns(infos.size());
+        std::vector<std::vector<std::size_t>> families;
+        std::map<std::string, std::size_t> family_indices;
+
+        std::size_t num_values = 0;
+        std::size_t num_arrays = 0;
+        for (std::size_t i = 0; i != infos.size(); ++i)
+        {
+            columns[i] = is_array_counter(infos[i].type_) ? num_arrays++ :
+                                                            num_values++;
+
+            performance_counters::counter_path_elements p;
+            error_code ec(lightweight);
+            performance_counters::get_counter_path_elements(
+                infos[i].fullname_, p, ec);
+            if (ec || openmetrics::get_metric_type(infos[i].type_) == nullptr)
+                continue;
+
+            names[i] = openmetrics::get_metric_name(p);
+            labels[i] = openmetrics::get_metric_labels(p);
+
+            auto it = family_indices.find(names[i]);
+            if (it == family_indices.end())
+            {
+                it = family_indices.emplace(names[i], families.size()).first;
+                families.emplace_back();
+            }
+            families[it->second].push_back(i);
+        }
+
+        HPX_ASSERT(sample_values_.size() == num_samples * num_values);
+        HPX_ASSERT(sample_array_offsets_.size() == num_samples * num_arrays);
+
+        // timestamps are given in seconds
+        std::vector<std::string> timestamps;
+        timestamps.reserve(num_samples);
+        for (double t : sample_times_)
+            timestamps.push_back(
+                hpx::util::format(strings::timestamp_format, t));
+
+        std::ostringstream out;
+        out.precision(std::numeric_limits<double>::digits10);
+
+        for (std::vector<std::size_t> const& family : families)
+        {
+            performance_counters::counter_info const& info =
+                infos[family.front()];
+            std::string const& name = names[family.front()];
+
+            out << "# TYPE " << name << ' '
+                << openmetrics::get_metric_type(info.type_) << '\n';
+            openmetrics::print_help(out, name, info);
+
+            char const* suffix = info.type_ ==
+                    performance_counters::counter_monotonically_increasing ?
+                "_total" :
+                "";
+
+            for (std::size_t i : family)
+            {
+                for (std::size_t s = 0; s != num_samples; ++s)
+                {
+                    if (!is_array_counter(infos[i].type_))
+                    {
+                        double const val =
+                            sample_values_[s * num_values + columns[i]];
+                        if (std::isnan(val))
+                            continue;
+
+                        out << name << suffix;
+                        openmetrics::print_labels(out, labels[i]);
+                        out << ' ' << val << ' ' << timestamps[s] << '\n';
+                        continue;
+                    }
+
+                    std::size_t const k = s * num_arrays + columns[i];
+                    std::int64_t const* const data = sample_arrays_.data();
+                    std::int64_t const* const begin =
+                        data + sample_array_offsets_[k];
+                    std::int64_t const* const end =
+                        data + (k + 1 < sample_array_offsets_.size() ?
+                                       sample_array_offsets_[k + 1] :
+                                       sample_arrays_.size());
+
+                    if (infos[i].type_ ==
+                        performance_counters::counter_histogram)
+                    {
+                        openmetrics::print_histogram(
+                            out, name, labels[i], begin, end, timestamps[s]);
+                    }
+                    else
+                    {
+                        openmetrics::print_raw_values(
+                            out, name, labels[i], begin, end, timestamps[s]);
+                    }
+                }
+            }
+        }
+        out << "# EOF\n";
+
+        sample_times_.clear();
+        sample_values_.clear();
+        sample_arrays_.clear();
+        sample_array_offsets_.clear();
+
+        if (destination_is_cout)
+        {
+            std::cout << out.str() << std::flush;
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+        else
+        {
+            openmetrics::write_output(destination_, out.str(), ec);
+        }
+    }
+
+    void query_counters::flush_openmetrics(error_code& ec)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        if (sample_times_.empty() || destination_ == "none")
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
+        print_openmetrics(
+            destination_ == "cout", counters_.get_counter_infos(), ec);
+    }
 }}
@@ -0,0 +1,282 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of the AGAS primary namespace server
+// on the hosting locality. All worker threads concurrently bind, resolve,
+// increment and decrement the credits of, and unbind their own set of gids.
+// The gids are bound in ranges, and instances of a managed component are
+// kept alive during all measurements, which makes the primary namespace hold
+// the (large) gid ranges bound by the component heaps as well.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/runtime/agas/addressing_service.hpp>
+#include <hpx/runtime/agas/server/primary_namespace.hpp>
+
+#include <hpx/modules/program_options.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using hpx::agas::server::primary_namespace;
+
+///////////////////////////////////////////////////////////////////////////////
+struct managed_object
+  : hpx::components::managed_component_base<managed_object>
+{
+};
+
+typedef hpx::components::managed_component<managed_object>
+    managed_object_type;
+HPX_REGISTER_COMPONENT(managed_object_type, agas_stress_managed_object);
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t gids_per_thread = 10000;
+std::uint64_t gids_per_range = 64;
+std::uint64_t resolves_per_gid = 4;
+std::uint64_t components_per_thread = 10000;
+
+///////////////////////////////////////////////////////////////////////////////
+// the gids are bound in ranges of gids_per_range consecutive ids
+std::uint64_t range_count(std::uint64_t i)
+{
+    return (std::min)(gids_per_range, gids_per_thread - i);
+}
+
+void bind_gids(primary_namespace* server, hpx::naming::gid_type const& lower,
+    hpx::naming::gid_type const& locality)
+{
+    hpx::naming::gid_type gid = lower;
+    for (std::uint64_t i = 0; i < gids_per_thread; i += gids_per_range)
+    {
+        std::uint64_t const count = range_count(i);
+        hpx::agas::gva g(locality,
+            hpx::components::component_base_lco_with_value, count,
+            reinterpret_cast<void*>(std::size_t(i + 1)), 1);
+        HPX_TEST(server->bind_gid(g, gid, locality));
+        gid += count;
+    }
+}
+
+void resolve_gids(primary_namespace* server, hpx::naming::gid_type const& lower)
+{
+    for (std::uint64_t j = 0; j != resolves_per_gid; ++j)
+    {
+        hpx::naming::gid_type gid = lower;
+        for (std::uint64_t i = 0; i != gids_per_thread; ++i, ++gid)
+        {
+            // every id resolves to the base of its range
+            primary_namespace::resolved_type r = server->resolve_gid(gid);
+            HPX_TEST(hpx::util::get<0>(r) ==
+                lower + (i - i % gids_per_range));
+        }
+    }
+}
+
+// the objects are allocated from the component heaps, each of which binds a
+// large range of gids
+std::vector<hpx::id_type> create_components()
+{
+    std::vector<hpx::id_type> ids;
+    ids.reserve(components_per_thread);
+
+    for (std::uint64_t i = 0; i != components_per_thread; ++i)
+    {
+        ids.push_back(hpx::new_<managed_object>(hpx::find_here()).get());
+    }
+    return ids;
+}
+
+void incref_decref_gids(
+    primary_namespace* server, hpx::naming::gid_type const& lower)
+{
+    // never drop the credits to zero as this would destroy the (fake)
+    // components
+    hpx::naming::gid_type gid = lower;
+    for (std::uint64_t i = 0; i != gids_per_thread; ++i, ++gid)
+    {
+        server->increment_credit(1, gid, gid);
+
+        std::vector<hpx::util::tuple<std::int64_t, hpx::naming::gid_type,
+            hpx::naming::gid_type>>
+            requests;
+        requests.emplace_back(-1, gid, gid);
+        server->decrement_credit(requests);
+    }
+}
+
+void unbind_gids(primary_namespace* server, hpx::naming::gid_type const& lower)
+{
+    hpx::naming::gid_type gid = lower;
+    for (std::uint64_t i = 0; i < gids_per_thread; i += gids_per_range)
+    {
+        std::uint64_t const count = range_count(i);
+        HPX_TEST(server->unbind_gid(count, gid));
+        gid += count;
+    }
+}
+
+void resolve_components(
+    primary_namespace* server, std::vector<hpx::id_type> const& ids)
+{
+    for (std::uint64_t j = 0; j != resolves_per_gid; ++j)
+    {
+        for (hpx::id_type const& id : ids)
+        {
+            primary_namespace::resolved_type r = server->resolve_gid(
+                hpx::naming::detail::get_stripped_gid(id.get_gid()));
+            HPX_TEST(hpx::util::get<0>(r) != hpx::naming::invalid_gid);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// run the given operation concurrently for each core, return the throughput
+// in operations per second
+template <typename F>
+double measure(std::size_t num_cores, std::uint64_t ops_per_core, F f)
+{
+    std::vector<hpx::future<void>> threads;
+    threads.reserve(num_cores);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != num_cores; ++i)
+    {
+        threads.push_back(hpx::async(f, i));
+    }
+
+    hpx::wait_all(threads);
+
+    std::uint64_t stop = hpx::util::high_resolution_clock::now();
+
+    double ops = double(num_cores * ops_per_core);
+    return ops / (double(stop - start) / 1e9);
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    bool print_header = vm.count("no-header") == 0;
+    std::size_t num_cores = hpx::get_os_thread_count();
+
+    if (gids_per_range == 0)
+        gids_per_range = 1;
+
+    hpx::agas::addressing_service& client = hpx::naming::get_agas_client();
+
+    // this benchmark directly accesses the primary namespace server which
+    // is available on the AGAS bootstrap locality only
+    primary_namespace* server =
+        reinterpret_cast<primary_namespace*>(client.get_primary_ns_lva());
+    if (server == nullptr)
+    {
+        hpx::cout << "the primary namespace server is not hosted on this "
+                     "locality"
+                  << hpx::endl;
+        return hpx::finalize();
+    }
+
+    hpx::naming::gid_type const locality = client.get_local_locality();
+
+    // create the component instances first, their heaps stay bound during
+    // all of the following measurements
+    std::vector<std::vector<hpx::id_type>> components(num_cores);
+    double create_rate = measure(num_cores, components_per_thread,
+        [&components](std::size_t i) { components[i] = create_components(); });
+
+    // allocate one block of gids per core
+    std::vector<hpx::naming::gid_type> lowers;
+    lowers.reserve(num_cores);
+    for (std::size_t i = 0; i != num_cores; ++i)
+    {
+        hpx::naming::gid_type lower, upper;
+        client.get_id_range(gids_per_thread, lower, upper);
+        lowers.push_back(hpx::naming::detail::get_stripped_gid(lower));
+    }
+
+    std::uint64_t const ranges_per_thread =
+        (gids_per_thread + gids_per_range - 1) / gids_per_range;
+
+    double bind_rate = measure(num_cores, ranges_per_thread,
+        [server, &lowers, &locality](std::size_t i) {
+            bind_gids(server, lowers[i], locality);
+        });
+
+    double resolve_rate = measure(num_cores,
+        resolves_per_gid * gids_per_thread,
+        [server, &lowers](std::size_t i) { resolve_gids(server, lowers[i]); });
+
+    double resolve_components_rate = measure(num_cores,
+        resolves_per_gid * components_per_thread,
+        [server, &components](std::size_t i) {
+            resolve_components(server, components[i]);
+        });
+
+    double refcnt_rate = measure(num_cores, 2 * gids_per_thread,
+        [server, &lowers](std::size_t i) {
+            incref_decref_gids(server, lowers[i]);
+        });
+
+    double unbind_rate = measure(num_cores, ranges_per_thread,
+        [server, &lowers](std::size_t i) { unbind_gids(server, lowers[i]); });
+
+    components.clear();
+
+    if (print_header)
+    {
+        hpx::cout << "num_cores,gids_per_core,gids_per_range,"
+                     "components_per_core,create[ops/s],bind[ops/s],"
+                     "resolve[ops/s],resolve_components[ops/s],"
+                     "incref_decref[ops/s],unbind[ops/s]"
+                  << hpx::endl;
+    }
+
+    hpx::util::format_to(hpx::cout, "{},{},{},{},{},{},{},{},{},{}",
+        num_cores, gids_per_thread, gids_per_range, components_per_thread,
+        create_rate, bind_rate, resolve_rate, resolve_components_rate,
+        refcnt_rate, unbind_rate)
+        << hpx::endl;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    namespace po = hpx::program_options;
+    po::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("gids",
+            po::value<std::uint64_t>(&gids_per_thread)->default_value(10000),
+            "number of gids to bind per core (default: 10000)")
+        ("range",
+            po::value<std::uint64_t>(&gids_per_range)->default_value(64),
+            "number of gids bound at once (default: 64)")
+        ("components",
+            po::value<std::uint64_t>(&components_per_thread)
+                ->default_value(10000),
+            "number of managed components to create per core "
+            "(default: 10000)")
+        ("resolves",
+            po::value<std::uint64_t>(&resolves_per_gid)->default_value(4),
+            "number of times each gid is resolved (default: 4)")
+        ("no-header", "do not print out the csv header row")
+        ;
+    // clang-format on
+
+    HPX_TEST_EQ(hpx::init(cmdline, argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,150 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of creating and destroying component
+// instances from many HPX threads concurrently. Instances of managed
+// components are allocated from the component heaps (wrapper_heap), while
+// instances of simple components are allocated using the global allocator.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <hpx/modules/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct simple_object
+  : hpx::components::component_base<simple_object>
+{
+};
+
+typedef hpx::components::component<simple_object> simple_object_type;
+HPX_REGISTER_COMPONENT(simple_object_type, simple_object);
+
+struct managed_object
+  : hpx::components::managed_component_base<managed_object>
+{
+};
+
+typedef hpx::components::managed_component<managed_object>
+    managed_object_type;
+HPX_REGISTER_COMPONENT(managed_object_type, managed_object);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Component>
+void create_components(std::size_t num_components)
+{
+    std::vector<hpx::id_type> ids;
+    ids.reserve(num_components);
+
+    for (std::size_t i = 0; i != num_components; ++i)
+    {
+        ids.push_back(hpx::new_<Component>(hpx::find_here()).get());
+    }
+
+    // the instances are released when ids goes out of scope
+}
+
+template <typename Component>
+double measure_creation(std::size_t num_samples, std::size_t num_tasks,
+    std::size_t num_components)
+{
+    double elapsed = 0;
+
+    for (std::size_t k = 0; k != num_samples; ++k)
+    {
+        hpx::util::high_resolution_timer t;
+
+        std::vector<hpx::future<void>> tasks;
+        tasks.reserve(num_tasks);
+
+        for (std::size_t i = 0; i != num_tasks; ++i)
+        {
+            tasks.push_back(
+                hpx::async(&create_components<Component>, num_components));
+        }
+        hpx::wait_all(tasks);
+
+        elapsed += t.elapsed();
+    }
+
+    return elapsed / num_samples;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::size_t num_samples = vm["samples"].as<std::size_t>();
+    std::size_t num_tasks = vm["tasks"].as<std::size_t>();
+    std::size_t num_components = vm["components"].as<std::size_t>();
+    bool header = !vm.count("no-header");
+
+    if (num_tasks == 0)
+        num_tasks = hpx::get_os_thread_count();
+
+    double elapsed_simple = measure_creation<simple_object>(
+        num_samples, num_tasks, num_components);
+    double elapsed_managed = measure_creation<managed_object>(
+        num_samples, num_tasks, num_components);
+
+    std::size_t const num_created = num_tasks * num_components;
+
+    if (header)
+    {
+        hpx::cout << "Component,OS-threads,Tasks,Components,"
+                     "Walltime[s],Throughput[1/s]"
+                  << hpx::endl;
+    }
+
+    std::size_t const num_os_threads = hpx::get_os_thread_count();
+
+    hpx::util::format_to(hpx::cout, "{},{},{},{},{:.6},{:.2}\n",
+        "simple", num_os_threads, num_tasks, num_components, elapsed_simple,
+        num_created / elapsed_simple);
+    hpx::util::format_to(hpx::cout, "{},{},{},{},{:.6},{:.2}\n",
+        "managed", num_os_threads, num_tasks, num_components,
+        elapsed_managed, num_created / elapsed_managed)
+        << hpx::flush;
+
+    hpx::util::print_cdash_timing(
+        "ComponentCreationSimple", elapsed_simple / num_created);
+    hpx::util::print_cdash_timing(
+        "ComponentCreationManaged", elapsed_managed / num_created);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    namespace po = hpx::program_options;
+
+    // Configure application-specific options.
+    po::options_description opts("usage: " HPX_APPLICATION_STRING " [options]");
+    opts.add_options()
+        ("samples,s", po::value<std::size_t>()->default_value(10),
+         "number of samples to average over (default: 10)")
+        ("tasks,t", po::value<std::size_t>()->default_value(0),
+         "number of concurrently running tasks creating components "
+         "(default: number of OS-threads)")
+        ("components,c", po::value<std::size_t>()->default_value(10000),
+         "number of components created by each task (default: 10000)")
+        ("no-header,n", "do not print out the csv header row")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(opts, argc, argv);
+}
@@ -213,6 +213,29 @@ void measure_function_futures_wait_all(
     print_stats("async", "WaitAll", exec_name(exec), count, duration, csv);
 }
 
+// Time async execution with a single continuation attached to each future,
+// the continuations are run inline by the thread making the future ready
+template <typename Executor>
+void measure_function_futures_then(
+    std::uint64_t count, bool csv, Executor& exec)
+{
+    std::vector<future<double>> futures;
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        futures.push_back(async(exec, &null_function)
+                              .then(hpx::launch::sync,
+                                  [](future<double>&& f) { return f.get(); }));
+    }
+    wait_all(futures);
+
+    const double duration = walltime.elapsed();
+    print_stats("then", "WaitAll", exec_name(exec), count, duration, csv);
+}
+
 template <typename Executor>
 void measure_function_futures_thread_count(
     std::uint64_t count, bool csv, Executor& exec)
@@ -574,6 +597,8 @@ int hpx_main(variables_map& vm)
                 measure_function_futures_wait_each(count, csv, tpe);
                 measure_function_futures_wait_all(count, csv, par);
                 measure_function_futures_wait_all(count, csv, tpe);
+                measure_function_futures_then(count, csv, par);
+                measure_function_futures_then(count, csv, tpe);
                 measure_function_futures_thread_count(count, csv, par);
                 measure_function_futures_thread_count(count, csv, tpe);
                 measure_function_futures_sliding_semaphore(count, csv, par);
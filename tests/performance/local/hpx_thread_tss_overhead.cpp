@@ -0,0 +1,111 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of thread specific data on HPX threads
+// (hpx::threads::thread_specific_ptr). It performs the same updates as
+// native_tls_overhead and hpx_tls_overhead do for OS-threads.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/threading_base/thread_specific_ptr.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// thread specific globals
+static hpx::threads::thread_specific_ptr<double> global_scratch;
+
+// more objects to make the storage use slots beyond the inline ones
+static hpx::threads::thread_specific_ptr<double> other_scratch[8];
+
+// we use a global here to prevent the updates from being optimized away
+double global_result = 0.;
+
+///////////////////////////////////////////////////////////////////////////////
+double worker(std::uint64_t updates, std::size_t other)
+{
+    for (std::size_t i = 0; i != other && i != 8; ++i)
+        other_scratch[i].reset(new double(1.));
+
+    double result = 0.;
+    for (std::uint64_t i = 0; i != updates; ++i)
+    {
+        global_scratch.reset(new double(0.));
+
+        *global_scratch += 1. / (2. * double(i) * (*global_scratch) + 1.);
+        result += *global_scratch.get();
+
+        global_scratch.reset();
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::uint64_t const tasks = vm["tasks"].as<std::uint64_t>();
+    std::uint64_t const updates = vm["updates"].as<std::uint64_t>();
+    std::size_t const other = vm["other-slots"].as<std::size_t>();
+
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<double>> futures;
+    futures.reserve(tasks);
+    for (std::uint64_t i = 0; i != tasks; ++i)
+    {
+        futures.push_back(hpx::async(&worker, updates, other));
+    }
+    for (auto& f : futures)
+        global_result += f.get();
+
+    double const duration = t.elapsed();
+
+    if (vm.count("csv"))
+    {
+        hpx::util::format_to(
+            std::cout, "{1},{2},{3}\n", updates, tasks, duration);
+    }
+    else
+    {
+        hpx::util::format_to(std::cout,
+            "ran {1} updates per HPX-thread on {2} HPX-threads in {3} "
+            "seconds\n",
+            updates, tasks, duration);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("tasks",
+         hpx::program_options::value<std::uint64_t>()->default_value(16),
+         "number of HPX-threads")
+        ("updates,u",
+         hpx::program_options::value<std::uint64_t>()->default_value(1 << 20),
+         "updates made to the thread specific variable per HPX-thread")
+        ("other-slots",
+         hpx::program_options::value<std::size_t>()->default_value(0),
+         "number of other thread specific variables (at most 8) each "
+         "HPX-thread sets before starting the updates")
+        ("csv",
+         "output results as csv (format: updates,HPX-threads,duration)")
+        ;
+    // clang-format on
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -69,6 +69,7 @@ int hpx_main(hpx::program_options::variables_map& vm)
     bool print_header = vm.count("no-header") == 0;
     bool do_child = vm.count("no-child") == 0;      // fork only
     bool do_parent = vm.count("no-parent") == 0;    // async only
+    bool do_lazy = vm.count("no-lazy") == 0;        // lazy only
     std::size_t num_cores = hpx::get_os_thread_count();
     if (vm.count("num_cores") != 0)
         num_cores = vm["num_cores"].as<std::size_t>();
@@ -83,19 +84,27 @@ int hpx_main(hpx::program_options::variables_map& vm)
     if (do_child)
         parent_stealing_time = measure(hpx::launch::fork);
 
+    // finally collect times for child stealing with inline execution of
+    // children which were not stolen
+    double lazy_stealing_time = 0;
+    if (do_lazy)
+        lazy_stealing_time = measure(hpx::launch::lazy);
+
     if (print_header)
     {
         hpx::cout
-            << "num_cores,num_threads,child_stealing_time[s],parent_stealing_time[s]"
+            << "num_cores,num_threads,child_stealing_time[s],parent_stealing_time[s],"
+               "lazy_child_stealing_time[s]"
             << hpx::endl;
     }
 
     hpx::util::format_to(hpx::cout,
-        "{},{},{},{}",
+        "{},{},{},{},{}",
         num_cores,
         iterations,
         child_stealing_time,
-        parent_stealing_time) << hpx::endl;
+        parent_stealing_time,
+        lazy_stealing_time) << hpx::endl;
 
     return hpx::finalize();
 }
@@ -122,6 +131,8 @@ int main(int argc, char* argv[])
         ("no-header", "do not print out the csv header row")
         ("no-child", "do not test child-stealing (launch::fork only)")
         ("no-parent", "do not test child-stealing (launch::async only)")
+        ("no-lazy", "do not test child-stealing with inline execution "
+            "(launch::lazy only)")
         ;
 
     return hpx::init(cmdline, argc, argv);
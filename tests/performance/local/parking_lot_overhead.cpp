@@ -0,0 +1,220 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the synchronization primitives based on the global
+// parking lot with the existing ones under contention. Each task repeatedly
+// acquires one out of a configurable number of locks (or semaphores) and
+// performs a short delay while holding it.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/synchronization/compact_counting_semaphore.hpp>
+#include <hpx/synchronization/compact_mutex.hpp>
+#include <hpx/synchronization/counting_semaphore.hpp>
+#include <hpx/synchronization/mutex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the delay from being optimized away
+double global_scratch = 0;
+std::uint64_t num_iterations = 0;
+std::uint64_t delay_iterations = 0;
+
+double delay()
+{
+    double d = 0.;
+    for (std::uint64_t j = 0; j < delay_iterations; ++j)
+    {
+        d += 1. / (2. * double(j) + 1.);
+    }
+    return d;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+struct lock_policy
+{
+    using type = Mutex;
+
+    static std::unique_ptr<Mutex[]> create(std::size_t count)
+    {
+        return std::unique_ptr<Mutex[]>(new Mutex[count]);
+    }
+
+    static void acquire(Mutex& mtx)
+    {
+        mtx.lock();
+    }
+    static void release(Mutex& mtx)
+    {
+        mtx.unlock();
+    }
+};
+
+template <typename Semaphore>
+struct semaphore_policy
+{
+    using type = Semaphore;
+
+    static std::unique_ptr<Semaphore[]> create(std::size_t count)
+    {
+        std::unique_ptr<Semaphore[]> sems(new Semaphore[count]);
+        for (std::size_t i = 0; i != count; ++i)
+            sems[i].signal(2);
+        return sems;
+    }
+
+    static void acquire(Semaphore& sem)
+    {
+        sem.wait();
+    }
+    static void release(Semaphore& sem)
+    {
+        sem.signal();
+    }
+};
+
+struct compact_semaphore_policy
+{
+    using type = hpx::lcos::local::compact_counting_semaphore;
+
+    static std::unique_ptr<type[]> create(std::size_t count)
+    {
+        std::unique_ptr<type[]> sems(new type[count]);
+        for (std::size_t i = 0; i != count; ++i)
+            sems[i].release(2);
+        return sems;
+    }
+
+    static void acquire(type& sem)
+    {
+        sem.acquire();
+    }
+    static void release(type& sem)
+    {
+        sem.release();
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Policy>
+void run_benchmark(std::string const& name, std::uint64_t tasks,
+    std::size_t num_objects, bool csv)
+{
+    auto objects = Policy::create(num_objects);
+
+    hpx::util::high_resolution_timer walltime;
+
+    std::vector<hpx::future<double>> futures;
+    futures.reserve(tasks);
+    for (std::uint64_t i = 0; i != tasks; ++i)
+    {
+        futures.push_back(hpx::async([&objects, i, num_objects]() {
+            typename Policy::type& obj = objects[i % num_objects];
+            double d = 0.;
+            for (std::uint64_t j = 0; j != num_iterations; ++j)
+            {
+                Policy::acquire(obj);
+                d += delay();
+                Policy::release(obj);
+            }
+            return d;
+        }));
+    }
+
+    for (auto& f : futures)
+        global_scratch += f.get();
+
+    double const duration = walltime.elapsed();
+
+    if (csv)
+    {
+        hpx::util::format_to(hpx::cout, "{1},{2},{3},{4}\n", name, tasks,
+            num_objects, duration)
+            << hpx::flush;
+    }
+    else
+    {
+        hpx::util::format_to(hpx::cout,
+            "{1}: {2} tasks contending for {3} objects in {4} seconds\n",
+            name, tasks, num_objects, duration)
+            << hpx::flush;
+    }
+    hpx::util::print_cdash_timing(name.c_str(), duration);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::uint64_t const tasks = vm["tasks"].as<std::uint64_t>();
+    std::size_t const num_objects = vm["objects"].as<std::size_t>();
+    bool const csv = vm.count("csv") != 0;
+
+    num_iterations = vm["iterations"].as<std::uint64_t>();
+    delay_iterations = vm["delay-iterations"].as<std::uint64_t>();
+
+    if (!csv)
+    {
+        hpx::util::format_to(hpx::cout,
+            "sizeof(mutex): {1}, sizeof(compact_mutex): {2}\n"
+            "sizeof(counting_semaphore): {3}, "
+            "sizeof(compact_counting_semaphore): {4}\n",
+            sizeof(hpx::lcos::local::mutex),
+            sizeof(hpx::lcos::local::compact_mutex),
+            sizeof(hpx::lcos::local::counting_semaphore),
+            sizeof(hpx::lcos::local::compact_counting_semaphore))
+            << hpx::flush;
+    }
+
+    run_benchmark<lock_policy<hpx::lcos::local::mutex>>(
+        "Mutex", tasks, num_objects, csv);
+    run_benchmark<lock_policy<hpx::lcos::local::compact_mutex>>(
+        "CompactMutex", tasks, num_objects, csv);
+    run_benchmark<semaphore_policy<hpx::lcos::local::counting_semaphore>>(
+        "CountingSemaphore", tasks, num_objects, csv);
+    run_benchmark<compact_semaphore_policy>(
+        "CompactCountingSemaphore", tasks, num_objects, csv);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("tasks",
+         hpx::program_options::value<std::uint64_t>()->default_value(1000),
+         "number of tasks contending for the synchronization objects")
+        ("objects",
+         hpx::program_options::value<std::size_t>()->default_value(1),
+         "number of synchronization objects the tasks are distributed over")
+        ("iterations",
+         hpx::program_options::value<std::uint64_t>()->default_value(1000),
+         "number of acquire/release operations per task")
+        ("delay-iterations",
+         hpx::program_options::value<std::uint64_t>()->default_value(10),
+         "number of iterations in the delay loop while holding an object")
+        ("csv", "output results as csv (format: name,tasks,objects,duration)")
+        ;
+    // clang-format on
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -303,17 +303,10 @@ struct triad_step
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-template <typename Allocator, typename Policy>
-std::vector<std::vector<double>> run_benchmark(std::size_t iterations,
-    std::size_t size, Allocator&& alloc, Policy&& policy)
+template <typename Vector, typename Policy>
+std::vector<std::vector<double>> run_kernels(std::size_t iterations,
+    Vector& a, Vector& b, Vector& c, Policy&& policy)
 {
-    // Allocate our data
-    using vector_type = hpx::compute::vector<STREAM_TYPE, Allocator>;
-
-    vector_type a(size, alloc);
-    vector_type b(size, alloc);
-    vector_type c(size, alloc);
-
     // Initialize arrays
     hpx::parallel::fill(policy, a.begin(), a.end(), 1.0);
     hpx::parallel::fill(policy, b.begin(), b.end(), 2.0);
@@ -393,6 +386,58 @@ std::vector<std::vector<double>> run_benchmark(std::size_t iterations,
     return timing;
 }
 
+template <typename Allocator, typename Policy>
+std::vector<std::vector<double>> run_benchmark(std::size_t iterations,
+    std::size_t size, Allocator&& alloc, Policy&& policy)
+{
+    // Allocate our data
+    using vector_type = hpx::compute::vector<STREAM_TYPE, Allocator>;
+
+    vector_type a(size, alloc);
+    vector_type b(size, alloc);
+    vector_type c(size, alloc);
+
+    return run_kernels(iterations, a, b, c, std::forward<Policy>(policy));
+}
+
+// Run the kernels on NUMA partitioned views of uninitialized memory. The
+// arrays are initialized using the executor paired with the views, which
+// places each partition on the NUMA domain of the target it is owned by
+// (first touch). All kernels are scheduled according to this placement.
+std::vector<std::vector<double>> run_partitioned_benchmark(
+    std::size_t iterations, std::size_t size)
+{
+    using executor_type = hpx::compute::host::numa_partitioned_executor<>;
+    using view_type = hpx::compute::host::numa_partitioned_view<STREAM_TYPE>;
+
+    hpx::threads::topology& topo = retrieve_topology();
+
+    std::size_t const bytes = size * sizeof(STREAM_TYPE);
+    STREAM_TYPE* a_data = static_cast<STREAM_TYPE*>(topo.allocate(bytes));
+    STREAM_TYPE* b_data = static_cast<STREAM_TYPE*>(topo.allocate(bytes));
+    STREAM_TYPE* c_data = static_cast<STREAM_TYPE*>(topo.allocate(bytes));
+
+    std::vector<std::vector<double>> timing;
+    {
+        executor_type exec(hpx::compute::host::numa_domains());
+
+        view_type a(a_data, size, exec);
+        view_type b(b_data, size, exec);
+        view_type c(c_data, size, exec);
+
+        auto policy =
+            hpx::parallel::execution::par.on(exec).with(a.parameters());
+
+        timing = run_kernels(iterations, a, b, c, policy);
+    }
+
+    topo.deallocate(c_data, bytes);
+    topo.deallocate(b_data, bytes);
+    topo.deallocate(a_data, bytes);
+
+    return timing;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(hpx::program_options::variables_map& vm)
 {
@@ -515,10 +560,16 @@ int hpx_main(hpx::program_options::variables_map& vm)
             timing = run_benchmark<>(
                 iterations, vector_size, std::move(alloc), std::move(policy));
         }
+        else if (executor == 4)
+        {
+            // NUMA partitioned views, each chunk runs on the NUMA domain
+            // owning its memory.
+            timing = run_partitioned_benchmark(iterations, vector_size);
+        }
         else
         {
             HPX_THROW_EXCEPTION(hpx::commandline_option_error, "hpx_main",
-                "Invalid executor id given (0-3 allowed");
+                "Invalid executor id given (0-4 allowed");
         }
     }
     time_total = mysecond() - time_total;
@@ -598,7 +649,8 @@ int main(int argc, char* argv[])
             "size of vector (default: 1024)")
         (   "executor",
             hpx::program_options::value<std::size_t>()->default_value(3),
-            "executor to use (0-3) (default: 3, thread_pool_executor)")
+            "executor to use (0-4) (default: 3, thread_pool_executor, "
+            "4: numa_partitioned_executor)")
 
 #if defined(HPX_HAVE_COMPUTE)
         (   "use-accelerator",
@@ -0,0 +1,128 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of the send path of the parcel layer
+// if many threads concurrently send small parcels to many destinations. Run
+// it on a larger number of localities to exercise the per-destination send
+// queues, for instance:
+//
+//      many_peers_send_performance --hpx:localities=8 --senders=64
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/modules/timing.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::uint64_t> received_count(0);
+
+void receive(std::vector<char> const&)
+{
+    ++received_count;
+}
+HPX_PLAIN_ACTION(receive, receive_action);
+
+///////////////////////////////////////////////////////////////////////////////
+// send the given number of parcels, the destinations are chosen round-robin
+void send_parcels(std::vector<hpx::id_type> const& peers, std::size_t sender,
+    std::size_t nparcels, std::size_t window, std::size_t payload)
+{
+    std::vector<char> data(payload, 'x');
+
+    std::vector<hpx::future<void>> futures;
+    futures.reserve(window);
+
+    for (std::size_t i = 0; i != nparcels; ++i)
+    {
+        hpx::id_type const& dest = peers[(sender + i) % peers.size()];
+        futures.push_back(hpx::async<receive_action>(dest, data));
+
+        if (futures.size() == window)
+        {
+            hpx::wait_all(futures);
+            futures.clear();
+        }
+    }
+    hpx::wait_all(futures);
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::size_t const senders = vm["senders"].as<std::size_t>();
+    std::size_t const nparcels = vm["nparcels"].as<std::size_t>();
+    std::size_t const window = vm["window"].as<std::size_t>();
+    std::size_t const payload = vm["payload"].as<std::size_t>();
+
+    std::vector<hpx::id_type> peers = hpx::find_remote_localities();
+    if (peers.empty())
+    {
+        hpx::cout << "This benchmark needs to be run on at least two "
+                     "localities\n"
+                  << hpx::flush;
+        return hpx::finalize();
+    }
+
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void>> tasks;
+    tasks.reserve(senders);
+    for (std::size_t i = 0; i != senders; ++i)
+    {
+        tasks.push_back(hpx::async(
+            &send_parcels, std::cref(peers), i, nparcels, window, payload));
+    }
+    hpx::wait_all(tasks);
+
+    double const elapsed = t.elapsed();
+    double const total = double(senders * nparcels);
+
+    hpx::cout << "Locality " << hpx::get_locality_id() << ": sent " << total
+              << " parcels to " << peers.size() << " peers using " << senders
+              << " senders in " << elapsed << " [s], "
+              << total / elapsed << " [parcels/s]\n"
+              << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options
+    hpx::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // clang-format off
+    cmdline.add_options()
+        ("senders",
+         hpx::program_options::value<std::size_t>()->default_value(64),
+         "the number of concurrently sending threads per locality")
+        ("nparcels,n",
+         hpx::program_options::value<std::size_t>()->default_value(10000),
+         "the number of parcels sent by each sender")
+        ("window",
+         hpx::program_options::value<std::size_t>()->default_value(256),
+         "the number of outstanding parcels per sender")
+        ("payload",
+         hpx::program_options::value<std::size_t>()->default_value(8),
+         "the size of the payload of each parcel (in bytes)")
+        ;
+    // clang-format on
+
+    // Initialize and run HPX
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -9,12 +9,76 @@
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/serialization.hpp>
+#include <hpx/allocator_support/thread_local_caching_allocator.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <string>
 #include <vector>
 
+///////////////////////////////////////////////////////////////////////////////
+// Count all allocations performed through the global operator new to report
+// the number of allocations per remote action invocation. Allocations of
+// action objects, thread functions, and shared states are served by the
+// per-thread allocator caches instead, those are accounted for through the
+// cache statistics (see allocation_counts below).
+std::atomic<std::uint64_t> allocation_count(0);
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct allocation_counts
+{
+    allocation_counts()
+      : operator_new(allocation_count.load())
+      , cache(hpx::util::get_allocator_cache_statistics(false))
+    {
+    }
+
+    // allocations which had to go to the memory allocator, i.e. all calls
+    // to operator new, the allocations the caches couldn't serve, and the
+    // allocations bypassing the caches altogether
+    std::int64_t heap() const
+    {
+        return std::int64_t(operator_new) + cache.allocations -
+            cache.cache_hits + cache.uncached;
+    }
+
+    std::uint64_t operator_new;
+    hpx::util::allocator_cache_statistics cache;
+};
+
+allocation_counts operator-(
+    allocation_counts const& lhs, allocation_counts const& rhs)
+{
+    allocation_counts result(lhs);
+    result.operator_new -= rhs.operator_new;
+    result.cache.allocations -= rhs.cache.allocations;
+    result.cache.cache_hits -= rhs.cache.cache_hits;
+    result.cache.uncached -= rhs.cache.uncached;
+    return result;
+}
+
 namespace pingpong
 {
     namespace server
@@ -51,6 +115,8 @@ int hpx_main(hpx::program_options::variables_map& vm)
     hpx::naming::id_type other_locality = dummy[0];
 
 
+    allocation_counts const allocations_start;
+
     for(std::size_t i=0; i<n; ++i)
     {
         vec.push_back(hpx::async(act,other_locality));
@@ -69,6 +135,17 @@ int hpx_main(hpx::program_options::variables_map& vm)
                       <<received[n-1]<< "\n" << hpx::flush;
         }
     ).get();
+
+    // this includes the allocations needed for serving the actions invoked
+    // by the other locality
+    allocation_counts const allocations =
+        allocation_counts() - allocations_start;
+    hpx::cout << "Locality " << hpx::get_locality_id()
+              << ": heap allocations per action invocation: "
+              << double(allocations.heap()) / double(n)
+              << ", served from the allocator caches: "
+              << double(allocations.cache.cache_hits) / double(n) << "\n"
+              << hpx::flush;
     return hpx::finalize();
 }
 
@@ -0,0 +1,112 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server : hpx::components::component_base<test_server>
+{
+    test_server()
+      : value_(0)
+    {
+    }
+
+    std::uint64_t get_lva() const
+    {
+        return reinterpret_cast<std::uint64_t>(this);
+    }
+    HPX_DEFINE_COMPONENT_ACTION(test_server, get_lva, get_lva_action);
+
+    std::int64_t add(std::int64_t v)
+    {
+        return value_ += v;
+    }
+    HPX_DEFINE_COMPONENT_ACTION(test_server, add, add_action);
+
+    std::int64_t value_;
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::get_lva_action get_lva_action;
+HPX_REGISTER_ACTION_DECLARATION(get_lva_action);
+HPX_REGISTER_ACTION(get_lva_action);
+
+typedef test_server::add_action add_action;
+HPX_REGISTER_ACTION_DECLARATION(add_action);
+HPX_REGISTER_ACTION(add_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_cached_address()
+{
+    hpx::id_type id =
+        hpx::components::new_<test_server>(hpx::find_here()).get();
+    std::uint64_t lva = hpx::async<get_lva_action>(id).get();
+
+    // the address is resolved from AGAS first, and from the id afterwards
+    for (int i = 0; i != 3; ++i)
+    {
+        hpx::naming::address addr;
+        HPX_TEST(hpx::agas::is_local_address_cached(id, addr));
+        HPX_TEST_EQ(addr.address_, lva);
+        HPX_TEST(addr.locality_ == hpx::find_here().get_gid());
+    }
+
+    // copies of the id share the cached address
+    hpx::id_type id1 = id;
+    hpx::naming::address addr;
+    HPX_TEST(hpx::agas::is_local_address_cached(id1, addr));
+    HPX_TEST_EQ(addr.address_, lva);
+
+    // invocations through the cached address reach the object
+    std::vector<hpx::future<std::int64_t>> results;
+    for (std::int64_t i = 0; i != 100; ++i)
+    {
+        results.push_back(hpx::async<add_action>(id1, 1));
+    }
+    hpx::wait_all(results);
+
+    HPX_TEST_EQ(hpx::sync<add_action>(id, 0), std::int64_t(100));
+    HPX_TEST_EQ(hpx::async<get_lva_action>(id1).get(), lva);
+}
+
+void test_different_objects()
+{
+    hpx::id_type here = hpx::find_here();
+    hpx::id_type id1 = hpx::components::new_<test_server>(here).get();
+    hpx::id_type id2 = hpx::components::new_<test_server>(here).get();
+
+    for (int i = 0; i != 3; ++i)
+    {
+        HPX_TEST_NEQ(hpx::async<get_lva_action>(id1).get(),
+            hpx::async<get_lva_action>(id2).get());
+    }
+}
+
+int hpx_main()
+{
+    test_cached_address();
+    test_different_objects();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(
+        hpx::init(argc, argv), 0, "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,228 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+
+#if !defined(HPX_HAVE_AWAIT) && !defined(HPX_HAVE_CXX20_COROUTINES)
+#error "This test requires compiler support for C++20 coroutines"
+#endif
+
+#include <hpx/async_local/task.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int just_wait(int result)
+{
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return result;
+}
+
+hpx::task<int> value_task(int value)
+{
+    co_return value;
+}
+
+hpx::task<int> nested_task()
+{
+    int result = co_await value_task(20);
+    result += co_await value_task(22);
+    co_return result;
+}
+
+hpx::task<int> future_task()
+{
+    co_return co_await hpx::async(&just_wait, 42);
+}
+
+std::atomic<bool> void_task_executed(false);
+
+hpx::task<> void_task()
+{
+    void_task_executed = true;
+    co_return;
+}
+
+void simple_task_tests()
+{
+    HPX_TEST_EQ(hpx::sync_wait(value_task(42)), 42);
+    HPX_TEST_EQ(hpx::sync_wait(nested_task()), 42);
+    HPX_TEST_EQ(hpx::sync_wait(future_task()), 42);
+
+    // tasks are lazy
+    hpx::task<> t = void_task();
+    HPX_TEST(!void_task_executed);
+    HPX_TEST(t.valid());
+    HPX_TEST(!t.is_ready());
+
+    hpx::sync_wait(std::move(t));
+    HPX_TEST(void_task_executed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::task<int> fib(int n)
+{
+    if (n >= 2)
+        n = co_await fib(n - 1) + co_await fib(n - 2);
+    co_return n;
+}
+
+void recursive_task_tests()
+{
+    HPX_TEST_EQ(hpx::sync_wait(fib(10)), 55);
+    HPX_TEST_EQ(hpx::sync_wait(fib(20)), 6765);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::task<int> throwing_task()
+{
+    throw std::runtime_error("throwing_task");
+    co_return 42;
+}
+
+hpx::task<int> catching_task()
+{
+    try
+    {
+        co_await throwing_task();
+    }
+    catch (std::runtime_error const&)
+    {
+        co_return 42;
+    }
+    co_return 0;
+}
+
+void exception_task_tests()
+{
+    bool caught_exception = false;
+    try
+    {
+        hpx::sync_wait(throwing_task());
+        HPX_TEST(false);
+    }
+    catch (std::runtime_error const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    HPX_TEST_EQ(hpx::sync_wait(catching_task()), 42);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::task<hpx::thread::id> schedule_task()
+{
+    co_await hpx::schedule(hpx::parallel::execution::parallel_executor());
+    co_return hpx::this_thread::get_id();
+}
+
+void schedule_task_tests()
+{
+    hpx::thread::id id = hpx::sync_wait(schedule_task());
+    HPX_TEST_NEQ(id, hpx::this_thread::get_id());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::task<int> scheduled_value_task(int value)
+{
+    co_await hpx::schedule(hpx::parallel::execution::parallel_executor());
+    co_return value;
+}
+
+std::atomic<std::size_t> void_task_count(0);
+
+hpx::task<> scheduled_void_task()
+{
+    co_await hpx::schedule(hpx::parallel::execution::parallel_executor());
+    ++void_task_count;
+}
+
+void when_all_task_tests()
+{
+    {
+        std::vector<hpx::task<int>> tasks;
+        for (int i = 0; i != 100; ++i)
+        {
+            tasks.push_back(i % 2 ? value_task(i) : scheduled_value_task(i));
+        }
+
+        std::vector<int> results =
+            hpx::sync_wait(hpx::when_all(std::move(tasks)));
+        HPX_TEST_EQ(results.size(), std::size_t(100));
+        for (int i = 0; i != 100; ++i)
+        {
+            HPX_TEST_EQ(results[i], i);
+        }
+    }
+
+    {
+        std::vector<hpx::task<>> tasks;
+        for (int i = 0; i != 100; ++i)
+        {
+            tasks.push_back(scheduled_void_task());
+        }
+
+        hpx::sync_wait(hpx::when_all(std::move(tasks)));
+        HPX_TEST_EQ(void_task_count.load(), std::size_t(100));
+    }
+
+    {
+        std::vector<hpx::task<int>> tasks;
+        tasks.push_back(scheduled_value_task(1));
+        tasks.push_back(throwing_task());
+
+        bool caught_exception = false;
+        try
+        {
+            hpx::sync_wait(hpx::when_all(std::move(tasks)));
+            HPX_TEST(false);
+        }
+        catch (std::runtime_error const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    {
+        std::vector<hpx::task<int>> tasks;
+        HPX_TEST(hpx::sync_wait(hpx::when_all(std::move(tasks))).empty());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    simple_task_tests();
+    recursive_task_tests();
+    exception_task_tests();
+    schedule_task_tests();
+    when_all_task_tests();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // We force this test to use several threads by default.
+    std::vector<std::string> const cfg = {"hpx.os_threads=all"};
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,242 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test verifying that the elastic_pool_policy lends a shared processing unit
+// to an overloaded pool and reclaims it once the owning pool has work, and
+// that it honors the minimal number of cores of each pool.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/schedulers.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/modules/timing.hpp>
+#include <hpx/threading_base/scheduler_mode.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void busy_work()
+{
+    hpx::util::high_resolution_timer t;
+    while (t.elapsed() < 0.001)
+    {
+    }
+}
+
+template <typename F>
+bool wait_for(F&& f, double timeout = 10.0)
+{
+    hpx::util::high_resolution_timer t;
+    while (!f())
+    {
+        if (t.elapsed() > timeout)
+            return false;
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::vector<hpx::future<void>> load_pool(std::string const& pool_name)
+{
+    hpx::parallel::execution::pool_executor exec(pool_name);
+
+    std::vector<hpx::future<void>> fs;
+    for (std::size_t i = 0; i != 2000; ++i)
+    {
+        fs.push_back(hpx::async(exec, &busy_work));
+    }
+    return fs;
+}
+
+// a pool is never run on less than min_cores processing units, neither
+// initially nor after reclaiming a lent processing unit
+void test_min_cores()
+{
+    hpx::threads::elastic_pool_policy policy(
+        std::chrono::microseconds(1000), 2);
+
+    hpx::threads::elastic_pool_parameters io_params;
+    io_params.min_cores = 1;
+    io_params.max_cores = 2;
+
+    hpx::threads::elastic_pool_parameters compute_params;
+    compute_params.min_cores = 2;
+    compute_params.max_cores = 2;
+
+    policy.add_pool("io", io_params);
+    policy.add_pool("compute", compute_params);
+
+    policy.start();
+
+    // the shared processing unit owned by io is lent to compute right away
+    HPX_TEST(wait_for(
+        [&]() { return policy.get_num_cores("io") == std::size_t(1); }));
+    HPX_TEST_EQ(policy.get_num_cores("compute"), std::size_t(2));
+
+    {
+        // io does not reclaim its processing unit, even when it has work
+        std::vector<hpx::future<void>> fs = load_pool("io");
+
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(50));
+        HPX_TEST_EQ(policy.get_num_cores("io"), std::size_t(1));
+        HPX_TEST_EQ(policy.get_num_cores("compute"), std::size_t(2));
+
+        hpx::wait_all(fs);
+    }
+
+    policy.stop();
+
+    HPX_TEST_EQ(policy.get_num_cores("io"), std::size_t(2));
+    HPX_TEST_EQ(policy.get_num_cores("compute"), std::size_t(1));
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    hpx::threads::elastic_pool_policy policy(
+        std::chrono::microseconds(1000), 2);
+
+    hpx::threads::elastic_pool_parameters params;
+    params.min_cores = 1;
+    params.max_cores = 2;
+
+    // the shared processing unit is owned by the pool added first
+    policy.add_pool("io", params);
+    policy.add_pool("compute", params);
+
+    HPX_TEST_EQ(policy.get_num_cores("io"), std::size_t(2));
+    HPX_TEST_EQ(policy.get_num_cores("compute"), std::size_t(2));
+
+    policy.start();
+    HPX_TEST(policy.is_running());
+
+    HPX_TEST(wait_for([&]() {
+        return policy.get_num_cores("compute") == std::size_t(1);
+    }));
+    HPX_TEST_EQ(policy.get_num_cores("io"), std::size_t(2));
+
+    {
+        // the idle io pool lends its shared processing unit to compute
+        std::vector<hpx::future<void>> fs = load_pool("compute");
+
+        HPX_TEST(wait_for([&]() {
+            return policy.get_num_cores("compute") == std::size_t(2);
+        }));
+        HPX_TEST_EQ(policy.get_num_cores("io"), std::size_t(1));
+
+        hpx::wait_all(fs);
+    }
+
+    HPX_TEST_LTE(std::int64_t(1), policy.get_move_count());
+
+    {
+        // the io pool reclaims its processing unit as soon as it has work
+        std::vector<hpx::future<void>> fs = load_pool("io");
+
+        HPX_TEST(wait_for([&]() {
+            return policy.get_num_cores("io") == std::size_t(2);
+        }));
+        HPX_TEST_EQ(policy.get_num_cores("compute"), std::size_t(1));
+
+        hpx::wait_all(fs);
+    }
+
+    HPX_TEST_LTE(std::int64_t(2), policy.get_move_count());
+    HPX_TEST_LTE(
+        std::int64_t(2), hpx::threads::get_elastic_core_move_count(false));
+
+    policy.stop();
+    HPX_TEST(!policy.is_running());
+
+    HPX_TEST_EQ(policy.get_num_cores("io"), std::size_t(2));
+    HPX_TEST_EQ(policy.get_num_cores("compute"), std::size_t(1));
+
+    test_min_cores();
+
+    return hpx::finalize();
+}
+
+void test_scheduler(
+    int argc, char* argv[], hpx::resource::scheduling_policy scheduler)
+{
+    hpx::init_params init_args;
+
+    init_args.cfg = {"hpx.os_threads=4"};
+    init_args.rp_mode = hpx::resource::partitioner_mode(
+        hpx::resource::mode_allow_oversubscription |
+        hpx::resource::mode_allow_dynamic_pools);
+    init_args.rp_callback = [scheduler](auto& rp) {
+        hpx::threads::policies::scheduler_mode const mode =
+            hpx::threads::policies::scheduler_mode(
+                hpx::threads::policies::default_mode |
+                hpx::threads::policies::enable_elasticity);
+
+        rp.create_thread_pool("io", scheduler, mode);
+        rp.create_thread_pool("compute", scheduler, mode);
+
+        std::vector<hpx::resource::pu> pus;
+        for (hpx::resource::numa_domain const& d : rp.numa_domains())
+        {
+            for (hpx::resource::core const& c : d.cores())
+            {
+                for (hpx::resource::pu const& p : c.pus())
+                {
+                    pus.push_back(p);
+                }
+            }
+        }
+
+        // pus[0] is left to the default pool, pus[3] is shared by io and
+        // compute
+        rp.add_resource(pus[1], "io");
+        rp.add_resource(pus[2], "compute");
+        rp.add_resource(pus[3], "io", false);
+        rp.add_resource(pus[3], "compute", false);
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, init_args), 0);
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<hpx::resource::scheduling_policy> schedulers = {
+#if defined(HPX_HAVE_LOCAL_SCHEDULER)
+        hpx::resource::scheduling_policy::local,
+        hpx::resource::scheduling_policy::local_priority_fifo,
+#if defined(HPX_HAVE_CXX11_STD_ATOMIC_128BIT)
+        hpx::resource::scheduling_policy::local_priority_lifo,
+#endif
+#endif
+#if defined(HPX_HAVE_ABP_SCHEDULER) && defined(HPX_HAVE_CXX11_STD_ATOMIC_128BIT)
+        hpx::resource::scheduling_policy::abp_priority_fifo,
+        hpx::resource::scheduling_policy::abp_priority_lifo,
+#endif
+#if defined(HPX_HAVE_STATIC_SCHEDULER)
+        hpx::resource::scheduling_policy::static_,
+#endif
+#if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
+        hpx::resource::scheduling_policy::static_priority,
+#endif
+#if defined(HPX_HAVE_WORK_STEALING_SCHEDULER)
+        hpx::resource::scheduling_policy::work_stealing,
+#endif
+    };
+
+    for (auto const scheduler : schedulers)
+    {
+        test_scheduler(argc, argv, scheduler);
+    }
+
+    return hpx::util::report_errors();
+}
@@ -246,6 +246,9 @@ int main(int argc, char* argv[])
 #endif
 #if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
             hpx::resource::scheduling_policy::static_priority,
+#endif
+#if defined(HPX_HAVE_WORK_STEALING_SCHEDULER)
+            hpx::resource::scheduling_policy::work_stealing,
 #endif
         };
 
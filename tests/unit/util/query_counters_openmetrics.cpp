@@ -0,0 +1,246 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  SPDX-License-Identifier: BSL-1.0
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/testing.hpp>
+#include <hpx/util/query_counters.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(HPX_WINDOWS)
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+namespace fs = hpx::filesystem;
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::int64_t> query_count(0);
+
+std::int64_t get_count(bool)
+{
+    return ++query_count;
+}
+
+std::int64_t get_gauge(bool)
+{
+    return 42;
+}
+
+// lower and upper boundary, number of buckets, then the underflow bucket,
+// the buckets, and the overflow bucket
+std::vector<std::int64_t> get_histogram(bool)
+{
+    return {0, 100, 2, 1, 2, 3, 4};
+}
+
+std::vector<std::int64_t> get_values(bool)
+{
+    return {5, 6, 7};
+}
+
+void register_counter_types()
+{
+    using hpx::util::placeholders::_1;
+    using hpx::util::placeholders::_2;
+    namespace pc = hpx::performance_counters;
+
+    pc::install_counter_type("/test/count", &get_count,
+        "counts the queries", "", pc::counter_monotonically_increasing);
+    pc::install_counter_type("/test/gauge", &get_gauge, "returns 42");
+    pc::install_counter_type("/test/values", &get_values, "returns 5, 6, 7");
+    pc::install_counter_type("/test/histogram", pc::counter_histogram,
+        "returns a fixed histogram",
+        hpx::util::bind(&pc::locality_raw_values_counter_creator, _1,
+            hpx::util::function_nonser<std::vector<std::int64_t>(bool)>(
+                &get_histogram),
+            _2),
+        &pc::locality_counter_discoverer, HPX_PERFORMANCE_COUNTER_V1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string read_file(fs::path const& p)
+{
+    std::ifstream in(p.string().c_str());
+    return std::string(
+        std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+std::size_t count_lines(std::string const& data, std::string const& prefix)
+{
+    std::size_t result = 0;
+    std::size_t pos = 0;
+    while ((pos = data.find(prefix, pos)) != std::string::npos)
+    {
+        if (pos == 0 || data[pos - 1] == '\n')
+            ++result;
+        pos += prefix.size();
+    }
+    return result;
+}
+
+std::shared_ptr<hpx::util::query_counters> make_query_counters(
+    std::string const& destination)
+{
+    std::vector<std::string> const names = {"/test/count", "/test/gauge",
+        "/test/histogram", "/test/values"};
+
+    // the interval is long enough for the timer to never fire again
+    return std::make_shared<hpx::util::query_counters>(names,
+        std::vector<std::string>(), 3600 * 1000, destination, "openmetrics",
+        std::vector<std::string>(), false, false, false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// every series carries the given number of samples
+void check_exposition(std::string const& data, std::size_t samples)
+{
+    std::string const labels = "locality=\"0\",instance=\"total\"";
+
+    HPX_TEST_EQ(count_lines(data, "# TYPE hpx_test_count counter\n"),
+        std::size_t(1));
+    HPX_TEST_EQ(count_lines(data, "# HELP hpx_test_count counts the queries\n"),
+        std::size_t(1));
+    HPX_TEST_EQ(count_lines(data, "hpx_test_count_total{" + labels + "} "),
+        samples);
+
+    HPX_TEST_EQ(count_lines(data, "# TYPE hpx_test_gauge gauge\n"),
+        std::size_t(1));
+    HPX_TEST_EQ(
+        count_lines(data, "hpx_test_gauge{" + labels + "} 42 "), samples);
+
+    std::string const histogram = "hpx_test_histogram";
+    HPX_TEST_EQ(count_lines(data, "# TYPE " + histogram + " gaugehistogram\n"),
+        std::size_t(1));
+    HPX_TEST_EQ(count_lines(data,
+                    histogram + "_bucket{" + labels + ",le=\"0\"} 1 "),
+        samples);
+    HPX_TEST_EQ(count_lines(data,
+                    histogram + "_bucket{" + labels + ",le=\"50\"} 3 "),
+        samples);
+    HPX_TEST_EQ(count_lines(data,
+                    histogram + "_bucket{" + labels + ",le=\"100\"} 6 "),
+        samples);
+    HPX_TEST_EQ(count_lines(data,
+                    histogram + "_bucket{" + labels + ",le=\"+Inf\"} 10 "),
+        samples);
+    HPX_TEST_EQ(
+        count_lines(data, histogram + "_gcount{" + labels + "} 10 "), samples);
+
+    HPX_TEST_EQ(count_lines(data, "# TYPE hpx_test_values unknown\n"),
+        std::size_t(1));
+    HPX_TEST_EQ(
+        count_lines(data, "hpx_test_values{" + labels + ",index=\"0\"} 5 "),
+        samples);
+    HPX_TEST_EQ(
+        count_lines(data, "hpx_test_values{" + labels + ",index=\"2\"} 7 "),
+        samples);
+
+    // the exposition is terminated exactly once
+    HPX_TEST_EQ(count_lines(data, "# EOF\n"), std::size_t(1));
+    HPX_TEST(data.size() >= 6 &&
+        data.compare(data.size() - 6, 6, "# EOF\n") == 0);
+}
+
+void test_batches(fs::path const& dir)
+{
+    fs::path const destination = dir / "counters.prom";
+    auto qc = make_query_counters(destination.string());
+
+    // the first sample is taken right away, it is buffered
+    qc->start();
+    HPX_TEST(!fs::exists(destination));
+
+    // the second sample completes the batch
+    qc->evaluate_counters();
+    HPX_TEST(fs::exists(destination));
+    check_exposition(read_file(destination), 2);
+
+    // the third sample is buffered again, the file is not touched
+    qc->evaluate_counters();
+    check_exposition(read_file(destination), 2);
+
+    // the remaining sample is written when the counters are stopped
+    qc->stop_evaluating_counters(true);
+    check_exposition(read_file(destination), 1);
+
+    // the temporary file is gone
+    HPX_TEST(!fs::exists(dir / "counters.prom.tmp"));
+}
+
+void test_write_error(fs::path const& dir)
+{
+    fs::path const destination = dir / "missing" / "counters.prom";
+    auto qc = make_query_counters(destination.string());
+
+    qc->start();
+
+    hpx::error_code ec;
+    HPX_TEST(!qc->evaluate_counters(false, nullptr, false, ec));
+    HPX_TEST(ec);
+    HPX_TEST_EQ(ec.value(), int(hpx::filesystem_error));
+
+    qc->stop_evaluating_counters(true);
+}
+
+#if !defined(HPX_WINDOWS)
+// writing to a named pipe nobody reads from does not block
+void test_fifo(fs::path const& dir)
+{
+    fs::path const destination = dir / "counters.fifo";
+    HPX_TEST_EQ(::mkfifo(destination.string().c_str(), 0600), 0);
+
+    auto qc = make_query_counters(destination.string());
+
+    qc->start();
+
+    hpx::error_code ec;
+    qc->evaluate_counters(false, nullptr, false, ec);
+    HPX_TEST(!ec);
+
+    qc->stop_evaluating_counters(true);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::random_device random_device;
+    fs::path const dir = fs::temp_directory_path() /
+        ("hpx_query_counters_openmetrics_" + std::to_string(random_device()));
+    fs::create_directories(dir);
+
+    test_batches(dir);
+    test_write_error(dir);
+#if !defined(HPX_WINDOWS)
+    test_fifo(dir);
+#endif
+
+    fs::remove_all(dir);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::register_startup_function(&register_counter_types);
+
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=1", "hpx.print_counter.batch_size=2"};
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    return hpx::util::report_errors();
+}